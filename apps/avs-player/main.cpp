@@ -4,11 +4,13 @@
 #include <cerrno>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <limits>
 #include <mutex>
@@ -17,6 +19,7 @@
 #include <variant>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #define DR_WAV_IMPLEMENTATION
@@ -36,13 +39,32 @@ extern "C" {
 #include <avs/effects.hpp>
 #include <avs/engine.hpp>
 #include <avs/fft.hpp>
+#include <avs/frame_interpolator.hpp>
 #include <avs/fs.hpp>
+#include <avs/idle_monitor.hpp>
 #include <avs/preset.hpp>
+#include <avs/preset_loader.hpp>
 #include <avs/runtime/ResourceManager.hpp>
+#include <avs/thread_placement.hpp>
 #include <avs/window.hpp>
 
 namespace {
 
+// Windowed frame budget for adaptive quality: one 60 Hz refresh.
+constexpr double kFrameBudgetMs = 1000.0 / 60.0;
+constexpr float kTransitionSeconds = 1.0f;
+// SCHED_FIFO priorities for --realtime; audio outranks rendering so a heavy
+// frame can never starve capture.
+constexpr int kAudioFifoPriority = 70;
+constexpr int kRenderFifoPriority = 50;
+// While idle the loop still polls input and audio this often, so sound or a
+// key press resumes full rate within a frame or so.
+constexpr std::chrono::milliseconds kIdlePollInterval{10};
+constexpr int kDefaultIdleFps = 4;
+// With --interpolate, how often the presenting thread checks back while no
+// interpolated frame is available yet.
+constexpr std::chrono::milliseconds kStepPollInterval{1};
+
 avs::runtime::ResourceManager& resourceManager() {
   static avs::runtime::ResourceManager manager;
   return manager;
@@ -76,7 +98,7 @@ bool loadWav(const std::filesystem::path& path, WavData& out) {
   return true;
 }
 
-std::string hashFrame(const std::vector<std::uint8_t>& data) {
+std::string hashFrame(const avs::core::AlignedBytes& data) {
   SHA256_CTX ctx;
   sha256_init(&ctx);
   sha256_update(&ctx, data.data(), data.size());
@@ -97,14 +119,49 @@ void printUsage() {
       "                 [--render-backend <cpu|opengl|file>] [--export-path <dir>]\n"
       "                 [--export-pattern <pattern>] [--sample-rate <hz|default>]\n"
       "                 [--channels <count|default>] [--input-device <id>]\n"
-      "                 [--list-input-devices] [--demo-script] [--presets <directory>] [--help]\n"
+      "                 [--list-input-devices] [--demo-script] [--presets <directory>]\n"
+      "                 [--quality <0-3|auto>] [--render-scale <0.25-1>] [--threads <n>]\n"
+      "                 [--transition <1-14>] [--render-cpus <list>] [--audio-cpus <list>]\n"
+      "                 [--realtime] [--nice <n>] [--idle-fps <n|off>] [--interpolate]\n"
+      "                 [--help]\n"
+      "\n"
+      "Quality:\n"
+      "  --quality auto             Lower effect quality when frames exceed 16.6 ms (windowed default)\n"
+      "  --quality <0-3>            Lock effect quality; 3 is full quality (headless default)\n"
+      "  --render-scale <factor>    Run effects at a fraction of the output size and\n"
+      "                             upscale bilinearly on present (e.g. 0.5)\n"
+      "  --threads <n>              Split band-safe effects into row bands across n\n"
+      "                             threads (default 1); output is identical\n"
+      "\n"
+      "Presets:\n"
+      "  --presets <dir>            Play the .avs files in <dir> in name order; 'n' switches\n"
+      "                             to the next one, which is prepared in the background\n"
+      "  --transition <1-14>        Crossfade preset switches over 1 s with the given\n"
+      "                             transition mode instead of cutting (1 = dissolve)\n"
+      "\n"
+      "Thread placement (windowed mode):\n"
+      "  --render-cpus <list>       Pin the render thread and band workers, one per CPU,\n"
+      "                             to a CPU list such as 2-5 or 2,3,6\n"
+      "  --audio-cpus <list>        Pin the audio callback; render threads avoid these\n"
+      "                             CPUs unless --render-cpus says otherwise\n"
+      "  --realtime                 Request SCHED_FIFO for audio (%d) and rendering (%d)\n"
+      "  --nice <n>                 Nice level for render threads when not realtime\n"
+      "\n"
+      "Display rate (windowed mode):\n"
+      "  --interpolate              Step the chain on its own thread and present\n"
+      "                             motion-compensated in-between frames at the display\n"
+      "                             rate; adds one rendered frame of latency\n"
+      "  --idle-fps <n|off>         Once the audio is silent and the output has stopped\n"
+      "                             changing for a second, render only n frames per\n"
+      "                             second until sound, a reload or a resize (default %d)\n"
       "\n"
       "Render backends:\n"
       "  --render-backend cpu       Headless CPU rendering (no window)\n"
       "  --render-backend opengl    OpenGL windowed rendering (default)\n"
       "  --render-backend file      Export PNG sequence (requires --export-path)\n"
       "  --export-path <dir>        Directory for PNG exports (file backend)\n"
-      "  --export-pattern <pattern> Filename pattern (e.g., frame_%%05d.png)\n");
+      "  --export-pattern <pattern> Filename pattern (e.g., frame_%%05d.png)\n",
+      kAudioFifoPriority, kRenderFifoPriority, kDefaultIdleFps);
 }
 
 void printInputDevices(const std::vector<avs::audio::DeviceInfo>& devices) {
@@ -469,8 +526,77 @@ class LiveAudioAnalyzer {
   std::mutex mutex_;
 };
 
+// Runs engine steps off the presenting thread for --interpolate, so a slow
+// chain never holds up presenting at the display rate. One step at a time.
+class StepThread {
+ public:
+  explicit StepThread(const avs::ThreadPlacement& placement) {
+    thread_ = std::thread([this, placement] {
+      avs::ThreadPlacementReport report =
+          placement.empty() ? avs::currentThreadPlacement() : avs::applyThreadPlacement(placement);
+      std::unique_lock<std::mutex> lock(mutex_);
+      placement_ = std::move(report);
+      started_ = true;
+      wake_.notify_all();
+      for (;;) {
+        wake_.wait(lock, [this] { return stop_ || job_; });
+        if (stop_) return;
+        std::function<void()> job = std::move(job_);
+        job_ = nullptr;
+        lock.unlock();
+        job();
+        lock.lock();
+        running_ = false;
+      }
+    });
+    std::unique_lock<std::mutex> lock(mutex_);
+    wake_.wait(lock, [this] { return started_; });
+  }
+
+  ~StepThread() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+  }
+
+  StepThread(const StepThread&) = delete;
+  StepThread& operator=(const StepThread&) = delete;
+
+  // Run `job` on the step thread; the previous one must be done().
+  void start(std::function<void()> job) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_ = std::move(job);
+      running_ = true;
+    }
+    wake_.notify_all();
+  }
+
+  bool done() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !running_;
+  }
+
+  // Where the step thread ended up.
+  const avs::ThreadPlacementReport& placement() const { return placement_; }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::function<void()> job_;
+  bool running_ = false;
+  bool started_ = false;
+  bool stop_ = false;
+  avs::ThreadPlacementReport placement_;
+  std::thread thread_;
+};
+
 int runHeadless(const std::filesystem::path& wavPath, const std::filesystem::path& presetPath,
-                int frames, const std::filesystem::path& outDir, bool writePngs) {
+                int frames, const std::filesystem::path& outDir, bool writePngs,
+                std::optional<int> qualityLevel, float renderScale, int threads) {
   WavData wav;
   if (!loadWav(wavPath, wav)) {
     std::fprintf(stderr, "failed to load wav\n");
@@ -491,6 +617,12 @@ int runHeadless(const std::filesystem::path& wavPath, const std::filesystem::pat
   const int width = 64;
   const int height = 64;
   avs::Engine engine(width, height);
+  // Headless output must be reproducible, so quality never adapts to frame time here.
+  if (qualityLevel) {
+    engine.lockQualityLevel(*qualityLevel);
+  }
+  engine.setRenderScale(renderScale);
+  engine.setThreadCount(threads);
   engine.setChain(std::move(parsed.chain));
 
   OfflineAudio audio(wav);
@@ -506,7 +638,7 @@ int runHeadless(const std::filesystem::path& wavPath, const std::filesystem::pat
     auto s = audio.poll();
     engine.setAudio(s);
     engine.step(1.0f / 60.0f);
-    const auto& fb = engine.frame();
+    const auto& fb = engine.outputFrame();
     hashes << hashFrame(fb.rgba) << '\n';
     if (writePngs) {
       char name[32];
@@ -542,6 +674,16 @@ int main(int argc, char** argv) {
   std::string renderBackend = "opengl";  // default
   std::filesystem::path exportPath;
   std::string exportPattern = "frame_%05d.png";
+  std::optional<int> qualityLevel;  // unset: adaptive when windowed, full quality when headless
+  float renderScale = 1.0f;
+  int threads = 1;
+  int transitionMode = 0;  // 0: cut between presets
+  std::optional<std::vector<int>> renderCpus;
+  std::optional<std::vector<int>> audioCpus;
+  bool realtime = false;
+  std::optional<int> renderNice;
+  int idleFps = kDefaultIdleFps;
+  bool interpolate = false;
 
   std::unique_ptr<avs::audio::AudioEngine> audioEngine;
   std::vector<avs::audio::DeviceInfo> availableDevices;
@@ -643,6 +785,74 @@ int main(int argc, char** argv) {
       exportPath = argv[++i];
     } else if (arg == "--export-pattern" && i + 1 < argc) {
       exportPattern = argv[++i];
+    } else if (arg == "--render-scale" && i + 1 < argc) {
+      std::string token = argv[++i];
+      char* end = nullptr;
+      const float parsed = std::strtof(token.c_str(), &end);
+      if (end == token.c_str() || *end != '\0' || !(parsed >= avs::Engine::kMinRenderScale) ||
+          parsed > 1.0f) {
+        std::fprintf(stderr, "--render-scale expects a value between %.2f and 1\n",
+                     avs::Engine::kMinRenderScale);
+        return 1;
+      }
+      renderScale = parsed;
+    } else if (arg == "--threads" && i + 1 < argc) {
+      auto parsed = parsePositiveInt(argv[++i]);
+      if (!parsed.has_value()) {
+        std::fprintf(stderr, "--threads expects a positive integer\n");
+        return 1;
+      }
+      threads = parsed.value();
+    } else if (arg == "--transition" && i + 1 < argc) {
+      auto parsed = parsePositiveInt(argv[++i]);
+      if (!parsed.has_value() || parsed.value() >= avs::core::kTransitionModeCount) {
+        std::fprintf(stderr, "--transition expects a mode between 1 and %d\n",
+                     avs::core::kTransitionModeCount - 1);
+        return 1;
+      }
+      transitionMode = parsed.value();
+    } else if ((arg == "--render-cpus" || arg == "--audio-cpus") && i + 1 < argc) {
+      auto parsed = avs::parseCpuList(argv[++i]);
+      if (!parsed.has_value()) {
+        std::fprintf(stderr, "%s expects a CPU list such as 0-3,6\n", arg.c_str());
+        return 1;
+      }
+      (arg == "--render-cpus" ? renderCpus : audioCpus) = std::move(parsed);
+    } else if (arg == "--realtime") {
+      realtime = true;
+    } else if (arg == "--nice" && i + 1 < argc) {
+      errno = 0;
+      char* end = nullptr;
+      const char* text = argv[++i];
+      long parsed = std::strtol(text, &end, 10);
+      if (end == text || *end != '\0' || errno == ERANGE || parsed < -20 || parsed > 19) {
+        std::fprintf(stderr, "--nice expects a value between -20 and 19\n");
+        return 1;
+      }
+      renderNice = static_cast<int>(parsed);
+    } else if (arg == "--interpolate") {
+      interpolate = true;
+    } else if (arg == "--idle-fps" && i + 1 < argc) {
+      std::string token = normalizeToken(argv[++i]);
+      if (token == "off") {
+        idleFps = 0;
+      } else if (auto parsed = parsePositiveInt(token)) {
+        idleFps = *parsed;
+      } else {
+        std::fprintf(stderr, "--idle-fps expects a positive integer or 'off'\n");
+        return 1;
+      }
+    } else if (arg == "--quality" && i + 1 < argc) {
+      std::string token = normalizeToken(argv[++i]);
+      if (token == "auto") {
+        qualityLevel.reset();
+      } else if (token.size() == 1 && token[0] >= '0' &&
+                 token[0] - '0' <= avs::core::kMaxQualityLevel) {
+        qualityLevel = token[0] - '0';
+      } else {
+        std::fprintf(stderr, "--quality expects 0-%d or 'auto'\n", avs::core::kMaxQualityLevel);
+        return 1;
+      }
     } else {
       std::fprintf(stderr, "Unknown argument: %s\n", arg.c_str());
       printUsage();
@@ -682,7 +892,8 @@ int main(int argc, char** argv) {
       return 1;
     }
     // Route to headless mode with PNG export
-    return runHeadless(wavPath, presetPath, frames, exportPath, true);
+    return runHeadless(wavPath, presetPath, frames, exportPath, true, qualityLevel,
+                       renderScale, threads);
   }
 
   if (renderBackend == "cpu") {
@@ -700,7 +911,8 @@ int main(int argc, char** argv) {
       return 1;
     }
     // Route to headless mode without PNG export
-    return runHeadless(wavPath, presetPath, frames, outPath, false);
+    return runHeadless(wavPath, presetPath, frames, outPath, false, qualityLevel,
+                       renderScale, threads);
   }
 
   // Handle legacy --headless flag (backward compatibility)
@@ -715,7 +927,8 @@ int main(int argc, char** argv) {
       return 1;
     }
     bool writePngs = outPath != ".";
-    return runHeadless(wavPath, presetPath, frames, outPath, writePngs);
+    return runHeadless(wavPath, presetPath, frames, outPath, writePngs, qualityLevel,
+                       renderScale, threads);
   }
 
   // OpenGL backend (default) - windowed mode
@@ -776,6 +989,11 @@ int main(int argc, char** argv) {
     analyzer.setOutputChannelCount(channelCount);
   }
 
+  avs::ThreadPlacement audioPlacement;
+  if (audioCpus) audioPlacement.cpus = *audioCpus;
+  if (realtime) audioPlacement.realtimePriority = kAudioFifoPriority;
+  audioEngine->setCallbackPlacement(audioPlacement);
+
   avs::audio::AudioEngine::InputStream inputStream;
   try {
     inputStream = audioEngine->openInputStream(
@@ -794,24 +1012,84 @@ int main(int argc, char** argv) {
   avs::Window window(1920, 1080, "AVS Player");
 
   avs::Engine engine(1920, 1080);
+  if (qualityLevel) {
+    engine.lockQualityLevel(*qualityLevel);
+  } else {
+    engine.setFrameBudget(kFrameBudgetMs);
+  }
+  engine.setRenderScale(renderScale);
+  engine.setThreadCount(threads);
+
+  // Reloads are built on the loader thread and swapped in between frames, so
+  // the render loop never waits on parsing or script compilation. It starts
+  // before the loop thread is pinned so it keeps the process-wide affinity and
+  // scheduling policy instead of sharing a realtime render CPU.
+  avs::PresetLoader presetLoader;
+
+  // Render threads stay off the audio CPUs unless told otherwise. The thread
+  // that steps the chain doubles as band worker 0, so it takes the first CPU
+  // of the set: the loop thread, or the step thread with --interpolate.
+  avs::ThreadPlacement renderPlacement;
+  if (renderCpus) {
+    renderPlacement.cpus = *renderCpus;
+  } else if (audioCpus) {
+    for (int cpu : avs::availableCpus()) {
+      if (std::find(audioCpus->begin(), audioCpus->end(), cpu) == audioCpus->end()) {
+        renderPlacement.cpus.push_back(cpu);
+      }
+    }
+  }
+  if (realtime) renderPlacement.realtimePriority = kRenderFifoPriority;
+  renderPlacement.nice = renderNice;
+  avs::ThreadPlacement loopPlacement = renderPlacement;
+  if (!loopPlacement.cpus.empty()) loopPlacement.cpus.resize(1);
+  std::unique_ptr<StepThread> stepThread;
+  std::unique_ptr<avs::FrameInterpolator> interpolator;
+  if (interpolate) {
+    stepThread = std::make_unique<StepThread>(loopPlacement);
+    interpolator = std::make_unique<avs::FrameInterpolator>();
+  }
+  if (!renderPlacement.empty()) {
+    const avs::ThreadPlacementReport loopReport =
+        stepThread ? stepThread->placement() : avs::applyThreadPlacement(loopPlacement);
+    std::printf("render thread: %s\n", avs::describeThreadPlacement(loopReport).c_str());
+    engine.setThreadPlacement(renderPlacement);
+    const auto workers = engine.workerPlacements();
+    for (size_t i = 0; i < workers.size(); ++i) {
+      std::printf("render worker %zu: %s\n", i + 1,
+                  avs::describeThreadPlacement(workers[i]).c_str());
+    }
+  }
+  bool audioPlacementReported = audioPlacement.empty();
+
   std::filesystem::path currentPreset;
   std::unique_ptr<avs::FileWatcher> watcher;
-  auto loadPreset = [&]() -> bool {
-    if (currentPreset.empty()) return false;
-    auto parsed = avs::parsePreset(currentPreset);
-    if (!parsed.warnings.empty()) {
-      for (const auto& w : parsed.warnings) {
-        std::fprintf(stderr, "%s\n", w.c_str());
-      }
+  auto installPreset = [&](avs::LoadedChain loaded, bool crossfade) -> bool {
+    for (const auto& w : loaded.warnings) {
+      std::fprintf(stderr, "%s\n", w.c_str());
     }
-    if (parsed.chain.empty()) {
-      std::fprintf(stderr, "failed to parse preset: %s\n", currentPreset.string().c_str());
+    if (!loaded.ok()) {
+      std::fprintf(stderr, "failed to parse preset: %s\n", loaded.path.string().c_str());
       return false;
     }
-    engine.setChain(std::move(parsed.chain));
-    watcher = std::make_unique<avs::FileWatcher>(currentPreset);
+    if (crossfade && transitionMode > 0) {
+      engine.beginTransition(std::move(loaded.effects), loaded.w, loaded.h,
+                             static_cast<avs::core::TransitionMode>(transitionMode),
+                             kTransitionSeconds);
+    } else {
+      presetLoader.retire(engine.swapChain(std::move(loaded.effects), loaded.w, loaded.h));
+      // A hard cut: motion between the old chain's frames and the new one's is meaningless.
+      if (interpolator) interpolator->reset();
+    }
+    watcher = std::make_unique<avs::FileWatcher>(loaded.path);
     return true;
   };
+  auto loadPreset = [&]() -> bool {
+    if (currentPreset.empty()) return false;
+    return installPreset(
+        avs::PresetLoader::build(currentPreset, engine.renderWidth(), engine.renderHeight()),
+        false);
+  };
 
   bool chainConfigured = false;
   if (!presetPath.empty()) {
@@ -823,15 +1101,34 @@ int main(int argc, char** argv) {
     }
   }
 
-  if (!chainConfigured && !presetDir.empty()) {
+  // --presets doubles as a set list. The entry after the current one is kept
+  // warm in the loader's cache, so stepping to it is a pointer swap.
+  std::vector<std::filesystem::path> playlist;
+  if (!presetDir.empty()) {
     for (auto& e : std::filesystem::directory_iterator(presetDir)) {
       if (e.is_regular_file() && e.path().extension() == ".avs") {
-        currentPreset = e.path();
-        chainConfigured = loadPreset();
-        if (chainConfigured) break;
+        playlist.push_back(e.path());
       }
     }
+    std::sort(playlist.begin(), playlist.end());
+  }
+  size_t playlistIndex = playlist.empty() ? 0 : playlist.size() - 1;
+  auto prefetchNext = [&]() {
+    if (playlist.size() < 2) return;
+    presetLoader.prefetch(playlist[(playlistIndex + 1) % playlist.size()], engine.renderWidth(),
+                          engine.renderHeight());
+  };
+
+  for (size_t i = 0; i < playlist.size(); ++i) {
+    if (playlist[i] == currentPreset) {
+      playlistIndex = i;
+    } else if (!chainConfigured) {
+      currentPreset = playlist[i];
+      chainConfigured = loadPreset();
+      if (chainConfigured) playlistIndex = i;
+    }
   }
+  prefetchNext();
 
   std::vector<std::unique_ptr<avs::Effect>> chain;
   if (!chainConfigured && demoScript) {
@@ -857,31 +1154,112 @@ int main(int argc, char** argv) {
     watcher = std::make_unique<avs::FileWatcher>(currentPreset);
   }
 
-  auto last = std::chrono::steady_clock::now();
+  // Steady silent output drops to idleFps; see avs::IdleMonitor.
+  avs::IdleMonitor::Config idleConfig;
+  if (idleFps > 0) {
+    idleConfig.idleIntervalSeconds = 1.0 / idleFps;
+  } else {
+    idleConfig.settleFrames = 0;
+  }
+  avs::IdleMonitor idleMonitor(idleConfig);
+  std::pair<int, int> windowSize{0, 0};
+
+  auto lastStep = std::chrono::steady_clock::now();
+  auto lastPoll = lastStep;
+  const auto loopStart = lastStep;
   float printAccum = 0.0f;
+  // With --interpolate a step in flight owns the engine; everything that
+  // touches it waits until the step thread is done.
+  bool stepping = false;
+  double stepSeconds = 0.0;
+  avs::Framebuffer presented;
   while (window.poll()) {
     auto now = std::chrono::steady_clock::now();
-    float dt = std::chrono::duration<float>(now - last).count();
-    last = now;
+    printAccum += std::chrono::duration<float>(now - lastPoll).count();
+    lastPoll = now;
+
+    if (!audioPlacementReported) {
+      if (auto placed = inputStream.callbackPlacement()) {
+        std::printf("audio callback: %s\n", avs::describeThreadPlacement(*placed).c_str());
+        audioPlacementReported = true;
+      }
+    }
 
     auto s = analyzer.poll();
-    engine.setAudio(s);
-    printAccum += dt;
+    idleMonitor.observeAudio(s.rms);
     if (printAccum > 0.5f) {
       printAccum = 0.0f;
-      std::printf("rms %.3f bands %.3f %.3f %.3f\n", s.rms, s.bands[0], s.bands[1], s.bands[2]);
+      std::printf("rms %.3f bands %.3f %.3f %.3f%s\n", s.rms, s.bands[0], s.bands[1], s.bands[2],
+                  idleMonitor.idle() ? " (idle)" : "");
     }
 
-    if (!currentPreset.empty()) {
+    if (!playlist.empty() && window.keyPressed('n')) {
+      playlistIndex = (playlistIndex + 1) % playlist.size();
+      currentPreset = playlist[playlistIndex];
+      presetLoader.request(currentPreset, engine.renderWidth(), engine.renderHeight());
+      prefetchNext();
+      idleMonitor.wake();
+    } else if (!currentPreset.empty()) {
       if (window.keyPressed('r') || (watcher && watcher->poll())) {
-        loadPreset();
+        presetLoader.request(currentPreset, engine.renderWidth(), engine.renderHeight());
+        idleMonitor.wake();
+      }
+    }
+
+    if (stepping && stepThread->done()) {
+      stepping = false;
+      presetLoader.retire(engine.takeRetiredChain());
+      idleMonitor.observeFrame(engine.frame());
+      interpolator->submit(engine.frame(), stepSeconds);
+    }
+
+    if (!stepping) {
+      engine.setAudio(s);
+      if (window.size() != windowSize) {
+        windowSize = window.size();
+        engine.resize(windowSize.first, windowSize.second);
+        if (interpolator) interpolator->reset();
+        idleMonitor.wake();
+      }
+      if (auto loaded = presetLoader.takeReady()) {
+        installPreset(std::move(*loaded), true);
+        idleMonitor.wake();
+      }
+
+      // While idle the window keeps showing the last frame; the chain only
+      // runs often enough to notice when its output starts changing again.
+      const float dt = std::chrono::duration<float>(now - lastStep).count();
+      if (idleMonitor.shouldRender(dt)) {
+        lastStep = now;
+        if (stepThread) {
+          stepSeconds = std::chrono::duration<double>(now - loopStart).count();
+          stepThread->start([&engine, dt] { engine.step(dt); });
+          stepping = true;
+        } else {
+          engine.step(dt);
+          presetLoader.retire(engine.takeRetiredChain());
+          const auto& frame = engine.frame();
+          idleMonitor.observeFrame(frame);
+          if (!idleMonitor.idle()) {
+            // The window stretches the texture with linear filtering, so a
+            // reduced render scale is upscaled on the GPU.
+            window.blit(frame.rgba.data(), frame.w, frame.h);
+            continue;
+          }
+        }
       }
     }
 
-    auto [w, h] = window.size();
-    engine.resize(w, h);
-    engine.step(dt);
-    window.blit(engine.frame().rgba.data(), w, h);
+    if (interpolator && !idleMonitor.idle()) {
+      if (interpolator->present(std::chrono::duration<double>(now - loopStart).count(),
+                                presented)) {
+        window.blit(presented.rgba.data(), presented.w, presented.h);
+      } else {
+        std::this_thread::sleep_for(kStepPollInterval);
+      }
+    } else {
+      std::this_thread::sleep_for(kIdlePollInterval);
+    }
   }
   return 0;
 }
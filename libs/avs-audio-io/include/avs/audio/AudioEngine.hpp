@@ -6,6 +6,8 @@
 #include <variant>
 #include <vector>
 
+#include <avs/thread_placement.hpp>
+
 #include "DeviceInfo.hpp"
 
 namespace avs::audio {
@@ -31,6 +33,11 @@ class AudioEngine {
 
   std::vector<DeviceInfo> listInputDevices() const;
 
+  // CPUs and priority for the callback thread of streams opened after this
+  // call. PortAudio owns that thread, so the placement is applied from inside
+  // the first callback.
+  void setCallbackPlacement(const ThreadPlacement& placement);
+
   class InputStream {
    public:
     InputStream();
@@ -43,6 +50,9 @@ class AudioEngine {
     InputStream& operator=(const InputStream&) = delete;
 
     bool isActive() const;
+    // Where the callback thread ended up; empty until the first callback, or
+    // if no placement was requested.
+    std::optional<ThreadPlacementReport> callbackPlacement() const;
 
     struct Impl;
 
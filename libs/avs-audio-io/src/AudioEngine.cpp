@@ -3,7 +3,9 @@
 #include <portaudio.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <utility>
@@ -39,12 +41,18 @@ std::string makePaErrorMessage(const std::string& prefix, PaError err) {
 
 struct AudioEngine::Impl {
   Impl() { (void)globalSession(); }
+
+  ThreadPlacement callbackPlacement;
 };
 
 struct AudioEngine::InputStream::Impl {
   PaStream* stream = nullptr;
   InputCallback callback;
   int channelCount = 0;
+  ThreadPlacement placement;
+  std::atomic<bool> placed{false};
+  mutable std::mutex placementMutex;
+  std::optional<ThreadPlacementReport> placementReport;
 };
 
 namespace {
@@ -57,6 +65,14 @@ int paStreamCallback(const void* input, void*, unsigned long frameCount,
     return paAbort;
   }
 
+  // One-off: the first callback places its own thread.
+  if (!impl->placed.load(std::memory_order_relaxed)) {
+    impl->placed.store(true, std::memory_order_relaxed);
+    ThreadPlacementReport report = applyThreadPlacement(impl->placement);
+    std::lock_guard<std::mutex> lock(impl->placementMutex);
+    impl->placementReport = std::move(report);
+  }
+
   const float* samples = static_cast<const float*>(input);
   thread_local std::vector<float> silence;
   if (!samples) {
@@ -88,6 +104,10 @@ AudioEngine::~AudioEngine() = default;
 AudioEngine::AudioEngine(AudioEngine&&) noexcept = default;
 AudioEngine& AudioEngine::operator=(AudioEngine&&) noexcept = default;
 
+void AudioEngine::setCallbackPlacement(const ThreadPlacement& placement) {
+  impl_->callbackPlacement = placement;
+}
+
 std::vector<DeviceInfo> AudioEngine::listInputDevices() const {
   (void)globalSession();
   PaDeviceIndex count = Pa_GetDeviceCount();
@@ -138,6 +158,14 @@ bool AudioEngine::InputStream::isActive() const {
   return Pa_IsStreamActive(impl_->stream) == 1;
 }
 
+std::optional<ThreadPlacementReport> AudioEngine::InputStream::callbackPlacement() const {
+  if (!impl_) {
+    return std::nullopt;
+  }
+  std::lock_guard<std::mutex> lock(impl_->placementMutex);
+  return impl_->placementReport;
+}
+
 AudioEngine::InputStream::InputStream(std::shared_ptr<Impl> impl) : impl_(std::move(impl)) {}
 
 AudioEngine::InputStream AudioEngine::openInputStream(const DeviceInfo& device, double sampleRate,
@@ -176,6 +204,8 @@ AudioEngine::InputStream AudioEngine::openInputStream(const DeviceInfo& device,
   auto impl = std::make_shared<InputStream::Impl>();
   impl->callback = std::move(callback);
   impl->channelCount = input.channelCount;
+  impl->placement = impl_->callbackPlacement;
+  impl->placed = impl->placement.empty();
 
   PaStream* stream = nullptr;
   PaError err = Pa_OpenStream(&stream, &input, nullptr, rate, framesPerBuffer, paClipOff,
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace avs {
+
+// Where a thread may run and how the scheduler should treat it. Each field is
+// a request; anything left at its default leaves the thread as it is.
+struct ThreadPlacement {
+  std::vector<int> cpus;      // CPUs the thread may run on; empty: any
+  int realtimePriority = 0;   // > 0: request SCHED_FIFO at this priority
+  std::optional<int> nice;    // nice level, also the fallback when FIFO is refused
+
+  bool empty() const { return cpus.empty() && realtimePriority <= 0 && !nice; }
+};
+
+// Where a thread actually ended up. Requests the OS refused (no
+// CAP_SYS_NICE, an offline CPU, ...) are listed in `refused`.
+struct ThreadPlacementReport {
+  std::vector<int> cpus;
+  bool realtime = false;
+  int priority = 0;  // SCHED_FIFO priority when realtime, nice level otherwise
+  std::vector<std::string> refused;
+};
+
+// Apply `placement` to the calling thread and report the result.
+ThreadPlacementReport applyThreadPlacement(const ThreadPlacement& placement);
+// Placement of the calling thread as the scheduler sees it.
+ThreadPlacementReport currentThreadPlacement();
+// One line, e.g. "cpus 2-5, SCHED_FIFO 40" or "cpus 0-7, nice -5".
+std::string describeThreadPlacement(const ThreadPlacementReport& report);
+
+// Parse a CPU list such as "0-3,6"; nullopt if malformed.
+std::optional<std::vector<int>> parseCpuList(std::string_view text);
+std::string formatCpuList(const std::vector<int>& cpus);
+// CPUs the process may run on, ascending.
+std::vector<int> availableCpus();
+
+}  // namespace avs
@@ -0,0 +1,3 @@
+#pragma once
+
+#include <avs/base/thread_placement.hpp>
@@ -0,0 +1,170 @@
+#include <avs/thread_placement.hpp>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <thread>
+
+namespace avs {
+
+namespace {
+
+std::string refusal(const std::string& what, int err) { return what + ": " + std::strerror(err); }
+
+#ifdef __linux__
+// setpriority() on a thread id changes only that thread on Linux.
+id_t currentTid() { return static_cast<id_t>(syscall(SYS_gettid)); }
+#endif
+
+bool parseInt(std::string_view text, int& value) {
+  if (text.empty()) return false;
+  const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+  return ec == std::errc() && end == text.data() + text.size() && value >= 0;
+}
+
+}  // namespace
+
+ThreadPlacementReport applyThreadPlacement(const ThreadPlacement& placement) {
+  std::vector<std::string> refused;
+#ifdef __linux__
+  if (!placement.cpus.empty()) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : placement.cpus) {
+      if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    }
+    const int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (err != 0) refused.push_back(refusal("cpus " + formatCpuList(placement.cpus), err));
+  }
+
+  bool realtime = false;
+  if (placement.realtimePriority > 0) {
+    sched_param param{};
+    param.sched_priority = std::clamp(placement.realtimePriority, sched_get_priority_min(SCHED_FIFO),
+                                      sched_get_priority_max(SCHED_FIFO));
+    const int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (err == 0) {
+      realtime = true;
+    } else {
+      refused.push_back(refusal("SCHED_FIFO " + std::to_string(param.sched_priority), err));
+    }
+  }
+
+  if (placement.nice && !realtime) {
+    if (setpriority(PRIO_PROCESS, currentTid(), *placement.nice) != 0) {
+      refused.push_back(refusal("nice " + std::to_string(*placement.nice), errno));
+    }
+  }
+#else
+  if (!placement.empty()) refused.push_back("thread placement is not supported on this platform");
+#endif
+  ThreadPlacementReport report = currentThreadPlacement();
+  report.refused = std::move(refused);
+  return report;
+}
+
+ThreadPlacementReport currentThreadPlacement() {
+  ThreadPlacementReport report;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) report.cpus.push_back(cpu);
+    }
+  }
+  int policy = SCHED_OTHER;
+  sched_param param{};
+  if (pthread_getschedparam(pthread_self(), &policy, &param) == 0 &&
+      (policy == SCHED_FIFO || policy == SCHED_RR)) {
+    report.realtime = true;
+    report.priority = param.sched_priority;
+  } else {
+    errno = 0;
+    const int nice = getpriority(PRIO_PROCESS, currentTid());
+    if (errno == 0) report.priority = nice;
+  }
+#else
+  report.cpus = availableCpus();
+#endif
+  return report;
+}
+
+std::string describeThreadPlacement(const ThreadPlacementReport& report) {
+  std::string text = "cpus " + (report.cpus.empty() ? std::string("?") : formatCpuList(report.cpus));
+  text += report.realtime ? ", SCHED_FIFO " : ", nice ";
+  text += std::to_string(report.priority);
+  for (size_t i = 0; i < report.refused.size(); ++i) {
+    text += i == 0 ? "; refused " : ", ";
+    text += report.refused[i];
+  }
+  return text;
+}
+
+std::optional<std::vector<int>> parseCpuList(std::string_view text) {
+  std::vector<int> cpus;
+  while (!text.empty()) {
+    const size_t comma = text.find(',');
+    const std::string_view item = text.substr(0, comma);
+    text = comma == std::string_view::npos ? std::string_view() : text.substr(comma + 1);
+    if (comma != std::string_view::npos && text.empty()) return std::nullopt;
+
+    const size_t dash = item.find('-');
+    int first = 0;
+    int last = 0;
+    if (dash == std::string_view::npos) {
+      if (!parseInt(item, first)) return std::nullopt;
+      last = first;
+    } else if (!parseInt(item.substr(0, dash), first) || !parseInt(item.substr(dash + 1), last) ||
+               last < first) {
+      return std::nullopt;
+    }
+    for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+  }
+  if (cpus.empty()) return std::nullopt;
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+std::string formatCpuList(const std::vector<int>& cpus) {
+  std::string text;
+  for (size_t i = 0; i < cpus.size();) {
+    size_t run = i;
+    while (run + 1 < cpus.size() && cpus[run + 1] == cpus[run] + 1) ++run;
+    if (!text.empty()) text += ',';
+    text += std::to_string(cpus[i]);
+    if (run > i) text += '-' + std::to_string(cpus[run]);
+    i = run + 1;
+  }
+  return text;
+}
+
+std::vector<int> availableCpus() {
+  std::vector<int> cpus;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+    }
+  }
+#endif
+  if (cpus.empty()) {
+    const int count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int cpu = 0; cpu < count; ++cpu) cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+}  // namespace avs
@@ -159,6 +159,8 @@ class WineAPEEffect : public Effect {
 
   void init(int w, int h) override;
   void process(const Framebuffer& in, Framebuffer& out) override;
+  // The plugin may compile and run code through the EEL bridge.
+  bool runsEel() const override { return true; }
 
  private:
   std::unique_ptr<C_RBASE> apeInstance_;
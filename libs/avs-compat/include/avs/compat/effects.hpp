@@ -7,6 +7,8 @@
 #include <vector>
 
 #include <avs/audio.hpp>
+#include <avs/core/AlignedBuffer.hpp>
+#include <avs/core/Quality.hpp>
 #include <avs/eel.hpp>
 
 namespace avs {
@@ -14,10 +16,11 @@ namespace avs {
 static_assert(EelVm::kLegacyVisSamples == AudioState::kLegacyVisSamples,
               "Legacy vis sample count mismatch");
 
+// Packed RGBA rows; the storage itself starts on a cache line.
 struct Framebuffer {
   int w = 0;
   int h = 0;
-  std::vector<std::uint8_t> rgba;
+  core::AlignedBytes rgba;
 };
 
 class Effect {
@@ -28,6 +31,44 @@ class Effect {
     (void)h;
   }
   virtual void process(const Framebuffer& in, Framebuffer& out) = 0;
+  // Per-frame engine state, delivered before process(). Effects that do not
+  // script against time, audio or the mouse ignore it.
+  virtual void update(float time, int frame, const AudioState& audio, const MouseState& mouse) {
+    (void)time;
+    (void)frame;
+    (void)audio;
+    (void)mouse;
+  }
+  // True when process(fb, fb) is valid: the effect never reads a pixel after
+  // writing it. The engine then runs it without switching buffers.
+  virtual bool processesInPlace() const { return false; }
+  // True when process() writes only some pixels and expects `out` to hold
+  // `in` already. The engine then seeds `out` before the call; effects that
+  // write every output pixel leave this false and save that copy.
+  virtual bool drawsOverInput() const { return false; }
+  // Row bands for a threaded Engine. When bandSafe() is true the engine may
+  // replace process() by prepareBands() on the calling thread followed by
+  // processBand() calls for disjoint row ranges covering [0, in.h), which may
+  // run concurrently. A band writes only its rows of `out`, and reads only its
+  // rows of `in` if the effect also processes in place.
+  virtual bool bandSafe() const { return false; }
+  virtual void prepareBands(const Framebuffer& in, Framebuffer& out) {
+    out.w = in.w;
+    out.h = in.h;
+    out.rgba.resize(in.rgba.size());
+  }
+  virtual void processBand(const Framebuffer& in, Framebuffer& out, int rowBegin, int rowEnd) {
+    (void)in;
+    (void)out;
+    (void)rowBegin;
+    (void)rowEnd;
+  }
+  // Level in [core::kMinQualityLevel, core::kMaxQualityLevel]; the maximum is
+  // the reference output. Effects without a cheaper mode ignore it.
+  virtual void setQualityLevel(int level) { (void)level; }
+  // True when process() runs EEL code. EEL's reg00..reg99 and gmegabuf are
+  // process-wide, so the engine never runs two such chains concurrently.
+  virtual bool runsEel() const { return false; }
 };
 
 class CompositeEffect : public Effect {
@@ -35,6 +76,10 @@ class CompositeEffect : public Effect {
   void addEffect(std::unique_ptr<Effect> effect);
   void init(int w, int h) override;
   void process(const Framebuffer& in, Framebuffer& out) override;
+  void update(float time, int frame, const AudioState& audio, const MouseState& mouse) override;
+  bool processesInPlace() const override;
+  void setQualityLevel(int level) override;
+  bool runsEel() const override;
 
   size_t childCount() const { return children_.size(); }
   const std::vector<std::unique_ptr<Effect>>& children() const { return children_; }
@@ -51,8 +96,12 @@ class BlurEffect : public Effect {
   explicit BlurEffect(int radius = 5);
   void init(int w, int h) override;
   void process(const Framebuffer& in, Framebuffer& out) override;
+  void setQualityLevel(int level) override;
 
  private:
+  void buildKernel();
+
+  int requestedRadius_;
   int radius_;
   std::vector<float> kernel_;
   Framebuffer temp_;
@@ -62,6 +111,9 @@ class ColorMapEffect : public Effect {
  public:
   void init(int w, int h) override;
   void process(const Framebuffer& in, Framebuffer& out) override;
+  bool processesInPlace() const override { return true; }
+  bool bandSafe() const override { return true; }
+  void processBand(const Framebuffer& in, Framebuffer& out, int rowBegin, int rowEnd) override;
 
  private:
   std::array<std::uint8_t, 256 * 3> lut_;
@@ -71,6 +123,8 @@ class ConvolutionEffect : public Effect {
  public:
   void init(int w, int h) override;
   void process(const Framebuffer& in, Framebuffer& out) override;
+  bool bandSafe() const override { return true; }
+  void processBand(const Framebuffer& in, Framebuffer& out, int rowBegin, int rowEnd) override;
 
  private:
   std::array<int, 9> kernel_;
@@ -80,6 +134,7 @@ class MotionBlurEffect : public Effect {
  public:
   void init(int w, int h) override;
   void process(const Framebuffer& in, Framebuffer& out) override;
+  bool processesInPlace() const override { return true; }
 
  private:
   Framebuffer prev_;
@@ -89,29 +144,43 @@ class ColorTransformEffect : public Effect {
  public:
   void init(int w, int h) override;
   void process(const Framebuffer& in, Framebuffer& out) override;
+  bool processesInPlace() const override { return true; }
+  bool bandSafe() const override { return true; }
+  void processBand(const Framebuffer& in, Framebuffer& out, int rowBegin, int rowEnd) override;
 };
 
 class GlowEffect : public Effect {
  public:
   void process(const Framebuffer& in, Framebuffer& out) override;
+  bool processesInPlace() const override { return true; }
+  bool bandSafe() const override { return true; }
+  void processBand(const Framebuffer& in, Framebuffer& out, int rowBegin, int rowEnd) override;
 };
 
 class ZoomRotateEffect : public Effect {
  public:
   void init(int w, int h) override;
   void process(const Framebuffer& in, Framebuffer& out) override;
+  bool bandSafe() const override { return true; }
+  void processBand(const Framebuffer& in, Framebuffer& out, int rowBegin, int rowEnd) override;
 };
 
 class MirrorEffect : public Effect {
  public:
   void init(int w, int h) override;
   void process(const Framebuffer& in, Framebuffer& out) override;
+  bool bandSafe() const override { return true; }
+  void processBand(const Framebuffer& in, Framebuffer& out, int rowBegin, int rowEnd) override;
 };
 
 class TunnelEffect : public Effect {
  public:
   void init(int w, int h) override;
   void process(const Framebuffer& in, Framebuffer& out) override;
+  bool processesInPlace() const override { return true; }
+  bool bandSafe() const override { return true; }
+  void prepareBands(const Framebuffer& in, Framebuffer& out) override;
+  void processBand(const Framebuffer& in, Framebuffer& out, int rowBegin, int rowEnd) override;
 
  private:
   int cx_ = 0;
@@ -122,12 +191,18 @@ class RadialBlurEffect : public Effect {
  public:
   void init(int w, int h) override;
   void process(const Framebuffer& in, Framebuffer& out) override;
+  bool bandSafe() const override { return true; }
+  void processBand(const Framebuffer& in, Framebuffer& out, int rowBegin, int rowEnd) override;
 };
 
 class AdditiveBlendEffect : public Effect {
  public:
   void init(int w, int h) override;
   void process(const Framebuffer& in, Framebuffer& out) override;
+  bool processesInPlace() const override { return true; }
+  bool bandSafe() const override { return true; }
+  void prepareBands(const Framebuffer& in, Framebuffer& out) override;
+  void processBand(const Framebuffer& in, Framebuffer& out, int rowBegin, int rowEnd) override;
 
  private:
   Framebuffer blend_;
@@ -150,7 +225,15 @@ class ScriptedEffect : public Effect {
   ~ScriptedEffect() override;
   void init(int w, int h) override;
   void process(const Framebuffer& in, Framebuffer& out) override;
-  void update(float time, int frame, const AudioState& audio, const MouseState& mouse);
+  // Color modifiers map each pixel by itself; superscopes sample the input
+  // while drawing and need it intact.
+  bool processesInPlace() const override { return mode_ == Mode::kColorModifier; }
+  bool bandSafe() const override { return mode_ == Mode::kColorModifier; }
+  void prepareBands(const Framebuffer& in, Framebuffer& out) override;
+  void processBand(const Framebuffer& in, Framebuffer& out, int rowBegin, int rowEnd) override;
+  void setQualityLevel(int level) override;
+  bool runsEel() const override { return true; }
+  void update(float time, int frame, const AudioState& audio, const MouseState& mouse) override;
   void setScripts(std::string frameScript, std::string pixelScript);
   void setScripts(std::string initScript,
                   std::string frameScript,
@@ -167,6 +250,11 @@ class ScriptedEffect : public Effect {
                      std::string beatScript,
                      std::string pixelScript);
   void compile();
+  // Runs the init (first frame only), frame and pending beat scripts; true
+  // when the beat script ran.
+  bool runFrameScripts();
+  void updateColorLut(bool beatExecuted);
+  void applyColorLut(std::uint8_t* pixels, size_t bytes) const;
   EelVm vm_;
   NSEEL_CODEHANDLE initCode_ = nullptr;
   NSEEL_CODEHANDLE frameCode_ = nullptr;
@@ -182,6 +270,7 @@ class ScriptedEffect : public Effect {
   bool isBeatFrame_ = false;
   float lastRms_ = 0.0f;
   Mode mode_ = Mode::kSuperscope;
+  int qualityLevel_ = core::kMaxQualityLevel;
   bool colorModRecompute_ = false;
   bool colorLutDirty_ = true;
   std::array<std::uint8_t, 256 * 3> colorLut_{};
@@ -203,6 +292,7 @@ class UnknownRenderObjectEffect : public Effect {
   UnknownRenderObjectEffect(std::string token, std::vector<std::uint8_t> payload);
   void init(int w, int h) override;
   void process(const Framebuffer& in, Framebuffer& out) override;
+  bool processesInPlace() const override { return true; }
 
   const std::string& originalToken() const noexcept { return token_; }
   const std::vector<std::uint8_t>& rawPayload() const noexcept { return payload_; }
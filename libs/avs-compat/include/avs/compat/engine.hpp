@@ -1,11 +1,18 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
 #include <avs/audio.hpp>
+#include <avs/core/DeterministicRng.hpp>
+#include <avs/core/FrameGovernor.hpp>
+#include <avs/core/ThreadPool.hpp>
+#include <avs/core/Transition.hpp>
 #include <avs/effects.hpp>
+#include <avs/scale.hpp>
+#include <avs/thread_placement.hpp>
 
 namespace avs {
 
@@ -13,25 +20,119 @@ class Engine {
  public:
   Engine(int w, int h);
 
+  // Output size; the chain runs at this size times renderScale().
   void resize(int w, int h);
   void setAudio(const AudioState& a);
   void setMouseState(const MouseState& mouse);
   void step(float dt);
+  // Last frame at render resolution.
   const Framebuffer& frame() const;
+  // Last frame at output resolution, bilinearly upscaled when the render scale
+  // is below 1. Presenters that filter on their own (GL textures) should use
+  // frame() instead.
+  const Framebuffer& outputFrame();
   void setChain(std::vector<std::unique_ptr<Effect>> chain);
+  // Install a chain whose effects were already init()ed at w x h, typically on
+  // a PresetLoader thread; it is only reinitialized if the render size has
+  // changed since. Returns the previous chain so the caller can free it off
+  // the render thread.
+  std::vector<std::unique_ptr<Effect>> swapChain(std::vector<std::unique_ptr<Effect>> chain, int w,
+                                                 int h);
+  // Crossfade from the running chain to `chain` (init()ed at w x h, as for
+  // swapChain()) over `seconds`. Until then both chains render every step,
+  // each on half of the threads when there are at least two and neither runs
+  // EEL code (Effect::runsEel()), and frame()
+  // shows them composited with `mode` (kRandom falls back to the cross
+  // dissolve). The incoming chain starts from a black frame. A new transition
+  // or a resize mid-way cuts the older outgoing chain; `seconds` <= 0 cuts
+  // straight to `chain`.
+  void beginTransition(std::vector<std::unique_ptr<Effect>> chain, int w, int h,
+                       core::TransitionMode mode, float seconds);
+  bool inTransition() const { return transition_.active; }
+  // Chains that left the engine through a transition, for the caller to free
+  // off the render thread (e.g. PresetLoader::retire()).
+  std::vector<std::unique_ptr<Effect>> takeRetiredChain();
+
+  // Size the chain runs at: the output size times renderScale().
+  int renderWidth() const { return w_; }
+  int renderHeight() const { return h_; }
+
+  // Adapt effect quality so step() stays under targetMs; 0 or less turns
+  // adaptation off and, unless a level is locked, restores full quality.
+  void setFrameBudget(double targetMs);
+  // Render every frame at a fixed level regardless of the budget.
+  void lockQualityLevel(int level);
+  void unlockQualityLevel();
+  int qualityLevel() const { return governor_.level(); }
+
+  // Run the chain at a fraction of the output size, clamped to
+  // [kMinRenderScale, 1]. Changing it reinitializes the chain.
+  void setRenderScale(float scale);
+  float renderScale() const { return renderScale_; }
+  static constexpr float kMinRenderScale = 0.25f;
+
+  // Split band-safe effects (Effect::bandSafe()) into row bands run on this
+  // many threads, the caller included. 1 or less runs every effect serially.
+  void setThreadCount(int threads);
+  int threadCount() const;
+  // CPUs and priority for the band workers (not the calling thread). During a
+  // transition each chain's workers take their own half of the CPU list.
+  void setThreadPlacement(const ThreadPlacement& placement);
+  const ThreadPlacement& threadPlacement() const { return placement_; }
+  // Where the band workers actually run; empty without a placement.
+  std::vector<ThreadPlacementReport> workerPlacements() const;
 
  private:
   void alloc(int w, int h);
+  void createPools(int threads);
+  void applyQualityLevel();
+  void installChain(std::vector<std::unique_ptr<Effect>>& chain, int w, int h);
+  void runChain(std::vector<std::unique_ptr<Effect>>& chain, std::array<Framebuffer, 2>& fb,
+                int& cur, core::ThreadPool* pool);
+  void processBands(core::ThreadPool* pool, Effect& effect, const Framebuffer& in,
+                    Framebuffer& out);
+  void stepTransition(float dt);
+  void endTransition();
+
+  // The outgoing side of a preset crossfade.
+  struct Transition {
+    bool active = false;
+    core::TransitionMode mode = core::TransitionMode::kCrossDissolve;
+    float seconds = 0.0f;
+    float elapsed = 0.0f;
+    std::uint32_t blockMask = 0;
+    std::vector<std::unique_ptr<Effect>> chain;
+    std::array<Framebuffer, 2> fb{};
+    int cur = 0;
+    Framebuffer blended;
+    core::DeterministicRng rng;
+  };
 
   std::array<Framebuffer, 2> fb_{};
-  int w_ = 0;
+  int w_ = 0;  // render size
   int h_ = 0;
+  int outW_ = 0;
+  int outH_ = 0;
+  float renderScale_ = 1.0f;
+  Framebuffer output_;
+  BilinearScaler scaler_;
   int cur_ = 0;
   std::vector<std::unique_ptr<Effect>> chain_;
   AudioState audio_{};
   MouseState mouse_{};
   float time_ = 0.0f;
   int frame_ = 0;
+  core::FrameGovernor governor_{core::FrameGovernor::Config{0.0}};
+  int appliedQuality_ = core::kMaxQualityLevel;
+  std::unique_ptr<core::ThreadPool> pool_;
+  ThreadPlacement placement_;
+  // Transitions run the two chains as two tasks of sidePool_, and their
+  // effects' bands on separate groups so neither waits on the other's pool.
+  // Chains that run EEL code take turns on pool_ instead.
+  std::unique_ptr<core::ThreadPool> sidePool_;
+  std::array<std::unique_ptr<core::ThreadPool>, 2> groupPools_;
+  Transition transition_;
+  std::vector<std::unique_ptr<Effect>> retired_;
 };
 
 }  // namespace avs
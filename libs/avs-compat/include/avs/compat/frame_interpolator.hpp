@@ -0,0 +1,110 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <avs/compat/effects.hpp>
+
+namespace avs {
+
+// Block motion between two frames: for every blockSize x blockSize block of
+// the newer frame, the displacement (dx, dy) such that the block's content sat
+// at (x - dx, y - dy) in the older one. Blocks whose best match still differs
+// by more than Config::maxBlockError are flagged unreliable and cross-faded.
+struct MotionField {
+  struct Vector {
+    std::int16_t dx = 0;
+    std::int16_t dy = 0;
+    bool reliable = false;
+  };
+
+  int blockSize = 0;
+  int cols = 0;
+  int rows = 0;
+  std::vector<Vector> vectors;  // row-major, cols * rows
+
+  const Vector& at(int col, int row) const { return vectors[static_cast<size_t>(row * cols + col)]; }
+};
+
+// Synthesizes frames between the last two rendered frames, so the display can
+// run faster than the chain. submit() hands each rendered frame over without
+// blocking; a background thread matches it against the previous one. present()
+// then blends the pair along the motion vectors for any display time.
+//
+// Presented frames trail rendering by one render interval: a frame submitted
+// at time t1 after one at t0 is reached at t1 + (t1 - t0), and until then the
+// output moves from the older frame towards it.
+class FrameInterpolator {
+ public:
+  struct Config {
+    int blockSize = 16;      // multiple of 4
+    int searchRadius = 16;   // pixels, in each direction
+    int maxBlockError = 12;  // mean absolute luma difference of a trusted match
+  };
+
+  FrameInterpolator();
+  explicit FrameInterpolator(const Config& config);
+  ~FrameInterpolator();
+
+  FrameInterpolator(const FrameInterpolator&) = delete;
+  FrameInterpolator& operator=(const FrameInterpolator&) = delete;
+
+  // Queue a rendered frame taken at `seconds`. A frame that has not been
+  // matched yet is replaced; a frame of another size starts a new pair.
+  void submit(const Framebuffer& frame, double seconds);
+  // Write the frame for display time `seconds` to `out`. False until two
+  // frames of the same size have been matched.
+  bool present(double seconds, Framebuffer& out);
+  // Block until every submitted frame has been matched.
+  void flush();
+  // Forget both frames, e.g. after a cut that should not be blended.
+  void reset();
+
+  static MotionField estimateMotion(const Framebuffer& older, const Framebuffer& newer,
+                                    const Config& config);
+  // Blend at `position` in [0, 1] from `older` to `newer`; both frames and
+  // `field` must be of the same size.
+  static void synthesize(const Framebuffer& older, const Framebuffer& newer,
+                         const MotionField& field, float position, Framebuffer& out);
+
+ private:
+  // A matched pair, immutable once published so present() can read it
+  // without holding the lock.
+  struct Pair {
+    std::shared_ptr<const Framebuffer> older;
+    std::shared_ptr<const Framebuffer> newer;
+    double olderSeconds = 0.0;
+    double newerSeconds = 0.0;
+    MotionField field;
+  };
+
+  struct Luma;
+
+  void run();
+  // Block matching on precomputed luma; without `search` every vector is
+  // zero and unreliable.
+  static MotionField match(const Luma& older, const Luma& newer, const Config& config, bool search);
+
+  Config config_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable idle_;
+  std::optional<Framebuffer> pending_;
+  double pendingSeconds_ = 0.0;
+  bool matching_ = false;
+  bool resetPending_ = false;
+  bool stop_ = false;
+  std::shared_ptr<const Pair> pair_;
+  // Worker-only: the last matched frame, the older side of the next pair.
+  std::shared_ptr<const Framebuffer> last_;
+  std::unique_ptr<const Luma> lastLuma_;
+  double lastSeconds_ = 0.0;
+  std::thread thread_;
+};
+
+}  // namespace avs
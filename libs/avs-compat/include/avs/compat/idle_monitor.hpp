@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+#include <avs/compat/effects.hpp>
+
+namespace avs {
+
+// Decides when a live player can stop rendering at full rate. Once the audio
+// has stayed at or below rmsThreshold and the chain has produced the same
+// frame settleFrames times in a row, the monitor turns idle: the caller only
+// renders every idleIntervalSeconds and keeps the last frame on screen. Audio
+// above the threshold, a frame that differs from the previous one, or wake()
+// (preset switch, reload, resize) resumes full rate at once.
+class IdleMonitor {
+ public:
+  struct Config {
+    float rmsThreshold = 0.01f;          // about -40 dBFS
+    int settleFrames = 60;               // identical quiet frames before idling; <= 0 never idles
+    double idleIntervalSeconds = 0.25;  // time between renders while idle
+  };
+
+  IdleMonitor();
+  explicit IdleMonitor(const Config& config);
+
+  // Audio level of the current loop iteration.
+  void observeAudio(float rms);
+  // A frame the chain just rendered; compared by hash with the previous one.
+  void observeFrame(const Framebuffer& frame);
+  // Something other than audio changed what the chain will render.
+  void wake();
+
+  bool idle() const { return idle_; }
+  // Whether to render now, `secondsSinceRender` after the last rendered frame.
+  bool shouldRender(double secondsSinceRender) const {
+    return !idle_ || secondsSinceRender >= config_.idleIntervalSeconds;
+  }
+  const Config& config() const { return config_; }
+
+  // 64-bit hash of the frame size and pixels; cheap enough to run every frame.
+  static std::uint64_t hashFrame(const Framebuffer& frame);
+
+ private:
+  Config config_;
+  std::uint64_t lastHash_ = 0;
+  bool hasHash_ = false;
+  bool quiet_ = false;
+  int stableFrames_ = 0;
+  bool idle_ = false;
+};
+
+}  // namespace avs
@@ -23,6 +23,7 @@ struct ParsedPreset {
   std::vector<std::string> comments;
   std::vector<LegacyEffectEntry> effects;
   std::filesystem::path presetPath;  // Path to the preset file (for APE DLL discovery)
+  bool loaded = false;               // False when the file could not be read
 };
 
 ParsedPreset parsePreset(const std::filesystem::path& file);
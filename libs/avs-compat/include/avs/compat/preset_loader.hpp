@@ -0,0 +1,118 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <avs/compat/effects.hpp>
+
+namespace avs {
+
+// An effect chain parsed from a preset file and initialized at w x h, with its
+// scripts compiled. A preset that loads may still hold no effects; `loaded` is
+// false only when the file could not be read.
+struct LoadedChain {
+  std::filesystem::path path;
+  std::vector<std::unique_ptr<Effect>> effects;
+  std::vector<std::string> warnings;
+  int w = 0;
+  int h = 0;
+  bool loaded = false;
+
+  bool ok() const { return loaded; }
+};
+
+// Builds preset chains on a background thread so that switching presets never
+// parses, allocates or compiles on the render thread. The render thread
+// polls takeReady() once per frame, swaps the result in at the frame boundary
+// (Engine::swapChain) and hands the chain it replaced back through retire(),
+// so it is destroyed on the loader thread as well.
+//
+// Finished chains can also be kept warm: prefetch() builds a preset into an
+// LRU cache keyed by path, file content hash and size, and a later request()
+// that hits the cache only moves the chain over, with no parsing or
+// compiling. A hit hands out the cached chain and builds a fresh copy behind
+// it, so a preset revisited in a set list is warm each time.
+class PresetLoader {
+ public:
+  PresetLoader();
+  ~PresetLoader();
+
+  PresetLoader(const PresetLoader&) = delete;
+  PresetLoader& operator=(const PresetLoader&) = delete;
+
+  // Parse and initialize `path` synchronously on the calling thread.
+  static LoadedChain build(const std::filesystem::path& path, int w, int h);
+
+  // Queue `path` for loading at w x h. A request that has not started yet is
+  // replaced, so only the newest preset is built when keys repeat quickly.
+  void request(const std::filesystem::path& path, int w, int h);
+  // The newest finished chain, if one is waiting; never blocks.
+  std::optional<LoadedChain> takeReady();
+  // Destroy a chain on the loader thread.
+  void retire(std::vector<std::unique_ptr<Effect>> chain);
+  // Build `path` at w x h in the background and keep it in the warm cache.
+  // Requests take priority; prefetches run when the loader is otherwise idle.
+  void prefetch(const std::filesystem::path& path, int w, int h);
+  // Memory the warm cache may hold. Effects do not report their footprint, so
+  // each one is charged a full frame (w * h * 4 bytes), a conservative bound
+  // for the frame-sized history most stateful effects keep. Least recently
+  // used entries are evicted first; 0 disables the cache.
+  void setCacheBudget(size_t bytes);
+  size_t cacheBudget() const;
+  size_t cachedBytes() const;
+  size_t cachedCount() const;
+  // True while a request or prefetch is queued or being built.
+  bool busy() const;
+
+  static constexpr size_t kDefaultCacheBudget = size_t{256} << 20;
+
+ private:
+  struct Request {
+    std::filesystem::path path;
+    int w = 0;
+    int h = 0;
+  };
+
+  struct CacheEntry {
+    std::uint64_t contentHash = 0;
+    size_t bytes = 0;
+    LoadedChain chain;
+  };
+
+  void run();
+  // Loader-thread halves of request() and prefetch(). Entered with `lock`
+  // held, which is released while the file is read and the chain is built.
+  void load(const Request& request, std::unique_lock<std::mutex>& lock);
+  void warm(const Request& request, std::unique_lock<std::mutex>& lock);
+  // Move out a cached chain for `request` whose file still hashes to
+  // `contentHash`, dropping stale entries for the same path. The remaining
+  // helpers also expect mutex_ held; evicted chains go to retired_.
+  std::optional<LoadedChain> takeCached(const Request& request, std::uint64_t contentHash);
+  void insertCached(CacheEntry entry);
+  void evictOverBudget();
+
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;
+  std::optional<Request> pending_;
+  std::deque<Request> prefetches_;
+  std::list<CacheEntry> cache_;  // most recently used first
+  size_t cacheBudget_ = kDefaultCacheBudget;
+  size_t cachedBytes_ = 0;
+  std::optional<LoadedChain> ready_;
+  std::vector<std::vector<std::unique_ptr<Effect>>> retired_;
+  bool building_ = false;
+  bool stop_ = false;
+  std::thread thread_;
+};
+
+}  // namespace avs
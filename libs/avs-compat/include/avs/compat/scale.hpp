@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <avs/compat/effects.hpp>
+
+namespace avs {
+
+// Bilinear resampler used to present frames rendered below output resolution.
+// Pixel centers are aligned, so equal sizes copy the input unchanged. Uses SSE2
+// when available; the scalar path produces identical bytes. Keeps its tap
+// tables and row scratch between calls so steady-state scaling does not allocate.
+class BilinearScaler {
+ public:
+  void scale(const Framebuffer& in, Framebuffer& out, int width, int height);
+
+ private:
+  // Source indices bracketing one destination pixel and the weight of the
+  // second, in 1/256ths.
+  struct Tap {
+    int first = 0;
+    int second = 0;
+    int weight = 0;
+  };
+
+  static void buildTaps(int srcSize, int dstSize, std::vector<Tap>& taps);
+
+  std::vector<Tap> columns_;
+  std::vector<Tap> rows_;
+  std::vector<std::uint16_t> blendedRow_;
+  int srcW_ = 0, srcH_ = 0, dstW_ = 0, dstH_ = 0;
+};
+
+}  // namespace avs
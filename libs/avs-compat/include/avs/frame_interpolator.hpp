@@ -0,0 +1,3 @@
+#pragma once
+
+#include <avs/compat/frame_interpolator.hpp>
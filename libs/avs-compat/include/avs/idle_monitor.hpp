@@ -0,0 +1,3 @@
+#pragma once
+
+#include <avs/compat/idle_monitor.hpp>
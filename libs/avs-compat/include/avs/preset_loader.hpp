@@ -0,0 +1,3 @@
+#pragma once
+
+#include <avs/compat/preset_loader.hpp>
@@ -5,8 +5,11 @@
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <avs/core/StateStream.hpp>
+
 namespace avs::runtime {
 
 struct Heightmap {
@@ -43,6 +46,65 @@ struct GlobalState {
     heightmaps.clear();
     legacyRender.reset();
   }
+
+  // Checkpoint of everything above, heightmaps in name order so equal states
+  // give equal bytes.
+  void save(avs::core::StateWriter& writer) const {
+    for (double value : registers) {
+      writer.writeF64(value);
+    }
+    std::vector<const std::pair<const std::string, Heightmap>*> sorted;
+    sorted.reserve(heightmaps.size());
+    for (const auto& entry : heightmaps) {
+      sorted.push_back(&entry);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const auto* a, const auto* b) { return a->first < b->first; });
+    writer.writeVarUint(sorted.size());
+    for (const auto* entry : sorted) {
+      const Heightmap& map = entry->second;
+      writer.writeString(entry->first);
+      writer.writeVarInt(map.width);
+      writer.writeVarInt(map.height);
+      writer.writeVarUint(map.samples.size());
+      for (float sample : map.samples) {
+        writer.writeF32(sample);
+      }
+    }
+    writer.writeVarUint(legacyRender.lineBlendMode);
+    writer.writeBool(legacyRender.lineBlendModeActive);
+  }
+
+  // Replaces the whole state; false, leaving it unchanged, on malformed data.
+  bool restore(avs::core::StateReader& reader) {
+    GlobalState loaded;
+    for (double& value : loaded.registers) {
+      value = reader.readF64();
+    }
+    const std::size_t mapCount = reader.readSize(reader.remaining());
+    for (std::size_t i = 0; i < mapCount && reader.ok(); ++i) {
+      std::string name = reader.readString();
+      Heightmap map;
+      map.width = static_cast<int>(reader.readVarInt());
+      map.height = static_cast<int>(reader.readVarInt());
+      map.samples.resize(reader.readSize(reader.remaining() / 4u));
+      for (float& sample : map.samples) {
+        sample = reader.readF32();
+      }
+      loaded.heightmaps[std::move(name)] = std::move(map);
+    }
+    const std::uint64_t blendMode = reader.readVarUint();
+    if (blendMode > UINT32_MAX) {
+      reader.fail();
+    }
+    loaded.legacyRender.lineBlendMode = static_cast<std::uint32_t>(blendMode);
+    loaded.legacyRender.lineBlendModeActive = reader.readBool();
+    if (!reader.ok()) {
+      return false;
+    }
+    *this = std::move(loaded);
+    return true;
+  }
 };
 
 }  // namespace avs::runtime
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -21,6 +22,22 @@ struct FrameView {
     const std::size_t bytes = static_cast<std::size_t>(height) * static_cast<std::size_t>(stride);
     return {data, bytes};
   }
+
+  // The width x height rectangle at (x, y), clipped to this view and sharing
+  // its pixels. span() of a sub-view also covers the parent's pixels to the
+  // right of it, so walk it row by row.
+  [[nodiscard]] FrameView subView(int x, int y, int w, int h) const {
+    const int x0 = std::clamp(x, 0, width);
+    const int y0 = std::clamp(y, 0, height);
+    const int x1 = std::clamp(x + std::max(w, 0), x0, width);
+    const int y1 = std::clamp(y + std::max(h, 0), y0, height);
+    if (!data || x1 == x0 || y1 == y0) {
+      return {};
+    }
+    return FrameView{data + static_cast<std::size_t>(y0) * static_cast<std::size_t>(stride) +
+                         static_cast<std::size_t>(x0) * 4u,
+                     x1 - x0, y1 - y0, stride};
+  }
 };
 
 enum class ClearBlendMode { Replace, Additive, Average, DefaultBlend };
@@ -11,14 +11,23 @@ namespace {
 std::array<std::vector<double>, avs::EelVm::kMegaBufBlocks> gMegaBlocks;
 std::mutex gMegaMutex;
 EEL_F gMegaError = 0.0;
+
+// NS-EEL's shared function table and RAM allocator are guarded by the host
+// mutex. Presets are compiled on a loader thread while the render thread runs
+// other VMs, so it has to be real.
+std::recursive_mutex& eelHostMutex() {
+  static std::recursive_mutex mutex;
+  return mutex;
+}
 }  // namespace
 
 namespace avs {
 
-extern "C" void NSEEL_HOSTSTUB_EnterMutex() {}
-extern "C" void NSEEL_HOSTSTUB_LeaveMutex() {}
+extern "C" void NSEEL_HOSTSTUB_EnterMutex() { eelHostMutex().lock(); }
+extern "C" void NSEEL_HOSTSTUB_LeaveMutex() { eelHostMutex().unlock(); }
 
 EelVm::EelVm() {
+  std::lock_guard<std::recursive_mutex> guard(eelHostMutex());
   static bool init = false;
   if (!init) {
     NSEEL_init();
@@ -40,18 +49,27 @@ EelVm::EelVm() {
 }
 
 EelVm::~EelVm() {
+  std::lock_guard<std::recursive_mutex> guard(eelHostMutex());
   if (ctx_) NSEEL_VM_free(ctx_);
 }
 
-EEL_F* EelVm::regVar(const char* name) { return NSEEL_VM_regvar(ctx_, name); }
+EEL_F* EelVm::regVar(const char* name) {
+  std::lock_guard<std::recursive_mutex> guard(eelHostMutex());
+  return NSEEL_VM_regvar(ctx_, name);
+}
 
 NSEEL_CODEHANDLE EelVm::compile(const std::string& code) {
+  std::lock_guard<std::recursive_mutex> guard(eelHostMutex());
   return NSEEL_code_compile(ctx_, code.c_str(), 0);
 }
 
 void EelVm::execute(NSEEL_CODEHANDLE code) { NSEEL_code_execute(code); }
 
-void EelVm::freeCode(NSEEL_CODEHANDLE code) { NSEEL_code_free(code); }
+// Retired chains are freed on the loader thread while the render thread compiles.
+void EelVm::freeCode(NSEEL_CODEHANDLE code) {
+  std::lock_guard<std::recursive_mutex> guard(eelHostMutex());
+  NSEEL_code_free(code);
+}
 
 void EelVm::setLegacySources(const LegacySources& sources) {
   legacySources_ = sources;
@@ -7,23 +7,9 @@
 
 namespace avs {
 
-void AdditiveBlendEffect::init(int w, int h) {
-  blend_.w = w;
-  blend_.h = h;
-  blend_.rgba.assign(static_cast<size_t>(w) * h * 4, 10);
-}
+namespace {
 
-void AdditiveBlendEffect::process(const Framebuffer& in, Framebuffer& out) {
-  out.w = in.w;
-  out.h = in.h;
-  out.rgba.resize(in.rgba.size());
-  if (blend_.rgba.size() != in.rgba.size()) {
-    blend_.rgba.assign(in.rgba.size(), 10);
-  }
-  const std::uint8_t* src = in.rgba.data();
-  const std::uint8_t* b = blend_.rgba.data();
-  std::uint8_t* dst = out.rgba.data();
-  size_t n = in.rgba.size();
+void addBytes(const std::uint8_t* src, const std::uint8_t* b, std::uint8_t* dst, size_t n) {
   if (hasSse2()) {
     size_t i = 0;
     __m128i add;
@@ -45,4 +31,34 @@ void AdditiveBlendEffect::process(const Framebuffer& in, Framebuffer& out) {
   }
 }
 
+}  // namespace
+
+void AdditiveBlendEffect::init(int w, int h) {
+  blend_.w = w;
+  blend_.h = h;
+  blend_.rgba.assign(static_cast<size_t>(w) * h * 4, 10);
+}
+
+void AdditiveBlendEffect::process(const Framebuffer& in, Framebuffer& out) {
+  prepareBands(in, out);
+  addBytes(in.rgba.data(), blend_.rgba.data(), out.rgba.data(), in.rgba.size());
+}
+
+void AdditiveBlendEffect::prepareBands(const Framebuffer& in, Framebuffer& out) {
+  out.w = in.w;
+  out.h = in.h;
+  out.rgba.resize(in.rgba.size());
+  if (blend_.rgba.size() != in.rgba.size()) {
+    blend_.rgba.assign(in.rgba.size(), 10);
+  }
+}
+
+void AdditiveBlendEffect::processBand(const Framebuffer& in, Framebuffer& out, int rowBegin,
+                                      int rowEnd) {
+  const size_t rowBytes = static_cast<size_t>(in.w) * 4u;
+  const size_t offset = static_cast<size_t>(rowBegin) * rowBytes;
+  addBytes(in.rgba.data() + offset, blend_.rgba.data() + offset, out.rgba.data() + offset,
+           static_cast<size_t>(rowEnd - rowBegin) * rowBytes);
+}
+
 }  // namespace avs
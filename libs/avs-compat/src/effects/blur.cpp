@@ -8,12 +8,31 @@
 
 namespace avs {
 
-BlurEffect::BlurEffect(int radius) : radius_(radius) {}
+namespace {
+// Radius ceiling per reduced quality level; full quality is uncapped.
+constexpr int kRadiusCapByLevel[core::kMaxQualityLevel] = {2, 3, 4};
+}  // namespace
+
+BlurEffect::BlurEffect(int radius) : requestedRadius_(radius), radius_(radius) {}
 
 void BlurEffect::init(int w, int h) {
   temp_.w = w;
   temp_.h = h;
   temp_.rgba.resize(static_cast<size_t>(w) * h * 4);
+  buildKernel();
+}
+
+void BlurEffect::setQualityLevel(int level) {
+  level = core::clampQualityLevel(level);
+  const int radius =
+      level >= core::kMaxQualityLevel ? requestedRadius_ : std::min(requestedRadius_, kRadiusCapByLevel[level]);
+  if (radius != radius_ || kernel_.empty()) {
+    radius_ = radius;
+    buildKernel();
+  }
+}
+
+void BlurEffect::buildKernel() {
   int size = radius_ * 2 + 1;
   kernel_.resize(static_cast<size_t>(size));
   float sigma = radius_ / 2.0f;
@@ -7,18 +7,9 @@
 
 namespace avs {
 
-void ColorTransformEffect::init(int w, int h) {
-  (void)w;
-  (void)h;
-}
+namespace {
 
-void ColorTransformEffect::process(const Framebuffer& in, Framebuffer& out) {
-  out.w = in.w;
-  out.h = in.h;
-  out.rgba.resize(in.rgba.size());
-  const std::uint8_t* src = in.rgba.data();
-  std::uint8_t* dst = out.rgba.data();
-  size_t n = in.rgba.size();
+void invertBytes(const std::uint8_t* src, std::uint8_t* dst, size_t n) {
   if (hasSse2()) {
     __m128i mask = _mm_set1_epi8(static_cast<char>(0xFF));
     size_t i = 0;
@@ -37,4 +28,26 @@ void ColorTransformEffect::process(const Framebuffer& in, Framebuffer& out) {
   }
 }
 
+}  // namespace
+
+void ColorTransformEffect::init(int w, int h) {
+  (void)w;
+  (void)h;
+}
+
+void ColorTransformEffect::process(const Framebuffer& in, Framebuffer& out) {
+  out.w = in.w;
+  out.h = in.h;
+  out.rgba.resize(in.rgba.size());
+  invertBytes(in.rgba.data(), out.rgba.data(), in.rgba.size());
+}
+
+void ColorTransformEffect::processBand(const Framebuffer& in, Framebuffer& out, int rowBegin,
+                                       int rowEnd) {
+  const size_t rowBytes = static_cast<size_t>(in.w) * 4u;
+  const size_t offset = static_cast<size_t>(rowBegin) * rowBytes;
+  invertBytes(in.rgba.data() + offset, out.rgba.data() + offset,
+              static_cast<size_t>(rowEnd - rowBegin) * rowBytes);
+}
+
 }  // namespace avs
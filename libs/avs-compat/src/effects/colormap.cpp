@@ -49,9 +49,13 @@ void ColorMapEffect::process(const Framebuffer& in, Framebuffer& out) {
   out.w = in.w;
   out.h = in.h;
   out.rgba.resize(in.rgba.size());
+  processBand(in, out, 0, in.h);
+}
+
+void ColorMapEffect::processBand(const Framebuffer& in, Framebuffer& out, int rowBegin,
+                                 int rowEnd) {
   int w = in.w;
-  int h = in.h;
-  for (int y = 0; y < h; ++y) {
+  for (int y = rowBegin; y < rowEnd; ++y) {
     for (int x = 0; x < w; ++x) {
       size_t idx = (static_cast<size_t>(y) * w + x) * 4;
       std::uint8_t g = in.rgba[idx];
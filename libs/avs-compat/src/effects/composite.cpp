@@ -1,5 +1,7 @@
 #include <avs/effects.hpp>
 
+#include <algorithm>
+
 namespace avs {
 
 void CompositeEffect::addEffect(std::unique_ptr<Effect> effect) {
@@ -21,9 +23,34 @@ void CompositeEffect::init(int w, int h) {
   }
 }
 
+void CompositeEffect::setQualityLevel(int level) {
+  for (auto& child : children_) {
+    child->setQualityLevel(level);
+  }
+}
+
+void CompositeEffect::update(float time, int frame, const AudioState& audio, const MouseState& mouse) {
+  for (auto& child : children_) {
+    child->update(time, frame, audio, mouse);
+  }
+}
+
+bool CompositeEffect::processesInPlace() const {
+  // With two or more children the output is only written by the last one,
+  // after the input has been read for the last time.
+  return children_.size() != 1 || children_.front()->processesInPlace();
+}
+
+bool CompositeEffect::runsEel() const {
+  return std::any_of(children_.begin(), children_.end(),
+                     [](const auto& child) { return child->runsEel(); });
+}
+
 void CompositeEffect::process(const Framebuffer& in, Framebuffer& out) {
   if (children_.empty()) {
-    out = in;
+    if (&in != &out) {
+      out = in;
+    }
     return;
   }
 
@@ -52,6 +79,9 @@ void CompositeEffect::process(const Framebuffer& in, Framebuffer& out) {
       buffer.rgba.resize(static_cast<size_t>(width_) * static_cast<size_t>(height_) * 4u);
       target = &buffer;
     }
+    if (children_[i]->drawsOverInput() && target != currentIn) {
+      target->rgba = currentIn->rgba;
+    }
     children_[i]->process(*currentIn, *target);
     currentIn = target;
     if (!last) {
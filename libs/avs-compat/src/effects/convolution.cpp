@@ -10,10 +10,11 @@ namespace avs {
 void ConvolutionEffect::init(int /*w*/, int /*h*/) { kernel_ = {0, -1, 0, -1, 5, -1, 0, -1, 0}; }
 
 namespace {
-void convScalar(const Framebuffer& in, Framebuffer& out, const std::array<int, 9>& kernel) {
+void convScalar(const Framebuffer& in, Framebuffer& out, const std::array<int, 9>& kernel,
+                int rowBegin, int rowEnd) {
   int w = in.w;
   int h = in.h;
-  for (int y = 0; y < h; ++y) {
+  for (int y = rowBegin; y < rowEnd; ++y) {
     for (int x = 0; x < w; ++x) {
       float r = 0, g = 0, b = 0;
       for (int ky = -1; ky <= 1; ++ky) {
@@ -37,10 +38,11 @@ void convScalar(const Framebuffer& in, Framebuffer& out, const std::array<int, 9
   }
 }
 
-void convSse2(const Framebuffer& in, Framebuffer& out, const std::array<int, 9>& kernel) {
+void convSse2(const Framebuffer& in, Framebuffer& out, const std::array<int, 9>& kernel,
+              int rowBegin, int rowEnd) {
   int w = in.w;
   int h = in.h;
-  for (int y = 0; y < h; ++y) {
+  for (int y = rowBegin; y < rowEnd; ++y) {
     for (int x = 0; x < w; ++x) {
       __m128 accum = _mm_setzero_ps();
       for (int ky = -1; ky <= 1; ++ky) {
@@ -71,10 +73,16 @@ void ConvolutionEffect::process(const Framebuffer& in, Framebuffer& out) {
   out.w = in.w;
   out.h = in.h;
   out.rgba.resize(in.rgba.size());
+  processBand(in, out, 0, in.h);
+}
+
+void ConvolutionEffect::processBand(const Framebuffer& in, Framebuffer& out, int rowBegin,
+                                    int rowEnd) {
+  // Out of place: rows next to the band are only read, through the clamped taps.
   if (hasSse2()) {
-    convSse2(in, out, kernel_);
+    convSse2(in, out, kernel_, rowBegin, rowEnd);
   } else {
-    convScalar(in, out, kernel_);
+    convScalar(in, out, kernel_, rowBegin, rowEnd);
   }
 }
 
@@ -7,13 +7,9 @@
 
 namespace avs {
 
-void GlowEffect::process(const Framebuffer& in, Framebuffer& out) {
-  out.w = in.w;
-  out.h = in.h;
-  out.rgba.resize(in.rgba.size());
-  const std::uint8_t* src = in.rgba.data();
-  std::uint8_t* dst = out.rgba.data();
-  size_t n = in.rgba.size();
+namespace {
+
+void brightenBytes(const std::uint8_t* src, std::uint8_t* dst, size_t n) {
   if (hasSse2()) {
     __m128i add = _mm_set1_epi8(50);
     size_t i = 0;
@@ -34,4 +30,20 @@ void GlowEffect::process(const Framebuffer& in, Framebuffer& out) {
   }
 }
 
+}  // namespace
+
+void GlowEffect::process(const Framebuffer& in, Framebuffer& out) {
+  out.w = in.w;
+  out.h = in.h;
+  out.rgba.resize(in.rgba.size());
+  brightenBytes(in.rgba.data(), out.rgba.data(), in.rgba.size());
+}
+
+void GlowEffect::processBand(const Framebuffer& in, Framebuffer& out, int rowBegin, int rowEnd) {
+  const size_t rowBytes = static_cast<size_t>(in.w) * 4u;
+  const size_t offset = static_cast<size_t>(rowBegin) * rowBytes;
+  brightenBytes(in.rgba.data() + offset, out.rgba.data() + offset,
+                static_cast<size_t>(rowEnd - rowBegin) * rowBytes);
+}
+
 }  // namespace avs
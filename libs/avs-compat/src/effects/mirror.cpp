@@ -16,13 +16,16 @@ void MirrorEffect::process(const Framebuffer& in, Framebuffer& out) {
   out.w = in.w;
   out.h = in.h;
   out.rgba.resize(in.rgba.size());
+  processBand(in, out, 0, in.h);
+}
+
+void MirrorEffect::processBand(const Framebuffer& in, Framebuffer& out, int rowBegin, int rowEnd) {
   int w = in.w;
-  int h = in.h;
   const std::uint8_t* src = in.rgba.data();
   std::uint8_t* dst = out.rgba.data();
   size_t rowPixels = static_cast<size_t>(w);
   if (hasSse2()) {
-    for (int y = 0; y < h; ++y) {
+    for (int y = rowBegin; y < rowEnd; ++y) {
       const std::uint8_t* s = src + static_cast<size_t>(y) * rowPixels * 4;
       std::uint8_t* d = dst + static_cast<size_t>(y) * rowPixels * 4;
       size_t i = 0;
@@ -42,7 +45,7 @@ void MirrorEffect::process(const Framebuffer& in, Framebuffer& out) {
       }
     }
   } else {
-    for (int y = 0; y < h; ++y) {
+    for (int y = rowBegin; y < rowEnd; ++y) {
       const std::uint8_t* s = src + static_cast<size_t>(y) * rowPixels * 4;
       std::uint8_t* d = dst + static_cast<size_t>(y) * rowPixels * 4;
       for (size_t x = 0; x < rowPixels; ++x) {
@@ -17,6 +17,11 @@ void RadialBlurEffect::process(const Framebuffer& in, Framebuffer& out) {
   out.w = in.w;
   out.h = in.h;
   out.rgba.resize(in.rgba.size());
+  processBand(in, out, 0, in.h);
+}
+
+void RadialBlurEffect::processBand(const Framebuffer& in, Framebuffer& out, int rowBegin,
+                                   int rowEnd) {
   int w = in.w;
   int h = in.h;
   size_t centerIdx = (static_cast<size_t>(h / 2) * w + (w / 2)) * 4;
@@ -24,23 +29,29 @@ void RadialBlurEffect::process(const Framebuffer& in, Framebuffer& out) {
   const std::uint8_t* src = in.rgba.data();
   std::uint8_t* dst = out.rgba.data();
   size_t n = in.rgba.size();
-  if (hasSse2()) {
+  size_t i = static_cast<size_t>(rowBegin) * static_cast<size_t>(w) * 4;
+  const size_t end = std::min(n, static_cast<size_t>(rowEnd) * static_cast<size_t>(w) * 4);
+  // _mm_avg_epu8 rounds up and the scalar tail rounds down. Bytes keep the
+  // rounding of the 16-byte block they fall in for the whole frame, so a band
+  // matches the unbanded result wherever its edges land.
+  const size_t vectorEnd = std::min(end, hasSse2() ? n & ~size_t{15} : size_t{0});
+  auto roundedUp = [&](size_t at) {
+    dst[at] = static_cast<std::uint8_t>((static_cast<int>(src[at]) + center[at % 4] + 1) / 2);
+  };
+  for (; i < vectorEnd && i % 16 != 0; ++i) roundedUp(i);
+  if (i < vectorEnd) {
     std::uint32_t centerValue = 0;
     std::memcpy(&centerValue, center, sizeof(centerValue));
     __m128i c = _mm_set1_epi32(static_cast<int>(centerValue));
-    size_t i = 0;
-    for (; i + 16 <= n; i += 16) {
+    for (; i + 16 <= vectorEnd; i += 16) {
       __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i_u*>(src + i));
       __m128i r = _mm_avg_epu8(v, c);
       _mm_storeu_si128(reinterpret_cast<__m128i_u*>(dst + i), r);
     }
-    for (; i < n; ++i) {
-      dst[i] = static_cast<std::uint8_t>((static_cast<int>(src[i]) + center[i % 4]) / 2);
-    }
-  } else {
-    for (size_t i = 0; i < n; ++i) {
-      dst[i] = static_cast<std::uint8_t>((static_cast<int>(src[i]) + center[i % 4]) / 2);
-    }
+  }
+  for (; i < vectorEnd; ++i) roundedUp(i);
+  for (; i < end; ++i) {
+    dst[i] = static_cast<std::uint8_t>((static_cast<int>(src[i]) + center[i % 4]) / 2);
   }
 }
 
@@ -7,6 +7,8 @@
 namespace {
 
 constexpr int kMaxSuperscopePoints = 128 * 1024;
+// Point ceiling per reduced quality level; full quality keeps the script's n.
+constexpr int kSuperscopePointCapByLevel[avs::core::kMaxQualityLevel] = {512, 2048, 8192};
 
 struct SampledColor {
   double r = 0.0;
@@ -41,7 +43,7 @@ static SampledColor sampleColor(const avs::Framebuffer& fb, double x, double y)
   return c;
 }
 
-static void drawPoint(std::vector<std::uint8_t>& rgba,
+static void drawPoint(avs::core::AlignedBytes& rgba,
                       int w,
                       int h,
                       int px,
@@ -64,7 +66,7 @@ static void drawPoint(std::vector<std::uint8_t>& rgba,
   }
 }
 
-static void drawLine(std::vector<std::uint8_t>& rgba,
+static void drawLine(avs::core::AlignedBytes& rgba,
                      int w,
                      int h,
                      int x0,
@@ -163,6 +165,8 @@ void ScriptedEffect::setAllScripts(std::string initScript,
   colorLutDirty_ = true;
 }
 
+void ScriptedEffect::setQualityLevel(int level) { qualityLevel_ = core::clampQualityLevel(level); }
+
 void ScriptedEffect::init(int w, int h) {
   w_ = w;
   h_ = h;
@@ -209,11 +213,75 @@ void ScriptedEffect::init(int w, int h) {
   sources.sampleCount = AudioState::kLegacyVisSamples;
   sources.channels = legacyChannels_;
   vm_.setLegacySources(sources);
+  // Compile now rather than on the first frame, so a chain initialized on a
+  // loader thread reaches the render thread ready to run.
+  compile();
   colorLutDirty_ = true;
   waveform_.fill(0.0f);
 
 }
 
+bool ScriptedEffect::runFrameScripts() {
+  if (!initRan_) {
+    if (initCode_) vm_.execute(initCode_);
+    initRan_ = true;
+    colorLutDirty_ = true;
+  }
+  if (frameCode_) vm_.execute(frameCode_);
+  if (!pendingBeat_) return false;
+  if (beatCode_) vm_.execute(beatCode_);
+  pendingBeat_ = false;
+  return true;
+}
+
+void ScriptedEffect::updateColorLut(bool beatExecuted) {
+  if (beatExecuted) colorLutDirty_ = true;
+  if (!colorModRecompute_ && !colorLutDirty_) return;
+  for (size_t i = 0; i < 256; ++i) {
+    double value = static_cast<double>(i) / 255.0;
+    if (r_) *r_ = static_cast<EEL_F>(value);
+    if (g_) *g_ = static_cast<EEL_F>(value);
+    if (b_) *b_ = static_cast<EEL_F>(value);
+    if (pixelCode_) vm_.execute(pixelCode_);
+    colorLut_[0 * 256 + i] = toByte(r_ ? *r_ : value);
+    colorLut_[1 * 256 + i] = toByte(g_ ? *g_ : value);
+    colorLut_[2 * 256 + i] = toByte(b_ ? *b_ : value);
+  }
+  colorLutDirty_ = false;
+}
+
+void ScriptedEffect::applyColorLut(std::uint8_t* pixels, size_t bytes) const {
+  for (size_t i = 0; i + 3 < bytes; i += 4) {
+    std::uint8_t r = pixels[i + 0];
+    std::uint8_t g = pixels[i + 1];
+    std::uint8_t b = pixels[i + 2];
+    pixels[i + 0] = colorLut_[0 * 256 + r];
+    pixels[i + 1] = colorLut_[1 * 256 + g];
+    pixels[i + 2] = colorLut_[2 * 256 + b];
+    pixels[i + 3] = 255u;
+  }
+}
+
+void ScriptedEffect::prepareBands(const Framebuffer& in, Framebuffer& out) {
+  (void)in;
+  compile();
+  out.w = w_;
+  out.h = h_;
+  out.rgba.resize(static_cast<size_t>(w_) * static_cast<size_t>(h_) * 4u);
+  updateColorLut(runFrameScripts());
+}
+
+void ScriptedEffect::processBand(const Framebuffer& in, Framebuffer& out, int rowBegin, int rowEnd) {
+  const size_t rowBytes = static_cast<size_t>(w_) * 4u;
+  const size_t offset = static_cast<size_t>(rowBegin) * rowBytes;
+  const size_t bytes = static_cast<size_t>(rowEnd - rowBegin) * rowBytes;
+  if (&in != &out) {
+    std::copy_n(in.rgba.begin() + static_cast<std::ptrdiff_t>(offset), bytes,
+                out.rgba.begin() + static_cast<std::ptrdiff_t>(offset));
+  }
+  applyColorLut(out.rgba.data() + offset, bytes);
+}
+
 void ScriptedEffect::update(float time,
                             int frame,
                             const AudioState& audio,
@@ -325,7 +393,9 @@ void ScriptedEffect::process(const Framebuffer& in, Framebuffer& out) {
   out.w = w_;
   out.h = h_;
   out.rgba.resize(expectedSize);
-  if (in.rgba.size() == expectedSize) {
+  if (&in == &out) {
+    // In place; resize() above already zero-filled any missing tail.
+  } else if (in.rgba.size() == expectedSize) {
     out.rgba = in.rgba;
   } else {
     std::fill(out.rgba.begin(), out.rgba.end(), 0);
@@ -334,43 +404,11 @@ void ScriptedEffect::process(const Framebuffer& in, Framebuffer& out) {
     }
   }
 
-  if (!initRan_) {
-    if (initCode_) vm_.execute(initCode_);
-    initRan_ = true;
-    colorLutDirty_ = true;
-  }
-  if (frameCode_) vm_.execute(frameCode_);
-  bool beatExecuted = false;
-  if (pendingBeat_) {
-    if (beatCode_) vm_.execute(beatCode_);
-    pendingBeat_ = false;
-    beatExecuted = true;
-  }
+  const bool beatExecuted = runFrameScripts();
 
   if (mode_ == Mode::kColorModifier) {
-    if (beatExecuted) colorLutDirty_ = true;
-    if (colorModRecompute_ || colorLutDirty_) {
-      for (size_t i = 0; i < 256; ++i) {
-        double value = static_cast<double>(i) / 255.0;
-        if (r_) *r_ = static_cast<EEL_F>(value);
-        if (g_) *g_ = static_cast<EEL_F>(value);
-        if (b_) *b_ = static_cast<EEL_F>(value);
-        if (pixelCode_) vm_.execute(pixelCode_);
-        colorLut_[0 * 256 + i] = toByte(r_ ? *r_ : value);
-        colorLut_[1 * 256 + i] = toByte(g_ ? *g_ : value);
-        colorLut_[2 * 256 + i] = toByte(b_ ? *b_ : value);
-      }
-      colorLutDirty_ = false;
-    }
-    for (size_t i = 0; i + 3 < out.rgba.size(); i += 4) {
-      std::uint8_t r = out.rgba[i + 0];
-      std::uint8_t g = out.rgba[i + 1];
-      std::uint8_t b = out.rgba[i + 2];
-      out.rgba[i + 0] = colorLut_[0 * 256 + r];
-      out.rgba[i + 1] = colorLut_[1 * 256 + g];
-      out.rgba[i + 2] = colorLut_[2 * 256 + b];
-      out.rgba[i + 3] = 255u;
-    }
+    updateColorLut(beatExecuted);
+    applyColorLut(out.rgba.data(), out.rgba.size());
     return;
   }
 
@@ -380,6 +418,9 @@ void ScriptedEffect::process(const Framebuffer& in, Framebuffer& out) {
   int total = n_ ? static_cast<int>(*n_) : 0;
   if (total <= 0) return;
   if (total > kMaxSuperscopePoints) total = kMaxSuperscopePoints;
+  if (qualityLevel_ < core::kMaxQualityLevel) {
+    total = std::min(total, kSuperscopePointCapByLevel[qualityLevel_]);
+  }
   if (n_) *n_ = static_cast<EEL_F>(total);
 
   bool haveLast = false;
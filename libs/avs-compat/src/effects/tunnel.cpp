@@ -14,14 +14,21 @@ void TunnelEffect::init(int w, int h) {
 }
 
 void TunnelEffect::process(const Framebuffer& in, Framebuffer& out) {
-  (void)in;
+  prepareBands(in, out);
+  processBand(in, out, 0, out.h);
+}
+
+void TunnelEffect::prepareBands(const Framebuffer& in, Framebuffer& out) {
   out.w = in.w;
   out.h = in.h;
   out.rgba.resize(static_cast<size_t>(out.w) * out.h * 4);
+}
+
+void TunnelEffect::processBand(const Framebuffer& in, Framebuffer& out, int rowBegin, int rowEnd) {
+  (void)in;
   int w = out.w;
-  int h = out.h;
   if (hasSse2()) {
-    for (int y = 0; y < h; ++y) {
+    for (int y = rowBegin; y < rowEnd; ++y) {
       __m128 dy = _mm_set1_ps(static_cast<float>(y - cy_));
       for (int x = 0; x < w; x += 4) {
         __m128 dx = _mm_set_ps(static_cast<float>(x + 3 - cx_), static_cast<float>(x + 2 - cx_),
@@ -41,7 +48,7 @@ void TunnelEffect::process(const Framebuffer& in, Framebuffer& out) {
       }
     }
   } else {
-    for (int y = 0; y < h; ++y) {
+    for (int y = rowBegin; y < rowEnd; ++y) {
       for (int x = 0; x < w; ++x) {
         int dx = x - cx_;
         int dy = y - cy_;
@@ -16,35 +16,33 @@ void ZoomRotateEffect::process(const Framebuffer& in, Framebuffer& out) {
   out.w = in.w;
   out.h = in.h;
   out.rgba.resize(in.rgba.size());
+  processBand(in, out, 0, in.h);
+}
+
+void ZoomRotateEffect::processBand(const Framebuffer& in, Framebuffer& out, int rowBegin,
+                                   int rowEnd) {
+  // Output pixel i is input pixel pixels - 1 - i, so a band of output rows
+  // gathers from the mirrored band of input rows.
   const std::uint8_t* src = in.rgba.data();
   std::uint8_t* dst = out.rgba.data();
-  size_t n = in.rgba.size();
-  size_t pixels = n / 4;
+  size_t pixels = in.rgba.size() / 4;
+  size_t i = static_cast<size_t>(rowBegin) * static_cast<size_t>(in.w);
+  const size_t end = std::min(pixels, static_cast<size_t>(rowEnd) * static_cast<size_t>(in.w));
   if (hasSse2()) {
-    size_t i = 0;
-    while (i + 4 <= pixels) {
+    while (i + 4 <= end) {
       __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i_u*>(src + (pixels - i - 4) * 4));
       v = _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
       _mm_storeu_si128(reinterpret_cast<__m128i_u*>(dst + i * 4), v);
       i += 4;
     }
-    for (; i < pixels; ++i) {
-      const std::uint8_t* s = src + (pixels - i - 1) * 4;
-      std::uint8_t* d = dst + i * 4;
-      d[0] = s[0];
-      d[1] = s[1];
-      d[2] = s[2];
-      d[3] = s[3];
-    }
-  } else {
-    for (size_t i = 0; i < pixels; ++i) {
-      const std::uint8_t* s = src + (pixels - i - 1) * 4;
-      std::uint8_t* d = dst + i * 4;
-      d[0] = s[0];
-      d[1] = s[1];
-      d[2] = s[2];
-      d[3] = s[3];
-    }
+  }
+  for (; i < end; ++i) {
+    const std::uint8_t* s = src + (pixels - i - 1) * 4;
+    std::uint8_t* d = dst + i * 4;
+    d[0] = s[0];
+    d[1] = s[1];
+    d[2] = s[2];
+    d[3] = s[3];
   }
 }
 
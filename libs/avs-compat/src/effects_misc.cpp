@@ -378,7 +378,9 @@ UnknownRenderObjectEffect::UnknownRenderObjectEffect(std::string token,
 void UnknownRenderObjectEffect::init(int, int) {}
 
 void UnknownRenderObjectEffect::process(const Framebuffer& in, Framebuffer& out) {
-  out = in;
+  if (&in != &out) {
+    out = in;
+  }
 }
 
 }  // namespace avs
@@ -1,14 +1,31 @@
 #include <avs/engine.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 
 #include <avs/audio.hpp>
+#include <avs/core/RowBand.hpp>
+#include <avs/core/Transition.hpp>
 #include <avs/effects.hpp>
 
 namespace avs {
 
-Engine::Engine(int w, int h) { alloc(w, h); }
+namespace {
+int scaledExtent(int extent, float scale) {
+  if (extent <= 0) return extent;
+  return std::max(1, static_cast<int>(std::lround(static_cast<float>(extent) * scale)));
+}
+
+// Bands handed out per pool thread, so idle workers can steal uneven rows.
+constexpr int kBandsPerThread = 4;
+
+bool chainRunsEel(const std::vector<std::unique_ptr<Effect>>& chain) {
+  return std::any_of(chain.begin(), chain.end(), [](const auto& e) { return e->runsEel(); });
+}
+}  // namespace
+
+Engine::Engine(int w, int h) : outW_(w), outH_(h) { alloc(w, h); }
 
 void Engine::alloc(int w, int h) {
   w_ = w;
@@ -21,13 +38,48 @@ void Engine::alloc(int w, int h) {
 }
 
 void Engine::resize(int w, int h) {
-  if (w == w_ && h == h_) return;
-  alloc(w, h);
+  outW_ = w;
+  outH_ = h;
+  const int renderW = scaledExtent(w, renderScale_);
+  const int renderH = scaledExtent(h, renderScale_);
+  if (renderW == w_ && renderH == h_) return;
+  if (transition_.active) endTransition();
+  alloc(renderW, renderH);
   for (auto& e : chain_) {
     e->init(w_, h_);
   }
 }
 
+void Engine::setRenderScale(float scale) {
+  scale = std::clamp(scale, kMinRenderScale, 1.0f);
+  if (scale == renderScale_) return;
+  renderScale_ = scale;
+  resize(outW_, outH_);
+}
+
+void Engine::setThreadCount(int threads) {
+  if (threads == threadCount()) return;
+  createPools(threads);
+}
+
+void Engine::setThreadPlacement(const ThreadPlacement& placement) {
+  placement_ = placement;
+  createPools(threadCount());
+}
+
+std::vector<ThreadPlacementReport> Engine::workerPlacements() const {
+  if (!pool_) return {};
+  return pool_->workerPlacements();
+}
+
+void Engine::createPools(int threads) {
+  pool_ = threads > 1 ? std::make_unique<core::ThreadPool>(threads, placement_) : nullptr;
+  sidePool_.reset();
+  for (auto& group : groupPools_) group.reset();
+}
+
+int Engine::threadCount() const { return pool_ ? pool_->getThreadCount() : 1; }
+
 void Engine::setAudio(const AudioState& a) { audio_ = a; }
 
 void Engine::setMouseState(const MouseState& mouse) { mouse_ = mouse; }
@@ -36,42 +88,218 @@ void Engine::setChain(std::vector<std::unique_ptr<Effect>> chain) {
   chain_ = std::move(chain);
   for (auto& e : chain_) {
     e->init(w_, h_);
+    if (appliedQuality_ != core::kMaxQualityLevel) {
+      e->setQualityLevel(appliedQuality_);
+    }
+  }
+}
+
+std::vector<std::unique_ptr<Effect>> Engine::swapChain(std::vector<std::unique_ptr<Effect>> chain,
+                                                       int w, int h) {
+  installChain(chain, w, h);
+  return chain;
+}
+
+void Engine::installChain(std::vector<std::unique_ptr<Effect>>& chain, int w, int h) {
+  std::swap(chain_, chain);
+  for (auto& e : chain_) {
+    if (w != w_ || h != h_) e->init(w_, h_);
+    if (appliedQuality_ != core::kMaxQualityLevel) {
+      e->setQualityLevel(appliedQuality_);
+    }
+  }
+}
+
+void Engine::beginTransition(std::vector<std::unique_ptr<Effect>> chain, int w, int h,
+                             core::TransitionMode mode, float seconds) {
+  if (transition_.active) endTransition();
+  if (seconds <= 0.0f) {
+    installChain(chain, w, h);
+    for (auto& e : chain) retired_.push_back(std::move(e));
+    return;
+  }
+
+  // The outgoing chain keeps its frames; the incoming one starts from black.
+  installChain(chain, w, h);
+  transition_.chain = std::move(chain);
+  std::swap(transition_.fb, fb_);
+  transition_.cur = cur_;
+  cur_ = 0;
+  for (auto& fb : fb_) {
+    fb.w = w_;
+    fb.h = h_;
+    fb.rgba.assign(static_cast<size_t>(w_) * h_ * 4, 0);
+  }
+  transition_.active = true;
+  transition_.mode = mode;
+  transition_.seconds = seconds;
+  transition_.elapsed = 0.0f;
+  transition_.blockMask = 0;
+  transition_.rng.reseed(static_cast<std::uint64_t>(frame_));
+
+  const int threads = threadCount();
+  if (threads > 1 && !sidePool_) {
+    sidePool_ = std::make_unique<core::ThreadPool>(2, placement_);
+    const std::array<int, 2> groupThreads{threads - threads / 2, threads / 2};
+    const size_t split = (placement_.cpus.size() + 1) / 2;
+    for (size_t side = 0; side < groupPools_.size(); ++side) {
+      if (groupThreads[side] > 1) {
+        ThreadPlacement group = placement_;
+        if (placement_.cpus.size() > 1) {
+          group.cpus.assign(placement_.cpus.begin() + (side == 0 ? 0 : split),
+                            side == 0 ? placement_.cpus.begin() + split : placement_.cpus.end());
+        }
+        groupPools_[side] = std::make_unique<core::ThreadPool>(groupThreads[side], group);
+      }
+    }
+  }
+}
+
+std::vector<std::unique_ptr<Effect>> Engine::takeRetiredChain() {
+  std::vector<std::unique_ptr<Effect>> retired;
+  std::swap(retired, retired_);
+  return retired;
+}
+
+void Engine::endTransition() {
+  for (auto& e : transition_.chain) retired_.push_back(std::move(e));
+  transition_.chain.clear();
+  transition_.active = false;
+}
+
+void Engine::setFrameBudget(double targetMs) {
+  governor_.setTargetMs(targetMs);
+  applyQualityLevel();
+}
+
+void Engine::lockQualityLevel(int level) {
+  governor_.lock(level);
+  applyQualityLevel();
+}
+
+void Engine::unlockQualityLevel() {
+  governor_.unlock();
+  applyQualityLevel();
+}
+
+void Engine::applyQualityLevel() {
+  const int level = governor_.level();
+  if (level == appliedQuality_) return;
+  appliedQuality_ = level;
+  for (auto& e : chain_) {
+    e->setQualityLevel(level);
   }
 }
 
+void Engine::processBands(core::ThreadPool* pool, Effect& effect, const Framebuffer& in,
+                          Framebuffer& out) {
+  const bool banded = pool && pool->isMultiThreaded() && effect.bandSafe() && in.h > 1 &&
+                      in.rgba.size() == static_cast<size_t>(in.w) * static_cast<size_t>(in.h) * 4u;
+  if (!banded) {
+    effect.process(in, out);
+    return;
+  }
+  effect.prepareBands(in, out);
+  const int bands = std::min(in.h, pool->getThreadCount() * kBandsPerThread);
+  pool->parallelFor(bands, [&](int band, int /*worker*/) {
+    const core::RowBand rows = core::rowBand(in.h, band, bands);
+    if (!rows.empty()) effect.processBand(in, out, rows.begin, rows.end);
+  });
+}
+
 void Engine::step(float dt) {
+  const bool governed = governor_.adaptive();
+  const auto stepStart = governed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
   time_ += dt;
   ++frame_;
 
-  // Debug: Print every 60 frames to verify step is being called
-  if (frame_ % 60 == 0) {
-    std::fprintf(stderr, "Engine::step frame %d, time %.2f, dt %.4f\n", frame_, time_, dt);
+  if (transition_.active) {
+    stepTransition(dt);
+  } else {
+    runChain(chain_, fb_, cur_, pool_.get());
   }
 
-  // Start with the current framebuffer (previous frame)
-  // Effects will render on top of this
-  int in = cur_;
-  int out = 1 - cur_;
-
-  // Copy the previous frame to the output buffer before processing effects.
-  // This enables frame-to-frame persistence, allowing effects to build upon
-  // the previous frame's content (critical for BufferSave/Restore and other
-  // temporal effects).
-  if (fb_[out].rgba.size() != fb_[in].rgba.size()) {
-    fb_[out].rgba.resize(fb_[in].rgba.size());
+  if (governed) {
+    governor_.observe(
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - stepStart).count());
+    applyQualityLevel();
   }
-  std::copy(fb_[in].rgba.begin(), fb_[in].rgba.end(), fb_[out].rgba.begin());
+}
 
-  for (auto& e : chain_) {
-    if (auto* se = dynamic_cast<ScriptedEffect*>(e.get())) {
-      se->update(time_, frame_, audio_, mouse_);
+void Engine::runChain(std::vector<std::unique_ptr<Effect>>& chain, std::array<Framebuffer, 2>& fb,
+                      int& cur, core::ThreadPool* pool) {
+  // fb[cur] holds the previous frame, which the chain builds on. In-place
+  // effects update it directly; the others write the spare buffer, which then
+  // becomes current. The spare holds stale pixels, so it is only seeded with
+  // the current frame for effects that draw over their input.
+  for (auto& e : chain) {
+    e->update(time_, frame_, audio_, mouse_);
+    Framebuffer& current = fb[cur];
+    if (e->processesInPlace()) {
+      processBands(pool, *e, current, current);
+      continue;
+    }
+    Framebuffer& spare = fb[1 - cur];
+    if (e->drawsOverInput()) {
+      spare.w = current.w;
+      spare.h = current.h;
+      spare.rgba = current.rgba;
     }
-    e->process(fb_[in], fb_[out]);
-    std::swap(in, out);
+    processBands(pool, *e, current, spare);
+    cur = 1 - cur;
   }
-  cur_ = in;
 }
 
-const Framebuffer& Engine::frame() const { return fb_[cur_]; }
+void Engine::stepTransition(float dt) {
+  // Side 0 is the incoming chain, side 1 the outgoing one. With threads the
+  // two run at once, each banding its effects over its own pool group. EEL
+  // registers and gmegabuf are shared by every script in the process, so a
+  // side running EEL code makes the two go one after the other, each banding
+  // over the whole pool.
+  const bool concurrent =
+      sidePool_ && !chainRunsEel(chain_) && !chainRunsEel(transition_.chain);
+  auto renderSide = [this, concurrent](int side) {
+    if (side == 0) {
+      runChain(chain_, fb_, cur_, concurrent ? groupPools_[0].get() : pool_.get());
+    } else {
+      runChain(transition_.chain, transition_.fb, transition_.cur,
+               concurrent ? groupPools_[1].get() : pool_.get());
+    }
+  };
+  if (concurrent) {
+    sidePool_->parallelFor(2, [&](int side, int /*worker*/) { renderSide(side); });
+  } else {
+    renderSide(0);
+    renderSide(1);
+  }
+
+  transition_.elapsed += dt;
+  const Framebuffer& to = fb_[cur_];
+  const Framebuffer& from = transition_.fb[transition_.cur];
+  if (transition_.elapsed >= transition_.seconds || from.rgba.size() != to.rgba.size() ||
+      from.w != to.w || from.h != to.h) {
+    endTransition();
+    return;
+  }
+  Framebuffer& blended = transition_.blended;
+  blended.w = to.w;
+  blended.h = to.h;
+  blended.rgba.resize(to.rgba.size());
+  const core::TransitionFrames frames{from.rgba.data(), to.rgba.data(), blended.rgba.data(), to.w,
+                                      to.h};
+  core::compositeTransition(transition_.mode, frames, transition_.elapsed / transition_.seconds,
+                            transition_.blockMask, transition_.rng);
+}
+
+const Framebuffer& Engine::frame() const {
+  return transition_.active ? transition_.blended : fb_[cur_];
+}
+
+const Framebuffer& Engine::outputFrame() {
+  const Framebuffer& current = frame();
+  if (current.w == outW_ && current.h == outH_) return current;
+  scaler_.scale(current, output_, outW_, outH_);
+  return output_;
+}
 
 }  // namespace avs
@@ -0,0 +1,468 @@
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+#include <avs/cpu_features.hpp>
+#include <avs/frame_interpolator.hpp>
+
+namespace avs {
+
+namespace {
+
+// Motion is searched on luma: coarsely on a quarter-resolution copy over the
+// whole radius, then refined at full resolution around the coarse vector.
+constexpr int kCoarseFactor = 4;
+constexpr int kRefineRadius = 2;
+constexpr int kWeightBits = 8;
+constexpr int kWeightOne = 1 << kWeightBits;
+constexpr int kRound = kWeightOne / 2;
+
+struct Plane {
+  int w = 0;
+  int h = 0;
+  std::vector<std::uint8_t> values;
+
+  const std::uint8_t* row(int y) const { return values.data() + static_cast<size_t>(y) * w; }
+};
+
+Plane lumaPlane(const Framebuffer& frame, bool sse2) {
+  Plane plane;
+  plane.w = frame.w;
+  plane.h = frame.h;
+  plane.values.resize(static_cast<size_t>(frame.w) * frame.h);
+  const std::uint8_t* src = frame.rgba.data();
+  std::uint8_t* dst = plane.values.data();
+  const size_t count = plane.values.size();
+  size_t i = 0;
+  if (sse2) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weights = _mm_set_epi16(0, 29, 150, 77, 0, 29, 150, 77);
+    // Four pixels per step: madd leaves (77r + 150g, 29b) per pixel, and the
+    // pair sums are gathered into the low lanes before narrowing.
+    for (; i + 4 <= count; i += 4) {
+      const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+      __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi8(px, zero), weights);
+      __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi8(px, zero), weights);
+      lo = _mm_add_epi32(lo, _mm_srli_epi64(lo, 32));
+      hi = _mm_add_epi32(hi, _mm_srli_epi64(hi, 32));
+      __m128i sum = _mm_unpacklo_epi64(_mm_shuffle_epi32(lo, _MM_SHUFFLE(3, 1, 2, 0)),
+                                       _mm_shuffle_epi32(hi, _MM_SHUFFLE(3, 1, 2, 0)));
+      sum = _mm_srli_epi32(sum, 8);
+      sum = _mm_packs_epi32(sum, sum);
+      sum = _mm_packus_epi16(sum, sum);
+      const std::uint32_t packed = static_cast<std::uint32_t>(_mm_cvtsi128_si32(sum));
+      std::memcpy(dst + i, &packed, 4);
+    }
+  }
+  for (; i < count; ++i) {
+    const std::uint8_t* px = src + i * 4;
+    dst[i] = static_cast<std::uint8_t>((px[0] * 77 + px[1] * 150 + px[2] * 29) >> 8);
+  }
+  return plane;
+}
+
+Plane downsample(const Plane& full) {
+  Plane plane;
+  plane.w = full.w / kCoarseFactor;
+  plane.h = full.h / kCoarseFactor;
+  plane.values.resize(static_cast<size_t>(plane.w) * plane.h);
+  for (int y = 0; y < plane.h; ++y) {
+    for (int x = 0; x < plane.w; ++x) {
+      int sum = 0;
+      for (int sy = 0; sy < kCoarseFactor; ++sy) {
+        const std::uint8_t* src = full.row(y * kCoarseFactor + sy) + x * kCoarseFactor;
+        for (int sx = 0; sx < kCoarseFactor; ++sx) {
+          sum += src[sx];
+        }
+      }
+      plane.values[static_cast<size_t>(y) * plane.w + x] =
+          static_cast<std::uint8_t>(sum / (kCoarseFactor * kCoarseFactor));
+    }
+  }
+  return plane;
+}
+
+int rowCostScalar(const std::uint8_t* a, const std::uint8_t* b, int count, int begin = 0) {
+  int cost = 0;
+  for (int i = begin; i < count; ++i) {
+    cost += std::abs(a[i] - b[i]);
+  }
+  return cost;
+}
+
+int rowCostSse2(const std::uint8_t* a, const std::uint8_t* b, int count) {
+  __m128i sum = _mm_setzero_si128();
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    sum = _mm_add_epi64(sum, _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                                          _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))));
+  }
+  for (; i + 4 <= count; i += 4) {
+    std::uint32_t wa, wb;
+    std::memcpy(&wa, a + i, 4);
+    std::memcpy(&wb, b + i, 4);
+    sum = _mm_add_epi64(sum, _mm_sad_epu8(_mm_cvtsi32_si128(static_cast<int>(wa)),
+                                          _mm_cvtsi32_si128(static_cast<int>(wb))));
+  }
+  const int cost = _mm_cvtsi128_si32(sum) + _mm_cvtsi128_si32(_mm_srli_si128(sum, 8));
+  return cost + rowCostScalar(a, b, count, i);
+}
+
+__m128i loadRow4(const Plane& plane, int x, int y) {
+  std::int32_t row;
+  std::memcpy(&row, plane.row(y) + x, 4);
+  return _mm_cvtsi32_si128(row);
+}
+
+// Gathered in registers; going through memory would stall store forwarding.
+__m128i loadBlock4x4(const Plane& plane, int x, int y) {
+  const __m128i top = _mm_unpacklo_epi32(loadRow4(plane, x, y), loadRow4(plane, x, y + 1));
+  const __m128i bottom = _mm_unpacklo_epi32(loadRow4(plane, x, y + 2), loadRow4(plane, x, y + 3));
+  return _mm_unpacklo_epi64(top, bottom);
+}
+
+// Sum of absolute differences between the w x h block of `newer` at (x, y)
+// and the block of `older` displaced by -(dx, dy), or -1 when that block
+// leaves the frame.
+int blockCost(const Plane& older, const Plane& newer, int x, int y, int w, int h, int dx, int dy,
+              bool sse2) {
+  const int sx = x - dx;
+  const int sy = y - dy;
+  if (sx < 0 || sy < 0 || sx + w > older.w || sy + h > older.h) {
+    return -1;
+  }
+  int cost = 0;
+  for (int row = 0; row < h; ++row) {
+    const std::uint8_t* a = newer.row(y + row) + x;
+    const std::uint8_t* b = older.row(sy + row) + sx;
+    cost += sse2 ? rowCostSse2(a, b, w) : rowCostScalar(a, b, w);
+  }
+  return cost;
+}
+
+void blendBytesScalar(const std::uint8_t* a, const std::uint8_t* b, int weight, std::uint8_t* dst,
+                      int count, int begin = 0) {
+  const int aWeight = kWeightOne - weight;
+  for (int i = begin; i < count; ++i) {
+    dst[i] = static_cast<std::uint8_t>((a[i] * aWeight + b[i] * weight + kRound) >> kWeightBits);
+  }
+}
+
+void blendBytesSse2(const std::uint8_t* a, const std::uint8_t* b, int weight, std::uint8_t* dst,
+                    int count) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i aWeight = _mm_set1_epi16(static_cast<short>(kWeightOne - weight));
+  const __m128i bWeight = _mm_set1_epi16(static_cast<short>(weight));
+  const __m128i round = _mm_set1_epi16(kRound);
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    // Products stay below 2^16 because the two weights sum to 256.
+    __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(va, zero), aWeight),
+                               _mm_mullo_epi16(_mm_unpacklo_epi8(vb, zero), bWeight));
+    __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(va, zero), aWeight),
+                               _mm_mullo_epi16(_mm_unpackhi_epi8(vb, zero), bWeight));
+    lo = _mm_srli_epi16(_mm_add_epi16(lo, round), kWeightBits);
+    hi = _mm_srli_epi16(_mm_add_epi16(hi, round), kWeightBits);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+  }
+  blendBytesScalar(a, b, weight, dst, count, i);
+}
+
+// blockCost() for a 4x4 block already loaded from `newer`; a whole
+// quarter-resolution block fits one register.
+int blockCost4x4(const Plane& older, __m128i block, int x, int y, int dx, int dy) {
+  const int sx = x - dx;
+  const int sy = y - dy;
+  if (sx < 0 || sy < 0 || sx + 4 > older.w || sy + 4 > older.h) {
+    return -1;
+  }
+  const __m128i sum = _mm_sad_epu8(block, loadBlock4x4(older, sx, sy));
+  return _mm_cvtsi128_si32(sum) + _mm_cvtsi128_si32(_mm_srli_si128(sum, 8));
+}
+
+struct Candidate {
+  int dx = 0;
+  int dy = 0;
+  int cost = std::numeric_limits<int>::max();
+
+  // Ties go to the shorter vector, so flat areas stay still.
+  void consider(int candidateDx, int candidateDy, int candidateCost) {
+    if (candidateCost < 0) return;
+    if (candidateCost < cost ||
+        (candidateCost == cost &&
+         std::abs(candidateDx) + std::abs(candidateDy) < std::abs(dx) + std::abs(dy))) {
+      dx = candidateDx;
+      dy = candidateDy;
+      cost = candidateCost;
+    }
+  }
+};
+
+int clampCoord(int value, int limit) { return std::clamp(value, 0, limit - 1); }
+
+}  // namespace
+
+// Luma at full and quarter resolution. The newer frame of one pair is the
+// older frame of the next, so the worker keeps its planes.
+struct FrameInterpolator::Luma {
+  Plane full;
+  Plane coarse;
+
+  explicit Luma(const Framebuffer& frame) {
+    full = lumaPlane(frame, hasSse2());
+    coarse = downsample(full);
+  }
+};
+
+FrameInterpolator::FrameInterpolator() : FrameInterpolator(Config{}) {}
+
+FrameInterpolator::FrameInterpolator(const Config& config) : config_(config) {
+  config_.blockSize = std::max(kCoarseFactor, config_.blockSize / kCoarseFactor * kCoarseFactor);
+  config_.searchRadius = std::max(0, config_.searchRadius);
+  thread_ = std::thread([this] { run(); });
+}
+
+FrameInterpolator::~FrameInterpolator() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_one();
+  thread_.join();
+}
+
+void FrameInterpolator::submit(const Framebuffer& frame, double seconds) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_ = frame;
+    pendingSeconds_ = seconds;
+  }
+  wake_.notify_one();
+}
+
+bool FrameInterpolator::present(double seconds, Framebuffer& out) {
+  std::shared_ptr<const Pair> pair;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pair = pair_;
+  }
+  if (!pair) return false;
+  const double interval = pair->newerSeconds - pair->olderSeconds;
+  const double position = std::clamp((seconds - pair->newerSeconds) / interval, 0.0, 1.0);
+  synthesize(*pair->older, *pair->newer, pair->field, static_cast<float>(position), out);
+  return true;
+}
+
+void FrameInterpolator::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this] { return !pending_ && !matching_; });
+}
+
+void FrameInterpolator::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  pending_.reset();
+  pair_.reset();
+  resetPending_ = true;
+}
+
+void FrameInterpolator::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    wake_.wait(lock, [this] { return stop_ || pending_.has_value(); });
+    if (stop_) return;
+    auto frame = std::make_shared<const Framebuffer>(std::move(*pending_));
+    pending_.reset();
+    const double seconds = pendingSeconds_;
+    const bool fresh = std::exchange(resetPending_, false);
+    matching_ = true;
+    lock.unlock();
+
+    if (fresh) last_.reset();
+    auto luma = std::make_unique<const Luma>(*frame);
+    std::shared_ptr<Pair> pair;
+    if (last_ && last_->w == frame->w && last_->h == frame->h && seconds > lastSeconds_) {
+      pair = std::make_shared<Pair>();
+      pair->older = last_;
+      pair->newer = frame;
+      pair->olderSeconds = lastSeconds_;
+      pair->newerSeconds = seconds;
+      pair->field = match(*lastLuma_, *luma, config_, true);
+    }
+    last_ = std::move(frame);
+    lastLuma_ = std::move(luma);
+    lastSeconds_ = seconds;
+
+    lock.lock();
+    matching_ = false;
+    if (!resetPending_) {
+      pair_ = std::move(pair);
+    }
+    if (!pending_) {
+      idle_.notify_all();
+    }
+  }
+}
+
+MotionField FrameInterpolator::estimateMotion(const Framebuffer& older, const Framebuffer& newer,
+                                              const Config& config) {
+  if (older.w != newer.w || older.h != newer.h || newer.w <= 0 || newer.h <= 0) {
+    return match(Luma(newer), Luma(newer), config, false);
+  }
+  return match(Luma(older), Luma(newer), config, true);
+}
+
+MotionField FrameInterpolator::match(const Luma& older, const Luma& newer, const Config& config,
+                                     bool search) {
+  MotionField field;
+  const int blockSize = std::max(kCoarseFactor, config.blockSize / kCoarseFactor * kCoarseFactor);
+  field.blockSize = blockSize;
+  const Plane& olderLuma = older.full;
+  const Plane& newerLuma = newer.full;
+  const Plane& olderCoarse = older.coarse;
+  const Plane& newerCoarse = newer.coarse;
+  if (newerLuma.w <= 0 || newerLuma.h <= 0) return field;
+  field.cols = (newerLuma.w + blockSize - 1) / blockSize;
+  field.rows = (newerLuma.h + blockSize - 1) / blockSize;
+  field.vectors.assign(static_cast<size_t>(field.cols) * field.rows, MotionField::Vector{});
+  if (!search) return field;
+
+  const int radius = std::max(0, config.searchRadius);
+  const int coarseRadius = radius / kCoarseFactor;
+  const int coarseBlock = blockSize / kCoarseFactor;
+  const bool sse2 = hasSse2();
+
+  for (int row = 0; row < field.rows; ++row) {
+    for (int col = 0; col < field.cols; ++col) {
+      const int x = col * blockSize;
+      const int y = row * blockSize;
+      const int w = std::min(blockSize, newerLuma.w - x);
+      const int h = std::min(blockSize, newerLuma.h - y);
+
+      Candidate coarse;
+      const int cx = x / kCoarseFactor;
+      const int cy = y / kCoarseFactor;
+      const int cw = std::min(coarseBlock, newerCoarse.w - cx);
+      const int ch = std::min(coarseBlock, newerCoarse.h - cy);
+      if (sse2 && cw == 4 && ch == 4) {
+        const __m128i block = loadBlock4x4(newerCoarse, cx, cy);
+        for (int dy = -coarseRadius; dy <= coarseRadius; ++dy) {
+          for (int dx = -coarseRadius; dx <= coarseRadius; ++dx) {
+            coarse.consider(dx, dy, blockCost4x4(olderCoarse, block, cx, cy, dx, dy));
+          }
+        }
+      } else if (cw > 0 && ch > 0) {
+        for (int dy = -coarseRadius; dy <= coarseRadius; ++dy) {
+          for (int dx = -coarseRadius; dx <= coarseRadius; ++dx) {
+            coarse.consider(dx, dy,
+                            blockCost(olderCoarse, newerCoarse, cx, cy, cw, ch, dx, dy, sse2));
+          }
+        }
+      }
+      const int baseDx = coarse.cost == std::numeric_limits<int>::max() ? 0 : coarse.dx * kCoarseFactor;
+      const int baseDy = coarse.cost == std::numeric_limits<int>::max() ? 0 : coarse.dy * kCoarseFactor;
+
+      Candidate best;
+      best.consider(0, 0, blockCost(olderLuma, newerLuma, x, y, w, h, 0, 0, sse2));
+      for (int dy = baseDy - kRefineRadius; dy <= baseDy + kRefineRadius; ++dy) {
+        for (int dx = baseDx - kRefineRadius; dx <= baseDx + kRefineRadius; ++dx) {
+          if (std::abs(dx) > radius || std::abs(dy) > radius) continue;
+          best.consider(dx, dy, blockCost(olderLuma, newerLuma, x, y, w, h, dx, dy, sse2));
+        }
+      }
+      // Motion is usually coherent, so the left and upper neighbours' vectors
+      // rescue blocks whose coarse match went astray.
+      for (const auto* neighbour : {col > 0 ? &field.at(col - 1, row) : nullptr,
+                                    row > 0 ? &field.at(col, row - 1) : nullptr}) {
+        if (neighbour && neighbour->reliable) {
+          best.consider(neighbour->dx, neighbour->dy,
+                        blockCost(olderLuma, newerLuma, x, y, w, h, neighbour->dx, neighbour->dy,
+                                  sse2));
+        }
+      }
+
+      const int samples = w * h;
+      MotionField::Vector& vector = field.vectors[static_cast<size_t>(row) * field.cols + col];
+      vector.dx = static_cast<std::int16_t>(best.dx);
+      vector.dy = static_cast<std::int16_t>(best.dy);
+      vector.reliable = best.cost <= config.maxBlockError * samples;
+    }
+  }
+  return field;
+}
+
+void FrameInterpolator::synthesize(const Framebuffer& older, const Framebuffer& newer,
+                                   const MotionField& field, float position, Framebuffer& out) {
+  out.w = newer.w;
+  out.h = newer.h;
+  if (position <= 0.0f) {
+    out.rgba = older.rgba;
+    return;
+  }
+  if (position >= 1.0f) {
+    out.rgba = newer.rgba;
+    return;
+  }
+  out.rgba.resize(newer.rgba.size());
+  const int weight =
+      std::clamp(static_cast<int>(std::lround(position * kWeightOne)), 1, kWeightOne - 1);
+  const bool sse2 = hasSse2();
+  const int w = newer.w;
+  const int h = newer.h;
+  // Without a field for this size the whole frame is a plain cross-fade.
+  const bool matched = field.blockSize > 0 &&
+                       field.vectors.size() == static_cast<size_t>(field.cols) * field.rows &&
+                       field.cols * field.blockSize >= w && field.rows * field.blockSize >= h;
+  const int blockSize = matched ? field.blockSize : std::max(w, 1);
+  const int cols = matched ? field.cols : 1;
+  for (int y = 0; y < h; ++y) {
+    std::uint8_t* dst = out.rgba.data() + static_cast<size_t>(y) * w * 4u;
+    for (int col = 0; col < cols; ++col) {
+      const MotionField::Vector vector = matched ? field.at(col, y / blockSize) : MotionField::Vector{};
+      // The older frame is sampled `position` of the way back along the
+      // vector and the newer one the rest of the way forward.
+      int olderDx = 0, olderDy = 0, newerDx = 0, newerDy = 0;
+      if (vector.reliable) {
+        olderDx = static_cast<int>(std::lround(position * vector.dx));
+        olderDy = static_cast<int>(std::lround(position * vector.dy));
+        newerDx = vector.dx - olderDx;
+        newerDy = vector.dy - olderDy;
+      }
+      const std::uint8_t* olderRow =
+          older.rgba.data() + static_cast<size_t>(clampCoord(y - olderDy, h)) * w * 4u;
+      const std::uint8_t* newerRow =
+          newer.rgba.data() + static_cast<size_t>(clampCoord(y + newerDy, h)) * w * 4u;
+      const int xBegin = col * blockSize;
+      const int xEnd = std::min(w, xBegin + blockSize);
+      // Both samples stay inside the frame on [inBegin, inEnd), so that span
+      // blends whole rows of bytes; only the pixels past it need clamping.
+      const int inBegin = std::clamp(std::max(olderDx, -newerDx), xBegin, xEnd);
+      const int inEnd = std::clamp(std::min(w + olderDx, w - newerDx), inBegin, xEnd);
+      auto blendPixel = [&](int x) {
+        const std::uint8_t* a = olderRow + static_cast<size_t>(clampCoord(x - olderDx, w)) * 4u;
+        const std::uint8_t* b = newerRow + static_cast<size_t>(clampCoord(x + newerDx, w)) * 4u;
+        blendBytesScalar(a, b, weight, dst + static_cast<size_t>(x) * 4u, 4);
+      };
+      for (int x = xBegin; x < inBegin; ++x) blendPixel(x);
+      const std::uint8_t* a = olderRow + static_cast<std::ptrdiff_t>(inBegin - olderDx) * 4;
+      const std::uint8_t* b = newerRow + static_cast<std::ptrdiff_t>(inBegin + newerDx) * 4;
+      std::uint8_t* o = dst + static_cast<size_t>(inBegin) * 4u;
+      const int bytes = (inEnd - inBegin) * 4;
+      if (sse2) {
+        blendBytesSse2(a, b, weight, o, bytes);
+      } else {
+        blendBytesScalar(a, b, weight, o, bytes);
+      }
+      for (int x = inEnd; x < xEnd; ++x) blendPixel(x);
+    }
+  }
+}
+
+}  // namespace avs
@@ -0,0 +1,72 @@
+#include <cstring>
+
+#include <avs/idle_monitor.hpp>
+
+namespace avs {
+
+namespace {
+constexpr std::uint64_t kHashSeed = 0xcbf29ce484222325ull;
+constexpr std::uint64_t kHashMultiplier = 0x9e3779b97f4a7c15ull;
+
+// Word-at-a-time multiply/xorshift mix; only equality matters, so it trades
+// the byte-wise quality of FNV for eight bytes per step.
+std::uint64_t mix(std::uint64_t hash, std::uint64_t word) {
+  hash = (hash ^ word) * kHashMultiplier;
+  return hash ^ (hash >> 29);
+}
+}  // namespace
+
+IdleMonitor::IdleMonitor() : IdleMonitor(Config{}) {}
+
+IdleMonitor::IdleMonitor(const Config& config) : config_(config) {}
+
+void IdleMonitor::observeAudio(float rms) {
+  quiet_ = rms <= config_.rmsThreshold;
+  if (!quiet_) {
+    stableFrames_ = 0;
+    idle_ = false;
+  }
+}
+
+void IdleMonitor::observeFrame(const Framebuffer& frame) {
+  const std::uint64_t hash = hashFrame(frame);
+  if (hasHash_ && hash == lastHash_ && quiet_) {
+    ++stableFrames_;
+  } else {
+    stableFrames_ = 0;
+    idle_ = false;
+  }
+  lastHash_ = hash;
+  hasHash_ = true;
+  if (config_.settleFrames > 0 && stableFrames_ >= config_.settleFrames) {
+    idle_ = true;
+  }
+}
+
+void IdleMonitor::wake() {
+  hasHash_ = false;
+  stableFrames_ = 0;
+  idle_ = false;
+}
+
+std::uint64_t IdleMonitor::hashFrame(const Framebuffer& frame) {
+  const std::uint64_t dims = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(frame.w)) << 32) |
+                             static_cast<std::uint32_t>(frame.h);
+  std::uint64_t hash = mix(kHashSeed, dims);
+  const std::uint8_t* data = frame.rgba.data();
+  const size_t size = frame.rgba.size();
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    std::uint64_t word;
+    std::memcpy(&word, data + i, 8);
+    hash = mix(hash, word);
+  }
+  if (i < size) {
+    std::uint64_t tail = 0;
+    std::memcpy(&tail, data + i, size - i);
+    hash = mix(hash, tail);
+  }
+  return mix(hash, static_cast<std::uint64_t>(size));
+}
+
+}  // namespace avs
@@ -581,6 +581,7 @@ ParsedPreset parsePreset(const std::filesystem::path& file) {
   if (parseBinaryMagicHeader(buffer, headerLen, version)) {
     auto preset = parseBinaryPreset(buffer, headerLen);
     preset.presetPath = file;  // Ensure preset path is set
+    preset.loaded = true;
     if (!isKnownMagicVersion(version)) {
       preset.warnings.push_back("unknown preset version: " + version);
     }
@@ -588,6 +589,7 @@ ParsedPreset parsePreset(const std::filesystem::path& file) {
   }
   auto preset = parseTextPreset(std::string(buffer.begin(), buffer.end()));
   preset.presetPath = file;  // Ensure preset path is set
+  preset.loaded = true;
   return preset;
 }
 
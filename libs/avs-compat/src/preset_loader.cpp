@@ -0,0 +1,240 @@
+#include <avs/preset_loader.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+#include <avs/preset.hpp>
+
+namespace avs {
+
+namespace {
+
+// FNV-1a over the preset file; nullopt when it cannot be read.
+std::optional<std::uint64_t> hashFile(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) return std::nullopt;
+  std::uint64_t hash = 1469598103934665603ull;
+  for (std::istreambuf_iterator<char> it(file), end; it != end; ++it) {
+    hash ^= static_cast<std::uint8_t>(*it);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+size_t estimateBytes(const LoadedChain& chain) {
+  return chain.effects.size() * static_cast<size_t>(chain.w) * static_cast<size_t>(chain.h) * 4u;
+}
+
+}  // namespace
+
+PresetLoader::PresetLoader() : thread_([this] { run(); }) {}
+
+PresetLoader::~PresetLoader() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_one();
+  thread_.join();
+}
+
+LoadedChain PresetLoader::build(const std::filesystem::path& path, int w, int h) {
+  LoadedChain result;
+  result.path = path;
+  result.w = w;
+  result.h = h;
+  auto parsed = parsePreset(path);
+  result.loaded = parsed.loaded;
+  result.warnings = std::move(parsed.warnings);
+  result.effects = std::move(parsed.chain);
+  for (auto& effect : result.effects) {
+    effect->init(w, h);
+  }
+  return result;
+}
+
+void PresetLoader::request(const std::filesystem::path& path, int w, int h) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_ = Request{path, w, h};
+  }
+  wake_.notify_one();
+}
+
+std::optional<LoadedChain> PresetLoader::takeReady() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::optional<LoadedChain> result = std::move(ready_);
+  ready_.reset();
+  return result;
+}
+
+void PresetLoader::retire(std::vector<std::unique_ptr<Effect>> chain) {
+  if (chain.empty()) return;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retired_.push_back(std::move(chain));
+  }
+  wake_.notify_one();
+}
+
+void PresetLoader::prefetch(const std::filesystem::path& path, int w, int h) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    prefetches_.push_back(Request{path, w, h});
+  }
+  wake_.notify_one();
+}
+
+void PresetLoader::setCacheBudget(size_t bytes) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cacheBudget_ = bytes;
+    evictOverBudget();
+  }
+  wake_.notify_one();
+}
+
+size_t PresetLoader::cacheBudget() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cacheBudget_;
+}
+
+size_t PresetLoader::cachedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cachedBytes_;
+}
+
+size_t PresetLoader::cachedCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cache_.size();
+}
+
+bool PresetLoader::busy() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pending_.has_value() || !prefetches_.empty() || building_;
+}
+
+void PresetLoader::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    wake_.wait(lock,
+               [this] { return stop_ || pending_ || !retired_.empty() || !prefetches_.empty(); });
+    if (stop_) break;
+
+    if (pending_) {
+      Request request = std::move(*pending_);
+      pending_.reset();
+      building_ = true;
+      load(request, lock);
+      building_ = false;
+    } else if (!retired_.empty()) {
+      auto retired = std::move(retired_);
+      retired_.clear();
+      lock.unlock();
+      retired.clear();
+      lock.lock();
+    } else {
+      Request request = std::move(prefetches_.front());
+      prefetches_.pop_front();
+      building_ = true;
+      warm(request, lock);
+      building_ = false;
+    }
+  }
+}
+
+void PresetLoader::load(const Request& request, std::unique_lock<std::mutex>& lock) {
+  lock.unlock();
+  const std::optional<std::uint64_t> contentHash = hashFile(request.path);
+  lock.lock();
+
+  std::optional<LoadedChain> chain;
+  if (contentHash) chain = takeCached(request, *contentHash);
+  if (chain) {
+    // Keep the preset warm for its next visit.
+    if (cacheBudget_ > 0) prefetches_.push_back(request);
+  } else {
+    lock.unlock();
+    chain = build(request.path, request.w, request.h);
+    lock.lock();
+  }
+  // A chain nobody took yet is stale now; free it here, not on the caller.
+  if (ready_) retired_.push_back(std::move(ready_->effects));
+  ready_ = std::move(chain);
+}
+
+void PresetLoader::warm(const Request& request, std::unique_lock<std::mutex>& lock) {
+  if (cacheBudget_ == 0) return;
+  lock.unlock();
+  const std::optional<std::uint64_t> contentHash = hashFile(request.path);
+  lock.lock();
+  if (!contentHash) return;
+
+  for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+    if (it->chain.path == request.path && it->contentHash == *contentHash &&
+        it->chain.w == request.w && it->chain.h == request.h) {
+      cache_.splice(cache_.begin(), cache_, it);
+      return;
+    }
+  }
+
+  lock.unlock();
+  CacheEntry entry;
+  entry.contentHash = *contentHash;
+  entry.chain = build(request.path, request.w, request.h);
+  entry.bytes = estimateBytes(entry.chain);
+  lock.lock();
+  if (entry.chain.ok()) insertCached(std::move(entry));
+}
+
+std::optional<LoadedChain> PresetLoader::takeCached(const Request& request,
+                                                    std::uint64_t contentHash) {
+  std::optional<LoadedChain> result;
+  for (auto it = cache_.begin(); it != cache_.end();) {
+    if (it->chain.path != request.path) {
+      ++it;
+      continue;
+    }
+    const bool fresh = it->contentHash == contentHash;
+    if (fresh && (it->chain.w != request.w || it->chain.h != request.h || result)) {
+      ++it;
+      continue;
+    }
+    cachedBytes_ -= it->bytes;
+    if (fresh) {
+      result = std::move(it->chain);
+    } else {
+      retired_.push_back(std::move(it->chain.effects));
+    }
+    it = cache_.erase(it);
+  }
+  return result;
+}
+
+void PresetLoader::insertCached(CacheEntry entry) {
+  // One warm copy per preset and size; a newer build replaces an older one.
+  for (auto it = cache_.begin(); it != cache_.end();) {
+    if (it->chain.path == entry.chain.path && it->chain.w == entry.chain.w &&
+        it->chain.h == entry.chain.h) {
+      cachedBytes_ -= it->bytes;
+      retired_.push_back(std::move(it->chain.effects));
+      it = cache_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  cachedBytes_ += entry.bytes;
+  cache_.push_front(std::move(entry));
+  evictOverBudget();
+}
+
+void PresetLoader::evictOverBudget() {
+  while (!cache_.empty() && cachedBytes_ > cacheBudget_) {
+    cachedBytes_ -= cache_.back().bytes;
+    retired_.push_back(std::move(cache_.back().chain.effects));
+    cache_.pop_back();
+  }
+}
+
+}  // namespace avs
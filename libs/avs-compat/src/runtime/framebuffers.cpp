@@ -41,6 +41,39 @@ Color unpackColor(std::uint32_t argb) {
   return c;
 }
 
+// Row-wise copy of the overlap of two views.
+void copyRect(const FrameView& src, const FrameView& dst) {
+  const int width = std::min(src.width, dst.width);
+  const int height = std::min(src.height, dst.height);
+  if (!src.data || !dst.data || width <= 0 || height <= 0) return;
+  const std::size_t rowBytes = static_cast<std::size_t>(width) * kChannels;
+  for (int y = 0; y < height; ++y) {
+    std::memcpy(dst.data + static_cast<std::size_t>(y) * dst.stride,
+                src.data + static_cast<std::size_t>(y) * src.stride, rowBytes);
+  }
+}
+
+// dst(x, y) = src(x - dx, y - dy), black where that falls outside src.
+void shiftFrame(const FrameView& src, const FrameView& dst, int dx, int dy) {
+  const int x0 = std::clamp(dx, 0, dst.width);
+  const int x1 = std::clamp(src.width + dx, x0, dst.width);
+  const int y0 = std::clamp(dy, 0, dst.height);
+  const int y1 = std::clamp(src.height + dy, y0, dst.height);
+  const std::size_t rowBytes = static_cast<std::size_t>(dst.width) * kChannels;
+  for (int y = 0; y < dst.height; ++y) {
+    std::uint8_t* row = dst.data + static_cast<std::size_t>(y) * dst.stride;
+    if (y < y0 || y >= y1) {
+      std::memset(row, 0, rowBytes);
+      continue;
+    }
+    std::memset(row, 0, static_cast<std::size_t>(x0) * kChannels);
+    std::memset(row + static_cast<std::size_t>(x1) * kChannels, 0,
+                static_cast<std::size_t>(dst.width - x1) * kChannels);
+  }
+  copyRect(src.subView(x0 - dx, y0 - dy, x1 - x0, y1 - y0),
+           dst.subView(x0, y0, x1 - x0, y1 - y0));
+}
+
 }  // namespace
 
 Framebuffers::Framebuffers(int width, int height) {
@@ -132,36 +165,37 @@ void Framebuffers::clear(const ClearSettings& settings) {
   FrameView view = currentView();
   if (!view.data) return;
   const Color color = unpackColor(settings.argb);
-  const std::size_t pixelCount = static_cast<std::size_t>(view.width) * static_cast<std::size_t>(view.height);
-  std::uint8_t* dst = view.data;
-  for (std::size_t i = 0; i < pixelCount; ++i) {
-    switch (settings.blend) {
-      case ClearBlendMode::Replace:
-        dst[0] = color.r;
-        dst[1] = color.g;
-        dst[2] = color.b;
-        dst[3] = color.a;
-        break;
-      case ClearBlendMode::Additive:
-        dst[0] = saturatingAdd(dst[0], color.r);
-        dst[1] = saturatingAdd(dst[1], color.g);
-        dst[2] = saturatingAdd(dst[2], color.b);
-        dst[3] = saturatingAdd(dst[3], color.a);
-        break;
-      case ClearBlendMode::Average:
-        dst[0] = average(dst[0], color.r);
-        dst[1] = average(dst[1], color.g);
-        dst[2] = average(dst[2], color.b);
-        dst[3] = average(dst[3], color.a);
-        break;
-      case ClearBlendMode::DefaultBlend:
-        dst[0] = blendDefault(dst[0], color.r);
-        dst[1] = blendDefault(dst[1], color.g);
-        dst[2] = blendDefault(dst[2], color.b);
-        dst[3] = blendDefault(dst[3], color.a);
-        break;
+  for (int y = 0; y < view.height; ++y) {
+    std::uint8_t* dst = view.data + static_cast<std::size_t>(y) * view.stride;
+    for (int x = 0; x < view.width; ++x) {
+      switch (settings.blend) {
+        case ClearBlendMode::Replace:
+          dst[0] = color.r;
+          dst[1] = color.g;
+          dst[2] = color.b;
+          dst[3] = color.a;
+          break;
+        case ClearBlendMode::Additive:
+          dst[0] = saturatingAdd(dst[0], color.r);
+          dst[1] = saturatingAdd(dst[1], color.g);
+          dst[2] = saturatingAdd(dst[2], color.b);
+          dst[3] = saturatingAdd(dst[3], color.a);
+          break;
+        case ClearBlendMode::Average:
+          dst[0] = average(dst[0], color.r);
+          dst[1] = average(dst[1], color.g);
+          dst[2] = average(dst[2], color.b);
+          dst[3] = average(dst[3], color.a);
+          break;
+        case ClearBlendMode::DefaultBlend:
+          dst[0] = blendDefault(dst[0], color.r);
+          dst[1] = blendDefault(dst[1], color.g);
+          dst[2] = blendDefault(dst[2], color.b);
+          dst[3] = blendDefault(dst[3], color.a);
+          break;
+      }
+      dst += kChannels;
     }
-    dst += kChannels;
   }
 }
 
@@ -196,56 +230,37 @@ void Framebuffers::wrap(const WrapSettings& settings) {
   FrameView src = previousView();
   FrameView dst = currentView();
   if (!src.data || !dst.data) return;
-  for (int y = 0; y < dst.height; ++y) {
-    const int sy = wrapCoord(y + settings.offsetY, src.height);
-    const std::uint8_t* srcRow = src.data + sy * src.stride;
-    std::uint8_t* dstRow = dst.data + y * dst.stride;
-    for (int x = 0; x < dst.width; ++x) {
-      const int sx = wrapCoord(x + settings.offsetX, src.width);
-      const std::uint8_t* sp = srcRow + sx * kChannels;
-      std::uint8_t* dp = dstRow + x * kChannels;
-      std::copy(sp, sp + kChannels, dp);
-    }
-  }
+  if (src.width != dst.width || src.height != dst.height) return;
+  // A toroidal shift is four rectangle copies: the source is cut at the wrap
+  // point and each piece lands in the opposite corner.
+  const int ox = wrapCoord(settings.offsetX, src.width);
+  const int oy = wrapCoord(settings.offsetY, src.height);
+  const int restX = src.width - ox;
+  const int restY = src.height - oy;
+  copyRect(src.subView(ox, oy, restX, restY), dst.subView(0, 0, restX, restY));
+  copyRect(src.subView(0, oy, ox, restY), dst.subView(restX, 0, ox, restY));
+  copyRect(src.subView(ox, 0, restX, oy), dst.subView(0, restY, restX, oy));
+  copyRect(src.subView(0, 0, ox, oy), dst.subView(restX, restY, ox, oy));
 }
 
 void Framebuffers::slideIn(const SlideSettings& settings) {
   FrameView src = previousView();
   FrameView dst = currentView();
   if (!src.data || !dst.data) return;
-  const int amount = std::max(0, settings.amount);
-  for (int y = 0; y < dst.height; ++y) {
-    std::uint8_t* dstRow = dst.data + y * dst.stride;
-    for (int x = 0; x < dst.width; ++x) {
-      std::uint8_t* dp = dstRow + x * kChannels;
-      int sx = x;
-      int sy = y;
-      bool valid = true;
-      switch (settings.direction) {
-        case SlideDirection::Left:
-          sx = x - amount;
-          valid = sx >= 0;
-          break;
-        case SlideDirection::Right:
-          sx = x + amount;
-          valid = sx < src.width;
-          break;
-        case SlideDirection::Up:
-          sy = y - amount;
-          valid = sy >= 0;
-          break;
-        case SlideDirection::Down:
-          sy = y + amount;
-          valid = sy < src.height;
-          break;
-      }
-      if (valid) {
-        const std::uint8_t* sp = src.data + sy * src.stride + sx * kChannels;
-        std::copy(sp, sp + kChannels, dp);
-      } else {
-        std::fill(dp, dp + kChannels, 0);
-      }
-    }
+  const int amount = std::min(std::max(0, settings.amount), std::max(dst.width, dst.height));
+  switch (settings.direction) {
+    case SlideDirection::Left:
+      shiftFrame(src, dst, amount, 0);
+      break;
+    case SlideDirection::Right:
+      shiftFrame(src, dst, -amount, 0);
+      break;
+    case SlideDirection::Up:
+      shiftFrame(src, dst, 0, amount);
+      break;
+    case SlideDirection::Down:
+      shiftFrame(src, dst, 0, -amount);
+      break;
   }
 }
 
@@ -253,39 +268,20 @@ void Framebuffers::slideOut(const SlideSettings& settings) {
   FrameView src = previousView();
   FrameView dst = currentView();
   if (!src.data || !dst.data) return;
-  const int amount = std::max(0, settings.amount);
-  for (int y = 0; y < dst.height; ++y) {
-    std::uint8_t* dstRow = dst.data + y * dst.stride;
-    for (int x = 0; x < dst.width; ++x) {
-      std::uint8_t* dp = dstRow + x * kChannels;
-      int sx = x;
-      int sy = y;
-      bool valid = true;
-      switch (settings.direction) {
-        case SlideDirection::Left:
-          sx = x + amount;
-          valid = sx < src.width;
-          break;
-        case SlideDirection::Right:
-          sx = x - amount;
-          valid = sx >= 0;
-          break;
-        case SlideDirection::Up:
-          sy = y + amount;
-          valid = sy < src.height;
-          break;
-        case SlideDirection::Down:
-          sy = y - amount;
-          valid = sy >= 0;
-          break;
-      }
-      if (valid) {
-        const std::uint8_t* sp = src.data + sy * src.stride + sx * kChannels;
-        std::copy(sp, sp + kChannels, dp);
-      } else {
-        std::fill(dp, dp + kChannels, 0);
-      }
-    }
+  const int amount = std::min(std::max(0, settings.amount), std::max(dst.width, dst.height));
+  switch (settings.direction) {
+    case SlideDirection::Left:
+      shiftFrame(src, dst, -amount, 0);
+      break;
+    case SlideDirection::Right:
+      shiftFrame(src, dst, amount, 0);
+      break;
+    case SlideDirection::Up:
+      shiftFrame(src, dst, 0, -amount);
+      break;
+    case SlideDirection::Down:
+      shiftFrame(src, dst, 0, amount);
+      break;
   }
 }
 
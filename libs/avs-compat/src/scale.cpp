@@ -0,0 +1,147 @@
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <avs/cpu_features.hpp>
+#include <avs/scale.hpp>
+
+namespace avs {
+
+namespace {
+constexpr int kWeightBits = 8;
+constexpr int kWeightOne = 1 << kWeightBits;
+constexpr int kRound = kWeightOne / 2;
+
+// Blend two source rows into 16-bit channel values: (top * (256 - w) + bottom * w + 128) >> 8.
+void blendRowsScalar(const std::uint8_t* top, const std::uint8_t* bottom, int weight,
+                     std::uint16_t* dst, size_t count, size_t begin = 0) {
+  const int topWeight = kWeightOne - weight;
+  for (size_t i = begin; i < count; ++i) {
+    dst[i] = static_cast<std::uint16_t>((top[i] * topWeight + bottom[i] * weight + kRound) >> kWeightBits);
+  }
+}
+
+void blendRowsSse2(const std::uint8_t* top, const std::uint8_t* bottom, int weight,
+                   std::uint16_t* dst, size_t count) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i topWeight = _mm_set1_epi16(static_cast<short>(kWeightOne - weight));
+  const __m128i bottomWeight = _mm_set1_epi16(static_cast<short>(weight));
+  const __m128i round = _mm_set1_epi16(kRound);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + i));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + i));
+    // Products stay below 2^16 because the two weights sum to 256.
+    __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(t, zero), topWeight),
+                               _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), bottomWeight));
+    __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(t, zero), topWeight),
+                               _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), bottomWeight));
+    lo = _mm_srli_epi16(_mm_add_epi16(lo, round), kWeightBits);
+    hi = _mm_srli_epi16(_mm_add_epi16(hi, round), kWeightBits);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), lo);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), hi);
+  }
+  blendRowsScalar(top, bottom, weight, dst, count, i);
+}
+
+template <typename Tap>
+void blendColumnsScalar(const std::uint16_t* row, const std::vector<Tap>& columns, std::uint8_t* dst,
+                        size_t begin = 0) {
+  for (size_t x = begin; x < columns.size(); ++x) {
+    const Tap& tap = columns[x];
+    const std::uint16_t* a = row + static_cast<size_t>(tap.first) * 4u;
+    const std::uint16_t* b = row + static_cast<size_t>(tap.second) * 4u;
+    const int aWeight = kWeightOne - tap.weight;
+    for (int c = 0; c < 4; ++c) {
+      dst[x * 4u + static_cast<size_t>(c)] =
+          static_cast<std::uint8_t>((a[c] * aWeight + b[c] * tap.weight + kRound) >> kWeightBits);
+    }
+  }
+}
+
+template <typename Tap>
+void blendColumnsSse2(const std::uint16_t* row, const std::vector<Tap>& columns, std::uint8_t* dst) {
+  const __m128i round = _mm_set1_epi16(kRound);
+  const auto loadPixel = [row](int index) {
+    return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + static_cast<size_t>(index) * 4u));
+  };
+  size_t x = 0;
+  // Two destination pixels per register: four 16-bit channels each.
+  for (; x + 2 <= columns.size(); x += 2) {
+    const Tap& p = columns[x];
+    const Tap& q = columns[x + 1];
+    const __m128i a = _mm_unpacklo_epi64(loadPixel(p.first), loadPixel(q.first));
+    const __m128i b = _mm_unpacklo_epi64(loadPixel(p.second), loadPixel(q.second));
+    const short pw = static_cast<short>(p.weight);
+    const short qw = static_cast<short>(q.weight);
+    const short pa = static_cast<short>(kWeightOne - p.weight);
+    const short qa = static_cast<short>(kWeightOne - q.weight);
+    const __m128i aWeight = _mm_set_epi16(qa, qa, qa, qa, pa, pa, pa, pa);
+    const __m128i bWeight = _mm_set_epi16(qw, qw, qw, qw, pw, pw, pw, pw);
+    __m128i sum = _mm_add_epi16(_mm_mullo_epi16(a, aWeight), _mm_mullo_epi16(b, bWeight));
+    sum = _mm_srli_epi16(_mm_add_epi16(sum, round), kWeightBits);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x * 4u), _mm_packus_epi16(sum, sum));
+  }
+  blendColumnsScalar(row, columns, dst, x);
+}
+}  // namespace
+
+void BilinearScaler::buildTaps(int srcSize, int dstSize, std::vector<Tap>& taps) {
+  taps.resize(static_cast<size_t>(dstSize));
+  const double step = static_cast<double>(srcSize) / static_cast<double>(dstSize);
+  for (int d = 0; d < dstSize; ++d) {
+    const double center = std::clamp((d + 0.5) * step - 0.5, 0.0, static_cast<double>(srcSize - 1));
+    int first = static_cast<int>(center);
+    int weight = static_cast<int>(std::lround((center - first) * kWeightOne));
+    if (weight == kWeightOne) {
+      ++first;
+      weight = 0;
+    }
+    taps[static_cast<size_t>(d)] = Tap{first, std::min(first + 1, srcSize - 1), weight};
+  }
+}
+
+void BilinearScaler::scale(const Framebuffer& in, Framebuffer& out, int width, int height) {
+  width = std::max(width, 0);
+  height = std::max(height, 0);
+  out.w = width;
+  out.h = height;
+  out.rgba.resize(static_cast<size_t>(width) * static_cast<size_t>(height) * 4u);
+  if (width == 0 || height == 0) return;
+  if (in.w <= 0 || in.h <= 0 || in.rgba.size() < static_cast<size_t>(in.w) * in.h * 4u) {
+    std::fill(out.rgba.begin(), out.rgba.end(), 0);
+    return;
+  }
+
+  if (in.w != srcW_ || width != dstW_) {
+    buildTaps(in.w, width, columns_);
+  }
+  if (in.h != srcH_ || height != dstH_) {
+    buildTaps(in.h, height, rows_);
+  }
+  srcW_ = in.w;
+  srcH_ = in.h;
+  dstW_ = width;
+  dstH_ = height;
+
+  const size_t srcStride = static_cast<size_t>(in.w) * 4u;
+  const size_t dstStride = static_cast<size_t>(width) * 4u;
+  blendedRow_.resize(srcStride);
+  const bool sse2 = hasSse2();
+  for (int y = 0; y < height; ++y) {
+    const Tap& tap = rows_[static_cast<size_t>(y)];
+    const std::uint8_t* top = in.rgba.data() + static_cast<size_t>(tap.first) * srcStride;
+    const std::uint8_t* bottom = in.rgba.data() + static_cast<size_t>(tap.second) * srcStride;
+    std::uint8_t* dst = out.rgba.data() + static_cast<size_t>(y) * dstStride;
+    if (sse2) {
+      blendRowsSse2(top, bottom, tap.weight, blendedRow_.data(), srcStride);
+      blendColumnsSse2(blendedRow_.data(), columns_, dst);
+    } else {
+      blendRowsScalar(top, bottom, tap.weight, blendedRow_.data(), srcStride);
+      blendColumnsScalar(blendedRow_.data(), columns_, dst);
+    }
+  }
+}
+
+}  // namespace avs
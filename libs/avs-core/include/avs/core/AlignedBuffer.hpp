@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace avs::core {
+
+/** @brief Alignment of pixel storage and of every padded row within it. */
+inline constexpr std::size_t kCacheLineBytes = 64;
+
+/**
+ * @brief Bytes per row for a @p width pixel RGBA row padded to a cache line.
+ *
+ * Rows starting on cache-line boundaries allow aligned SIMD loads at any row
+ * and keep a row band from sharing a line with its neighbour.
+ */
+constexpr std::size_t alignedRowStride(int width) {
+  const std::size_t packed = width > 0 ? static_cast<std::size_t>(width) * 4u : 0u;
+  return (packed + kCacheLineBytes - 1) & ~(kCacheLineBytes - 1);
+}
+
+/** @brief std::allocator replacement returning @p Alignment aligned storage. */
+template <typename T, std::size_t Alignment = kCacheLineBytes>
+struct AlignedAllocator {
+  static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0);
+
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() noexcept = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+  T* allocate(std::size_t count) {
+    return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+  }
+  void deallocate(T* pointer, std::size_t) noexcept {
+    ::operator delete(pointer, std::align_val_t{Alignment});
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept {
+    return true;
+  }
+};
+
+/** @brief Byte vector whose data() is cache-line aligned. */
+using AlignedBytes = std::vector<std::uint8_t, AlignedAllocator<std::uint8_t>>;
+
+}  // namespace avs::core
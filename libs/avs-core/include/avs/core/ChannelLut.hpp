@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace avs::core {
+
+/**
+ * @brief Per-channel 256-entry lookup tables for the three color bytes of a pixel.
+ *
+ * Table c maps byte c of every 4-byte pixel; the fourth (alpha) byte passes
+ * through. Effects that are pure per-channel functions of their input express a
+ * frame as one of these so the pipeline can compose adjacent effects and sweep
+ * the framebuffer once.
+ */
+struct ChannelLut {
+  std::array<std::array<std::uint8_t, 256>, 3> channels{};
+
+  /** @brief Reset every table to the identity mapping. */
+  void setIdentity() {
+    for (auto& table : channels) {
+      for (int value = 0; value < 256; ++value) {
+        table[static_cast<std::size_t>(value)] = static_cast<std::uint8_t>(value);
+      }
+    }
+  }
+
+  /** @brief Fill every table from @p map(channel, value). */
+  template <typename Fn>
+  void fill(Fn&& map) {
+    for (int channel = 0; channel < 3; ++channel) {
+      for (int value = 0; value < 256; ++value) {
+        channels[static_cast<std::size_t>(channel)][static_cast<std::size_t>(value)] =
+            map(channel, static_cast<std::uint8_t>(value));
+      }
+    }
+  }
+
+  /** @brief Compose in place so that applying the result equals applying this, then @p next. */
+  void then(const ChannelLut& next) {
+    for (std::size_t channel = 0; channel < 3; ++channel) {
+      auto& table = channels[channel];
+      const auto& after = next.channels[channel];
+      for (auto& entry : table) {
+        entry = after[entry];
+      }
+    }
+  }
+
+  /** @brief True when a black pixel stays black. */
+  [[nodiscard]] bool mapsBlackToBlack() const {
+    return channels[0][0] == 0 && channels[1][0] == 0 && channels[2][0] == 0;
+  }
+
+  /** @brief Map pixels [begin, end) of a packed 4-byte-per-pixel buffer. */
+  void apply(std::uint8_t* pixels, std::size_t begin, std::size_t end) const {
+    const auto& c0 = channels[0];
+    const auto& c1 = channels[1];
+    const auto& c2 = channels[2];
+    for (std::size_t i = begin; i < end; ++i) {
+      std::uint8_t* px = pixels + i * 4u;
+      px[0] = c0[px[0]];
+      px[1] = c1[px[1]];
+      px[2] = c2[px[2]];
+    }
+  }
+};
+
+}  // namespace avs::core
@@ -5,8 +5,47 @@
 
 namespace avs::core {
 
+/**
+ * @brief Counter-based random stream: value @p index is a pure function of the
+ * stream key and the index.
+ *
+ * Bands and tiles can draw from the same stream in any order, on any thread,
+ * and still see the values a serial renderer would; index by pixel or row, never
+ * by band, since band geometry changes with the thread count.
+ */
+class RandomStream {
+ public:
+  RandomStream() = default;
+  explicit RandomStream(std::uint64_t key) : key_(key) {}
+
+  /** @brief Raw 32-bit value at @p index. */
+  [[nodiscard]] std::uint32_t at(std::uint64_t index) const {
+    // SplitMix64 finalizer over the key-offset counter.
+    std::uint64_t z = key_ + (index + 1u) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<std::uint32_t>((z ^ (z >> 31)) >> 32);
+  }
+
+  /** @brief Integer in [@p lo, @p hi] at @p index. */
+  [[nodiscard]] int rangeAt(std::uint64_t index, int lo, int hi) const {
+    const std::uint64_t span = static_cast<std::uint64_t>(hi - lo) + 1u;
+    return lo + static_cast<int>((static_cast<std::uint64_t>(at(index)) * span) >> 32);
+  }
+
+ private:
+  std::uint64_t key_ = 0;
+};
+
 /**
  * @brief Frame-level deterministic random number generator.
+ *
+ * Determinism contract: an effect's randomness depends only on the seed, the
+ * frame index, the effect's position in the chain and (for per-pixel noise)
+ * the pixel index, never on how many values other effects or other threads
+ * consumed. The pipeline calls reseed(frame, node) before each effect; the
+ * sequential nextUint32()/uniform() draws are for serial per-frame state in
+ * render() or smp_begin(), and smp_render() draws come from stream().
  */
 class DeterministicRng {
  public:
@@ -14,9 +53,12 @@ class DeterministicRng {
   explicit DeterministicRng(std::uint64_t seed);
 
   /**
-   * @brief Update the RNG state for a specific frame index.
+   * @brief Update the RNG state for a specific frame index and effect.
+   *
+   * Effect 0 yields the same sequence as the frame-only seeding did, so a
+   * single effect renders as before.
    */
-  void reseed(std::uint64_t frameIndex);
+  void reseed(std::uint64_t frameIndex, std::uint64_t effectIndex = 0);
 
   /**
    * @brief Generate the next raw 32-bit value.
@@ -28,10 +70,19 @@ class DeterministicRng {
    */
   [[nodiscard]] float uniform(float min, float max);
 
+  /**
+   * @brief Counter-based stream for the current frame and effect.
+   *
+   * Independent of the sequential draws; @p salt separates several streams of
+   * one effect.
+   */
+  [[nodiscard]] RandomStream stream(std::uint64_t salt = 0) const;
+
   [[nodiscard]] std::uint64_t seed() const { return baseSeed_; }
 
  private:
   std::uint64_t baseSeed_ = 0;
+  std::uint64_t streamKey_ = 0;
   std::mt19937 engine_;
 };
 
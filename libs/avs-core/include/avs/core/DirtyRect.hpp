@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+namespace avs::core {
+
+/**
+ * @brief Conservative bounding box of the pixels that may not be black.
+ *
+ * Covers [x0, x1) x [y0, y1). Outside it every pixel has zero color bytes;
+ * alpha is not tracked. The default value is unbounded, meaning nothing is
+ * known about the frame, so code that ignores dirty tracking stays correct.
+ * Unions only ever grow the box: several small shapes far apart are tracked
+ * as the one box around all of them.
+ */
+struct DirtyRect {
+  static constexpr int kUnbounded = std::numeric_limits<int>::max();
+
+  int x0 = 0;
+  int y0 = 0;
+  int x1 = kUnbounded;
+  int y1 = kUnbounded;
+
+  /** @brief Nothing known: any pixel may be non-black. */
+  static constexpr DirtyRect all() { return {}; }
+
+  /** @brief The whole frame is black. */
+  static constexpr DirtyRect none() { return {0, 0, 0, 0}; }
+
+  [[nodiscard]] constexpr bool empty() const { return x1 <= x0 || y1 <= y0; }
+
+  [[nodiscard]] constexpr bool coversFrame(int width, int height) const {
+    return x0 <= 0 && y0 <= 0 && x1 >= width && y1 >= height;
+  }
+
+  /** @brief True when any row in [begin, end) may hold non-black pixels. */
+  [[nodiscard]] constexpr bool intersectsRows(int begin, int end) const {
+    return !empty() && begin < y1 && end > y0;
+  }
+
+  [[nodiscard]] constexpr DirtyRect clipped(int width, int height) const {
+    DirtyRect result{std::max(x0, 0), std::max(y0, 0), std::min(x1, width), std::min(y1, height)};
+    return result.empty() ? none() : result;
+  }
+
+  /** @brief Grow to cover pixel (@p x, @p y). */
+  constexpr void include(int x, int y) {
+    if (empty()) {
+      *this = {x, y, x + 1, y + 1};
+      return;
+    }
+    x0 = std::min(x0, x);
+    y0 = std::min(y0, y);
+    x1 = std::max(x1, x + 1);
+    y1 = std::max(y1, y + 1);
+  }
+
+  /** @brief Grow to cover @p other as well. */
+  constexpr void include(const DirtyRect& other) {
+    if (other.empty()) {
+      return;
+    }
+    if (empty()) {
+      *this = other;
+      return;
+    }
+    x0 = std::min(x0, other.x0);
+    y0 = std::min(y0, other.y0);
+    x1 = std::max(x1, other.x1);
+    y1 = std::max(y1, other.y1);
+  }
+
+  constexpr bool operator==(const DirtyRect&) const = default;
+};
+
+}  // namespace avs::core
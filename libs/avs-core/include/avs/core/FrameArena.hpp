@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <avs/core/AlignedBuffer.hpp>
+
+namespace avs::core {
+
+/**
+ * @brief Bump allocator for scratch memory that only lives for one frame.
+ *
+ * Every allocation is aligned to kAlignment and stays valid until reset(),
+ * which Pipeline calls once render() finishes. When a frame outgrows the
+ * current block another one is chained on; the next reset() folds them into a
+ * single block of the combined size, so after the first few frames of a
+ * preset the arena stops touching the heap altogether.
+ *
+ * Not thread-safe. Allocate from render() or smp_begin(), hand the pointers to
+ * the bands, and keep anything that must survive the frame (history, feedback
+ * buffers) in the effect itself.
+ */
+class FrameArena {
+ public:
+  static constexpr std::size_t kAlignment = kCacheLineBytes;
+
+  FrameArena() = default;
+  FrameArena(const FrameArena&) = delete;
+  FrameArena& operator=(const FrameArena&) = delete;
+  FrameArena(FrameArena&&) noexcept = default;
+  FrameArena& operator=(FrameArena&&) noexcept = default;
+
+  /** @brief Uninitialized storage for @p bytes; null when @p bytes is 0. */
+  void* allocate(std::size_t bytes);
+
+  /** @brief Uninitialized storage for @p count values of a trivial type. */
+  template <typename T>
+  T* allocateArray(std::size_t count) {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                  "FrameArena never runs constructors or destructors");
+    static_assert(alignof(T) <= kAlignment);
+    return static_cast<T*>(allocate(count * sizeof(T)));
+  }
+
+  /** @brief Release every allocation at once. Capacity is kept for the next frame. */
+  void reset();
+
+  /** @brief Bytes handed out since the last reset(), including alignment padding. */
+  std::size_t bytesUsed() const { return retiredBytes_ + offset_; }
+
+  /** @brief Total bytes held across all blocks. */
+  std::size_t capacity() const;
+
+ private:
+  struct AlignedDelete {
+    void operator()(std::byte* data) const;
+  };
+  struct Block {
+    std::unique_ptr<std::byte[], AlignedDelete> data;
+    std::size_t size = 0;
+  };
+
+  void addBlock(std::size_t minBytes);
+
+  std::vector<Block> blocks_;
+  std::size_t offset_ = 0;        ///< Bytes used in blocks_.back().
+  std::size_t retiredBytes_ = 0;  ///< Bytes used in every block before the last.
+};
+
+/**
+ * @brief Frame scratch from @p arena, or from @p fallback when there is none.
+ *
+ * Lets an effect run both under a Pipeline, which provides an arena, and when
+ * driven directly with a bare RenderContext. The fallback only grows.
+ */
+template <typename T>
+T* frameScratch(FrameArena* arena, std::vector<T>& fallback, std::size_t count) {
+  if (arena) {
+    return arena->allocateArray<T>(count);
+  }
+  if (fallback.size() < count) {
+    fallback.resize(count);
+  }
+  return fallback.data();
+}
+
+}  // namespace avs::core
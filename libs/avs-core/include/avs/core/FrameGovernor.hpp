@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+
+#include <avs/core/Profiling.hpp>
+#include <avs/core/Quality.hpp>
+
+namespace avs::core {
+
+/**
+ * @brief Picks a quality level that keeps frame times inside a budget.
+ *
+ * Frame times are collected over a fixed window. When the window's p90 exceeds
+ * the target the level drops by one; when it stays below a fraction of the
+ * target for several consecutive windows the level rises by one. The gap
+ * between the two thresholds and the longer wait before stepping up keep the
+ * level from oscillating around the budget. Every change starts a fresh window
+ * so the next decision only sees frames rendered at the new level.
+ */
+class FrameGovernor {
+ public:
+  struct Config {
+    /** Frame budget in milliseconds; 0 or less disables adaptation. */
+    double targetMs = 1000.0 / 60.0;
+    /** Frames observed per decision. */
+    std::size_t window = 30;
+    /** Step down when the window's p90 exceeds targetMs * downshiftRatio. */
+    double downshiftRatio = 1.0;
+    /** Count a window as headroom when its p90 is below targetMs * upshiftRatio. */
+    double upshiftRatio = 0.7;
+    /** Consecutive headroom windows required before stepping up. */
+    int upshiftWindows = 3;
+  };
+
+  FrameGovernor();
+  explicit FrameGovernor(const Config& config);
+
+  /**
+   * @brief Record one frame time.
+   * @return The level to render the next frame at.
+   */
+  int observe(double frameMs);
+
+  int level() const { return level_; }
+
+  /** @brief True when observe() may change the level. */
+  bool adaptive() const { return config_.targetMs > 0.0 && !locked_; }
+
+  /**
+   * @brief Change the budget, keeping the current level.
+   *
+   * 0 or less disables adaptation and returns an unlocked governor to full quality.
+   */
+  void setTargetMs(double targetMs);
+  double targetMs() const { return config_.targetMs; }
+
+  /** @brief Pin the level; observe() keeps it until unlock(). */
+  void lock(int level);
+  /** @brief Resume adaptation from the locked level, or full quality without a budget. */
+  void unlock();
+  bool locked() const { return locked_; }
+
+  const Config& config() const { return config_; }
+
+ private:
+  void restartWindow();
+
+  Config config_;
+  RollingHistogram window_;
+  int level_ = kMaxQualityLevel;
+  int headroomWindows_ = 0;
+  bool locked_ = false;
+};
+
+}  // namespace avs::core
@@ -1,10 +1,46 @@
 #pragma once
 
+#include <avs/core/ChannelLut.hpp>
 #include <avs/core/ParamBlock.hpp>
+#include <avs/core/Quality.hpp>
 #include <avs/core/RenderContext.hpp>
+#include <avs/core/RowBand.hpp>
+#include <avs/core/StateStream.hpp>
 
 namespace avs::core {
 
+/**
+ * @brief How an effect's smp_render() bands read the framebuffer.
+ *
+ * The pipeline fuses runs of local effects onto cache-sized row tiles, so a
+ * tile passes through the whole run before the next tile is loaded. Only
+ * effects whose pixel work happens entirely inside smp_render() may declare
+ * themselves local: their smp_begin() and smp_finish() must not read or write
+ * the framebuffer, except that a neighborhood effect snapshots its source in
+ * smp_begin().
+ */
+struct AccessPattern {
+  enum class Kind {
+    Pointwise,     ///< Each band reads and writes only its own rows.
+    Neighborhood,  ///< Bands sample `radius` rows around their own from a snapshot.
+    Global,        ///< Reads history, other frames, or writes outside its band.
+  };
+
+  Kind kind = Kind::Global;
+  /** Halo in rows for Neighborhood effects; kWholeFrameHalo when unbounded. */
+  int radius = 0;
+};
+
+/**
+ * @brief What an effect's output depends on, so the pipeline can reuse it.
+ */
+enum class OutputDependence {
+  Frame,    ///< Input pixels, time, audio or randomness: rendered every frame.
+  Params,   ///< Fixed values over a fixed set of channels, given the parameters,
+            ///< quality level and frame size; every other channel passes through.
+  Nothing,  ///< Leaves the framebuffer as it is.
+};
+
 /**
  * @brief Interface implemented by all renderable effects in the pipeline.
  */
@@ -21,15 +57,32 @@ class IEffect {
    */
   virtual bool render(RenderContext& context) = 0;
 
+  /**
+   * @brief Prepare shared per-frame state before a multi-threaded render (optional).
+   *
+   * Called once on the dispatching thread before any smp_render() call for the
+   * frame, mirroring the legacy APE smp_begin(). Effects update lookup tables,
+   * consume beat/RNG state and allocate scratch here so the parallel bands only
+   * read shared members.
+   *
+   * @param context Mutable rendering context for the current frame.
+   * @param maxThreads Number of bands the caller is able to dispatch; usually a
+   * small multiple of the pool size so idle workers can steal.
+   * @return Number of bands to dispatch (at most maxThreads); 0 skips smp_render().
+   */
+  virtual int smp_begin(RenderContext& /* context */, int maxThreads) { return maxThreads; }
+
   /**
    * @brief Multi-threaded render method (optional).
    *
    * Effects can optionally override this method to provide multi-threaded
    * rendering. The default implementation falls back to single-threaded render().
+   * Each band index runs exactly once per frame, but bands may run on any pool
+   * thread and several may share one, so per-band scratch is keyed by threadId.
    *
    * @param context Mutable rendering context for the current frame.
-   * @param threadId Current thread ID (0-indexed).
-   * @param maxThreads Total number of threads available.
+   * @param threadId Band index (0-indexed).
+   * @param maxThreads Total number of bands dispatched.
    * @return true when rendering succeeded, false when the effect should halt
    * further processing.
    */
@@ -41,6 +94,13 @@ class IEffect {
     return true;
   }
 
+  /**
+   * @brief Finalize the frame after every smp_render() call has returned (optional).
+   *
+   * @return false when the effect should halt further processing.
+   */
+  virtual bool smp_finish(RenderContext& /* context */) { return true; }
+
   /**
    * @brief Check if this effect supports multi-threaded rendering.
    *
@@ -48,6 +108,80 @@ class IEffect {
    */
   virtual bool supportsMultiThreaded() const { return false; }
 
+  /**
+   * @brief Declare how smp_render() accesses the framebuffer.
+   *
+   * Consulted only for effects that support multi-threading. The default,
+   * Global, keeps the effect out of fused tile runs.
+   */
+  virtual AccessPattern accessPattern() const { return {}; }
+
+  /**
+   * @brief Whether this frame's output is a pure per-channel function of the input.
+   *
+   * Only asked of Pointwise effects. Must not change effect state; effects whose
+   * current parameters mix channels (exclusion colors, thresholds) return false.
+   */
+  virtual bool hasChannelLut(const RenderContext& /* context */) const { return false; }
+
+  /**
+   * @brief Express this frame as per-channel lookup tables.
+   *
+   * Called instead of smp_begin()/smp_render()/smp_finish() when the pipeline
+   * collapses adjacent LUT effects into one pass, and only after
+   * hasChannelLut() returned true. Advances per-frame state (beat, RNG draws)
+   * exactly as smp_begin() would; a disabled effect writes the identity.
+   */
+  virtual void buildChannelLut(RenderContext& /* context */, ChannelLut& lut) { lut.setIdentity(); }
+
+  /**
+   * @brief Whether this frame leaves black pixels (RGB 0) black.
+   *
+   * Asked of Pointwise effects after smp_begin(). When true the pipeline keeps
+   * the dirty region across the effect and may skip bands holding only black
+   * rows, so smp_render() must not have side effects beyond its own pixels.
+   */
+  virtual bool preservesBlack(const RenderContext& /* context */) const { return false; }
+
+  /**
+   * @brief Declare what decides this effect's output under its current parameters.
+   *
+   * Asked after setParams() and setQualityLevel(). The pipeline drops Nothing
+   * effects from its schedule and renders a Params effect once per frame size
+   * into a cached layer, compositing that layer instead of calling render().
+   * A Params effect must not depend on the framebuffer, the frame, audio or
+   * randomness, and must not keep state across renders.
+   */
+  virtual OutputDependence outputDependence() const { return OutputDependence::Frame; }
+
+  /**
+   * @brief Select a cheaper rendering mode when frames run over budget (optional).
+   *
+   * Called between frames with a level in [kMinQualityLevel, kMaxQualityLevel].
+   * kMaxQualityLevel must reproduce the reference output exactly; lower levels
+   * may cap radii, coarsen grids or drop points. The default ignores the level.
+   */
+  virtual void setQualityLevel(int /* level */) {}
+
+  /**
+   * @brief Write the state this effect carries from one frame to the next (optional).
+   *
+   * History frames, counters, script variables: whatever a fresh instance given
+   * the same parameters would need to render the next frame exactly as this one
+   * will. Parameters themselves are not part of it. Effects without temporal
+   * state write nothing.
+   */
+  virtual void saveState(StateWriter& /* writer */) const {}
+
+  /**
+   * @brief Resume from data written by saveState() (optional).
+   *
+   * Called between frames, after setParams() with the parameters the state was
+   * saved under. Returns false when the data does not fit this effect; the
+   * effect may then be left partly restored.
+   */
+  virtual bool restoreState(StateReader& /* reader */) { return true; }
+
   /**
    * @brief Update effect parameters prior to rendering.
    *
@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 
+#include <avs/core/RenderContext.hpp>
+
 namespace avs {
 namespace core {
 
@@ -39,13 +41,36 @@ public:
   virtual const uint8_t* data() const = 0;
 
   /**
-   * @brief Get pixel data size in bytes.
+   * @brief Get pixel data size in bytes, including any row padding (stride() * height()).
    */
   virtual size_t sizeBytes() const = 0;
 
+  /**
+   * @brief Bytes between the starts of consecutive rows in data().
+   *
+   * At least width() * 4. Backends that pad rows return more; the default is packed.
+   */
+  virtual size_t stride() const { return static_cast<size_t>(width()) * 4u; }
+
+  /**
+   * @brief Strided view of data(); empty for backends without direct access.
+   */
+  PixelBufferView view() {
+    PixelBufferView result;
+    result.data = supportsDirectAccess() ? data() : nullptr;
+    if (result.data) {
+      result.size = sizeBytes();
+      result.stride = stride();
+      result.width = width();
+      result.height = height();
+    }
+    return result;
+  }
+
   /**
    * @brief Copy pixel data from source buffer to framebuffer.
-   * @param sourceData RGBA pixel data (width * height * 4 bytes)
+   * @param sourceData RGBA pixel data, either packed rows (width * height * 4
+   *                   bytes) or rows laid out like data() (sizeBytes())
    * @param numBytes Size of source data in bytes
    *
    * For GPU backends, this may upload data to GPU.
@@ -54,7 +79,8 @@ public:
 
   /**
    * @brief Copy framebuffer pixel data to destination buffer.
-   * @param destData Destination buffer (must be at least sizeBytes())
+   * @param destData Destination buffer, receiving packed rows (width * height * 4
+   *                 bytes) or the padded layout of data() (sizeBytes())
    * @param numBytes Size of destination buffer in bytes
    *
    * For GPU backends, this may download data from GPU.
@@ -102,11 +128,16 @@ public:
 
 /**
  * @brief Create CPU framebuffer (in-memory RGBA buffer).
+ *
+ * Storage is cache-line aligned. Rows are packed unless @p padRows is set,
+ * in which case every row is padded to a multiple of kCacheLineBytes and
+ * stride() may exceed width * 4. Pipeline::render() only accepts packed rows.
  * @param width Initial width in pixels
  * @param height Initial height in pixels
+ * @param padRows Pad each row to a cache line for aligned row access
  * @return Unique pointer to CPU framebuffer
  */
-std::unique_ptr<IFramebuffer> createCPUFramebuffer(int width, int height);
+std::unique_ptr<IFramebuffer> createCPUFramebuffer(int width, int height, bool padRows = false);
 
 /**
  * @brief Create OpenGL framebuffer (wraps existing OpenGL context).
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <avs/core/StateStream.hpp>
+
+namespace avs::core {
+
+/**
+ * @brief 32-bit Mersenne Twister producing the same sequence as std::mt19937.
+ *
+ * Unlike the standard engine its state is reachable without the text stream
+ * operators, so checkpoints store it as 624 words plus the read index and read
+ * back identically whatever standard library wrote them.
+ */
+class Mt19937 {
+ public:
+  using result_type = std::uint32_t;
+
+  static constexpr std::size_t kStateSize = 624;
+  static constexpr result_type kDefaultSeed = 5489u;
+
+  Mt19937() { seed(kDefaultSeed); }
+  explicit Mt19937(result_type value) { seed(value); }
+
+  void seed(result_type value);
+  result_type operator()();
+
+  static constexpr result_type min() { return 0u; }
+  static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+  void saveState(StateWriter& writer) const;
+  /** @brief Replaces the state only when the whole record is valid. */
+  bool restoreState(StateReader& reader);
+
+ private:
+  void twist();
+
+  std::array<result_type, kStateSize> state_{};
+  std::size_t index_ = kStateSize;
+};
+
+}  // namespace avs::core
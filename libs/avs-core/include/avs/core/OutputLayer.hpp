@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <avs/core/DirtyRect.hpp>
+#include <avs/core/IEffect.hpp>
+#include <avs/core/RenderContext.hpp>
+
+namespace avs::core {
+
+/**
+ * @brief Cached output of an OutputDependence::Params effect.
+ *
+ * capture() renders the effect over three constant probe frames and records,
+ * for every channel byte, either the value the effect writes there or that it
+ * passes the input through. The result is a premultiplied layer with binary
+ * per-channel coverage, and composite() applies it as out = color | (in & keep),
+ * which reproduces render() bit for bit. Rows the layer covers whole are copied
+ * and rows it leaves alone are skipped.
+ */
+class OutputLayer {
+ public:
+  enum class Capture {
+    Cached,  ///< The layer now holds the effect's output.
+    Blends,  ///< Some output byte depends on the input, so there is nothing to cache.
+    Failed,  ///< render() reported failure or the context has no frame.
+  };
+
+  /**
+   * @brief Render @p effect into the layer at the context's size and @p quality.
+   *
+   * The context's framebuffer and dirty regions are restored afterwards.
+   */
+  Capture capture(IEffect& effect, RenderContext& context, int quality);
+
+  /** @brief True when the layer was captured at this context's size and @p quality. */
+  bool matches(const RenderContext& context, int quality) const;
+
+  /**
+   * @brief Apply the layer to the context's framebuffer, which must match it.
+   *
+   * Sets dirtyOut from dirtyIn and the non-black pixels of the layer.
+   */
+  void composite(RenderContext& context) const;
+
+  void reset();
+
+ private:
+  enum class RowKind : std::uint8_t { Keep, Copy, Blend };
+
+  int width_ = 0;
+  int height_ = 0;
+  int quality_ = 0;
+  bool valid_ = false;
+  std::vector<std::uint32_t> color_;  ///< Bytes the effect writes; zero where the input passes.
+  std::vector<std::uint32_t> keep_;   ///< 0xFF for bytes the input passes through.
+  std::vector<RowKind> rows_;
+  DirtyRect painted_ = DirtyRect::none();  ///< Written pixels whose color is not black.
+  bool coversColor_ = false;               ///< Every RGB byte of the frame is written.
+};
+
+}  // namespace avs::core
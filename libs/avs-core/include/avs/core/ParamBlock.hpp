@@ -1,80 +1,159 @@
 #pragma once
 
+#include <algorithm>
 #include <optional>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <utility>
 #include <variant>
+#include <vector>
+
+#include <avs/core/ParamKey.hpp>
 
 namespace avs::core {
 
 /**
  * @brief Typed container for effect parameters.
+ *
+ * Values live in a flat vector sorted by interned key id, so lookups are a
+ * binary search over a few cache lines. The ParamKey overloads never allocate;
+ * overwriting an existing non-string value does not allocate either. The
+ * string overloads intern on set and look up without inserting on get.
  */
 class ParamBlock {
  public:
   using Value = std::variant<int, float, bool, std::string>;
 
-  void setInt(const std::string& key, int value) { values_[key] = value; }
-  void setFloat(const std::string& key, float value) { values_[key] = value; }
-  void setBool(const std::string& key, bool value) { values_[key] = value; }
-  void setString(const std::string& key, std::string value) {
-    values_[key] = std::move(value);
-  }
+  void setInt(ParamKey key, int value) { assign(key, value); }
+  void setFloat(ParamKey key, float value) { assign(key, value); }
+  void setBool(ParamKey key, bool value) { assign(key, value); }
+  void setString(ParamKey key, std::string value) { assign(key, std::move(value)); }
 
-  [[nodiscard]] bool contains(const std::string& key) const {
-    return values_.find(key) != values_.end();
+  void setInt(std::string_view key, int value) { setInt(ParamKey(key), value); }
+  void setFloat(std::string_view key, float value) { setFloat(ParamKey(key), value); }
+  void setBool(std::string_view key, bool value) { setBool(ParamKey(key), value); }
+  void setString(std::string_view key, std::string value) {
+    setString(ParamKey(key), std::move(value));
   }
 
-  [[nodiscard]] int getInt(const std::string& key, int defaultValue = 0) const {
-    if (auto value = getValue<int>(key)) {
-      return *value;
-    }
-    if (auto valueFloat = getValue<float>(key)) {
-      return static_cast<int>(*valueFloat);
+  [[nodiscard]] bool contains(ParamKey key) const { return find(key) != nullptr; }
+  [[nodiscard]] bool contains(std::string_view key) const { return find(key) != nullptr; }
+
+  /** @brief First of @p aliases present in this block, in alias order. */
+  [[nodiscard]] std::optional<ParamKey> firstPresent(const ParamAliases& aliases) const {
+    for (ParamKey key : aliases.keys()) {
+      if (contains(key)) {
+        return key;
+      }
     }
-    return defaultValue;
+    return std::nullopt;
   }
 
-  [[nodiscard]] float getFloat(const std::string& key, float defaultValue = 0.0f) const {
-    if (auto value = getValue<float>(key)) {
-      return *value;
-    }
-    if (auto valueInt = getValue<int>(key)) {
-      return static_cast<float>(*valueInt);
+  [[nodiscard]] int getInt(ParamKey key, int defaultValue = 0) const {
+    return intFrom(find(key), defaultValue);
+  }
+  [[nodiscard]] int getInt(std::string_view key, int defaultValue = 0) const {
+    return intFrom(find(key), defaultValue);
+  }
+
+  [[nodiscard]] float getFloat(ParamKey key, float defaultValue = 0.0f) const {
+    return floatFrom(find(key), defaultValue);
+  }
+  [[nodiscard]] float getFloat(std::string_view key, float defaultValue = 0.0f) const {
+    return floatFrom(find(key), defaultValue);
+  }
+
+  [[nodiscard]] bool getBool(ParamKey key, bool defaultValue = false) const {
+    return boolFrom(find(key), defaultValue);
+  }
+  [[nodiscard]] bool getBool(std::string_view key, bool defaultValue = false) const {
+    return boolFrom(find(key), defaultValue);
+  }
+
+  [[nodiscard]] std::string getString(ParamKey key, std::string defaultValue = {}) const {
+    const std::string* value = findString(key);
+    return value ? *value : defaultValue;
+  }
+  [[nodiscard]] std::string getString(std::string_view key, std::string defaultValue = {}) const {
+    const Value* value = find(key);
+    const std::string* text = value ? std::get_if<std::string>(value) : nullptr;
+    return text ? *text : defaultValue;
+  }
+
+  /** @brief The stored string, or null when @p key is absent or holds another type. */
+  [[nodiscard]] const std::string* findString(ParamKey key) const {
+    const Value* value = find(key);
+    return value ? std::get_if<std::string>(value) : nullptr;
+  }
+
+ private:
+  struct Entry {
+    ParamKey key;
+    Value value;
+  };
+
+  [[nodiscard]] const Value* find(ParamKey key) const {
+    auto it = lowerBound(key);
+    return it != entries_.end() && it->key == key ? &it->value : nullptr;
+  }
+
+  [[nodiscard]] const Value* find(std::string_view key) const {
+    const std::optional<ParamKey> interned = ParamKey::lookup(key);
+    return interned ? find(*interned) : nullptr;
+  }
+
+  [[nodiscard]] std::vector<Entry>::const_iterator lowerBound(ParamKey key) const {
+    return std::lower_bound(entries_.begin(), entries_.end(), key,
+                            [](const Entry& entry, ParamKey k) { return entry.key < k; });
+  }
+
+  template <typename T>
+  void assign(ParamKey key, T&& value) {
+    auto it = entries_.begin() + (lowerBound(key) - entries_.cbegin());
+    if (it != entries_.end() && it->key == key) {
+      it->value = std::forward<T>(value);
+    } else {
+      entries_.insert(it, Entry{key, Value(std::forward<T>(value))});
     }
-    return defaultValue;
   }
 
-  [[nodiscard]] bool getBool(const std::string& key, bool defaultValue = false) const {
-    if (auto value = getValue<bool>(key)) {
-      return *value;
+  static int intFrom(const Value* value, int defaultValue) {
+    if (!value) {
+      return defaultValue;
+    }
+    if (auto asInt = std::get_if<int>(value)) {
+      return *asInt;
+    }
+    if (auto asFloat = std::get_if<float>(value)) {
+      return static_cast<int>(*asFloat);
     }
     return defaultValue;
   }
 
-  [[nodiscard]] std::string getString(const std::string& key,
-                                      std::string defaultValue = {}) const {
-    if (auto value = getValue<std::string>(key)) {
-      return *value;
+  static float floatFrom(const Value* value, float defaultValue) {
+    if (!value) {
+      return defaultValue;
+    }
+    if (auto asFloat = std::get_if<float>(value)) {
+      return *asFloat;
+    }
+    if (auto asInt = std::get_if<int>(value)) {
+      return static_cast<float>(*asInt);
     }
     return defaultValue;
   }
 
- private:
-  template <typename T>
-  [[nodiscard]] std::optional<T> getValue(const std::string& key) const {
-    auto it = values_.find(key);
-    if (it == values_.end()) {
-      return std::nullopt;
+  static bool boolFrom(const Value* value, bool defaultValue) {
+    if (!value) {
+      return defaultValue;
     }
-    if (auto value = std::get_if<T>(&it->second)) {
-      return *value;
+    if (auto asBool = std::get_if<bool>(value)) {
+      return *asBool;
     }
-    return std::nullopt;
+    return defaultValue;
   }
 
-  std::unordered_map<std::string, Value> values_;
+  std::vector<Entry> entries_;
 };
 
 }  // namespace avs::core
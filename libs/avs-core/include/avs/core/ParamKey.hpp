@@ -0,0 +1,65 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace avs::core {
+
+/**
+ * @brief Interned parameter name.
+ *
+ * Constructing a key looks the name up in a process-wide table once; after
+ * that keys compare and order by a 32-bit id. Effects keep their keys in
+ * statics so setParams() never hashes or allocates strings.
+ */
+class ParamKey {
+ public:
+  constexpr ParamKey() = default;
+
+  /** @brief Intern @p name; equal names always yield equal keys. */
+  explicit ParamKey(std::string_view name);
+
+  /** @brief Key for @p name if it has ever been interned; never inserts. */
+  [[nodiscard]] static std::optional<ParamKey> lookup(std::string_view name);
+
+  [[nodiscard]] constexpr std::uint32_t id() const { return id_; }
+  [[nodiscard]] constexpr bool valid() const { return id_ != kInvalidId; }
+
+  /** @brief The interned spelling; empty for a default-constructed key. */
+  [[nodiscard]] const std::string& name() const;
+
+  friend constexpr bool operator==(ParamKey, ParamKey) = default;
+  friend constexpr auto operator<=>(ParamKey, ParamKey) = default;
+
+ private:
+  static constexpr std::uint32_t kInvalidId = ~std::uint32_t{0};
+
+  explicit constexpr ParamKey(std::uint32_t id) : id_(id) {}
+
+  std::uint32_t id_ = kInvalidId;
+};
+
+/**
+ * @brief Ordered alternative spellings of one parameter.
+ *
+ * Presets from different eras name the same setting differently. An effect
+ * builds one of these once (typically as a function-local static) and asks
+ * ParamBlock::firstPresent() which spelling a block actually carries.
+ */
+class ParamAliases {
+ public:
+  ParamAliases(std::initializer_list<std::string_view> names);
+  explicit ParamAliases(const std::vector<std::string>& names);
+
+  [[nodiscard]] const std::vector<ParamKey>& keys() const { return keys_; }
+
+ private:
+  std::vector<ParamKey> keys_;
+};
+
+}  // namespace avs::core
@@ -1,17 +1,48 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include <avs/core/ChannelLut.hpp>
 #include <avs/core/EffectRegistry.hpp>
+#include <avs/core/FrameArena.hpp>
+#include <avs/core/FrameGovernor.hpp>
+#include <avs/core/OutputLayer.hpp>
 #include <avs/core/ParamBlock.hpp>
+#include <avs/core/Profiling.hpp>
+#include <avs/core/StateStream.hpp>
+#include <avs/core/TaskCostModel.hpp>
 #include <avs/core/ThreadPool.hpp>
 
 namespace avs::core {
 
 /**
  * @brief Ordered collection of effects executed for each frame.
+ *
+ * Consecutive local effects (see AccessPattern) are fused: the frame is cut
+ * into cache-sized row tiles and each tile runs through the whole run before
+ * the next one, instead of every effect sweeping the full framebuffer. Within
+ * a run, adjacent effects that reduce to per-channel lookup tables are
+ * composed into a single table set and applied in one pass.
+ *
+ * With more than one thread, a TaskCostModel decides per node (or fused run)
+ * and per frame size how many threads and bands are worth the dispatch, from
+ * costs calibrated on earlier frames; small frames and cheap effects render on
+ * the calling thread.
+ *
+ * Effects that leave the frame alone (OutputDependence::Nothing) are dropped
+ * from the schedule. Effects whose output is fixed by their parameters are
+ * rendered once per frame size and quality level into an OutputLayer, which
+ * later frames composite instead of calling render().
+ *
+ * With a frame budget set, a FrameGovernor watches render() times and moves
+ * every effect between quality levels to stay inside it.
+ *
+ * Unless the context already carries one, render() lends effects a FrameArena
+ * for per-frame scratch and resets it once the last effect has finished.
  */
 class Pipeline {
  public:
@@ -26,6 +57,11 @@ class Pipeline {
 
   /**
    * @brief Execute all registered effects for the given frame.
+   *
+   * The frame must be packed: context.framebuffer rows exactly context.width
+   * pixels apart, and a framebufferBackend with direct access exposing those
+   * same pixels, as createCPUFramebuffer() does unless padRows is set.
+   * Otherwise no effect runs and render() returns false.
    * @return true if every effect reported success.
    */
   bool render(RenderContext& context);
@@ -46,15 +82,136 @@ class Pipeline {
    */
   int getThreadCount() const { return threadPool_ ? threadPool_->getThreadCount() : 1; }
 
+  /**
+   * @brief Let the cost model choose threads and bands per node (the default).
+   *
+   * When off, every multi-threaded node uses the whole pool at a fixed number
+   * of bands per thread, whatever its cost.
+   */
+  void setAutoThreading(bool enabled) { autoThreading_ = enabled; }
+
+  bool autoThreading() const { return autoThreading_; }
+
+  /** @brief Calibrated costs behind the threading decisions. */
+  const TaskCostModel& costModel() const { return costModel_; }
+
+  /**
+   * @brief Turn per-node timing on or off. Enabling starts from empty statistics.
+   *
+   * While disabled, render() takes no timestamps.
+   */
+  void setProfilingEnabled(bool enabled);
+
+  bool profilingEnabled() const { return profiler_ != nullptr; }
+
+  /**
+   * @brief Rolling per-node and per-frame timings; empty when profiling is disabled.
+   *
+   * Nodes in a fused run share the run's wall time in proportion to the time
+   * each spent in its own begin, tiles and finish. Threads, tasks and the cost
+   * estimate record the last threading decision. Serialize with toJson().
+   */
+  PipelineProfile profile() const;
+
+  /**
+   * @brief Adapt effect quality to keep render() under @p targetMs.
+   *
+   * 0 or less turns adaptation off and, unless a level is locked, restores full quality.
+   */
+  void setFrameBudget(double targetMs);
+
+  /** @brief Render every frame at @p level, ignoring the frame budget. */
+  void lockQualityLevel(int level);
+
+  /** @brief Let the frame budget drive the quality level again. */
+  void unlockQualityLevel();
+
+  /** @brief Level effects are currently rendering at. */
+  int qualityLevel() const { return governor_.level(); }
+
+  /**
+   * @brief Checkpoint the temporal state of every effect (see IEffect::saveState()).
+   *
+   * The checkpoint records each node's key, so it restores only into a chain
+   * built from the same preset. Frame index, time and the GlobalState behind
+   * RenderContext::globals belong to the caller, who saves them alongside.
+   */
+  std::vector<std::uint8_t> saveState() const;
+
+  /**
+   * @brief Return every effect to the state in @p checkpoint, between frames.
+   *
+   * All or nothing: when the checkpoint does not match the chain or an effect
+   * rejects its data, the effects keep the state they had and this returns false.
+   */
+  bool restoreState(const std::vector<std::uint8_t>& checkpoint);
+
  private:
   struct Node {
     std::string key;
     ParamBlock params;
     std::unique_ptr<IEffect> effect;
+    OutputDependence dependence = OutputDependence::Frame;
+    std::unique_ptr<OutputLayer> layer;  ///< Memoized output of a Params node.
+    bool layerRejected = false;          ///< Capture showed the effect blends; never cache it.
+  };
+
+  /** Rebuild schedule_ and every node's dependence, e.g. after a quality change. */
+  void rebuildSchedule();
+  /** Whether the node at schedule @p position can join a fused run as @p kind. */
+  bool isLocal(std::size_t position, AccessPattern::Kind kind) const;
+  /** One past the last schedule position of the fused run starting at @p first. */
+  std::size_t fusedRunEnd(std::size_t first) const;
+  bool renderFused(std::size_t first, std::size_t last, RenderContext& context);
+  bool renderNode(std::size_t index, RenderContext& context, PipelineProfiler::Sample* sample);
+  /** Composite @p node's layer, capturing it first if stale; false to render normally. */
+  bool renderCached(Node& node, RenderContext& context);
+  void recordFusedRun(double runMs, int threads, int tiles, std::size_t pixelCount,
+                      double nsPerPixel);
+  /** Threads and bands for @p node over @p pixels, from the cost model unless auto threading is off. */
+  TaskCostModel::Decision planThreads(std::size_t node, std::size_t pixels) const;
+  /** Feed one render of @p node to the cost model; per-worker task time is in workerMs_. */
+  void calibrate(std::size_t node, std::size_t pixels, double serialMs, double dispatchMs);
+  /** True when renders are timed for the cost model. */
+  bool calibrating() const {
+    return autoThreading_ && threadPool_ && threadPool_->isMultiThreaded();
+  }
+  /** Check @p checkpoint against the chain and split it into one section per node. */
+  bool readCheckpoint(const std::vector<std::uint8_t>& checkpoint,
+                      std::vector<StateReader>& sections) const;
+  /** Hand each node its section; false as soon as one does not take it whole. */
+  bool restoreEffects(std::vector<StateReader>& sections);
+  /** Push the governor's level to every effect if it changed. */
+  void applyQualityLevel();
+
+  /** One member of a fused run: an effect's bands, or a collapsed LUT group. */
+  struct RunStep {
+    IEffect* effect = nullptr;  ///< Null for a LUT group.
+    int bands = 0;
+    std::size_t lut = 0;  ///< Index into runLuts_ when effect is null.
+    std::size_t node = 0;       ///< Schedule position of the first node covered by this step.
+    std::size_t nodeCount = 1;  ///< Nodes covered; more than one only for LUT groups.
+    bool preservesBlack = false;  ///< Black input pixels stay black this frame.
   };
 
   EffectRegistry& registry_;
   std::vector<Node> nodes_;
+  std::vector<std::size_t> schedule_;  ///< Indices of the nodes render() runs, in order.
+  std::vector<RunStep> runSteps_;
+  std::vector<ChannelLut> runLuts_;
+  ChannelLut lutScratch_;
+  FrameArena arena_;  ///< Lent to effects through RenderContext::arena during render().
+
+  std::unique_ptr<PipelineProfiler> profiler_;
+  std::vector<double> stepMs_;      ///< Per-step time of the fused run being profiled.
+  std::vector<double> tileStepMs_;  ///< Per-worker, per-step tile time, worker-major.
+
+  TaskCostModel costModel_;
+  bool autoThreading_ = true;
+  std::vector<double> workerMs_;  ///< Per-worker task time of the render being calibrated.
+
+  FrameGovernor governor_{FrameGovernor::Config{0.0}};
+  int appliedQuality_ = kMaxQualityLevel;  ///< Level last pushed to the effects.
   std::unique_ptr<ThreadPool> threadPool_;
 };
 
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace avs::core {
+
+/**
+ * @brief Fixed-size rolling window of samples with percentile queries.
+ *
+ * Holds the most recent `capacity` samples; older ones are overwritten.
+ */
+class RollingHistogram {
+ public:
+  static constexpr std::size_t kDefaultCapacity = 600;
+
+  explicit RollingHistogram(std::size_t capacity = kDefaultCapacity);
+
+  void add(double value);
+  void clear();
+
+  /** @brief Number of samples currently in the window. */
+  std::size_t size() const { return filled_ ? samples_.size() : next_; }
+
+  /**
+   * @brief Nearest-rank percentile of the window.
+   * @param percent Value in [0, 100].
+   * @return 0 when the window is empty.
+   */
+  double percentile(double percent) const;
+
+ private:
+  std::vector<double> samples_;
+  std::size_t next_ = 0;
+  bool filled_ = false;
+  mutable std::vector<double> scratch_;
+};
+
+/**
+ * @brief Aggregated timings for one pipeline node.
+ *
+ * Percentiles cover the rolling window; the `last*` fields describe the most
+ * recent frame the node was part of.
+ */
+struct NodeProfile {
+  std::string key;
+  std::uint64_t frames = 0;
+  double p50Ms = 0.0;
+  double p95Ms = 0.0;
+  double p99Ms = 0.0;
+  double lastMs = 0.0;
+  int lastThreads = 1;
+  /** Bands or tiles the frame was cut into; 1 when rendered whole. */
+  int lastTasks = 1;
+  std::uint64_t lastPixels = 0;
+  bool lastSmp = false;
+  bool lastFused = false;
+  /** Composited from the node's cached OutputLayer instead of rendered. */
+  bool lastCached = false;
+  /** Fraction of recorded frames rendered through the SMP path. */
+  double smpFraction = 0.0;
+  /**
+   * Calibrated cost per pixel behind the last threading decision; for fused
+   * nodes, the cost of the whole run. 0 while uncalibrated.
+   */
+  double costNsPerPixel = 0.0;
+};
+
+/**
+ * @brief Snapshot of pipeline timings returned by Pipeline::profile().
+ */
+struct PipelineProfile {
+  std::uint64_t frames = 0;
+  double frameP50Ms = 0.0;
+  double frameP95Ms = 0.0;
+  double frameP99Ms = 0.0;
+  /** Calibrated overhead of one thread pool dispatch, in microseconds. */
+  double dispatchUs = 0.0;
+  std::vector<NodeProfile> nodes;
+};
+
+/** @brief Serialize a profile snapshot as a JSON document. */
+std::string toJson(const PipelineProfile& profile);
+
+/**
+ * @brief Per-node and per-frame sample recorder used by Pipeline.
+ *
+ * Only exists while profiling is enabled, so a disabled pipeline pays a single
+ * null check per node.
+ */
+class PipelineProfiler {
+ public:
+  struct Sample {
+    double ms = 0.0;
+    int threads = 1;
+    int tasks = 1;
+    std::uint64_t pixels = 0;
+    double nsPerPixel = 0.0;
+    bool smp = false;
+    bool fused = false;
+    bool cached = false;
+  };
+
+  void recordNode(std::size_t node, const Sample& sample);
+  void recordFrame(double ms);
+
+  /** @brief Build a snapshot; @p keys names the nodes in pipeline order. */
+  PipelineProfile snapshot(const std::vector<std::string>& keys) const;
+
+ private:
+  struct NodeStats {
+    RollingHistogram histogram;
+    std::uint64_t frames = 0;
+    std::uint64_t smpFrames = 0;
+    Sample last;
+  };
+
+  std::vector<NodeStats> nodes_;
+  RollingHistogram frameHistogram_;
+  std::uint64_t frames_ = 0;
+};
+
+}  // namespace avs::core
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <algorithm>
+
+namespace avs::core {
+
+/**
+ * @brief Render quality levels shared by effects and the frame governor.
+ *
+ * Level kMaxQualityLevel is the reference output; every step down trades
+ * fidelity for frame time (smaller blur radii, coarser warp grids, fewer
+ * scope points). Effects without a cheaper mode ignore the level.
+ */
+inline constexpr int kMinQualityLevel = 0;
+inline constexpr int kMaxQualityLevel = 3;
+
+constexpr int clampQualityLevel(int level) {
+  return std::clamp(level, kMinQualityLevel, kMaxQualityLevel);
+}
+
+}  // namespace avs::core
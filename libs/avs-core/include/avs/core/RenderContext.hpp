@@ -1,9 +1,11 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 
 #include <avs/core/DeterministicRng.hpp>
+#include <avs/core/DirtyRect.hpp>
 
 namespace avs::runtime {
 struct GlobalState;
@@ -15,14 +17,57 @@ struct Analysis;
 
 namespace avs::core {
 
+class FrameArena;
 class IFramebuffer;
 
 /**
- * @brief View into a mutable pixel buffer.
+ * @brief View into a mutable RGBA pixel buffer.
+ *
+ * Rows are @ref rowStride() bytes apart, which may exceed `width * 4` when the
+ * owner pads rows (see alignedRowStride()) or when the view is a sub-rectangle
+ * of a wider buffer. Views built from just `{data, size}` leave stride at 0,
+ * meaning rows are packed; their geometry comes from RenderContext.
  */
 struct PixelBufferView {
   std::uint8_t* data = nullptr;
   std::size_t size = 0;
+  std::size_t stride = 0;  ///< Bytes between row starts; 0 means packed.
+  int width = 0;
+  int height = 0;
+
+  [[nodiscard]] std::size_t rowStride() const {
+    return stride != 0 ? stride : static_cast<std::size_t>(width) * 4u;
+  }
+
+  /** @brief True when rows follow each other without padding. */
+  [[nodiscard]] bool packed() const { return rowStride() == static_cast<std::size_t>(width) * 4u; }
+
+  [[nodiscard]] std::uint8_t* row(int y) const {
+    return data + static_cast<std::size_t>(y) * rowStride();
+  }
+
+  /**
+   * @brief View of the @p w x @p h rectangle at (@p x, @p y), sharing this buffer.
+   *
+   * The rectangle is clipped to the view; an empty intersection yields an empty view.
+   */
+  [[nodiscard]] PixelBufferView subView(int x, int y, int w, int h) const {
+    const int x0 = std::clamp(x, 0, width);
+    const int y0 = std::clamp(y, 0, height);
+    const int x1 = std::clamp(x + std::max(w, 0), x0, width);
+    const int y1 = std::clamp(y + std::max(h, 0), y0, height);
+    if (!data || x1 == x0 || y1 == y0) {
+      return {};
+    }
+    PixelBufferView view;
+    view.stride = rowStride();
+    view.width = x1 - x0;
+    view.height = y1 - y0;
+    view.data = row(y0) + static_cast<std::size_t>(x0) * 4u;
+    view.size = static_cast<std::size_t>(view.height - 1) * view.stride +
+                static_cast<std::size_t>(view.width) * 4u;
+    return view;
+  }
 };
 
 /**
@@ -38,7 +83,8 @@ struct AudioBufferView {
  *
  * @note Modern effects should prefer using `framebufferBackend` over the legacy
  *       `framebuffer` view. The backend provides additional functionality like
- *       upload/download, resize, and backend-specific optimizations.
+ *       upload/download, resize, and backend-specific optimizations. Its rows
+ *       may be padded, so reach its pixels through view() and row().
  */
 struct RenderContext {
   std::uint64_t frameIndex = 0;
@@ -58,8 +104,11 @@ struct RenderContext {
   /**
    * @brief Legacy pixel buffer view (deprecated, use framebufferBackend).
    *
-   * Maintained for backward compatibility. New effects should use
-   * framebufferBackend->data() instead of framebuffer.data directly.
+   * Maintained for backward compatibility. New effects should walk
+   * framebufferBackend->view() row by row through row() instead of indexing
+   * framebuffer.data directly; the backend's data() may be padded and is not
+   * safe to index as `y * width * 4`. Pipeline::render() only accepts packed
+   * frames, where both describe the same pixels.
    */
   PixelBufferView framebuffer;
 
@@ -68,6 +117,32 @@ struct RenderContext {
   const avs::audio::Analysis* audioAnalysis = nullptr;
   avs::runtime::GlobalState* globals = nullptr;
   DeterministicRng rng;
+
+  /**
+   * @brief Scratch memory released when the frame ends (optional).
+   *
+   * Pipeline::render() supplies its own arena when this is null. Effects should
+   * fetch transient buffers through frameScratch() so they still work without one.
+   */
+  FrameArena* arena = nullptr;
+
+  /**
+   * @brief Region that may be non-black before this effect runs.
+   *
+   * Pipeline narrows it as effects report what they wrote; outside the pipeline
+   * it stays unbounded. Effects may use it to skip work on black areas.
+   */
+  DirtyRect dirtyIn;
+
+  /**
+   * @brief Region that may be non-black after this effect runs.
+   *
+   * Pipeline presets it before each effect: to dirtyIn for effects that keep
+   * black at black (IEffect::preservesBlack()), otherwise to unbounded. Effects
+   * that clear the frame or draw only small shapes may tighten it, e.g. set it to
+   * dirtyIn and then include() every pixel they write.
+   */
+  DirtyRect dirtyOut;
 };
 
 }  // namespace avs::core
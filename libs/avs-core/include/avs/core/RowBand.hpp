@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace avs::core {
+
+/**
+ * @brief Half-open range of framebuffer rows assigned to one render thread.
+ */
+struct RowBand {
+  int begin = 0;
+  int end = 0;
+
+  [[nodiscard]] bool empty() const { return end <= begin; }
+};
+
+/**
+ * @brief Half-open range of pixel indices assigned to one render thread.
+ */
+struct PixelSpan {
+  std::size_t begin = 0;
+  std::size_t end = 0;
+
+  [[nodiscard]] bool empty() const { return end <= begin; }
+};
+
+/**
+ * @brief Split @p height rows into @p maxThreads contiguous bands.
+ *
+ * Bands differ in size by at most one row and are ordered by thread id, so the
+ * union over all threads covers [0, height) exactly once.
+ */
+[[nodiscard]] inline RowBand rowBand(int height, int threadId, int maxThreads) {
+  if (height <= 0 || maxThreads <= 0 || threadId < 0 || threadId >= maxThreads) {
+    return {};
+  }
+  const int base = height / maxThreads;
+  const int extra = height % maxThreads;
+  const int begin = threadId * base + std::min(threadId, extra);
+  const int end = begin + base + (threadId < extra ? 1 : 0);
+  return {begin, end};
+}
+
+/**
+ * @brief Row-aligned slice of a packed pixel array for one render thread.
+ *
+ * The last band also absorbs pixels past width * height so effects that walk
+ * the whole buffer keep touching every pixel they did single-threaded. A single
+ * band always covers [0, pixelCount), whatever the frame geometry.
+ */
+[[nodiscard]] inline PixelSpan rowBandPixels(std::size_t pixelCount,
+                                             int width,
+                                             int height,
+                                             int threadId,
+                                             int maxThreads) {
+  if (maxThreads == 1 && threadId == 0) {
+    return {0, pixelCount};
+  }
+  if (width <= 0 || height <= 0 || maxThreads <= 0 || threadId < 0 || threadId >= maxThreads) {
+    return {};
+  }
+  const RowBand band = rowBand(height, threadId, maxThreads);
+  const std::size_t stride = static_cast<std::size_t>(width);
+  const std::size_t begin = std::min(pixelCount, static_cast<std::size_t>(band.begin) * stride);
+  const std::size_t end = threadId == maxThreads - 1
+                              ? pixelCount
+                              : std::min(pixelCount, static_cast<std::size_t>(band.end) * stride);
+  return {begin, std::max(begin, end)};
+}
+
+/**
+ * @brief Row band plus the neighbouring rows a filter samples around it.
+ *
+ * Neighbourhood filters snapshot their source in smp_begin(). Each band then
+ * writes only `rows` and reads only `source` of that snapshot: `rows` widened
+ * by the halo on both sides and clamped to the frame.
+ */
+struct HaloBand {
+  RowBand rows;
+  RowBand source;
+};
+
+/** @brief Halo value for filters whose bands may sample any source row. */
+inline constexpr int kWholeFrameHalo = -1;
+
+/**
+ * @brief rowBand() widened by @p haloRows source rows above and below.
+ *
+ * Pass kWholeFrameHalo (or any negative halo) for filters such as mosaic that
+ * sample arbitrary rows.
+ */
+[[nodiscard]] inline HaloBand haloBand(int height, int threadId, int maxThreads, int haloRows) {
+  HaloBand band;
+  band.rows = rowBand(height, threadId, maxThreads);
+  if (band.rows.empty()) {
+    return band;
+  }
+  if (haloRows < 0) {
+    band.source = {0, height};
+    return band;
+  }
+  band.source.begin = std::max(0, band.rows.begin - haloRows);
+  band.source.end = std::min(height, band.rows.end + haloRows);
+  return band;
+}
+
+}  // namespace avs::core
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace avs::core {
+
+/**
+ * @brief Appends values to a checkpoint in a compact, portable binary form.
+ *
+ * Integers are LEB128 varints (signed ones zigzag-encoded), floats are their
+ * IEEE bits in little-endian order and byte blobs carry a varint length, so a
+ * checkpoint reads back identically on any host. The format has no field
+ * tags: a reader must ask for the same values in the same order.
+ */
+class StateWriter {
+ public:
+  void writeBool(bool value) { bytes_.push_back(value ? 1u : 0u); }
+  void writeU8(std::uint8_t value) { bytes_.push_back(value); }
+  void writeVarUint(std::uint64_t value);
+  void writeVarInt(std::int64_t value);
+  void writeF32(float value);
+  void writeF64(double value);
+  /** @brief Length-prefixed bytes. */
+  void writeBytes(const void* data, std::size_t size);
+  void writeString(std::string_view text) { writeBytes(text.data(), text.size()); }
+
+  const std::vector<std::uint8_t>& data() const { return bytes_; }
+  std::vector<std::uint8_t> take() { return std::move(bytes_); }
+
+ private:
+  std::vector<std::uint8_t> bytes_;
+};
+
+/**
+ * @brief Reads values written by StateWriter.
+ *
+ * Running past the end or meeting a malformed value marks the reader failed;
+ * from then on every read returns zero or empty, so callers read a whole
+ * record and check ok() once.
+ */
+class StateReader {
+ public:
+  StateReader(const std::uint8_t* data, std::size_t size) : data_(data), size_(size) {}
+  explicit StateReader(const std::vector<std::uint8_t>& bytes)
+      : StateReader(bytes.data(), bytes.size()) {}
+
+  bool readBool();
+  std::uint8_t readU8();
+  std::uint64_t readVarUint();
+  std::int64_t readVarInt();
+  float readF32();
+  double readF64();
+  /** @brief A varint count, failing when it exceeds @p limit. */
+  std::size_t readSize(std::size_t limit);
+  /** @brief Length-prefixed bytes, replacing the contents of @p out. */
+  bool readBytes(std::vector<std::uint8_t>& out);
+  /** @brief Length-prefixed bytes into @p out, failing unless exactly @p size were written. */
+  bool readBytes(void* out, std::size_t size);
+  std::string readString();
+  /** @brief Length-prefixed bytes as a reader of their own, without copying them. */
+  StateReader readSection();
+
+  /** @brief Mark the data as unusable, e.g. when a value is out of range. */
+  void fail() { failed_ = true; }
+  bool ok() const { return !failed_; }
+  bool atEnd() const { return position_ == size_; }
+  std::size_t remaining() const { return size_ - position_; }
+
+ private:
+  /** Start of the next @p count bytes, or null after marking the reader failed. */
+  const std::uint8_t* take(std::size_t count);
+
+  const std::uint8_t* data_ = nullptr;
+  std::size_t size_ = 0;
+  std::size_t position_ = 0;
+  bool failed_ = false;
+};
+
+}  // namespace avs::core
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace avs::core {
+
+/**
+ * @brief Decides how many threads and tasks a pipeline node is worth.
+ *
+ * Each node's cost per pixel is calibrated from its own renders and kept per
+ * frame size, since cache footprint shifts it. The dispatch overhead of the
+ * pool, the wake-up and barrier that every threaded node pays, is calibrated
+ * from threaded runs. A node is threaded only when every thread gets more work
+ * than a dispatch costs, and each task covers at least
+ * Config::minPixelsPerTask pixels, so small frames and cheap effects stay on
+ * the calling thread.
+ *
+ * A node with no estimate at any frame size renders serially, which is also
+ * its calibration run.
+ */
+class TaskCostModel {
+ public:
+  struct Config {
+    /** Smallest slice of the frame worth handing to a task. */
+    std::size_t minPixelsPerTask = 4096;
+    /** Smallest amount of work, in microseconds, worth handing to a task. */
+    double minTaskUs = 20.0;
+    /** Dispatch overhead assumed until a threaded run has measured it. */
+    double initialDispatchUs = 30.0;
+    /** Tasks per thread when work allows, so idle workers can steal. */
+    int tasksPerThread = 4;
+  };
+
+  struct Decision {
+    /** Threads to run on; 1 renders on the calling thread. */
+    int threads = 1;
+    /** Bands or tiles to cut the frame into. */
+    int tasks = 1;
+    /** Estimate the decision was based on; 0 while uncalibrated. */
+    double nsPerPixel = 0.0;
+  };
+
+  TaskCostModel();
+  explicit TaskCostModel(const Config& config);
+
+  /** @brief Plan @p node over a frame of @p pixels on a pool of @p poolThreads. */
+  Decision decide(std::size_t node, std::size_t pixels, int poolThreads) const;
+
+  /**
+   * @brief Record @p workUs of work, summed over every thread, for @p node over
+   * a frame of @p pixels.
+   */
+  void observeWork(std::size_t node, std::size_t pixels, double workUs);
+
+  /** @brief Record the time a threaded dispatch spent beyond its busiest worker. */
+  void observeDispatch(double overheadUs);
+
+  /**
+   * @brief Cost estimate for @p node at @p pixels.
+   *
+   * Falls back to the node's most recent estimate at another size, or 0.
+   */
+  double nsPerPixel(std::size_t node, std::size_t pixels) const;
+
+  double dispatchUs() const { return dispatchUs_; }
+
+  /** @brief Forget every node estimate; the dispatch estimate is kept. */
+  void clear() { nodes_.clear(); }
+
+  const Config& config() const { return config_; }
+
+ private:
+  static constexpr std::size_t kSizesPerNode = 4;
+
+  struct Estimate {
+    std::size_t pixels = 0;
+    double nsPerPixel = 0.0;
+    std::uint64_t lastUse = 0;  ///< NodeCost::uses when last observed; 0 for an empty slot.
+  };
+
+  struct NodeCost {
+    std::array<Estimate, kSizesPerNode> sizes{};
+    std::size_t latest = kSizesPerNode;  ///< Most recently updated slot.
+    std::uint64_t uses = 0;              ///< Observations so far, ordering the slots by recency.
+  };
+
+  Config config_;
+  std::vector<NodeCost> nodes_;
+  double dispatchUs_ = 0.0;
+};
+
+}  // namespace avs::core
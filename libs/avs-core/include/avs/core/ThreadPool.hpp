@@ -2,71 +2,158 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
+#include <avs/thread_placement.hpp>
+
 namespace avs::core {
 
 /**
- * @brief Simple thread pool for parallel effect rendering.
+ * @brief Work-stealing thread pool for parallel effect rendering.
+ *
+ * The calling thread takes part in every dispatch as worker 0, so a pool of
+ * N threads runs N - 1 background workers. Tasks are integer indices handed
+ * out through per-worker range deques: each worker pops from the front of its
+ * own range and steals the back half of a busy worker's range once it runs
+ * dry, which keeps cores busy when per-row cost is uneven (superscopes,
+ * sparse particles, clipped rotations).
+ *
+ * Idle workers spin briefly on their own wake-up counter before parking on it,
+ * so a dispatch signals only the workers it uses, and the dispatch itself
+ * never allocates.
  *
- * This thread pool is designed specifically for the AVS rendering pipeline,
- * where work is distributed across scanlines or pixel rows.
+ * Workers can be placed on specific CPUs and scheduling classes: worker i is
+ * pinned to cpus[i % cpus.size()] of the placement, so each stays on one core
+ * and keeps its cache, while the dispatching thread (worker 0) is left to the
+ * caller to place.
  */
 class ThreadPool {
  public:
   /**
    * @brief Construct a thread pool with the specified number of threads.
    *
-   * @param numThreads Number of worker threads (0 or 1 = single-threaded)
+   * @param numThreads Number of threads including the caller (0 or 1 = single-threaded)
+   * @param placement CPUs and priority for the background workers; the
+   *        constructor returns once every worker has applied it
    */
-  explicit ThreadPool(int numThreads);
+  explicit ThreadPool(int numThreads, const ThreadPlacement& placement = {});
 
   /**
    * @brief Destructor - waits for all threads to complete.
    */
   ~ThreadPool();
 
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * @brief Run @p taskCount tasks across the pool and wait for all of them.
+   *
+   * @p fn is invoked as fn(taskIndex, workerIndex) exactly once per task index
+   * in [0, taskCount). workerIndex is in [0, getThreadCount()) and identifies
+   * the executing thread, so it may index per-thread scratch. @p fn is called
+   * through a reference and must stay valid until parallelFor() returns, which
+   * it always does because the call blocks.
+   */
+  template <typename Fn>
+  void parallelFor(int taskCount, Fn&& fn) {
+    parallelFor(taskCount, workerCount_, fn);
+  }
+
+  /**
+   * @brief parallelFor() on at most @p maxWorkers threads, the caller included.
+   *
+   * Workers past the limit are not woken and sit the dispatch out, so a small
+   * job neither waits on them at the barrier nor spreads its working set over
+   * their caches.
+   */
+  template <typename Fn>
+  void parallelFor(int taskCount, int maxWorkers, Fn&& fn) {
+    using Callable = std::remove_reference_t<Fn>;
+    TaskRef task;
+    task.object = const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+    task.invoke = [](void* object, int taskIndex, int workerIndex) {
+      (*static_cast<Callable*>(object))(taskIndex, workerIndex);
+    };
+    run(taskCount, maxWorkers, task);
+  }
+
   /**
    * @brief Execute a task in parallel across all threads.
    *
-   * The task function will be called once per thread with the thread ID
-   * (0-indexed) and the total number of threads as arguments.
+   * Compatibility shim over parallelFor(): the task is called once per thread
+   * ID (0-indexed) with the total number of threads, as before. IDs are
+   * scheduled like any other task, so two IDs may run on the same thread.
    *
-   * This method blocks until all threads have completed the task.
+   * This method blocks until every ID has completed.
    *
    * @param task Function to execute: (threadId, maxThreads) -> void
    */
   void execute(std::function<void(int, int)> task);
 
   /**
-   * @brief Get the number of threads in this pool.
+   * @brief Get the number of threads in this pool, including the caller.
    *
    * @return Number of worker threads
    */
-  int getThreadCount() const { return static_cast<int>(threads_.size()); }
+  int getThreadCount() const { return workerCount_; }
 
   /**
    * @brief Check if the pool is multi-threaded.
    *
    * @return true if thread count > 1, false otherwise
    */
-  bool isMultiThreaded() const { return threads_.size() > 1; }
+  bool isMultiThreaded() const { return workerCount_ > 1; }
+
+  /**
+   * @brief Where each background worker ended up, for workers 1..N-1.
+   *
+   * Empty unless a placement was given to the constructor.
+   */
+  const std::vector<ThreadPlacementReport>& workerPlacements() const { return placements_; }
 
  private:
-  void workerLoop(int threadId);
+  /** Non-owning type-erased reference to the callable of the running dispatch. */
+  struct TaskRef {
+    void* object = nullptr;
+    void (*invoke)(void*, int, int) = nullptr;
+  };
+
+  /**
+   * Task range [begin, end) packed into one word so pops and steals are single
+   * CASes, next to the counter the dispatcher bumps to wake the owning worker.
+   */
+  struct alignas(64) WorkQueue {
+    std::atomic<std::uint64_t> range{0};
+    std::atomic<std::uint32_t> wake{0};
+  };
+
+  void run(int taskCount, int maxWorkers, TaskRef task);
+  void workerLoop(int workerIndex);
+  void drain(int workerIndex);
+  bool popLocal(int workerIndex, int& taskIndex);
+  bool steal(int workerIndex);
+  void waitForWorkers(int expected);
 
+  int workerCount_ = 1;
   std::vector<std::thread> threads_;
-  std::function<void(int, int)> currentTask_;
+  std::vector<ThreadPlacementReport> placements_;
+  std::unique_ptr<WorkQueue[]> queues_;
+
+  TaskRef task_;
+  std::atomic<int> activeWorkers_{0};  ///< Workers taking part in the current dispatch.
+  std::atomic<int> finishedWorkers_{0};
+  std::atomic<bool> dispatcherParked_{false};
+  std::atomic<bool> shutdown_{false};
+
   std::mutex mutex_;
-  std::condition_variable taskReady_;
   std::condition_variable taskComplete_;
-  std::atomic<bool> shutdown_{false};
-  std::atomic<int> activeWorkers_{0};
-  std::atomic<int> completedWorkers_{0};
-  bool hasTask_{false};
 };
 
 }  // namespace avs::core
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+#include <avs/core/DeterministicRng.hpp>
+
+namespace avs::core {
+
+/**
+ * @brief Preset transition styles, numbered as in the original AVS list.
+ */
+enum class TransitionMode : std::uint8_t {
+  kRandom = 0,
+  kCrossDissolve,
+  kLeftRightPush,
+  kRightLeftPush,
+  kTopBottomPush,
+  kBottomTopPush,
+  kNineRandomBlocks,
+  kSplitLeftRightPush,
+  kLeftRightToCenterPush,
+  kLeftRightToCenterSqueeze,
+  kLeftRightWipe,
+  kRightLeftWipe,
+  kTopBottomWipe,
+  kBottomTopWipe,
+  kDotDissolve,
+};
+
+inline constexpr int kTransitionModeCount = 15;
+
+/**
+ * @brief Two equally sized, packed RGBA frames and the frame blended from them.
+ */
+struct TransitionFrames {
+  const std::uint8_t* from = nullptr;  ///< Shown at progress 0 (outgoing).
+  const std::uint8_t* to = nullptr;    ///< Grows in as progress rises (incoming).
+  std::uint8_t* dst = nullptr;
+  int width = 0;
+  int height = 0;
+};
+
+/**
+ * @brief Composite @p frames with @p mode at @p progress in [0, 1].
+ *
+ * Shared by the TransitionEffect and the compat engine's preset crossfades.
+ * Progress is eased with a sine S-curve. Nine Random Blocks reveals blocks
+ * drawn from @p rng and remembers them in @p blockMask, which must be 0 when a
+ * transition starts; the other modes leave both untouched. Random falls back
+ * to the cross dissolve.
+ */
+void compositeTransition(TransitionMode mode, const TransitionFrames& frames, float progress,
+                         std::uint32_t& blockMask, DeterministicRng& rng);
+
+}  // namespace avs::core
@@ -1,4 +1,5 @@
 #include "avs/core/IFramebuffer.hpp"
+#include "avs/core/AlignedBuffer.hpp"
 #include <algorithm>
 #include <cstring>
 #include <stdexcept>
@@ -10,11 +11,12 @@ namespace {
 
 class CPUFramebuffer : public IFramebuffer {
 public:
-  CPUFramebuffer(int width, int height) : width_(width), height_(height) {
+  CPUFramebuffer(int width, int height, bool padRows)
+      : width_(width), height_(height), padRows_(padRows) {
     if (width <= 0 || height <= 0) {
       throw std::invalid_argument("CPUFramebuffer: invalid dimensions");
     }
-    pixels_.resize(width * height * 4, 0);
+    allocate();
   }
 
   int width() const override { return width_; }
@@ -24,25 +26,38 @@ public:
   const uint8_t* data() const override { return pixels_.data(); }
 
   size_t sizeBytes() const override { return pixels_.size(); }
+  size_t stride() const override { return stride_; }
 
   void upload(const uint8_t* sourceData, size_t numBytes) override {
     if (!sourceData) {
       throw std::invalid_argument("CPUFramebuffer::upload: null source data");
     }
-    if (numBytes != pixels_.size()) {
+    if (numBytes == pixels_.size()) {
+      std::memcpy(pixels_.data(), sourceData, numBytes);
+    } else if (numBytes == packedBytes()) {
+      const size_t rowBytes = static_cast<size_t>(width_) * 4;
+      for (int y = 0; y < height_; ++y) {
+        std::memcpy(pixels_.data() + y * stride_, sourceData + y * rowBytes, rowBytes);
+      }
+    } else {
       throw std::invalid_argument("CPUFramebuffer::upload: size mismatch");
     }
-    std::memcpy(pixels_.data(), sourceData, numBytes);
   }
 
   void download(uint8_t* destData, size_t numBytes) const override {
     if (!destData) {
       throw std::invalid_argument("CPUFramebuffer::download: null destination");
     }
-    if (numBytes != pixels_.size()) {
+    if (numBytes == pixels_.size()) {
+      std::memcpy(destData, pixels_.data(), numBytes);
+    } else if (numBytes == packedBytes()) {
+      const size_t rowBytes = static_cast<size_t>(width_) * 4;
+      for (int y = 0; y < height_; ++y) {
+        std::memcpy(destData + y * rowBytes, pixels_.data() + y * stride_, rowBytes);
+      }
+    } else {
       throw std::invalid_argument("CPUFramebuffer::download: size mismatch");
     }
-    std::memcpy(destData, pixels_.data(), numBytes);
   }
 
   void present() override {
@@ -55,10 +70,11 @@ public:
                           (static_cast<uint32_t>(b) << 16) |
                           (static_cast<uint32_t>(g) << 8) |
                           static_cast<uint32_t>(r);
+    // Padding is filled too; stride_ is a multiple of 4 and this keeps the loop flat.
     uint32_t* pixels32 = reinterpret_cast<uint32_t*>(pixels_.data());
-    const int totalPixels = width_ * height_;
+    const size_t totalWords = pixels_.size() / 4;
 
-    for (int i = 0; i < totalPixels; ++i) {
+    for (size_t i = 0; i < totalWords; ++i) {
       pixels32[i] = color;
     }
   }
@@ -70,7 +86,7 @@ public:
 
     width_ = newWidth;
     height_ = newHeight;
-    pixels_.resize(width_ * height_ * 4, 0);
+    allocate();
   }
 
   bool supportsDirectAccess() const override { return true; }
@@ -78,15 +94,24 @@ public:
   const char* backendName() const override { return "CPU"; }
 
 private:
+  size_t packedBytes() const { return static_cast<size_t>(width_) * height_ * 4; }
+
+  void allocate() {
+    stride_ = padRows_ ? alignedRowStride(width_) : static_cast<size_t>(width_) * 4;
+    pixels_.assign(stride_ * height_, 0);
+  }
+
   int width_;
   int height_;
-  std::vector<uint8_t> pixels_;
+  bool padRows_;
+  size_t stride_ = 0;
+  AlignedBytes pixels_;
 };
 
 }  // namespace
 
-std::unique_ptr<IFramebuffer> createCPUFramebuffer(int width, int height) {
-  return std::make_unique<CPUFramebuffer>(width, height);
+std::unique_ptr<IFramebuffer> createCPUFramebuffer(int width, int height, bool padRows) {
+  return std::make_unique<CPUFramebuffer>(width, height, padRows);
 }
 
 }  // namespace core
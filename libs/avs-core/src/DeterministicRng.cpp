@@ -20,6 +20,14 @@ std::uint64_t readSeedFromEnv() {
   return static_cast<std::uint64_t>(parsed);
 }
 
+// SplitMix64 finalizer; spreads small indices over all 64 bits.
+std::uint64_t mix64(std::uint64_t z) {
+  z += 0x9E3779B97F4A7C15ull;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
 }  // namespace
 
 namespace avs::core {
@@ -30,15 +38,23 @@ DeterministicRng::DeterministicRng(std::uint64_t seed) : baseSeed_(seed) {
   reseed(0);
 }
 
-void DeterministicRng::reseed(std::uint64_t frameIndex) {
+void DeterministicRng::reseed(std::uint64_t frameIndex, std::uint64_t effectIndex) {
   std::uint64_t combined = baseSeed_ ^ (frameIndex + 0x9E3779B97F4A7C15ull);
+  if (effectIndex != 0) {
+    combined ^= mix64(effectIndex);
+  }
   engine_.seed(static_cast<std::mt19937::result_type>(combined));
+  streamKey_ = mix64(combined);
 }
 
 std::uint32_t DeterministicRng::nextUint32() {
   return engine_();
 }
 
+RandomStream DeterministicRng::stream(std::uint64_t salt) const {
+  return RandomStream(salt == 0 ? streamKey_ : mix64(streamKey_ ^ salt));
+}
+
 float DeterministicRng::uniform(float min, float max) {
   std::uniform_real_distribution<float> dist(min, max);
   return dist(engine_);
@@ -0,0 +1,69 @@
+#include <avs/core/FrameArena.hpp>
+
+#include <algorithm>
+#include <new>
+
+namespace avs::core {
+
+namespace {
+
+// Smallest block worth chaining on; tiny first allocations would otherwise
+// cost a new block each until the arena settles.
+constexpr std::size_t kMinBlockBytes = 64 * 1024;
+
+constexpr std::size_t alignUp(std::size_t bytes) {
+  return (bytes + FrameArena::kAlignment - 1) & ~(FrameArena::kAlignment - 1);
+}
+
+}  // namespace
+
+void FrameArena::AlignedDelete::operator()(std::byte* data) const {
+  ::operator delete[](data, std::align_val_t{kAlignment});
+}
+
+void* FrameArena::allocate(std::size_t bytes) {
+  if (bytes == 0) {
+    return nullptr;
+  }
+  bytes = alignUp(bytes);
+  if (blocks_.empty() || blocks_.back().size - offset_ < bytes) {
+    addBlock(bytes);
+  }
+  std::byte* result = blocks_.back().data.get() + offset_;
+  offset_ += bytes;
+  return result;
+}
+
+void FrameArena::reset() {
+  if (blocks_.size() > 1) {
+    // Fold the chain into one block big enough for the whole frame.
+    const std::size_t total = capacity();
+    blocks_.clear();
+    addBlock(total);
+  }
+  offset_ = 0;
+  retiredBytes_ = 0;
+}
+
+std::size_t FrameArena::capacity() const {
+  std::size_t total = 0;
+  for (const Block& block : blocks_) {
+    total += block.size;
+  }
+  return total;
+}
+
+void FrameArena::addBlock(std::size_t minBytes) {
+  if (!blocks_.empty()) {
+    retiredBytes_ += offset_;
+  }
+  const std::size_t previous = blocks_.empty() ? 0 : blocks_.back().size;
+  const std::size_t size = alignUp(std::max({minBytes, previous * 2, kMinBlockBytes}));
+  Block block;
+  block.data.reset(static_cast<std::byte*>(::operator new[](size, std::align_val_t{kAlignment})));
+  block.size = size;
+  blocks_.push_back(std::move(block));
+  offset_ = 0;
+}
+
+}  // namespace avs::core
@@ -0,0 +1,79 @@
+#include <avs/core/FrameGovernor.hpp>
+
+#include <algorithm>
+
+namespace avs::core {
+
+namespace {
+
+// Upper percentile of the window compared against the budget, so a handful of
+// slow frames is enough to step down but a single hitch is not.
+constexpr double kDecisionPercentile = 90.0;
+
+}  // namespace
+
+FrameGovernor::FrameGovernor() : FrameGovernor(Config{}) {}
+
+FrameGovernor::FrameGovernor(const Config& config)
+    : config_(config), window_(std::max<std::size_t>(1, config.window)) {
+  config_.window = std::max<std::size_t>(1, config_.window);
+  config_.upshiftWindows = std::max(1, config_.upshiftWindows);
+}
+
+int FrameGovernor::observe(double frameMs) {
+  if (!adaptive()) {
+    return level_;
+  }
+  window_.add(frameMs);
+  if (window_.size() < config_.window) {
+    return level_;
+  }
+
+  const double p90 = window_.percentile(kDecisionPercentile);
+  window_.clear();
+  if (p90 > config_.targetMs * config_.downshiftRatio) {
+    headroomWindows_ = 0;
+    if (level_ > kMinQualityLevel) {
+      --level_;
+    }
+  } else if (p90 < config_.targetMs * config_.upshiftRatio) {
+    if (++headroomWindows_ >= config_.upshiftWindows) {
+      headroomWindows_ = 0;
+      if (level_ < kMaxQualityLevel) {
+        ++level_;
+      }
+    }
+  } else {
+    headroomWindows_ = 0;
+  }
+  return level_;
+}
+
+void FrameGovernor::setTargetMs(double targetMs) {
+  config_.targetMs = targetMs;
+  if (targetMs <= 0.0 && !locked_) {
+    level_ = kMaxQualityLevel;
+  }
+  restartWindow();
+}
+
+void FrameGovernor::lock(int level) {
+  level_ = clampQualityLevel(level);
+  locked_ = true;
+  restartWindow();
+}
+
+void FrameGovernor::unlock() {
+  locked_ = false;
+  if (config_.targetMs <= 0.0) {
+    level_ = kMaxQualityLevel;
+  }
+  restartWindow();
+}
+
+void FrameGovernor::restartWindow() {
+  window_.clear();
+  headroomWindows_ = 0;
+}
+
+}  // namespace avs::core
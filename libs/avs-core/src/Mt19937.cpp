@@ -0,0 +1,69 @@
+#include <avs/core/Mt19937.hpp>
+
+namespace avs::core {
+
+namespace {
+
+constexpr std::size_t kShift = 397;
+constexpr std::uint32_t kMatrixA = 0x9908B0DFu;
+constexpr std::uint32_t kUpperMask = 0x80000000u;
+constexpr std::uint32_t kLowerMask = 0x7FFFFFFFu;
+
+}  // namespace
+
+void Mt19937::seed(result_type value) {
+  state_[0] = value;
+  for (std::size_t i = 1; i < kStateSize; ++i) {
+    const std::uint32_t previous = state_[i - 1];
+    state_[i] = 1812433253u * (previous ^ (previous >> 30)) + static_cast<std::uint32_t>(i);
+  }
+  index_ = kStateSize;
+}
+
+void Mt19937::twist() {
+  for (std::size_t i = 0; i < kStateSize; ++i) {
+    const std::uint32_t y =
+        (state_[i] & kUpperMask) | (state_[(i + 1) % kStateSize] & kLowerMask);
+    state_[i] = state_[(i + kShift) % kStateSize] ^ (y >> 1) ^ ((y & 1u) ? kMatrixA : 0u);
+  }
+  index_ = 0;
+}
+
+Mt19937::result_type Mt19937::operator()() {
+  if (index_ >= kStateSize) {
+    twist();
+  }
+  std::uint32_t y = state_[index_++];
+  y ^= y >> 11;
+  y ^= (y << 7) & 0x9D2C5680u;
+  y ^= (y << 15) & 0xEFC60000u;
+  y ^= y >> 18;
+  return y;
+}
+
+void Mt19937::saveState(StateWriter& writer) const {
+  for (std::uint32_t word : state_) {
+    writer.writeVarUint(word);
+  }
+  writer.writeVarUint(index_);
+}
+
+bool Mt19937::restoreState(StateReader& reader) {
+  std::array<result_type, kStateSize> state{};
+  for (auto& word : state) {
+    const std::uint64_t value = reader.readVarUint();
+    if (value > max()) {
+      reader.fail();
+    }
+    word = static_cast<result_type>(value);
+  }
+  const std::size_t index = reader.readSize(kStateSize);
+  if (!reader.ok()) {
+    return false;
+  }
+  state_ = state;
+  index_ = index;
+  return true;
+}
+
+}  // namespace avs::core
@@ -0,0 +1,136 @@
+#include <avs/core/OutputLayer.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+namespace avs::core {
+
+namespace {
+
+// Probe fills. A byte that reads back as its probe value in all three passed
+// through; one that reads back the same in all three was written. Anything
+// else depends on the input.
+constexpr std::array<std::uint8_t, 3> kProbeFills = {0x00, 0xFF, 0x5A};
+
+}  // namespace
+
+OutputLayer::Capture OutputLayer::capture(IEffect& effect, RenderContext& context, int quality) {
+  reset();
+  if (context.width <= 0 || context.height <= 0) {
+    return Capture::Failed;
+  }
+  const int width = context.width;
+  const int height = context.height;
+  const std::size_t pixels = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+  const std::size_t bytes = pixels * 4u;
+
+  const PixelBufferView framebuffer = context.framebuffer;
+  const DirtyRect dirtyIn = context.dirtyIn;
+  const DirtyRect dirtyOut = context.dirtyOut;
+  std::array<std::vector<std::uint8_t>, kProbeFills.size()> probes;
+  bool rendered = true;
+  for (std::size_t i = 0; i < probes.size() && rendered; ++i) {
+    probes[i].assign(bytes, kProbeFills[i]);
+    context.framebuffer = {probes[i].data(), bytes};
+    context.dirtyIn = DirtyRect::all();
+    context.dirtyOut = DirtyRect::all();
+    rendered = effect.render(context);
+  }
+  context.framebuffer = framebuffer;
+  context.dirtyIn = dirtyIn;
+  context.dirtyOut = dirtyOut;
+  if (!rendered) {
+    return Capture::Failed;
+  }
+
+  color_.assign(pixels, 0u);
+  keep_.assign(pixels, 0u);
+  rows_.assign(static_cast<std::size_t>(height), RowKind::Copy);
+  coversColor_ = true;
+  for (int y = 0; y < height; ++y) {
+    bool keeps = false;
+    bool writes = false;
+    for (int x = 0; x < width; ++x) {
+      const std::size_t pixel = static_cast<std::size_t>(y) * static_cast<std::size_t>(width) +
+                                static_cast<std::size_t>(x);
+      std::array<std::uint8_t, 4> color{};
+      std::array<std::uint8_t, 4> keep{};
+      bool colored = false;
+      for (std::size_t c = 0; c < 4; ++c) {
+        const std::size_t byte = pixel * 4u + c;
+        const std::uint8_t value = probes[0][byte];
+        if (probes[1][byte] == value && probes[2][byte] == value) {
+          color[c] = value;
+          writes = true;
+          colored = colored || (c < 3 && value != 0);
+        } else if (value == kProbeFills[0] && probes[1][byte] == kProbeFills[1] &&
+                   probes[2][byte] == kProbeFills[2]) {
+          keep[c] = 0xFF;
+          keeps = true;
+          coversColor_ = coversColor_ && c == 3;
+        } else {
+          reset();
+          return Capture::Blends;
+        }
+      }
+      std::memcpy(&color_[pixel], color.data(), 4);
+      std::memcpy(&keep_[pixel], keep.data(), 4);
+      if (colored) {
+        painted_.include(x, y);
+      }
+    }
+    rows_[static_cast<std::size_t>(y)] = !keeps ? RowKind::Copy : writes ? RowKind::Blend : RowKind::Keep;
+  }
+
+  width_ = width;
+  height_ = height;
+  quality_ = quality;
+  valid_ = true;
+  return Capture::Cached;
+}
+
+bool OutputLayer::matches(const RenderContext& context, int quality) const {
+  return valid_ && context.width == width_ && context.height == height_ && quality == quality_;
+}
+
+void OutputLayer::composite(RenderContext& context) const {
+  std::uint8_t* data = context.framebuffer.data;
+  const std::size_t width = static_cast<std::size_t>(width_);
+  for (std::size_t y = 0; y < rows_.size(); ++y) {
+    const std::size_t row = y * width;
+    switch (rows_[y]) {
+      case RowKind::Keep:
+        break;
+      case RowKind::Copy:
+        std::memcpy(data + row * 4u, &color_[row], width * 4u);
+        break;
+      case RowKind::Blend:
+        for (std::size_t x = row; x < row + width; ++x) {
+          std::uint32_t pixel;
+          std::memcpy(&pixel, data + x * 4u, 4);
+          pixel = color_[x] | (pixel & keep_[x]);
+          std::memcpy(data + x * 4u, &pixel, 4);
+        }
+        break;
+    }
+  }
+
+  // Pixels the layer leaves alone keep whatever dirtyIn allowed.
+  DirtyRect region = coversColor_ ? DirtyRect::none() : context.dirtyIn;
+  region.include(painted_);
+  context.dirtyOut = region;
+}
+
+void OutputLayer::reset() {
+  valid_ = false;
+  width_ = 0;
+  height_ = 0;
+  color_.clear();
+  keep_.clear();
+  rows_.clear();
+  painted_ = DirtyRect::none();
+  coversColor_ = false;
+}
+
+}  // namespace avs::core
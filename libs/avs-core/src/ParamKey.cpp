@@ -0,0 +1,91 @@
+#include <avs/core/ParamKey.hpp>
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace avs::core {
+
+namespace {
+
+struct NameHash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+};
+
+/** Process-wide name table. Names are never removed, so ids and name() references stay valid. */
+class KeyTable {
+ public:
+  static KeyTable& instance() {
+    static KeyTable table;
+    return table;
+  }
+
+  std::optional<std::uint32_t> find(std::string_view name) const {
+    std::shared_lock lock(mutex_);
+    auto it = ids_.find(name);
+    if (it == ids_.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  std::uint32_t intern(std::string_view name) {
+    if (auto id = find(name)) {
+      return *id;
+    }
+    std::unique_lock lock(mutex_);
+    auto it = ids_.find(name);
+    if (it != ids_.end()) {
+      return it->second;
+    }
+    const auto id = static_cast<std::uint32_t>(names_.size());
+    names_.emplace_back(name);
+    ids_.emplace(names_.back(), id);
+    return id;
+  }
+
+  const std::string& name(std::uint32_t id) const {
+    std::shared_lock lock(mutex_);
+    return names_[id];
+  }
+
+ private:
+  mutable std::shared_mutex mutex_;
+  std::deque<std::string> names_;
+  std::unordered_map<std::string, std::uint32_t, NameHash, std::equal_to<>> ids_;
+};
+
+}  // namespace
+
+ParamKey::ParamKey(std::string_view name) : id_(KeyTable::instance().intern(name)) {}
+
+std::optional<ParamKey> ParamKey::lookup(std::string_view name) {
+  if (auto id = KeyTable::instance().find(name)) {
+    return ParamKey(*id);
+  }
+  return std::nullopt;
+}
+
+const std::string& ParamKey::name() const {
+  static const std::string kEmpty;
+  return valid() ? KeyTable::instance().name(id_) : kEmpty;
+}
+
+ParamAliases::ParamAliases(std::initializer_list<std::string_view> names) {
+  keys_.reserve(names.size());
+  for (std::string_view name : names) {
+    keys_.emplace_back(name);
+  }
+}
+
+ParamAliases::ParamAliases(const std::vector<std::string>& names) {
+  keys_.reserve(names.size());
+  for (const auto& name : names) {
+    keys_.emplace_back(name);
+  }
+}
+
+}  // namespace avs::core
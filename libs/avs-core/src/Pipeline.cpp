@@ -1,12 +1,88 @@
 #include <avs/core/Pipeline.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <thread>
 #include <utility>
 
+#include <avs/core/IFramebuffer.hpp>
+#include <avs/core/RowBand.hpp>
+
 namespace avs::core {
 
+namespace {
+
+// Bands dispatched per pool thread. Finer bands let idle workers steal the
+// tail of a slow band instead of waiting on it at the barrier.
+constexpr int kBandsPerThread = 4;
+
+// Target working set of one fused tile: small enough that a tile stays in L2
+// while every effect of the run passes over it.
+constexpr std::size_t kFusedTileBytes = 128u * 1024u;
+
+// Minimum tile height per halo row, bounding the rows a neighborhood filter
+// re-reads around each tile to a quarter of the rows it writes.
+constexpr int kTileRowsPerHaloRow = 4;
+
+int fusedTileCount(const RenderContext& context, int tasks, int haloRows) {
+  if (context.width <= 0 || context.height <= 0) {
+    return 1;
+  }
+  const std::size_t frameBytes =
+      static_cast<std::size_t>(context.width) * static_cast<std::size_t>(context.height) * 4u;
+  const int cacheTiles = static_cast<int>((frameBytes + kFusedTileBytes - 1) / kFusedTileBytes);
+  int tiles = std::max(tasks, cacheTiles);
+  tiles = std::min(tiles, context.height);
+  if (haloRows > 0) {
+    tiles = std::min(tiles, std::max(1, context.height / (haloRows * kTileRowsPerHaloRow)));
+  }
+  return std::max(1, tiles);
+}
+
+using ProfileClock = std::chrono::steady_clock;
+
+double elapsedMs(ProfileClock::time_point start) {
+  return std::chrono::duration<double, std::milli>(ProfileClock::now() - start).count();
+}
+
+std::size_t framePixels(const RenderContext& context) {
+  if (context.width <= 0 || context.height <= 0) {
+    return 0u;
+  }
+  return static_cast<std::size_t>(context.width) * static_cast<std::size_t>(context.height);
+}
+
+// Fusion, cached layers, dirty rows and the effects themselves index the frame
+// as packed rows of context.width pixels. A backend with direct access must
+// expose those same pixels, so effects that prefer it see what the rest see.
+bool packedFrame(const RenderContext& context) {
+  const std::size_t rowBytes = static_cast<std::size_t>(std::max(context.width, 0)) * 4u;
+  if (context.framebuffer.stride != 0 && context.framebuffer.stride != rowBytes) {
+    return false;
+  }
+  IFramebuffer* backend = context.framebufferBackend;
+  if (!backend || !backend->supportsDirectAccess()) {
+    return true;
+  }
+  return backend->data() == context.framebuffer.data && backend->stride() == rowBytes &&
+         backend->width() == context.width && backend->height() == context.height;
+}
+
+// Leading bytes of a checkpoint, followed by the format version.
+constexpr std::uint8_t kCheckpointMagic[] = {'A', 'V', 'S', 'C'};
+constexpr std::uint64_t kCheckpointVersion = 1;
+
+TaskCostModel::Config costModelConfig() {
+  TaskCostModel::Config config;
+  config.tasksPerThread = kBandsPerThread;
+  return config;
+}
+
+}  // namespace
+
 Pipeline::Pipeline(EffectRegistry& registry, int numThreads)
-    : registry_(registry), threadPool_(nullptr) {
+    : registry_(registry), costModel_(costModelConfig()), threadPool_(nullptr) {
   if (numThreads > 1) {
     threadPool_ = std::make_unique<ThreadPool>(numThreads);
   }
@@ -18,45 +94,566 @@ void Pipeline::add(std::string key, ParamBlock params) {
     return;
   }
   effect->setParams(params);
-  nodes_.push_back(Node{std::move(key), std::move(params), std::move(effect)});
+  if (appliedQuality_ != kMaxQualityLevel) {
+    effect->setQualityLevel(appliedQuality_);
+  }
+  const OutputDependence dependence = effect->outputDependence();
+  Node node;
+  node.key = std::move(key);
+  node.params = std::move(params);
+  node.effect = std::move(effect);
+  node.dependence = dependence;
+  nodes_.push_back(std::move(node));
+  if (dependence != OutputDependence::Nothing) {
+    schedule_.push_back(nodes_.size() - 1);
+  }
+}
+
+void Pipeline::rebuildSchedule() {
+  schedule_.clear();
+  for (std::size_t index = 0; index < nodes_.size(); ++index) {
+    Node& node = nodes_[index];
+    // An effect that turned out to blend stays Frame; the rest may change with the level.
+    if (!node.layerRejected) {
+      node.dependence = node.effect->outputDependence();
+    }
+    if (node.dependence != OutputDependence::Nothing) {
+      schedule_.push_back(index);
+    }
+  }
 }
 
 bool Pipeline::render(RenderContext& context) {
+  if (!packedFrame(context)) {
+    return false;
+  }
   context.rng.reseed(context.frameIndex);
+  const bool timed = profiler_ || governor_.adaptive();
+  const ProfileClock::time_point frameStart = timed ? ProfileClock::now() : ProfileClock::time_point{};
+  // A caller-provided arena belongs to the caller, who also decides when to reset it.
+  const bool ownsArena = context.arena == nullptr;
+  if (ownsArena) {
+    context.arena = &arena_;
+  }
+
+  // Outside this box the frame is black. Only the caller knows what the buffer
+  // held before the frame, so tracking starts from whatever it put in dirtyIn.
+  DirtyRect region = context.dirtyIn.clipped(context.width, context.height);
+
   bool success = true;
+  std::size_t position = 0;
+  while (success && position < schedule_.size()) {
+    const std::size_t runEnd = fusedRunEnd(position);
+    const std::size_t index = schedule_[position];
+    context.dirtyIn = region;
+    context.dirtyOut = DirtyRect::all();
+    // A lone pointwise effect still goes through the tiled path when part of
+    // the frame is known black, so it can skip the black rows.
+    const bool sparsePointwise = runEnd - position == 1 &&
+                                 isLocal(position, AccessPattern::Kind::Pointwise) &&
+                                 !region.coversFrame(context.width, context.height);
+    if (runEnd - position > 1 || sparsePointwise) {
+      success = renderFused(position, runEnd, context);
+    } else if (nodes_[index].effect) {
+      context.rng.reseed(context.frameIndex, index);
+      if (profiler_) {
+        PipelineProfiler::Sample sample;
+        const ProfileClock::time_point start = ProfileClock::now();
+        success = renderNode(index, context, &sample);
+        sample.ms = elapsedMs(start);
+        profiler_->recordNode(index, sample);
+      } else {
+        success = renderNode(index, context, nullptr);
+      }
+    }
+    region = context.dirtyOut.clipped(context.width, context.height);
+    position = runEnd;
+  }
+  // Nothing is known about the buffer once the next frame starts from it.
+  context.dirtyIn = DirtyRect::all();
+  context.dirtyOut = region;
 
-  for (auto& node : nodes_) {
-    if (!node.effect) {
+  if (ownsArena) {
+    arena_.reset();
+    context.arena = nullptr;
+  }
+
+  if (timed) {
+    const double frameMs = elapsedMs(frameStart);
+    if (profiler_) {
+      profiler_->recordFrame(frameMs);
+    }
+    if (governor_.adaptive()) {
+      governor_.observe(frameMs);
+      applyQualityLevel();
+    }
+  }
+  return success;
+}
+
+bool Pipeline::isLocal(std::size_t position, AccessPattern::Kind kind) const {
+  const Node& node = nodes_[schedule_[position]];
+  // Cached layers are composited on their own, outside any run.
+  return node.effect && node.dependence == OutputDependence::Frame &&
+         node.effect->supportsMultiThreaded() && node.effect->accessPattern().kind == kind;
+}
+
+std::size_t Pipeline::fusedRunEnd(std::size_t first) const {
+  // A neighborhood effect snapshots its input in smp_begin(), before any tile of
+  // the run has rendered, so it can only open a run. Pointwise effects extend it.
+  if (!isLocal(first, AccessPattern::Kind::Pointwise) &&
+      !isLocal(first, AccessPattern::Kind::Neighborhood)) {
+    return first + 1;
+  }
+  std::size_t last = first + 1;
+  while (last < schedule_.size() && isLocal(last, AccessPattern::Kind::Pointwise)) {
+    ++last;
+  }
+  return last;
+}
+
+bool Pipeline::renderFused(std::size_t first, std::size_t last, RenderContext& context) {
+  const AccessPattern head = nodes_[schedule_[first]].effect->accessPattern();
+  const int haloRows = head.kind == AccessPattern::Kind::Neighborhood ? head.radius : 0;
+  const std::size_t pixelCount = framePixels(context);
+  // The run is dispatched as one unit, so it is planned and calibrated as one,
+  // under the index of its first node.
+  const TaskCostModel::Decision plan = planThreads(schedule_[first], pixelCount);
+  const int requested = fusedTileCount(context, plan.threads > 1 ? plan.tasks : 1, haloRows);
+  const bool profiling = profiler_ != nullptr;
+  const bool timed = calibrating();
+  const ProfileClock::time_point runStart = profiling ? ProfileClock::now() : ProfileClock::time_point{};
+  const ProfileClock::time_point setupStart = timed ? ProfileClock::now() : ProfileClock::time_point{};
+  stepMs_.clear();
+
+  // LUT groups map whole frames, so they need the full geometry up front.
+  const bool lutFusable = context.framebuffer.data && pixelCount > 0 &&
+                          context.framebuffer.size >= pixelCount * 4u;
+
+  // Every effect must cut the frame the same way, so the run uses the smallest
+  // band count any active member asked for.
+  runSteps_.clear();
+  std::size_t lutCount = 0;
+  int tiles = requested;
+  std::size_t index = first;
+  while (index < last) {
+    std::size_t lutEnd = index;
+    while (lutFusable && lutEnd < last &&
+           nodes_[schedule_[lutEnd]].effect->hasChannelLut(context)) {
+      ++lutEnd;
+    }
+    if (lutEnd - index > 1) {
+      if (runLuts_.size() <= lutCount) {
+        runLuts_.resize(lutCount + 1);
+      }
+      const ProfileClock::time_point start = profiling ? ProfileClock::now() : ProfileClock::time_point{};
+      ChannelLut& combined = runLuts_[lutCount];
+      combined.setIdentity();
+      const std::size_t groupBegin = index;
+      for (; index < lutEnd; ++index) {
+        context.rng.reseed(context.frameIndex, schedule_[index]);
+        nodes_[schedule_[index]].effect->buildChannelLut(context, lutScratch_);
+        combined.then(lutScratch_);
+      }
+      runSteps_.push_back(RunStep{nullptr, 1, lutCount, groupBegin, lutEnd - groupBegin,
+                                  combined.mapsBlackToBlack()});
+      ++lutCount;
+      if (profiling) {
+        stepMs_.push_back(elapsedMs(start));
+      }
       continue;
     }
 
-    // Check if effect supports multi-threading and pool is available
-    if (threadPool_ && threadPool_->isMultiThreaded() && node.effect->supportsMultiThreaded()) {
-      // Multi-threaded rendering
-      bool renderSuccess = true;
-      threadPool_->execute([&](int threadId, int maxThreads) {
-        if (!node.effect->smp_render(context, threadId, maxThreads)) {
-          renderSuccess = false;
-        }
-      });
+    const ProfileClock::time_point start = profiling ? ProfileClock::now() : ProfileClock::time_point{};
+    IEffect* effect = nodes_[schedule_[index]].effect.get();
+    context.rng.reseed(context.frameIndex, schedule_[index]);
+    const int bands = std::min(effect->smp_begin(context, requested), requested);
+    if (bands > 0) {
+      tiles = std::min(tiles, bands);
+    }
+    // Pointwise effects keep their state out of smp_finish(), so an effect with
+    // no bands leaves the frame as it was.
+    runSteps_.push_back(RunStep{effect, bands, 0, index, 1,
+                                bands <= 0 || effect->preservesBlack(context)});
+    if (profiling) {
+      stepMs_.push_back(elapsedMs(start));
+    }
+    ++index;
+  }
 
-      if (!renderSuccess) {
-        success = false;
-        break;
+  const std::size_t stepCount = runSteps_.size();
+  if (profiling) {
+    tileStepMs_.assign(static_cast<std::size_t>(getThreadCount()) * stepCount, 0.0);
+  }
+  double serialMs = 0.0;
+  if (timed) {
+    serialMs = elapsedMs(setupStart);
+    workerMs_.assign(static_cast<std::size_t>(getThreadCount()), 0.0);
+  }
+
+  // Rows outside the dirty region stay black through every leading step that
+  // preserves black, so those steps skip tiles lying entirely outside it. A
+  // neighborhood head reads rows beyond its tile and never skips.
+  const DirtyRect region = context.dirtyIn.clipped(context.width, context.height);
+  std::size_t blackPrefix = 0;
+  if (head.kind == AccessPattern::Kind::Pointwise) {
+    while (blackPrefix < stepCount && runSteps_[blackPrefix].preservesBlack) {
+      ++blackPrefix;
+    }
+  }
+  const bool skipBlackTiles =
+      blackPrefix > 0 && !region.coversFrame(context.width, context.height);
+
+  std::atomic<bool> renderSuccess{true};
+  const auto renderTile = [&](int tile, int workerIndex) {
+    const ProfileClock::time_point tileStart = timed ? ProfileClock::now() : ProfileClock::time_point{};
+    const RowBand rows = rowBand(context.height, tile, tiles);
+    const std::size_t firstStep =
+        skipBlackTiles && !region.intersectsRows(rows.begin, rows.end) ? blackPrefix : 0;
+    for (std::size_t s = firstStep; s < stepCount; ++s) {
+      const RunStep& step = runSteps_[s];
+      if (step.bands <= 0) {
+        continue;
+      }
+      const ProfileClock::time_point start = profiling ? ProfileClock::now() : ProfileClock::time_point{};
+      bool stepSuccess = true;
+      if (!step.effect) {
+        const PixelSpan span =
+            rowBandPixels(pixelCount, context.width, context.height, tile, tiles);
+        runLuts_[step.lut].apply(context.framebuffer.data, span.begin, span.end);
+      } else {
+        stepSuccess = step.effect->smp_render(context, tile, tiles);
+      }
+      if (profiling) {
+        // Each worker owns its row of slots, so no synchronization is needed.
+        tileStepMs_[static_cast<std::size_t>(workerIndex) * stepCount + s] += elapsedMs(start);
       }
-    } else {
-      // Single-threaded rendering
-      if (!node.effect->render(context)) {
-        success = false;
+      if (!stepSuccess) {
+        renderSuccess = false;
         break;
       }
     }
+    if (timed) {
+      workerMs_[static_cast<std::size_t>(workerIndex)] += elapsedMs(tileStart);
+    }
+  };
+  const bool threaded = plan.threads > 1 && threadPool_ && threadPool_->isMultiThreaded();
+  double dispatchMs = 0.0;
+  if (threaded) {
+    const ProfileClock::time_point dispatchStart = timed ? ProfileClock::now() : ProfileClock::time_point{};
+    threadPool_->parallelFor(tiles, plan.threads, renderTile);
+    if (timed) {
+      dispatchMs = elapsedMs(dispatchStart);
+    }
+  } else {
+    for (int tile = 0; tile < tiles; ++tile) {
+      renderTile(tile, 0);
+    }
   }
 
-  return success;
+  const ProfileClock::time_point finishStart = timed ? ProfileClock::now() : ProfileClock::time_point{};
+  for (std::size_t s = 0; s < stepCount; ++s) {
+    const RunStep& step = runSteps_[s];
+    if (!step.effect) {
+      continue;
+    }
+    const ProfileClock::time_point start = profiling ? ProfileClock::now() : ProfileClock::time_point{};
+    if (!step.effect->smp_finish(context)) {
+      renderSuccess = false;
+    }
+    if (profiling) {
+      stepMs_[s] += elapsedMs(start);
+    }
+  }
+
+  context.dirtyOut = blackPrefix == stepCount ? region : DirtyRect::all();
+
+  if (timed) {
+    calibrate(schedule_[first], pixelCount, serialMs + elapsedMs(finishStart), dispatchMs);
+  }
+  if (profiling) {
+    recordFusedRun(elapsedMs(runStart), threaded ? std::min(tiles, plan.threads) : 1, tiles,
+                   pixelCount, plan.nsPerPixel);
+  }
+  return renderSuccess;
+}
+
+void Pipeline::recordFusedRun(double runMs, int threads, int tiles, std::size_t pixelCount,
+                              double nsPerPixel) {
+  const std::size_t stepCount = runSteps_.size();
+  const std::size_t workers = stepCount > 0 ? tileStepMs_.size() / stepCount : 0;
+  double totalMs = 0.0;
+  for (std::size_t s = 0; s < stepCount; ++s) {
+    for (std::size_t worker = 0; worker < workers; ++worker) {
+      stepMs_[s] += tileStepMs_[worker * stepCount + s];
+    }
+    totalMs += stepMs_[s];
+  }
+
+  // A lone effect may take this path to skip black rows; it is not a fused run.
+  const bool fused = stepCount > 1 || (stepCount == 1 && runSteps_[0].nodeCount > 1);
+  for (std::size_t s = 0; s < stepCount; ++s) {
+    const RunStep& step = runSteps_[s];
+    const double share = totalMs > 0.0 ? stepMs_[s] / totalMs : 1.0 / static_cast<double>(stepCount);
+    PipelineProfiler::Sample sample;
+    sample.ms = runMs * share / static_cast<double>(step.nodeCount);
+    sample.threads = threads;
+    sample.tasks = tiles;
+    sample.pixels = step.bands > 0 ? pixelCount : 0u;
+    sample.nsPerPixel = nsPerPixel;
+    sample.smp = true;
+    sample.fused = fused;
+    for (std::size_t position = step.node; position < step.node + step.nodeCount; ++position) {
+      profiler_->recordNode(schedule_[position], sample);
+    }
+  }
+}
+
+bool Pipeline::renderNode(std::size_t index, RenderContext& context, PipelineProfiler::Sample* sample) {
+  IEffect& effect = *nodes_[index].effect;
+  const std::size_t pixels = framePixels(context);
+  if (nodes_[index].dependence == OutputDependence::Params && renderCached(nodes_[index], context)) {
+    if (sample) {
+      sample->pixels = pixels;
+      sample->cached = true;
+    }
+    return true;
+  }
+  const bool pooled =
+      threadPool_ && threadPool_->isMultiThreaded() && effect.supportsMultiThreaded();
+  const TaskCostModel::Decision plan = pooled ? planThreads(index, pixels) : TaskCostModel::Decision{};
+  const bool timed = pooled && calibrating();
+  if (sample) {
+    sample->pixels = pixels;
+    sample->nsPerPixel = plan.nsPerPixel;
+  }
+
+  if (plan.threads <= 1) {
+    // Single-threaded rendering: no pool, too little work, or not calibrated yet
+    const ProfileClock::time_point start = timed ? ProfileClock::now() : ProfileClock::time_point{};
+    const bool success = effect.render(context);
+    if (timed) {
+      workerMs_.clear();
+      calibrate(index, pixels, elapsedMs(start), 0.0);
+    }
+    return success;
+  }
+
+  // Multi-threaded rendering: begin/finish run here, bands run on the pool
+  std::atomic<bool> renderSuccess{true};
+  const ProfileClock::time_point beginStart = timed ? ProfileClock::now() : ProfileClock::time_point{};
+  const int bands = std::min(effect.smp_begin(context, plan.tasks), plan.tasks);
+  double serialMs = 0.0;
+  double dispatchMs = 0.0;
+  if (timed) {
+    serialMs = elapsedMs(beginStart);
+    workerMs_.assign(static_cast<std::size_t>(getThreadCount()), 0.0);
+  }
+  if (bands > 0) {
+    const ProfileClock::time_point dispatchStart = timed ? ProfileClock::now() : ProfileClock::time_point{};
+    threadPool_->parallelFor(bands, plan.threads, [&](int band, int workerIndex) {
+      const ProfileClock::time_point start = timed ? ProfileClock::now() : ProfileClock::time_point{};
+      if (!effect.smp_render(context, band, bands)) {
+        renderSuccess = false;
+      }
+      if (timed) {
+        workerMs_[static_cast<std::size_t>(workerIndex)] += elapsedMs(start);
+      }
+    });
+    if (timed) {
+      dispatchMs = elapsedMs(dispatchStart);
+    }
+  }
+  const ProfileClock::time_point finishStart = timed ? ProfileClock::now() : ProfileClock::time_point{};
+  if (!effect.smp_finish(context)) {
+    renderSuccess = false;
+  }
+  if (timed) {
+    calibrate(index, pixels, serialMs + elapsedMs(finishStart), dispatchMs);
+  }
+
+  if (sample) {
+    sample->smp = true;
+    sample->threads = std::max(1, std::min(bands, plan.threads));
+    sample->tasks = std::max(1, bands);
+    sample->pixels = bands > 0 ? pixels : 0u;
+  }
+  return renderSuccess;
+}
+
+bool Pipeline::renderCached(Node& node, RenderContext& context) {
+  const std::size_t pixels = framePixels(context);
+  if (pixels == 0 || !context.framebuffer.data || context.framebuffer.size < pixels * 4u) {
+    return false;
+  }
+  if (!node.layer) {
+    node.layer = std::make_unique<OutputLayer>();
+  }
+  if (!node.layer->matches(context, appliedQuality_)) {
+    switch (node.layer->capture(*node.effect, context, appliedQuality_)) {
+      case OutputLayer::Capture::Cached:
+        break;
+      case OutputLayer::Capture::Blends:
+        // The effect mixes its input in after all; render it every frame from now on.
+        node.dependence = OutputDependence::Frame;
+        node.layerRejected = true;
+        node.layer.reset();
+        return false;
+      case OutputLayer::Capture::Failed:
+        return false;
+    }
+  }
+  node.layer->composite(context);
+  return true;
+}
+
+TaskCostModel::Decision Pipeline::planThreads(std::size_t node, std::size_t pixels) const {
+  const int poolThreads = getThreadCount();
+  if (autoThreading_) {
+    return costModel_.decide(node, pixels, poolThreads);
+  }
+  TaskCostModel::Decision everything;
+  everything.threads = poolThreads;
+  everything.tasks = poolThreads > 1 ? poolThreads * kBandsPerThread : 1;
+  everything.nsPerPixel = costModel_.nsPerPixel(node, pixels);
+  return everything;
+}
+
+void Pipeline::calibrate(std::size_t node, std::size_t pixels, double serialMs, double dispatchMs) {
+  double workMs = serialMs;
+  double busiestMs = 0.0;
+  for (double ms : workerMs_) {
+    workMs += ms;
+    busiestMs = std::max(busiestMs, ms);
+  }
+  costModel_.observeWork(node, pixels, workMs * 1000.0);
+  // Whatever the dispatch took beyond its busiest worker went to waking
+  // workers, handing out tasks and the final barrier.
+  if (dispatchMs > 0.0) {
+    costModel_.observeDispatch((dispatchMs - busiestMs) * 1000.0);
+  }
 }
 
-void Pipeline::clear() { nodes_.clear(); }
+void Pipeline::clear() {
+  nodes_.clear();
+  schedule_.clear();
+  costModel_.clear();
+  if (profiler_) {
+    profiler_ = std::make_unique<PipelineProfiler>();
+  }
+}
+
+void Pipeline::setProfilingEnabled(bool enabled) {
+  profiler_ = enabled ? std::make_unique<PipelineProfiler>() : nullptr;
+}
+
+PipelineProfile Pipeline::profile() const {
+  if (!profiler_) {
+    return {};
+  }
+  std::vector<std::string> keys;
+  keys.reserve(nodes_.size());
+  for (const auto& node : nodes_) {
+    keys.push_back(node.key);
+  }
+  PipelineProfile profile = profiler_->snapshot(keys);
+  profile.dispatchUs = costModel_.dispatchUs();
+  return profile;
+}
+
+std::vector<std::uint8_t> Pipeline::saveState() const {
+  StateWriter writer;
+  for (std::uint8_t byte : kCheckpointMagic) {
+    writer.writeU8(byte);
+  }
+  writer.writeVarUint(kCheckpointVersion);
+  writer.writeVarUint(nodes_.size());
+  for (const auto& node : nodes_) {
+    StateWriter effectState;
+    node.effect->saveState(effectState);
+    writer.writeString(node.key);
+    writer.writeBytes(effectState.data().data(), effectState.data().size());
+  }
+  return writer.take();
+}
+
+bool Pipeline::restoreState(const std::vector<std::uint8_t>& checkpoint) {
+  std::vector<StateReader> sections;
+  if (!readCheckpoint(checkpoint, sections)) {
+    return false;
+  }
+  const std::vector<std::uint8_t> previous = saveState();
+  if (restoreEffects(sections)) {
+    return true;
+  }
+  // Put back the effects that already took their section.
+  std::vector<StateReader> rollback;
+  if (readCheckpoint(previous, rollback)) {
+    restoreEffects(rollback);
+  }
+  return false;
+}
+
+bool Pipeline::readCheckpoint(const std::vector<std::uint8_t>& checkpoint,
+                              std::vector<StateReader>& sections) const {
+  StateReader reader(checkpoint);
+  for (std::uint8_t byte : kCheckpointMagic) {
+    if (reader.readU8() != byte) {
+      return false;
+    }
+  }
+  if (reader.readVarUint() != kCheckpointVersion || reader.readVarUint() != nodes_.size()) {
+    return false;
+  }
+  sections.clear();
+  sections.reserve(nodes_.size());
+  for (const auto& node : nodes_) {
+    if (reader.readString() != node.key) {
+      return false;
+    }
+    sections.push_back(reader.readSection());
+  }
+  return reader.ok() && reader.atEnd();
+}
+
+bool Pipeline::restoreEffects(std::vector<StateReader>& sections) {
+  for (std::size_t index = 0; index < nodes_.size(); ++index) {
+    StateReader& section = sections[index];
+    if (!nodes_[index].effect->restoreState(section) || !section.ok() || !section.atEnd()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Pipeline::setFrameBudget(double targetMs) {
+  governor_.setTargetMs(targetMs);
+  applyQualityLevel();
+}
+
+void Pipeline::lockQualityLevel(int level) {
+  governor_.lock(level);
+  applyQualityLevel();
+}
+
+void Pipeline::unlockQualityLevel() {
+  governor_.unlock();
+  applyQualityLevel();
+}
+
+void Pipeline::applyQualityLevel() {
+  const int level = governor_.level();
+  if (level == appliedQuality_) {
+    return;
+  }
+  appliedQuality_ = level;
+  for (auto& node : nodes_) {
+    if (node.effect) {
+      node.effect->setQualityLevel(level);
+    }
+  }
+  rebuildSchedule();
+}
 
 void Pipeline::setThreadCount(int numThreads) {
   if (numThreads <= 1) {
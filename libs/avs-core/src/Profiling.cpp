@@ -0,0 +1,115 @@
+#include <avs/core/Profiling.hpp>
+
+#include <json.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace avs::core {
+
+RollingHistogram::RollingHistogram(std::size_t capacity) : samples_(std::max<std::size_t>(1, capacity)) {}
+
+void RollingHistogram::add(double value) {
+  samples_[next_] = value;
+  if (++next_ == samples_.size()) {
+    next_ = 0;
+    filled_ = true;
+  }
+}
+
+void RollingHistogram::clear() {
+  next_ = 0;
+  filled_ = false;
+}
+
+double RollingHistogram::percentile(double percent) const {
+  const std::size_t count = size();
+  if (count == 0) {
+    return 0.0;
+  }
+  scratch_.assign(samples_.begin(), samples_.begin() + static_cast<std::ptrdiff_t>(count));
+  const double clamped = std::clamp(percent, 0.0, 100.0);
+  const auto rank = static_cast<std::size_t>(std::ceil(clamped / 100.0 * static_cast<double>(count)));
+  const std::size_t index = rank == 0 ? 0 : rank - 1;
+  std::nth_element(scratch_.begin(), scratch_.begin() + static_cast<std::ptrdiff_t>(index), scratch_.end());
+  return scratch_[index];
+}
+
+void PipelineProfiler::recordNode(std::size_t node, const Sample& sample) {
+  if (node >= nodes_.size()) {
+    nodes_.resize(node + 1);
+  }
+  NodeStats& stats = nodes_[node];
+  stats.histogram.add(sample.ms);
+  ++stats.frames;
+  if (sample.smp) {
+    ++stats.smpFrames;
+  }
+  stats.last = sample;
+}
+
+void PipelineProfiler::recordFrame(double ms) {
+  frameHistogram_.add(ms);
+  ++frames_;
+}
+
+PipelineProfile PipelineProfiler::snapshot(const std::vector<std::string>& keys) const {
+  PipelineProfile profile;
+  profile.frames = frames_;
+  profile.frameP50Ms = frameHistogram_.percentile(50.0);
+  profile.frameP95Ms = frameHistogram_.percentile(95.0);
+  profile.frameP99Ms = frameHistogram_.percentile(99.0);
+
+  profile.nodes.reserve(keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    NodeProfile node;
+    node.key = keys[i];
+    if (i < nodes_.size()) {
+      const NodeStats& stats = nodes_[i];
+      node.frames = stats.frames;
+      node.p50Ms = stats.histogram.percentile(50.0);
+      node.p95Ms = stats.histogram.percentile(95.0);
+      node.p99Ms = stats.histogram.percentile(99.0);
+      node.lastMs = stats.last.ms;
+      node.lastThreads = stats.last.threads;
+      node.lastTasks = stats.last.tasks;
+      node.lastPixels = stats.last.pixels;
+      node.lastSmp = stats.last.smp;
+      node.lastFused = stats.last.fused;
+      node.lastCached = stats.last.cached;
+      node.smpFraction =
+          stats.frames > 0 ? static_cast<double>(stats.smpFrames) / static_cast<double>(stats.frames) : 0.0;
+      node.costNsPerPixel = stats.last.nsPerPixel;
+    }
+    profile.nodes.push_back(std::move(node));
+  }
+  return profile;
+}
+
+std::string toJson(const PipelineProfile& profile) {
+  nlohmann::json root;
+  root["frames"] = profile.frames;
+  root["frame_ms"] = {{"p50", profile.frameP50Ms}, {"p95", profile.frameP95Ms}, {"p99", profile.frameP99Ms}};
+  root["dispatch_us"] = profile.dispatchUs;
+
+  nlohmann::json nodes = nlohmann::json::array();
+  for (const auto& node : profile.nodes) {
+    nlohmann::json entry;
+    entry["effect"] = node.key;
+    entry["frames"] = node.frames;
+    entry["ms"] = {{"p50", node.p50Ms}, {"p95", node.p95Ms}, {"p99", node.p99Ms}, {"last", node.lastMs}};
+    entry["threads"] = node.lastThreads;
+    entry["tasks"] = node.lastTasks;
+    entry["pixels"] = node.lastPixels;
+    entry["smp"] = node.lastSmp;
+    entry["fused"] = node.lastFused;
+    entry["cached"] = node.lastCached;
+    entry["smp_fraction"] = node.smpFraction;
+    entry["ns_per_pixel"] = node.costNsPerPixel;
+    nodes.push_back(std::move(entry));
+  }
+  root["nodes"] = std::move(nodes);
+  return root.dump(2);
+}
+
+}  // namespace avs::core
@@ -0,0 +1,174 @@
+#include <avs/core/StateStream.hpp>
+
+#include <bit>
+#include <cstring>
+
+namespace avs::core {
+
+namespace {
+
+// Longest LEB128 encoding of a 64-bit value.
+constexpr int kMaxVarintBytes = 10;
+
+}  // namespace
+
+void StateWriter::writeVarUint(std::uint64_t value) {
+  while (value >= 0x80u) {
+    bytes_.push_back(static_cast<std::uint8_t>(value | 0x80u));
+    value >>= 7;
+  }
+  bytes_.push_back(static_cast<std::uint8_t>(value));
+}
+
+void StateWriter::writeVarInt(std::int64_t value) {
+  const std::uint64_t bits = static_cast<std::uint64_t>(value);
+  writeVarUint((bits << 1) ^ (value < 0 ? ~std::uint64_t{0} : std::uint64_t{0}));
+}
+
+void StateWriter::writeF32(float value) {
+  const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+  for (int shift = 0; shift < 32; shift += 8) {
+    bytes_.push_back(static_cast<std::uint8_t>(bits >> shift));
+  }
+}
+
+void StateWriter::writeF64(double value) {
+  const std::uint64_t bits = std::bit_cast<std::uint64_t>(value);
+  for (int shift = 0; shift < 64; shift += 8) {
+    bytes_.push_back(static_cast<std::uint8_t>(bits >> shift));
+  }
+}
+
+void StateWriter::writeBytes(const void* data, std::size_t size) {
+  writeVarUint(size);
+  const auto* begin = static_cast<const std::uint8_t*>(data);
+  bytes_.insert(bytes_.end(), begin, begin + size);
+}
+
+const std::uint8_t* StateReader::take(std::size_t count) {
+  if (failed_ || count > size_ - position_) {
+    failed_ = true;
+    return nullptr;
+  }
+  // An empty view may have no storage; a zero-length take still succeeds.
+  static constexpr std::uint8_t kEmpty = 0;
+  const std::uint8_t* start = data_ ? data_ + position_ : &kEmpty;
+  position_ += count;
+  return start;
+}
+
+bool StateReader::readBool() {
+  const std::uint8_t value = readU8();
+  if (value > 1u) {
+    failed_ = true;
+    return false;
+  }
+  return value != 0u;
+}
+
+std::uint8_t StateReader::readU8() {
+  const std::uint8_t* byte = take(1);
+  return byte ? *byte : 0u;
+}
+
+std::uint64_t StateReader::readVarUint() {
+  std::uint64_t value = 0;
+  for (int i = 0; i < kMaxVarintBytes; ++i) {
+    const std::uint8_t* byte = take(1);
+    if (!byte) {
+      return 0;
+    }
+    value |= static_cast<std::uint64_t>(*byte & 0x7Fu) << (7 * i);
+    if ((*byte & 0x80u) == 0) {
+      return value;
+    }
+  }
+  failed_ = true;
+  return 0;
+}
+
+std::int64_t StateReader::readVarInt() {
+  const std::uint64_t bits = readVarUint();
+  return static_cast<std::int64_t>((bits >> 1) ^ (~(bits & 1u) + 1u));
+}
+
+float StateReader::readF32() {
+  const std::uint8_t* bytes = take(4);
+  if (!bytes) {
+    return 0.0f;
+  }
+  std::uint32_t bits = 0;
+  for (int i = 0; i < 4; ++i) {
+    bits |= static_cast<std::uint32_t>(bytes[i]) << (8 * i);
+  }
+  return std::bit_cast<float>(bits);
+}
+
+double StateReader::readF64() {
+  const std::uint8_t* bytes = take(8);
+  if (!bytes) {
+    return 0.0;
+  }
+  std::uint64_t bits = 0;
+  for (int i = 0; i < 8; ++i) {
+    bits |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+  }
+  return std::bit_cast<double>(bits);
+}
+
+std::size_t StateReader::readSize(std::size_t limit) {
+  const std::uint64_t value = readVarUint();
+  if (value > limit) {
+    failed_ = true;
+    return 0;
+  }
+  return static_cast<std::size_t>(value);
+}
+
+bool StateReader::readBytes(std::vector<std::uint8_t>& out) {
+  // A blob can never be longer than what is left, which also bounds the allocation.
+  const std::size_t size = readSize(remaining());
+  const std::uint8_t* bytes = take(size);
+  if (!bytes) {
+    out.clear();
+    return false;
+  }
+  out.assign(bytes, bytes + size);
+  return true;
+}
+
+bool StateReader::readBytes(void* out, std::size_t size) {
+  if (readVarUint() != size) {
+    failed_ = true;
+    return false;
+  }
+  const std::uint8_t* bytes = take(size);
+  if (!bytes) {
+    return false;
+  }
+  if (size > 0) {
+    std::memcpy(out, bytes, size);
+  }
+  return true;
+}
+
+std::string StateReader::readString() {
+  const std::size_t size = readSize(remaining());
+  const std::uint8_t* bytes = take(size);
+  if (!bytes) {
+    return {};
+  }
+  return std::string(reinterpret_cast<const char*>(bytes), size);
+}
+
+StateReader StateReader::readSection() {
+  const std::size_t size = readSize(remaining());
+  const std::uint8_t* bytes = take(size);
+  StateReader section(bytes, bytes ? size : 0u);
+  if (!bytes) {
+    section.fail();
+  }
+  return section;
+}
+
+}  // namespace avs::core
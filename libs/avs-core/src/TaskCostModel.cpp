@@ -0,0 +1,101 @@
+#include <avs/core/TaskCostModel.hpp>
+
+#include <algorithm>
+
+namespace avs::core {
+
+namespace {
+
+// Weight of a new observation; frame-to-frame noise averages out over a
+// handful of frames while a real change of cost (new parameters, a resize)
+// still settles within a second.
+constexpr double kSmoothing = 0.25;
+
+double smooth(double current, double sample) { return current + (sample - current) * kSmoothing; }
+
+int clampToInt(double value, int limit) {
+  return value >= static_cast<double>(limit) ? limit : std::max(0, static_cast<int>(value));
+}
+
+}  // namespace
+
+TaskCostModel::TaskCostModel() : TaskCostModel(Config{}) {}
+
+TaskCostModel::TaskCostModel(const Config& config) : config_(config) {
+  config_.minPixelsPerTask = std::max<std::size_t>(1, config_.minPixelsPerTask);
+  config_.minTaskUs = std::max(0.0, config_.minTaskUs);
+  config_.tasksPerThread = std::max(1, config_.tasksPerThread);
+  dispatchUs_ = std::max(0.0, config_.initialDispatchUs);
+}
+
+TaskCostModel::Decision TaskCostModel::decide(std::size_t node, std::size_t pixels,
+                                              int poolThreads) const {
+  Decision decision;
+  decision.nsPerPixel = nsPerPixel(node, pixels);
+  if (poolThreads <= 1 || pixels == 0 || decision.nsPerPixel <= 0.0) {
+    return decision;
+  }
+
+  const double workUs = decision.nsPerPixel * static_cast<double>(pixels) / 1000.0;
+  const int maxTasks = poolThreads * config_.tasksPerThread;
+  const int tasksByPixels =
+      clampToInt(static_cast<double>(pixels / config_.minPixelsPerTask), maxTasks);
+  // A thread pays off once its share of the work outweighs the dispatch.
+  const double threadUs = std::max(dispatchUs_, config_.minTaskUs);
+  const int threadsByWork = threadUs > 0.0 ? clampToInt(workUs / threadUs, poolThreads) : poolThreads;
+  const int threads = std::min({poolThreads, threadsByWork, tasksByPixels});
+  if (threads < 2) {
+    return decision;
+  }
+
+  const int tasksByWork =
+      config_.minTaskUs > 0.0 ? clampToInt(workUs / config_.minTaskUs, maxTasks) : maxTasks;
+  decision.threads = threads;
+  decision.tasks = std::max(threads, std::min({threads * config_.tasksPerThread, tasksByPixels,
+                                               tasksByWork}));
+  return decision;
+}
+
+void TaskCostModel::observeWork(std::size_t node, std::size_t pixels, double workUs) {
+  if (pixels == 0 || workUs < 0.0) {
+    return;
+  }
+  if (node >= nodes_.size()) {
+    nodes_.resize(node + 1);
+  }
+  NodeCost& cost = nodes_[node];
+  const double sample = workUs * 1000.0 / static_cast<double>(pixels);
+
+  auto match = std::find_if(cost.sizes.begin(), cost.sizes.end(),
+                            [pixels](const Estimate& estimate) { return estimate.pixels == pixels; });
+  if (match != cost.sizes.end()) {
+    match->nsPerPixel = smooth(match->nsPerPixel, sample);
+  } else {
+    // A new frame size evicts the least recently observed one; empty slots go first.
+    match = std::min_element(
+        cost.sizes.begin(), cost.sizes.end(),
+        [](const Estimate& a, const Estimate& b) { return a.lastUse < b.lastUse; });
+    *match = Estimate{pixels, sample};
+  }
+  match->lastUse = ++cost.uses;
+  cost.latest = static_cast<std::size_t>(match - cost.sizes.begin());
+}
+
+void TaskCostModel::observeDispatch(double overheadUs) {
+  dispatchUs_ = std::max(0.0, smooth(dispatchUs_, overheadUs));
+}
+
+double TaskCostModel::nsPerPixel(std::size_t node, std::size_t pixels) const {
+  if (node >= nodes_.size()) {
+    return 0.0;
+  }
+  const NodeCost& cost = nodes_[node];
+  for (const Estimate& estimate : cost.sizes) {
+    if (estimate.pixels == pixels && pixels != 0) {
+      return estimate.nsPerPixel;
+    }
+  }
+  return cost.latest < kSizesPerNode ? cost.sizes[cost.latest].nsPerPixel : 0.0;
+}
+
+}  // namespace avs::core
@@ -1,29 +1,78 @@
 #include <avs/core/ThreadPool.hpp>
 
 #include <algorithm>
+#include <latch>
 
 namespace avs::core {
 
-ThreadPool::ThreadPool(int numThreads) {
+namespace {
+
+// Iterations an idle thread polls before parking; the first kBusySpins are
+// pure spins, the rest yield so an oversubscribed machine still makes progress.
+constexpr int kSpinIterations = 2048;
+constexpr int kBusySpins = 64;
+
+constexpr std::uint64_t packRange(std::uint32_t begin, std::uint32_t end) {
+  return (static_cast<std::uint64_t>(begin) << 32) | end;
+}
+
+constexpr std::uint32_t rangeBegin(std::uint64_t range) { return static_cast<std::uint32_t>(range >> 32); }
+
+constexpr std::uint32_t rangeEnd(std::uint64_t range) { return static_cast<std::uint32_t>(range); }
+
+void spinPause(int iteration) {
+  if (iteration >= kBusySpins) {
+    std::this_thread::yield();
+  }
+}
+
+}  // namespace
+
+ThreadPool::ThreadPool(int numThreads, const ThreadPlacement& placement) {
   if (numThreads <= 1) {
     // Single-threaded mode - no worker threads needed
     return;
   }
 
-  // Create worker threads
-  threads_.reserve(numThreads);
-  for (int i = 0; i < numThreads; ++i) {
-    threads_.emplace_back(&ThreadPool::workerLoop, this, i);
+  // The dispatching thread is worker 0; spawn the rest
+  workerCount_ = numThreads;
+  queues_ = std::make_unique<WorkQueue[]>(static_cast<std::size_t>(numThreads));
+  threads_.reserve(static_cast<std::size_t>(numThreads - 1));
+  if (placement.empty()) {
+    for (int i = 1; i < numThreads; ++i) {
+      threads_.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+    return;
   }
+
+  // Each worker places itself (nice levels only apply to the calling thread)
+  // and reports back before the pool is handed out.
+  placements_.resize(static_cast<std::size_t>(numThreads - 1));
+  std::latch placed(numThreads - 1);
+  for (int i = 1; i < numThreads; ++i) {
+    ThreadPlacement workerPlacement = placement;
+    if (!placement.cpus.empty()) {
+      workerPlacement.cpus = {placement.cpus[static_cast<std::size_t>(i) % placement.cpus.size()]};
+    }
+    threads_.emplace_back([this, i, workerPlacement, &placed] {
+      placements_[static_cast<std::size_t>(i - 1)] = applyThreadPlacement(workerPlacement);
+      placed.count_down();
+      workerLoop(i);
+    });
+  }
+  placed.wait();
 }
 
 ThreadPool::~ThreadPool() {
   {
     std::lock_guard<std::mutex> lock(mutex_);
     shutdown_ = true;
-    hasTask_ = true;  // Wake up threads
   }
-  taskReady_.notify_all();
+  for (int worker = 1; worker < workerCount_; ++worker) {
+    auto& wake = queues_[static_cast<std::size_t>(worker)].wake;
+    wake.fetch_add(1, std::memory_order_release);
+    wake.notify_one();
+  }
 
   for (auto& thread : threads_) {
     if (thread.joinable()) {
@@ -33,60 +82,145 @@ ThreadPool::~ThreadPool() {
 }
 
 void ThreadPool::execute(std::function<void(int, int)> task) {
-  if (threads_.empty()) {
-    // Single-threaded execution
-    task(0, 1);
+  const int threadCount = workerCount_;
+  parallelFor(threadCount, [&task, threadCount](int threadId, int /* workerIndex */) {
+    task(threadId, threadCount);
+  });
+}
+
+void ThreadPool::run(int taskCount, int maxWorkers, TaskRef task) {
+  if (taskCount <= 0) {
+    return;
+  }
+  const int active = std::clamp(maxWorkers, 1, workerCount_);
+  if (active <= 1 || taskCount == 1) {
+    for (int i = 0; i < taskCount; ++i) {
+      task.invoke(task.object, i, 0);
+    }
     return;
   }
 
-  // Multi-threaded execution
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    currentTask_ = std::move(task);
-    hasTask_ = true;
-    completedWorkers_ = 0;
+  // Seed every active worker with a contiguous slice; stealing rebalances from there.
+  // Workers past the limit are neither seeded nor woken.
+  task_ = task;
+  const int base = taskCount / active;
+  const int extra = taskCount % active;
+  for (int worker = 0; worker < active; ++worker) {
+    const int begin = worker * base + std::min(worker, extra);
+    const int end = begin + base + (worker < extra ? 1 : 0);
+    queues_[static_cast<std::size_t>(worker)].range.store(
+        packRange(static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(end)),
+        std::memory_order_relaxed);
   }
+  activeWorkers_.store(active, std::memory_order_relaxed);
+  finishedWorkers_.store(0, std::memory_order_relaxed);
 
-  // Wake up all worker threads
-  taskReady_.notify_all();
+  for (int worker = 1; worker < active; ++worker) {
+    auto& wake = queues_[static_cast<std::size_t>(worker)].wake;
+    wake.fetch_add(1, std::memory_order_release);
+    wake.notify_one();
+  }
 
-  // Wait for all workers to complete
-  {
-    std::unique_lock<std::mutex> lock(mutex_);
-    taskComplete_.wait(lock, [this] {
-      return completedWorkers_ == static_cast<int>(threads_.size());
-    });
-    hasTask_ = false;
+  drain(0);
+  waitForWorkers(active - 1);
+}
+
+void ThreadPool::waitForWorkers(int expected) {
+  for (int spin = 0; spin < kSpinIterations; ++spin) {
+    if (finishedWorkers_.load() == expected) {
+      return;
+    }
+    spinPause(spin);
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  dispatcherParked_ = true;
+  taskComplete_.wait(lock, [this, expected] { return finishedWorkers_.load() == expected; });
+  dispatcherParked_ = false;
+}
+
+void ThreadPool::drain(int workerIndex) {
+  if (workerIndex >= activeWorkers_.load(std::memory_order_relaxed)) {
+    return;
   }
+  int taskIndex = 0;
+  do {
+    while (popLocal(workerIndex, taskIndex)) {
+      task_.invoke(task_.object, taskIndex, workerIndex);
+    }
+  } while (steal(workerIndex));
 }
 
-void ThreadPool::workerLoop(int threadId) {
+bool ThreadPool::popLocal(int workerIndex, int& taskIndex) {
+  auto& range = queues_[static_cast<std::size_t>(workerIndex)].range;
+  std::uint64_t current = range.load(std::memory_order_acquire);
   while (true) {
-    std::function<void(int, int)> task;
-
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
-      taskReady_.wait(lock, [this] { return hasTask_; });
+    const std::uint32_t begin = rangeBegin(current);
+    const std::uint32_t end = rangeEnd(current);
+    if (begin >= end) {
+      return false;
+    }
+    if (range.compare_exchange_weak(current, packRange(begin + 1, end), std::memory_order_acq_rel,
+                                    std::memory_order_acquire)) {
+      taskIndex = static_cast<int>(begin);
+      return true;
+    }
+  }
+}
 
-      if (shutdown_) {
-        return;
+bool ThreadPool::steal(int workerIndex) {
+  const int active = activeWorkers_.load(std::memory_order_relaxed);
+  for (int offset = 1; offset < active; ++offset) {
+    const int victim = (workerIndex + offset) % active;
+    auto& range = queues_[static_cast<std::size_t>(victim)].range;
+    std::uint64_t current = range.load(std::memory_order_acquire);
+    while (true) {
+      const std::uint32_t begin = rangeBegin(current);
+      const std::uint32_t end = rangeEnd(current);
+      if (begin >= end) {
+        break;
+      }
+      // Take the back half (rounded up) so a single remaining task can move too.
+      const std::uint32_t take = (end - begin + 1u) / 2u;
+      if (range.compare_exchange_weak(current, packRange(begin, end - take), std::memory_order_acq_rel,
+                                      std::memory_order_acquire)) {
+        // Our own range is empty and only its owner ever grows it, so a plain store is safe.
+        queues_[static_cast<std::size_t>(workerIndex)].range.store(packRange(end - take, end),
+                                                                   std::memory_order_release);
+        return true;
       }
+    }
+  }
+  return false;
+}
 
-      task = currentTask_;
+void ThreadPool::workerLoop(int workerIndex) {
+  auto& wake = queues_[static_cast<std::size_t>(workerIndex)].wake;
+  std::uint32_t seenWake = 0;
+  while (true) {
+    std::uint32_t current = wake.load(std::memory_order_acquire);
+    for (int spin = 0; current == seenWake && spin < kSpinIterations; ++spin) {
+      spinPause(spin);
+      current = wake.load(std::memory_order_acquire);
+    }
+    while (current == seenWake) {
+      wake.wait(seenWake, std::memory_order_acquire);
+      current = wake.load(std::memory_order_acquire);
     }
 
-    // Execute the task
-    if (task) {
-      task(threadId, static_cast<int>(threads_.size()));
+    if (shutdown_.load()) {
+      return;
     }
 
+    seenWake = current;
+    // Read before checking in: once the last worker has, the dispatcher may start the next job.
+    const int expected = activeWorkers_.load(std::memory_order_relaxed) - 1;
+    drain(workerIndex);
+
     // Signal completion
-    {
+    if (finishedWorkers_.fetch_add(1) + 1 == expected && dispatcherParked_.load()) {
       std::lock_guard<std::mutex> lock(mutex_);
-      completedWorkers_++;
-      if (completedWorkers_ == static_cast<int>(threads_.size())) {
-        taskComplete_.notify_one();
-      }
+      taskComplete_.notify_one();
     }
   }
 }
@@ -0,0 +1,397 @@
+#include <avs/core/Transition.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+namespace avs::core {
+
+namespace {
+constexpr double kPi = 3.14159265358979323846;
+
+// Smooth S-curve using sine: sin((t - 0.5) * PI) / 2 + 0.5
+float smoothCurve(float t) { return static_cast<float>(std::sin((t - 0.5) * kPi) * 0.5 + 0.5); }
+
+// Blend two colors with linear interpolation
+std::array<std::uint8_t, 4> blendColors(const std::array<std::uint8_t, 4>& a,
+                                        const std::array<std::uint8_t, 4>& b, float t) {
+  const float oneMinusT = 1.0f - t;
+  return {
+      static_cast<std::uint8_t>(a[0] * oneMinusT + b[0] * t),
+      static_cast<std::uint8_t>(a[1] * oneMinusT + b[1] * t),
+      static_cast<std::uint8_t>(a[2] * oneMinusT + b[2] * t),
+      static_cast<std::uint8_t>(a[3] * oneMinusT + b[3] * t),
+  };
+}
+
+// In the modes below `srcA` is the incoming frame (`to`) and `srcB` the
+// outgoing one (`from`): pushes and wipes grow A across B as t rises.
+
+void renderCrossDissolve(const TransitionFrames& f, float t) {
+  const std::size_t pixelCount = f.width * f.height;
+  const std::uint8_t* srcA = f.to;
+  const std::uint8_t* srcB = f.from;
+  std::uint8_t* dst = f.dst;
+
+  for (std::size_t i = 0; i < pixelCount; ++i) {
+    const std::size_t offset = i * 4;
+    const std::array<std::uint8_t, 4> colorA = {
+        srcA[offset], srcA[offset + 1], srcA[offset + 2], srcA[offset + 3]};
+    const std::array<std::uint8_t, 4> colorB = {
+        srcB[offset], srcB[offset + 1], srcB[offset + 2], srcB[offset + 3]};
+    const auto blended = blendColors(colorB, colorA, t);
+    dst[offset] = blended[0];
+    dst[offset + 1] = blended[1];
+    dst[offset + 2] = blended[2];
+    dst[offset + 3] = blended[3];
+  }
+}
+
+void renderLeftRightPush(const TransitionFrames& f, float t) {
+  const int pushOffset = static_cast<int>(t * f.width);
+  const std::uint8_t* srcA = f.to;
+  const std::uint8_t* srcB = f.from;
+  std::uint8_t* dst = f.dst;
+
+  for (int y = 0; y < f.height; ++y) {
+    const int rowOffset = y * f.width * 4;
+    // Copy pushed part of A (from right side)
+    const int srcAOffset = rowOffset + (f.width - pushOffset) * 4;
+    std::memcpy(dst + rowOffset, srcA + srcAOffset, pushOffset * 4);
+    // Copy revealed part of B
+    const int dstOffset = rowOffset + pushOffset * 4;
+    std::memcpy(dst + dstOffset, srcB + rowOffset, (f.width - pushOffset) * 4);
+  }
+}
+
+void renderRightLeftPush(const TransitionFrames& f, float t) {
+  const int pushOffset = static_cast<int>(t * f.width);
+  const std::uint8_t* srcA = f.to;
+  const std::uint8_t* srcB = f.from;
+  std::uint8_t* dst = f.dst;
+
+  for (int y = 0; y < f.height; ++y) {
+    const int rowOffset = y * f.width * 4;
+    // Copy revealed part of B
+    const int srcBOffset = rowOffset + pushOffset * 4;
+    std::memcpy(dst + rowOffset, srcB + srcBOffset, (f.width - pushOffset) * 4);
+    // Copy pushed part of A
+    const int dstOffset = rowOffset + (f.width - pushOffset) * 4;
+    std::memcpy(dst + dstOffset, srcA + rowOffset, pushOffset * 4);
+  }
+}
+
+void renderTopBottomPush(const TransitionFrames& f, float t) {
+  const int pushOffset = static_cast<int>(t * f.height);
+  const std::uint8_t* srcA = f.to;
+  const std::uint8_t* srcB = f.from;
+  std::uint8_t* dst = f.dst;
+
+  // Copy pushed part of A (from bottom)
+  const std::size_t pushBytes = pushOffset * f.width * 4;
+  const std::size_t srcAOffset = (f.height - pushOffset) * f.width * 4;
+  std::memcpy(dst, srcA + srcAOffset, pushBytes);
+
+  // Copy revealed part of B
+  const std::size_t revealBytes = (f.height - pushOffset) * f.width * 4;
+  std::memcpy(dst + pushBytes, srcB, revealBytes);
+}
+
+void renderBottomTopPush(const TransitionFrames& f, float t) {
+  const int pushOffset = static_cast<int>(t * f.height);
+  const std::uint8_t* srcA = f.to;
+  const std::uint8_t* srcB = f.from;
+  std::uint8_t* dst = f.dst;
+
+  // Copy revealed part of B
+  const std::size_t revealBytes = (f.height - pushOffset) * f.width * 4;
+  const std::size_t srcBOffset = pushOffset * f.width * 4;
+  std::memcpy(dst, srcB + srcBOffset, revealBytes);
+
+  // Copy pushed part of A
+  std::memcpy(dst + revealBytes, srcA, pushOffset * f.width * 4);
+}
+
+void renderNineRandomBlocks(const TransitionFrames& f, float t, std::uint32_t& blockMask,
+                            DeterministicRng& rng) {
+  // Divide screen into 3x3 grid and reveal blocks randomly
+  const int stepCount = 9;
+  const int currentStep = static_cast<int>(t * stepCount);
+
+  // Reveal one block per step, catching up on steps a long frame skipped
+  for (int step = 0; step <= currentStep && step < stepCount; ++step) {
+    const int stepMask = 1 << (10 + step);
+    if ((blockMask & stepMask) != 0) {
+      continue;
+    }
+    // Pick a random unset block
+    int block;
+    do {
+      block = static_cast<int>(rng.nextUint32() % 9);
+    } while ((blockMask & (1 << block)) != 0 && (blockMask & 0x1FF) != 0x1FF);
+    blockMask |= (1 << block) | stepMask;
+  }
+
+  const int blockWidth = f.width / 3;
+  const int blockHeight = f.height / 3;
+  const int blockWidthRem = f.width - 2 * blockWidth;
+  const int blockHeightRem = f.height - 2 * blockHeight;
+
+  const std::uint8_t* srcA = f.to;
+  const std::uint8_t* srcB = f.from;
+  std::uint8_t* dst = f.dst;
+
+  // Start with buffer B
+  std::memcpy(dst, srcB, f.width * f.height * 4);
+
+  // Overwrite revealed blocks with buffer A
+  for (int block = 0; block < 9; ++block) {
+    if ((blockMask & (1 << block)) == 0) {
+      continue;
+    }
+
+    const int bx = block % 3;
+    const int by = block / 3;
+    const int blockW = (bx == 2) ? blockWidthRem : blockWidth;
+    const int blockH = (by == 2) ? blockHeightRem : blockHeight;
+
+    for (int y = 0; y < blockH; ++y) {
+      const int srcY = by * blockHeight + y;
+      const int srcX = bx * blockWidth;
+      const std::size_t srcOffset = (srcY * f.width + srcX) * 4;
+      const std::size_t dstOffset = srcOffset;
+      std::memcpy(dst + dstOffset, srcA + srcOffset, blockW * 4);
+    }
+  }
+}
+
+void renderSplitLeftRightPush(const TransitionFrames& f, float t) {
+  const int pushOffset = static_cast<int>(t * f.width);
+  const std::uint8_t* srcA = f.to;
+  const std::uint8_t* srcB = f.from;
+  std::uint8_t* dst = f.dst;
+
+  const int halfHeight = f.height / 2;
+
+  // Top half: push left to right
+  for (int y = 0; y < halfHeight; ++y) {
+    const int rowOffset = y * f.width * 4;
+    // Revealed part of B
+    std::memcpy(dst + rowOffset, srcB + rowOffset + pushOffset * 4,
+                (f.width - pushOffset) * 4);
+    // Pushed part of A (from right side)
+    const int dstOffset = rowOffset + (f.width - pushOffset) * 4;
+    const int srcAOffset = rowOffset + (f.width - pushOffset) * 4;
+    std::memcpy(dst + dstOffset, srcA + srcAOffset, pushOffset * 4);
+  }
+
+  // Bottom half: push right to left
+  for (int y = halfHeight; y < f.height; ++y) {
+    const int rowOffset = y * f.width * 4;
+    // Revealed part of B
+    const int srcBOffset = rowOffset + pushOffset * 4;
+    std::memcpy(dst + rowOffset, srcB + srcBOffset, (f.width - pushOffset) * 4);
+    // Pushed part of A
+    const int dstOffset = rowOffset + (f.width - pushOffset) * 4;
+    std::memcpy(dst + dstOffset, srcA + rowOffset, pushOffset * 4);
+  }
+}
+
+void renderLeftRightToCenterPush(const TransitionFrames& f, float t) {
+  const int pushOffset = static_cast<int>(t * f.width / 2);
+  const std::uint8_t* srcA = f.to;
+  const std::uint8_t* srcB = f.from;
+  std::uint8_t* dst = f.dst;
+
+  for (int y = 0; y < f.height; ++y) {
+    const int rowOffset = y * f.width * 4;
+    // Left side: push from left
+    const int srcALeftOffset = rowOffset + (f.width / 2 - pushOffset) * 4;
+    std::memcpy(dst + rowOffset, srcA + srcALeftOffset, pushOffset * 4);
+    // Right side: push from right
+    const int dstRightOffset = rowOffset + (f.width - pushOffset) * 4;
+    const int srcARightOffset = rowOffset + f.width / 2 * 4;
+    std::memcpy(dst + dstRightOffset, srcA + srcARightOffset, pushOffset * 4);
+    // Center: revealed part of B
+    const int centerOffset = rowOffset + pushOffset * 4;
+    const int centerWidth = f.width - 2 * pushOffset;
+    std::memcpy(dst + centerOffset, srcB + centerOffset, centerWidth * 4);
+  }
+}
+
+void renderLeftRightToCenterSqueeze(const TransitionFrames& f, float t) {
+  const int squeezeWidth = static_cast<int>(t * f.width / 2);
+  const std::uint8_t* srcA = f.to;
+  const std::uint8_t* srcB = f.from;
+  std::uint8_t* dst = f.dst;
+
+  for (int y = 0; y < f.height; ++y) {
+    const int rowOffset = y * f.width * 4;
+
+    // Left squeezed section
+    if (squeezeWidth > 0) {
+      const float scaleX = (f.width / 2.0f) / squeezeWidth;
+      for (int x = 0; x < squeezeWidth; ++x) {
+        const int srcX = static_cast<int>(x * scaleX);
+        const std::size_t srcOffset = (y * f.width + srcX) * 4;
+        const std::size_t dstOffset = rowOffset + x * 4;
+        std::memcpy(dst + dstOffset, srcA + srcOffset, 4);
+      }
+    }
+
+    // Center section from B
+    const int centerWidth = f.width - 2 * squeezeWidth;
+    if (centerWidth > 0) {
+      const float scaleX = static_cast<float>(f.width) / centerWidth;
+      for (int x = 0; x < centerWidth; ++x) {
+        const int srcX = static_cast<int>(x * scaleX);
+        const std::size_t srcOffset = (y * f.width + srcX) * 4;
+        const std::size_t dstOffset = rowOffset + (squeezeWidth + x) * 4;
+        std::memcpy(dst + dstOffset, srcB + srcOffset, 4);
+      }
+    }
+
+    // Right squeezed section
+    if (squeezeWidth > 0) {
+      const float scaleX = (f.width / 2.0f) / squeezeWidth;
+      for (int x = 0; x < squeezeWidth; ++x) {
+        const int srcX = f.width / 2 + static_cast<int>(x * scaleX);
+        const std::size_t srcOffset = (y * f.width + srcX) * 4;
+        const std::size_t dstOffset = rowOffset + (f.width - squeezeWidth + x) * 4;
+        std::memcpy(dst + dstOffset, srcA + srcOffset, 4);
+      }
+    }
+  }
+}
+
+void renderLeftRightWipe(const TransitionFrames& f, float t) {
+  const int wipeOffset = static_cast<int>(t * f.width);
+  const std::uint8_t* srcA = f.to;
+  const std::uint8_t* srcB = f.from;
+  std::uint8_t* dst = f.dst;
+
+  for (int y = 0; y < f.height; ++y) {
+    const int rowOffset = y * f.width * 4;
+    // Wiped part (A)
+    std::memcpy(dst + rowOffset, srcA + rowOffset, wipeOffset * 4);
+    // Remaining part (B)
+    const int remainOffset = rowOffset + wipeOffset * 4;
+    std::memcpy(dst + remainOffset, srcB + remainOffset, (f.width - wipeOffset) * 4);
+  }
+}
+
+void renderRightLeftWipe(const TransitionFrames& f, float t) {
+  const int wipeOffset = static_cast<int>(t * f.width);
+  const std::uint8_t* srcA = f.to;
+  const std::uint8_t* srcB = f.from;
+  std::uint8_t* dst = f.dst;
+
+  for (int y = 0; y < f.height; ++y) {
+    const int rowOffset = y * f.width * 4;
+    // Remaining part (B)
+    std::memcpy(dst + rowOffset, srcB + rowOffset, (f.width - wipeOffset) * 4);
+    // Wiped part (A)
+    const int wipeStart = rowOffset + (f.width - wipeOffset) * 4;
+    std::memcpy(dst + wipeStart, srcA + wipeStart, wipeOffset * 4);
+  }
+}
+
+void renderTopBottomWipe(const TransitionFrames& f, float t) {
+  const int wipeOffset = static_cast<int>(t * f.height);
+  const std::uint8_t* srcA = f.to;
+  const std::uint8_t* srcB = f.from;
+  std::uint8_t* dst = f.dst;
+
+  const std::size_t wipeBytes = wipeOffset * f.width * 4;
+  // Wiped part (A)
+  std::memcpy(dst, srcA, wipeBytes);
+  // Remaining part (B)
+  std::memcpy(dst + wipeBytes, srcB + wipeBytes,
+              (f.height - wipeOffset) * f.width * 4);
+}
+
+void renderBottomTopWipe(const TransitionFrames& f, float t) {
+  const int wipeOffset = static_cast<int>(t * f.height);
+  const std::uint8_t* srcA = f.to;
+  const std::uint8_t* srcB = f.from;
+  std::uint8_t* dst = f.dst;
+
+  const std::size_t remainBytes = (f.height - wipeOffset) * f.width * 4;
+  // Remaining part (B)
+  std::memcpy(dst, srcB, remainBytes);
+  // Wiped part (A)
+  std::memcpy(dst + remainBytes, srcA + remainBytes, wipeOffset * f.width * 4);
+}
+
+void renderDotDissolve(const TransitionFrames& f, float t) {
+  // Ordered dither: each pixel of a 4x4 Bayer cell switches to the incoming
+  // frame once progress passes its threshold, so the dots fill in evenly.
+  static constexpr std::array<std::uint8_t, 16> kBayer = {0, 8,  2, 10, 12, 4, 14, 6,
+                                                          3, 11, 1, 9,  15, 7, 13, 5};
+  const int level = static_cast<int>(t * 16.0f);
+  for (int y = 0; y < f.height; ++y) {
+    for (int x = 0; x < f.width; ++x) {
+      const bool useTo = kBayer[static_cast<std::size_t>((y & 3) * 4 + (x & 3))] < level;
+      const std::size_t offset = (static_cast<std::size_t>(y) * f.width + x) * 4;
+      std::memcpy(f.dst + offset, (useTo ? f.to : f.from) + offset, 4);
+    }
+  }
+}
+
+}  // namespace
+
+void compositeTransition(TransitionMode mode, const TransitionFrames& frames,
+                         float progress, std::uint32_t& blockMask,
+                         DeterministicRng& rng) {
+  using Mode = TransitionMode;
+  const float t = smoothCurve(std::clamp(progress, 0.0f, 1.0f));
+  switch (mode) {
+    case Mode::kRandom:
+    case Mode::kCrossDissolve:
+      renderCrossDissolve(frames, t);
+      break;
+    case Mode::kLeftRightPush:
+      renderLeftRightPush(frames, t);
+      break;
+    case Mode::kRightLeftPush:
+      renderRightLeftPush(frames, t);
+      break;
+    case Mode::kTopBottomPush:
+      renderTopBottomPush(frames, t);
+      break;
+    case Mode::kBottomTopPush:
+      renderBottomTopPush(frames, t);
+      break;
+    case Mode::kNineRandomBlocks:
+      renderNineRandomBlocks(frames, t, blockMask, rng);
+      break;
+    case Mode::kSplitLeftRightPush:
+      renderSplitLeftRightPush(frames, t);
+      break;
+    case Mode::kLeftRightToCenterPush:
+      renderLeftRightToCenterPush(frames, t);
+      break;
+    case Mode::kLeftRightToCenterSqueeze:
+      renderLeftRightToCenterSqueeze(frames, t);
+      break;
+    case Mode::kLeftRightWipe:
+      renderLeftRightWipe(frames, t);
+      break;
+    case Mode::kRightLeftWipe:
+      renderRightLeftWipe(frames, t);
+      break;
+    case Mode::kTopBottomWipe:
+      renderTopBottomWipe(frames, t);
+      break;
+    case Mode::kBottomTopWipe:
+      renderBottomTopWipe(frames, t);
+      break;
+    case Mode::kDotDissolve:
+      renderDotDissolve(frames, t);
+      break;
+  }
+}
+
+}  // namespace avs::core
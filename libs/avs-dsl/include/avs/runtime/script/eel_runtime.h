@@ -2,10 +2,12 @@
 
 #include <array>
 #include <cstdint>
-#include <random>
 #include <string>
 #include <string_view>
 
+#include <avs/core/Mt19937.hpp>
+#include <avs/core/StateStream.hpp>
+
 #include "ns-eel-addfuncs.h"
 #include "ns-eel.h"
 
@@ -48,6 +50,12 @@ class EelRuntime {
   [[nodiscard]] std::array<double, 32> snapshotQ() const;
   [[nodiscard]] std::array<EelVarPointer, 32> qPointers() const;
 
+  // Checkpoint of the VM: every variable by name, the megabuf blocks in use and
+  // the rand() stream. Compiled code is not included; a runtime restored
+  // before or after compiling the same scripts continues where this one was.
+  void saveState(avs::core::StateWriter& writer) const;
+  bool restoreState(avs::core::StateReader& reader);
+
  private:
   static void ensureGlobalInit();
 
@@ -59,7 +67,7 @@ class EelRuntime {
 
   NSEEL_VMCTX ctx_ = nullptr;
   NSEEL_CODEHANDLE handles_[3]{};
-  std::mt19937 rng_{};
+  avs::core::Mt19937 rng_{};
   std::array<EelVarPointer, 32> qRegisters_{};
 };
 
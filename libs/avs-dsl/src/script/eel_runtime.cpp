@@ -2,9 +2,27 @@
 
 #include <algorithm>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 namespace {
 std::once_flag gEelInitFlag;
+
+// Smallest encoded variable: a one-byte name with its length, then the f64.
+constexpr std::size_t kMinVarBytes = 2 + 8;
+
+using VarList = std::vector<std::pair<std::string, avs::runtime::script::EelVarPointer>>;
+
+int collectVar(const char* name, EEL_F* value, void* userctx) {
+  static_cast<VarList*>(userctx)->emplace_back(name, value);
+  return 1;
+}
+
+VarList listVars(NSEEL_VMCTX ctx) {
+  VarList vars;
+  NSEEL_VM_enumallvars(ctx, collectVar, &vars);
+  return vars;
+}
 }  // namespace
 
 namespace avs::runtime::script {
@@ -120,6 +138,98 @@ std::array<EelVarPointer, 32> EelRuntime::qPointers() const {
   return qRegisters_;
 }
 
+void EelRuntime::saveState(avs::core::StateWriter& writer) const {
+  auto vars = listVars(ctx_);
+  std::sort(vars.begin(), vars.end());
+  writer.writeVarUint(vars.size());
+  for (const auto& [name, value] : vars) {
+    writer.writeString(name);
+    writer.writeF64(value ? static_cast<double>(*value) : 0.0);
+  }
+
+  // Only allocated blocks, each without its trailing zeros.
+  std::vector<std::pair<unsigned int, int>> blocks;
+  for (unsigned int block = 0; block < NSEEL_RAM_BLOCKS; ++block) {
+    int valid = 0;
+    const EEL_F* ram = NSEEL_VM_getramptr_noalloc(ctx_, block * NSEEL_RAM_ITEMSPERBLOCK, &valid);
+    int used = ram ? valid : 0;
+    while (used > 0 && ram[used - 1] == 0.0) {
+      --used;
+    }
+    if (used > 0) {
+      blocks.emplace_back(block, used);
+    }
+  }
+  writer.writeVarUint(blocks.size());
+  for (const auto& [block, used] : blocks) {
+    const EEL_F* ram = NSEEL_VM_getramptr_noalloc(ctx_, block * NSEEL_RAM_ITEMSPERBLOCK, nullptr);
+    writer.writeVarUint(block);
+    writer.writeVarUint(static_cast<std::uint64_t>(used));
+    for (int i = 0; i < used; ++i) {
+      writer.writeF64(static_cast<double>(ram[i]));
+    }
+  }
+
+  rng_.saveState(writer);
+}
+
+bool EelRuntime::restoreState(avs::core::StateReader& reader) {
+  // Everything is read and checked before the VM is touched.
+  std::vector<std::pair<std::string, double>> vars(
+      reader.readSize(reader.remaining() / kMinVarBytes));
+  for (auto& [name, value] : vars) {
+    name = reader.readString();
+    value = reader.readF64();
+    if (name.empty()) {
+      reader.fail();
+    }
+  }
+
+  const unsigned int maxBlocks =
+      static_cast<unsigned int>(NSEEL_VM_setramsize(ctx_, 0)) / NSEEL_RAM_ITEMSPERBLOCK;
+  std::vector<std::pair<unsigned int, std::vector<double>>> blocks(
+      reader.readSize(std::min<std::size_t>(maxBlocks, reader.remaining())));
+  for (auto& [block, values] : blocks) {
+    block = static_cast<unsigned int>(reader.readSize(maxBlocks - 1));
+    values.resize(reader.readSize(
+        std::min<std::size_t>(NSEEL_RAM_ITEMSPERBLOCK, reader.remaining() / 8u)));
+    for (double& value : values) {
+      value = reader.readF64();
+    }
+  }
+
+  avs::core::Mt19937 rng;
+  if (!rng.restoreState(reader)) {
+    return false;
+  }
+
+  // Variables missing from the checkpoint did not exist yet when it was taken.
+  for (const auto& entry : listVars(ctx_)) {
+    if (entry.second) {
+      *entry.second = 0.0;
+    }
+  }
+  for (const auto& [name, value] : vars) {
+    EEL_F* var = NSEEL_VM_regvar(ctx_, name.c_str());
+    if (!var) {
+      return false;
+    }
+    *var = static_cast<EEL_F>(value);
+  }
+
+  NSEEL_VM_freeRAM(ctx_);
+  for (const auto& [block, values] : blocks) {
+    EEL_F* ram = NSEEL_VM_getramptr(ctx_, block * NSEEL_RAM_ITEMSPERBLOCK, nullptr);
+    if (!ram) {
+      return false;
+    }
+    std::copy(values.begin(), values.end(), ram);
+  }
+
+  rng_ = rng;
+  return true;
+}
+
 EEL_F EelRuntime::funcRand(void* opaque) {
   auto* self = static_cast<EelRuntime*>(opaque);
   const double value = static_cast<double>(self->rng_()) / static_cast<double>(self->rng_.max());
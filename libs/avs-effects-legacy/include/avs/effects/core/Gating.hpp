@@ -1,5 +1,7 @@
 #pragma once
 
+#include <avs/core/StateStream.hpp>
+
 namespace avs::effects {
 
 enum class GateFlag {
@@ -30,6 +32,10 @@ class BeatGate {
   [[nodiscard]] GateResult step(bool beatEvent);
   [[nodiscard]] bool stickyActive() const { return stickyActive_; }
 
+  // Hold and sticky state; the options come from the effect's parameters.
+  void saveState(avs::core::StateWriter& writer) const;
+  bool restoreState(avs::core::StateReader& reader);
+
  private:
   GateOptions options_{};
   int holdCounter_{0};
@@ -18,12 +18,16 @@ class ScriptedEffect : public avs::core::IEffect {
 
   bool render(avs::core::RenderContext& context) override;
   void setParams(const avs::core::ParamBlock& params) override;
+  void saveState(avs::core::StateWriter& writer) const override;
+  bool restoreState(avs::core::StateReader& reader) override;
 
  private:
   struct OverlayStyle;
 
   void ensureRuntime();
   bool compileScripts();
+  /** Recompile after a script change, rearming the init stage on success. */
+  void compileIfDirty();
   void rebuildScriptsFromParams(const avs::core::ParamBlock& params);
   bool executeStage(avs::runtime::script::EelRuntime::Stage stage,
                     avs::runtime::script::ExecutionBudget& budget,
@@ -3,6 +3,7 @@
 #include <array>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <avs/runtime/script/eel_runtime.h>
 #include <avs/effects/dynamic/frame_warp.h>
@@ -18,7 +19,12 @@ class DynamicShaderEffect : public FrameWarpEffect {
   ~DynamicShaderEffect() override = default;
 
   void setParams(const avs::core::ParamBlock& params) override;
-  bool render(avs::core::RenderContext& context) override;
+  // Below full quality the pixel script runs on a coarse grid and the sample
+  // coordinates in between are interpolated.
+  void setQualityLevel(int level) override;
+  // History, script time and the EEL variables and memory.
+  void saveState(avs::core::StateWriter& writer) const override;
+  bool restoreState(avs::core::StateReader& reader) override;
 
  protected:
   struct SampleCoord {
@@ -26,6 +32,11 @@ class DynamicShaderEffect : public FrameWarpEffect {
     float y{0.0f};
   };
 
+  // The EEL runtime is a single VM whose globals persist across pixels, so the
+  // pixel script runs serially here and only the history sampling is banded.
+  WarpStart beginWarp(avs::core::RenderContext& context) override;
+  void warpRows(avs::core::RenderContext& context, int rowBegin, int rowEnd) override;
+
   virtual SampleCoord resolveSample() const = 0;
 
   EEL_F* xVar_{nullptr};
@@ -45,6 +56,8 @@ class DynamicShaderEffect : public FrameWarpEffect {
   bool executeStage(avs::runtime::script::EelRuntime::Stage stage);
   void bindFrame(const avs::core::RenderContext& context);
   void bindPixel(int px, int py, const avs::core::RenderContext& context);
+  bool evaluatePixel(int px, int py, const avs::core::RenderContext& context, SampleCoord& out);
+  bool evaluateGrid(int width, int height, int step, const avs::core::RenderContext& context);
 
   std::unique_ptr<avs::runtime::script::EelRuntime> runtime_;
   avs::runtime::script::ExecutionBudget budget_{};
@@ -61,6 +74,10 @@ class DynamicShaderEffect : public FrameWarpEffect {
   std::string frameScript_;
   std::string pixelScript_;
 
+  std::vector<SampleCoord> sampleCoords_;
+  std::vector<SampleCoord> gridCoords_;
+  int qualityLevel_{avs::core::kMaxQualityLevel};
+
   bool dirty_{true};
   bool initExecuted_{false};
   double timeSeconds_{0.0};
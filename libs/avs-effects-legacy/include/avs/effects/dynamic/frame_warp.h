@@ -13,14 +13,45 @@ namespace avs::effects {
 // frame. The class maintains an internal copy of the last rendered frame and
 // offers bilinear sampling in the normalized AVS coordinate space
 // (x,y in [-1, 1]).
+//
+// The base also drives rendering: it prepares the history once per frame,
+// lets the subclass set up per-frame state in beginWarp(), hands disjoint
+// destination rows to warpRows() (on the pipeline's thread pool when one is
+// available) and stores the history after every band has finished.
 class FrameWarpEffect : public avs::core::IEffect {
  public:
   FrameWarpEffect() = default;
   ~FrameWarpEffect() override = default;
 
+  bool render(avs::core::RenderContext& context) override;
+  int smp_begin(avs::core::RenderContext& context, int maxThreads) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool smp_finish(avs::core::RenderContext& context) override;
+  bool supportsMultiThreaded() const override { return true; }
+
+  // The history frame. Subclasses with state of their own extend these and
+  // call the base first.
+  void saveState(avs::core::StateWriter& writer) const override;
+  bool restoreState(avs::core::StateReader& reader) override;
+
  protected:
   using Rgba = std::array<std::uint8_t, 4>;
 
+  enum class WarpStart { Render, Skip, Abort };
+
+  // Per-frame setup on the dispatching thread, called after the history is
+  // ready. Skip leaves the frame and history untouched; Abort additionally
+  // reports failure to the pipeline.
+  virtual WarpStart beginWarp(avs::core::RenderContext& context) {
+    (void)context;
+    return WarpStart::Render;
+  }
+
+  // Writes destination rows [rowBegin, rowEnd). Runs concurrently for
+  // disjoint row ranges, so it may only read the history and state prepared
+  // in beginWarp().
+  virtual void warpRows(avs::core::RenderContext& context, int rowBegin, int rowEnd) = 0;
+
   // Ensures the internal history buffer matches the provided framebuffer size.
   // On the very first call the current framebuffer contents become the history
   // so the first render pass samples from the supplied pixels.
@@ -36,6 +67,15 @@ class FrameWarpEffect : public avs::core::IEffect {
   // it clamps to the valid domain.
   [[nodiscard]] Rgba sampleHistory(float normX, float normY, bool wrap) const;
 
+  // The two halves of sampleHistory(): the pixel-space point it reads for
+  // normalized (normX, normY), and the bilinear sample at such a point.
+  // Effects whose mapping does not change between frames can keep the points
+  // and only sample per frame.
+  [[nodiscard]] std::array<float, 2> historyPoint(float normX, float normY, bool wrap) const;
+  [[nodiscard]] Rgba sampleHistoryAt(const std::array<float, 2>& point, bool wrap) const {
+    return bilinearSample(point[0], point[1], wrap);
+  }
+
   [[nodiscard]] int historyWidth() const { return width_; }
   [[nodiscard]] int historyHeight() const { return height_; }
 
@@ -48,6 +88,8 @@ class FrameWarpEffect : public avs::core::IEffect {
   std::vector<std::uint8_t> history_;
   int width_{0};
   int height_{0};
+  bool frameActive_{false};
+  bool frameFailed_{false};
 };
 
 }  // namespace avs::effects
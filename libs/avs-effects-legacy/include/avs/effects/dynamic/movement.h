@@ -1,16 +1,25 @@
 #pragma once
 
+#include <array>
+#include <vector>
+
 #include <avs/effects/dynamic/frame_warp.h>
 
 namespace avs::effects {
 
+// Static scale/rotate/offset warp of the previous frame. The mapping depends
+// only on the parameters and the frame size, so the history point of every
+// pixel is kept in a table that is rebuilt only when one of those changes.
 class MovementEffect : public FrameWarpEffect {
  public:
   MovementEffect() = default;
   ~MovementEffect() override = default;
 
   void setParams(const avs::core::ParamBlock& params) override;
-  bool render(avs::core::RenderContext& context) override;
+
+ protected:
+  WarpStart beginWarp(avs::core::RenderContext& context) override;
+  void warpRows(avs::core::RenderContext& context, int rowBegin, int rowEnd) override;
 
  private:
   float scale_{1.0f};
@@ -18,6 +27,13 @@ class MovementEffect : public FrameWarpEffect {
   float offsetX_{0.0f};
   float offsetY_{0.0f};
   bool wrap_{false};
+
+  void rebuildPoints();
+
+  std::vector<std::array<float, 2>> points_;
+  int pointsWidth_{0};
+  int pointsHeight_{0};
+  bool pointsDirty_{true};
 };
 
 }  // namespace avs::effects
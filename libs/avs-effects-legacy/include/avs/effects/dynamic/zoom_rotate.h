@@ -10,7 +10,10 @@ class ZoomRotateEffect : public FrameWarpEffect {
   ~ZoomRotateEffect() override = default;
 
   void setParams(const avs::core::ParamBlock& params) override;
-  bool render(avs::core::RenderContext& context) override;
+
+ protected:
+  WarpStart beginWarp(avs::core::RenderContext& context) override;
+  void warpRows(avs::core::RenderContext& context, int rowBegin, int rowEnd) override;
 
  private:
   float zoom_{1.0f};
@@ -18,6 +21,10 @@ class ZoomRotateEffect : public FrameWarpEffect {
   float anchorX_{0.5f};
   float anchorY_{0.5f};
   bool wrap_{false};
+
+  float cosR_{1.0f};
+  float sinR_{0.0f};
+  float invZoom_{1.0f};
 };
 
 }  // namespace avs::effects
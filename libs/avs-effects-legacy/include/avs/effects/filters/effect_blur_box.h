@@ -4,6 +4,7 @@
 #include <vector>
 
 #include <avs/core/IEffect.hpp>
+#include <avs/core/RowBand.hpp>
 
 namespace avs::effects::filters {
 
@@ -13,19 +14,36 @@ class BlurBox : public avs::core::IEffect {
   ~BlurBox() override = default;
 
   bool render(avs::core::RenderContext& context) override;
+  int smp_begin(avs::core::RenderContext& context, int maxThreads) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override {
+    return {avs::core::AccessPattern::Kind::Neighborhood, radius_};
+  }
   void setParams(const avs::core::ParamBlock& params) override;
+  void setQualityLevel(int level) override;
 
  private:
-  void ensureBuffers(int width, int height);
-  void horizontalPass(const std::uint8_t* src, std::uint8_t* dst, int width, int height) const;
-  void verticalPass(const std::uint8_t* src, std::uint8_t* dst, int width, int height) const;
-
-  int radius_ = 1;
+  /** Per-thread horizontal output for a band and its halo rows. */
+  struct BandScratch {
+    std::vector<std::uint8_t> rows;
+    std::vector<int> prefixRow;
+    std::vector<int> prefixColumn;
+  };
+
+  void horizontalPass(const std::uint8_t* src, std::uint8_t* dst, int width, int rows,
+                      std::vector<int>& prefixRow) const;
+  void verticalPass(const std::uint8_t* src, avs::core::RowBand srcRows, std::uint8_t* dst,
+                    int width, int height, avs::core::RowBand dstRows,
+                    std::vector<int>& prefixColumn) const;
+
+  int requestedRadius_ = 1;            ///< Radius from the parameters.
+  int radius_ = 1;                     ///< requestedRadius_ capped by the quality level.
+  int qualityLevel_ = avs::core::kMaxQualityLevel;
   bool preserveAlpha_ = true;
-  mutable std::vector<std::uint8_t> scratch_;
-  mutable std::vector<int> prefixRow_;
-  mutable std::vector<int> prefixColumn_;
+  bool snapshotSource_ = false;
+  std::vector<std::uint8_t> source_;
+  std::vector<BandScratch> bands_;
 };
 
 }  // namespace avs::effects::filters
-
@@ -15,6 +15,12 @@ class Convolution3x3 : public avs::core::IEffect {
   ~Convolution3x3() override = default;
 
   bool render(avs::core::RenderContext& context) override;
+  int smp_begin(avs::core::RenderContext& context, int maxThreads) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override {
+    return {avs::core::AccessPattern::Kind::Neighborhood, 1};
+  }
   void setParams(const avs::core::ParamBlock& params) override;
 
  private:
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 #include <avs/core/IEffect.hpp>
@@ -12,9 +13,22 @@ class FastBrightness : public avs::core::IEffect {
   ~FastBrightness() override = default;
 
   bool render(avs::core::RenderContext& context) override;
+  int smp_begin(avs::core::RenderContext& context, int maxThreads) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override {
+    return {avs::core::AccessPattern::Kind::Pointwise, 0};
+  }
+  bool hasChannelLut(const avs::core::RenderContext& context) const override;
+  bool preservesBlack(const avs::core::RenderContext& context) const override;
+  void buildChannelLut(avs::core::RenderContext& context, avs::core::ChannelLut& lut) override;
   void setParams(const avs::core::ParamBlock& params) override;
 
  private:
+  [[nodiscard]] bool isIdentity() const;
+  [[nodiscard]] std::uint8_t mapChannel(std::uint8_t value) const;
+  void applyPixels(std::uint8_t* pixels, std::size_t begin, std::size_t end) const;
+
   float amount_ = 2.0f;
   float bias_ = 0.0f;
   bool clampOutput_ = true;
@@ -1,33 +1,38 @@
 #pragma once
 
-#include <cstdint>
-#include <vector>
-
+#include <avs/core/DeterministicRng.hpp>
 #include <avs/core/IEffect.hpp>
 
 namespace avs::effects::filters {
 
+/**
+ * @brief Adds random per-channel noise of up to +/- amount.
+ *
+ * Noise is drawn per pixel index from a counter-based stream, so bands need no
+ * shared pattern and any thread count renders the same frame. Static grain
+ * keys the stream by seed alone and repeats every frame.
+ */
 class Grain : public avs::core::IEffect {
  public:
   Grain() = default;
   ~Grain() override = default;
 
   bool render(avs::core::RenderContext& context) override;
+  int smp_begin(avs::core::RenderContext& context, int maxThreads) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override {
+    return {avs::core::AccessPattern::Kind::Pointwise, 0};
+  }
   void setParams(const avs::core::ParamBlock& params) override;
 
  private:
-  void regenerateStaticPattern(int width, int height, std::uint64_t seedBase);
-
   int amount_ = 16;
   bool monochrome_ = false;
   bool staticGrain_ = false;
   int seedOffset_ = 0;
-  bool dirty_ = true;
 
-  int patternWidth_ = 0;
-  int patternHeight_ = 0;
-  std::uint64_t patternSeed_ = 0;
-  std::vector<int> staticPattern_;
+  avs::core::RandomStream stream_;  ///< This frame's noise, from smp_begin().
 };
 
 }  // namespace avs::effects::filters
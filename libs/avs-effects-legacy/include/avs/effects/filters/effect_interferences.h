@@ -3,6 +3,7 @@
 #include <array>
 #include <cstdint>
 
+#include <avs/core/DeterministicRng.hpp>
 #include <avs/core/IEffect.hpp>
 
 namespace avs::effects::filters {
@@ -15,6 +16,12 @@ class Interferences : public avs::core::IEffect {
   ~Interferences() override = default;
 
   bool render(avs::core::RenderContext& context) override;
+  int smp_begin(avs::core::RenderContext& context, int maxThreads) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override {
+    return {avs::core::AccessPattern::Kind::Pointwise, 0};
+  }
   void setParams(const avs::core::ParamBlock& params) override;
 
  private:
@@ -26,6 +33,9 @@ class Interferences : public avs::core::IEffect {
   bool vertical_ = false;
   Mode mode_ = Mode::Add;
   std::array<int, 3> tint_{{255, 255, 255}};
+
+  int framePhaseShift_ = 0;
+  avs::core::RandomStream noiseStream_;  ///< Per-pixel noise for this frame.
 };
 
 }  // namespace avs::effects::filters
@@ -16,6 +16,9 @@ class Comment : public avs::core::IEffect {
 
   bool render(avs::core::RenderContext& context) override;
   void setParams(const avs::core::ParamBlock& params) override;
+  avs::core::OutputDependence outputDependence() const override {
+    return avs::core::OutputDependence::Nothing;
+  }
 
   [[nodiscard]] const std::string& text() const noexcept { return comment_; }
 
@@ -17,6 +17,8 @@ class CustomBpmEffect : public avs::core::IEffect {
 
   void setParams(const avs::core::ParamBlock& params) override;
   bool render(avs::core::RenderContext& context) override;
+  void saveState(avs::core::StateWriter& writer) const override;
+  bool restoreState(avs::core::StateReader& reader) override;
 
  private:
   enum class Mode {
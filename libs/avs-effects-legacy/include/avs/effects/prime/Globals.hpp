@@ -17,10 +17,13 @@ class Globals : public avs::core::IEffect {
 
   bool render(avs::core::RenderContext& context) override;
   void setParams(const avs::core::ParamBlock& params) override;
+  void saveState(avs::core::StateWriter& writer) const override;
+  bool restoreState(avs::core::StateReader& reader) override;
 
  private:
   void ensureRuntime();
   bool compileScripts();
+  void compileIfDirty();
   void syncFromState(const avs::runtime::GlobalState& state);
   void syncToState(avs::runtime::GlobalState& state) const;
 
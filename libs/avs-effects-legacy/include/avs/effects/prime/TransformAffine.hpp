@@ -15,6 +15,8 @@ class TransformAffine : public avs::core::IEffect {
 
   bool render(avs::core::RenderContext& context) override;
   void setParams(const avs::core::ParamBlock& params) override;
+  void saveState(avs::core::StateWriter& writer) const override;
+  bool restoreState(avs::core::StateReader& reader) override;
 
  private:
   struct RandomConfig {
@@ -41,6 +41,14 @@ inline bool inBounds(const avs::core::RenderContext& ctx, int x, int y) {
   return x >= 0 && y >= 0 && x < ctx.width && y < ctx.height;
 }
 
+// Grows the frame's dirty region by the box spanning (x0, y0) and (x1, y1),
+// widened by pad pixels on every side.
+inline void markDrawn(avs::core::RenderContext& ctx, int x0, int y0, int x1, int y1, int pad = 0) {
+  ctx.dirtyOut.include(avs::core::DirtyRect{std::min(x0, x1) - pad, std::min(y0, y1) - pad,
+                                            std::max(x0, x1) + pad + 1,
+                                            std::max(y0, y1) + pad + 1});
+}
+
 inline std::uint8_t saturatingAdd(std::uint8_t a, std::uint8_t b) {
   const std::uint16_t sum = static_cast<std::uint16_t>(a) + static_cast<std::uint16_t>(b);
   return static_cast<std::uint8_t>(std::min<std::uint16_t>(sum, 255u));
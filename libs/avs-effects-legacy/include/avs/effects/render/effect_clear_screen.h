@@ -21,6 +21,7 @@ class ClearScreenEffect : public avs::core::IEffect {
 
   bool render(avs::core::RenderContext& context) override;
   void setParams(const avs::core::ParamBlock& params) override;
+  avs::core::OutputDependence outputDependence() const override;
 
   void setColor(std::uint32_t color) { color_ = color; }
   std::uint32_t color() const { return color_; }
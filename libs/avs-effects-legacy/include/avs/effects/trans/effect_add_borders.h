@@ -12,6 +12,7 @@ class AddBorders : public avs::core::IEffect {
 
   bool render(avs::core::RenderContext& context) override;
   void setParams(const avs::core::ParamBlock& params) override;
+  avs::core::OutputDependence outputDependence() const override;
 
  private:
   std::uint32_t color_ = 0x000000;  // Default: black
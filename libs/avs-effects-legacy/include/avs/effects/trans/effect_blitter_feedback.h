@@ -21,7 +21,9 @@ class BlitterFeedback : public avs::effects::FrameWarpEffect {
   ~BlitterFeedback() override = default;
 
   void setParams(const avs::core::ParamBlock& params) override;
-  bool render(avs::core::RenderContext& context) override;
+
+ protected:
+  void warpRows(avs::core::RenderContext& context, int rowBegin, int rowEnd) override;
 
  private:
   static int normalizeQuadrants(int value);
@@ -13,20 +13,27 @@ class R_Blur : public avs::core::IEffect {
   ~R_Blur() override = default;
 
   bool render(avs::core::RenderContext& context) override;
+  int smp_begin(avs::core::RenderContext& context, int maxThreads) override;
   bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
   bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override {
+    return {avs::core::AccessPattern::Kind::Neighborhood, vertical_ ? radius_ : 0};
+  }
   void setParams(const avs::core::ParamBlock& params) override;
+  void setQualityLevel(int level) override;
 
  private:
-  void ensureBuffers(int width, int height);
+  /** Point original_, blurred_ and (if @p needTemp) temp_ at this frame's scratch. */
+  void ensureBuffers(avs::core::RenderContext& context, bool needTemp);
   bool renderBox(avs::core::RenderContext& context);
   bool renderBoxThreaded(avs::core::RenderContext& context, int threadId, int maxThreads);
   void horizontalPass(const std::uint8_t* src, std::uint8_t* dst, int width, int height) const;
   void horizontalPassThreaded(const std::uint8_t* src, std::uint8_t* dst, int width, int height,
                               int startRow, int endRow) const;
   void verticalPass(const std::uint8_t* src, std::uint8_t* dst, int width, int height) const;
-  void verticalPassThreaded(const std::uint8_t* src, std::uint8_t* dst, int width, int height,
-                            int startRow, int endRow) const;
+  void verticalPassThreaded(const std::uint8_t* src, int srcBeginRow, int srcEndRow,
+                            std::uint8_t* dst, int width, int height, int startRow, int endRow,
+                            std::vector<int>& prefixColumn) const;
   void blend(std::uint8_t* dst,
              const std::uint8_t* original,
              const std::uint8_t* blurred,
@@ -40,20 +47,34 @@ class R_Blur : public avs::core::IEffect {
                      int startRow,
                      int endRow) const;
 
+  /** Per-thread horizontal output for a band and its halo rows. */
+  struct BandScratch {
+    std::vector<std::uint8_t> rows;
+    std::vector<int> prefixColumn;
+  };
+
   static int clampIndex(int value, int minValue, int maxValue);
   static std::uint8_t clampByte(int value);
 
-  int radius_ = 1;
+  int requestedRadius_ = 1;  ///< Radius from the parameters.
+  int radius_ = 1;           ///< requestedRadius_ capped by the quality level.
+  int qualityLevel_ = avs::core::kMaxQualityLevel;
   int strength_ = 256;
   bool horizontal_ = true;
   bool vertical_ = true;
   bool roundMode_ = false;
 
-  mutable std::vector<std::uint8_t> original_;
-  mutable std::vector<std::uint8_t> temp_;
-  mutable std::vector<std::uint8_t> blurred_;
+  // Frame scratch from ensureBuffers(); only valid until the frame ends.
+  std::uint8_t* original_ = nullptr;
+  std::uint8_t* temp_ = nullptr;
+  std::uint8_t* blurred_ = nullptr;
+  // Backing for the above when the context has no FrameArena.
+  std::vector<std::uint8_t> originalFallback_;
+  std::vector<std::uint8_t> tempFallback_;
+  std::vector<std::uint8_t> blurredFallback_;
   mutable std::vector<int> prefixRow_;
   mutable std::vector<int> prefixColumn_;
+  std::vector<BandScratch> bandScratch_;
 };
 
 }  // namespace avs::effects::trans
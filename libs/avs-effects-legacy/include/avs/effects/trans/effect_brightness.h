@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
 #include <avs/core/IEffect.hpp>
@@ -16,10 +17,20 @@ class Brightness : public avs::core::IEffect {
   ~Brightness() override = default;
 
   bool render(avs::core::RenderContext& context) override;
+  int smp_begin(avs::core::RenderContext& context, int maxThreads) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override {
+    return {avs::core::AccessPattern::Kind::Pointwise, 0};
+  }
+  bool hasChannelLut(const avs::core::RenderContext& context) const override;
+  bool preservesBlack(const avs::core::RenderContext& /* context */) const override { return true; }
+  void buildChannelLut(avs::core::RenderContext& context, avs::core::ChannelLut& lut) override;
   void setParams(const avs::core::ParamBlock& params) override;
 
  private:
   void updateLookupTables();
+  void applyPixels(std::uint8_t* pixels, std::size_t begin, std::size_t end) const;
   [[nodiscard]] bool shouldSkipPixel(const std::uint8_t* pixel) const;
 
   static int computeMultiplier(int sliderValue);
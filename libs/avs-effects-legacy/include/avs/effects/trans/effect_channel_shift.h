@@ -15,6 +15,13 @@ class ChannelShift : public avs::core::IEffect {
   ~ChannelShift() override = default;
 
   bool render(avs::core::RenderContext& context) override;
+  int smp_begin(avs::core::RenderContext& context, int maxThreads) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override {
+    return {avs::core::AccessPattern::Kind::Pointwise, 0};
+  }
+  bool preservesBlack(const avs::core::RenderContext& /* context */) const override { return true; }
   void setParams(const avs::core::ParamBlock& params) override;
 
  private:
@@ -15,6 +15,11 @@ class ColorClip : public avs::core::IEffect {
 
   void setParams(const avs::core::ParamBlock& params) override;
   bool render(avs::core::RenderContext& context) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override {
+    return {avs::core::AccessPattern::Kind::Pointwise, 0};
+  }
 
  private:
   bool enabled_ = true;
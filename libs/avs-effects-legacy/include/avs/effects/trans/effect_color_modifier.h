@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
 #include <avs/core/IEffect.hpp>
@@ -24,9 +25,18 @@ class ColorModifier : public avs::core::IEffect {
 
   void setParams(const avs::core::ParamBlock& params) override;
   bool render(avs::core::RenderContext& context) override;
+  int smp_begin(avs::core::RenderContext& context, int maxThreads) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override {
+    return {avs::core::AccessPattern::Kind::Pointwise, 0};
+  }
+  bool hasChannelLut(const avs::core::RenderContext& context) const override;
+  void buildChannelLut(avs::core::RenderContext& context, avs::core::ChannelLut& lut) override;
 
  private:
   void recomputeLookupTables();
+  void applyPixels(std::uint8_t* pixels, std::size_t begin, std::size_t end) const;
 
   bool enabled_ = true;
   Mode mode_ = Mode::Sine;
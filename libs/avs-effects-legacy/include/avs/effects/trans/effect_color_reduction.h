@@ -17,6 +17,14 @@ class ColorReduction : public avs::core::IEffect {
 
   void setParams(const avs::core::ParamBlock& params) override;
   bool render(avs::core::RenderContext& context) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override {
+    return {avs::core::AccessPattern::Kind::Pointwise, 0};
+  }
+  bool hasChannelLut(const avs::core::RenderContext& context) const override;
+  bool preservesBlack(const avs::core::RenderContext& /* context */) const override { return true; }
+  void buildChannelLut(avs::core::RenderContext& context, avs::core::ChannelLut& lut) override;
 
  private:
   void updateMask();
@@ -18,6 +18,13 @@ class InvertEffect : public avs::core::IEffect {
   ~InvertEffect() override = default;
 
   bool render(avs::core::RenderContext& context) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override {
+    return {avs::core::AccessPattern::Kind::Pointwise, 0};
+  }
+  bool hasChannelLut(const avs::core::RenderContext& context) const override;
+  void buildChannelLut(avs::core::RenderContext& context, avs::core::ChannelLut& lut) override;
   void setParams(const avs::core::ParamBlock& params) override;
 
   void setEnabled(bool enabled) { enabled_ = enabled; }
@@ -13,6 +13,12 @@ class Mosaic : public avs::core::IEffect {
   ~Mosaic() override = default;
 
   bool render(avs::core::RenderContext& context) override;
+  int smp_begin(avs::core::RenderContext& context, int maxThreads) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override {
+    return {avs::core::AccessPattern::Kind::Neighborhood, avs::core::kWholeFrameHalo};
+  }
   void setParams(const avs::core::ParamBlock& params) override;
 
  private:
@@ -25,7 +31,7 @@ class Mosaic : public avs::core::IEffect {
   static std::uint32_t blendAdditive(std::uint32_t dst, std::uint32_t src);
   static std::uint32_t blendAverage(std::uint32_t dst, std::uint32_t src);
 
-  void ensureScratch(std::size_t bytes);
+  void advanceBeatDecay();
 
   bool enabled_ = true;
   int quality_ = 50;
@@ -38,7 +44,10 @@ class Mosaic : public avs::core::IEffect {
   int remainingBeatFrames_ = 0;
   int currentQuality_ = 50;
 
-  std::vector<std::uint8_t> scratch_;
+  std::uint8_t* source_ = nullptr;     ///< Frame snapshot from smp_begin(); valid until the frame ends.
+  std::vector<std::uint8_t> scratch_;  ///< Backs source_ when the context has no FrameArena.
+  int frameQuality_ = 0;
+  std::vector<int> sampleRows_;
 };
 
 }  // namespace avs::effects::trans
@@ -21,6 +21,10 @@ class MultiDelay : public avs::core::IEffect {
 
   bool render(avs::core::RenderContext& context) override;
   void setParams(const avs::core::ParamBlock& params) override;
+  // The six buffers are shared, so only the oldest live instance writes them;
+  // the others save nothing.
+  void saveState(avs::core::StateWriter& writer) const override;
+  bool restoreState(avs::core::StateReader& reader) override;
 
  private:
   enum class Mode { Passthrough = 0, Store = 1, Fetch = 2 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
 #include <avs/core/IEffect.hpp>
@@ -13,6 +14,14 @@ class Multiplier : public avs::core::IEffect {
   ~Multiplier() override = default;
 
   bool render(avs::core::RenderContext& context) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override {
+    return {avs::core::AccessPattern::Kind::Pointwise, 0};
+  }
+  bool hasChannelLut(const avs::core::RenderContext& context) const override;
+  bool preservesBlack(const avs::core::RenderContext& /* context */) const override { return true; }
+  void buildChannelLut(avs::core::RenderContext& context, avs::core::ChannelLut& lut) override;
   void setParams(const avs::core::ParamBlock& params) override;
 
  private:
@@ -27,6 +36,8 @@ class Multiplier : public avs::core::IEffect {
     kZero = 7,
   };
 
+  void applyPixels(std::uint8_t* pixels, std::size_t begin, std::size_t end) const;
+
   static Mode decodeMode(int value) noexcept;
   static bool hasFramebuffer(const avs::core::RenderContext& context) noexcept;
   static std::uint8_t multiplyChannel(std::uint8_t value, int factor) noexcept;
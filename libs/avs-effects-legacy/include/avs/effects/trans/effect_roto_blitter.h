@@ -15,6 +15,10 @@ class RotoBlitter : public avs::core::IEffect {
   ~RotoBlitter() override = default;
 
   bool render(avs::core::RenderContext& context) override;
+  int smp_begin(avs::core::RenderContext& context, int maxThreads) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool smp_finish(avs::core::RenderContext& context) override;
+  bool supportsMultiThreaded() const override { return true; }
   void setParams(const avs::core::ParamBlock& params) override;
 
  private:
@@ -43,9 +47,14 @@ class RotoBlitter : public avs::core::IEffect {
   std::array<float, 2> anchorNorm_{0.5f, 0.5f};
 
   std::vector<std::uint8_t> history_;
-  std::vector<std::uint8_t> scratch_;
   int historyWidth_{0};
   int historyHeight_{0};
+
+  bool frameActive_{false};
+  float frameCos_{1.0f};
+  float frameSin_{0.0f};
+  float frameAnchorX_{0.0f};
+  float frameAnchorY_{0.0f};
 };
 
 }  // namespace avs::effects::trans
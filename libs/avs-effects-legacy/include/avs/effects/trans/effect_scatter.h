@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <vector>
 
+#include <avs/core/DeterministicRng.hpp>
 #include <avs/core/IEffect.hpp>
 
 namespace avs::effects::trans {
@@ -11,8 +12,9 @@ namespace avs::effects::trans {
  * @brief Implements the legacy "Trans / Scatter" effect.
  *
  * Pixels are displaced by sampling a random neighbourhood with a soft falloff
- * near the framebuffer edges. The random source is tied to the deterministic
- * frame RNG so results are reproducible for a fixed seed.
+ * near the framebuffer edges. Each pixel draws its offset from the frame's
+ * counter-based stream at its own index, so bands can run in any order and
+ * the result does not depend on the thread count.
  */
 class Scatter : public avs::core::IEffect {
  public:
@@ -20,6 +22,10 @@ class Scatter : public avs::core::IEffect {
   ~Scatter() override = default;
 
   bool render(avs::core::RenderContext& context) override;
+  int smp_begin(avs::core::RenderContext& context, int maxThreads) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override;
   void setParams(const avs::core::ParamBlock& params) override;
 
  private:
@@ -29,7 +35,6 @@ class Scatter : public avs::core::IEffect {
                                  int weight,
                                  int scale);
 
-  void ensureScratch(std::size_t bytes);
   void ensureOffsetTable(int width);
 
   struct ScatterOffset {
@@ -40,7 +45,9 @@ class Scatter : public avs::core::IEffect {
   bool enabled_ = true;
   int cachedWidth_ = 0;
   std::vector<ScatterOffset> offsets_;
-  std::vector<std::uint8_t> scratch_;
+  avs::core::RandomStream stream_;
+  const std::uint8_t* snapshot_ = nullptr;  ///< Frame scratch from smp_begin().
+  std::vector<std::uint8_t> scratch_;  ///< Used only when the context has no FrameArena.
 };
 
 }  // namespace avs::effects::trans
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <vector>
@@ -8,6 +7,7 @@
 #include <avs/core/IEffect.hpp>
 #include <avs/core/ParamBlock.hpp>
 #include <avs/core/RenderContext.hpp>
+#include <avs/core/Transition.hpp>
 
 namespace avs::effects::trans {
 
@@ -20,23 +20,7 @@ namespace avs::effects::trans {
  */
 class TransitionEffect : public avs::core::IEffect {
  public:
-  enum class Mode : std::uint8_t {
-    kRandom = 0,
-    kCrossDissolve,
-    kLeftRightPush,
-    kRightLeftPush,
-    kTopBottomPush,
-    kBottomTopPush,
-    kNineRandomBlocks,
-    kSplitLeftRightPush,
-    kLeftRightToCenterPush,
-    kLeftRightToCenterSqueeze,
-    kLeftRightWipe,
-    kRightLeftWipe,
-    kTopBottomWipe,
-    kBottomTopWipe,
-    kDotDissolve,
-  };
+  using Mode = avs::core::TransitionMode;
 
   TransitionEffect();
   ~TransitionEffect() override = default;
@@ -54,32 +38,9 @@ class TransitionEffect : public avs::core::IEffect {
   bool enabled() const { return enabled_; }
 
  private:
-  static constexpr std::size_t kModeCount = 15;
+  static constexpr std::size_t kModeCount = avs::core::kTransitionModeCount;
 
   void prepareBuffers(const avs::core::RenderContext& context);
-  void renderCrossDissolve(avs::core::RenderContext& context, float t);
-  void renderLeftRightPush(avs::core::RenderContext& context, float t);
-  void renderRightLeftPush(avs::core::RenderContext& context, float t);
-  void renderTopBottomPush(avs::core::RenderContext& context, float t);
-  void renderBottomTopPush(avs::core::RenderContext& context, float t);
-  void renderNineRandomBlocks(avs::core::RenderContext& context, float t);
-  void renderSplitLeftRightPush(avs::core::RenderContext& context, float t);
-  void renderLeftRightToCenterPush(avs::core::RenderContext& context, float t);
-  void renderLeftRightToCenterSqueeze(avs::core::RenderContext& context, float t);
-  void renderLeftRightWipe(avs::core::RenderContext& context, float t);
-  void renderRightLeftWipe(avs::core::RenderContext& context, float t);
-  void renderTopBottomWipe(avs::core::RenderContext& context, float t);
-  void renderBottomTopWipe(avs::core::RenderContext& context, float t);
-  void renderDotDissolve(avs::core::RenderContext& context, float t);
-
-  // Blend two colors with linear interpolation
-  static std::array<std::uint8_t, 4> blendColors(
-      const std::array<std::uint8_t, 4>& a,
-      const std::array<std::uint8_t, 4>& b,
-      float t);
-
-  // Apply smooth easing curve
-  static float smoothCurve(float t);
 
   Mode mode_ = Mode::kRandom;
   float transitionSpeed_ = 1.0f;  // Multiplier for transition duration
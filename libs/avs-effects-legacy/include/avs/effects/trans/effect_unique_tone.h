@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
 #include <avs/core/IEffect.hpp>
@@ -13,14 +14,22 @@ class UniqueTone : public avs::core::IEffect {
   ~UniqueTone() override = default;
 
   bool render(avs::core::RenderContext& context) override;
+  int smp_begin(avs::core::RenderContext& context, int maxThreads) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override {
+    return {avs::core::AccessPattern::Kind::Pointwise, 0};
+  }
   void setParams(const avs::core::ParamBlock& params) override;
 
  private:
   enum class BlendMode { kReplace, kAdditive, kAverage };
 
   void rebuildLookupTables();
+  void applyPixels(std::uint8_t* pixels, std::size_t begin, std::size_t end) const;
 
   static bool hasFramebuffer(const avs::core::RenderContext& context);
+  static std::size_t pixelCount(const avs::core::RenderContext& context);
   static std::uint8_t saturatingAdd(std::uint8_t base, std::uint8_t addend);
 
   bool enabled_ = true;
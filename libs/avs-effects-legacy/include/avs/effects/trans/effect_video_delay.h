@@ -15,12 +15,13 @@ class VideoDelay : public avs::core::IEffect {
 
   bool render(avs::core::RenderContext& context) override;
   void setParams(const avs::core::ParamBlock& params) override;
+  void saveState(avs::core::StateWriter& writer) const override;
+  bool restoreState(avs::core::StateReader& reader) override;
 
   [[nodiscard]] int currentDelayFrames() const noexcept { return currentDelayFrames_; }
 
  private:
   void ensureBuffer(std::size_t frameSize, int requiredFrames);
-  void ensureScratch(std::size_t frameSize);
   int computeDelayFrames(bool beatDetected);
 
   static constexpr int kMaxBeatMultiplier = 16;
@@ -38,7 +39,7 @@ class VideoDelay : public avs::core::IEffect {
   std::size_t headIndex_ = 0;
   std::size_t filledFrameCount_ = 0;
   std::vector<std::uint8_t> buffer_;
-  std::vector<std::uint8_t> scratch_;
+  std::vector<std::uint8_t> scratch_;  ///< Used only when the context has no FrameArena.
 };
 
 }  // namespace avs::effects::trans
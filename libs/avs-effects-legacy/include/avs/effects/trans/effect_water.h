@@ -19,7 +19,7 @@ class Water : public avs::core::IEffect {
  private:
   bool enabled_ = true;
   std::vector<std::uint8_t> lastFrame_;
-  std::vector<std::uint8_t> scratch_;
+  std::vector<std::uint8_t> scratch_;  ///< Used only when the context has no FrameArena.
 };
 
 }  // namespace avs::effects::trans
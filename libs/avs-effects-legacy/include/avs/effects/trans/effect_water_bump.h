@@ -25,6 +25,10 @@ class WaterBump : public avs::core::IEffect {
   ~WaterBump() override = default;
 
   bool render(avs::core::RenderContext& context) override;
+  int smp_begin(avs::core::RenderContext& context, int maxThreads) override;
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override;
+  bool smp_finish(avs::core::RenderContext& context) override;
+  bool supportsMultiThreaded() const override { return true; }
   void setParams(const avs::core::ParamBlock& params) override;
 
  private:
@@ -34,7 +38,8 @@ class WaterBump : public avs::core::IEffect {
   void applyDrop(avs::core::RenderContext& context);
   void applySineBlob(int x, int y, int radius, int heightDelta, avs::core::DeterministicRng& rng);
   void applyHeightBlob(int x, int y, int radius, int heightDelta, avs::core::DeterministicRng& rng);
-  void simulateWater();
+  void simulateRows(int rowBegin, int rowEnd);
+  void finishSimulation();
 
   bool enabled_ = true;
   int density_ = 6;
@@ -50,6 +55,7 @@ class WaterBump : public avs::core::IEffect {
   int currentPage_ = 0;
   std::vector<int> heightBuffers_[2];
   std::vector<std::uint8_t> scratch_;
+  bool frameActive_ = false;
 };
 
 }  // namespace avs::effects::trans
@@ -240,17 +240,50 @@ bool ScriptedEffect::compileScripts() {
   return true;
 }
 
-bool ScriptedEffect::render(avs::core::RenderContext& context) {
-  ensureRuntime();
+void ScriptedEffect::compileIfDirty() {
+  if (!dirty_) {
+    return;
+  }
+  if (!compileScripts()) {
+    // leave initExecuted_ false to retry next time after params change.
+  } else {
+    initExecuted_ = false;
+  }
+  dirty_ = false;
+}
 
-  if (dirty_) {
-    if (!compileScripts()) {
-      // leave initExecuted_ false to retry next time after params change.
-    } else {
-      initExecuted_ = false;
+void ScriptedEffect::saveState(avs::core::StateWriter& writer) const {
+  writer.writeF64(timeSeconds_);
+  writer.writeBool(initExecuted_);
+  writer.writeBool(runtime_ != nullptr);
+  if (runtime_) {
+    runtime_->saveState(writer);
+  }
+}
+
+bool ScriptedEffect::restoreState(avs::core::StateReader& reader) {
+  const double timeSeconds = reader.readF64();
+  const bool initExecuted = reader.readBool();
+  const bool hasRuntime = reader.readBool();
+  if (!reader.ok()) {
+    return false;
+  }
+  if (hasRuntime) {
+    // Compile now so the first render after the restore does not rerun init.
+    ensureRuntime();
+    compileIfDirty();
+    if (!runtime_->restoreState(reader)) {
+      return false;
     }
-    dirty_ = false;
   }
+  timeSeconds_ = timeSeconds;
+  initExecuted_ = initExecuted;
+  return true;
+}
+
+bool ScriptedEffect::render(avs::core::RenderContext& context) {
+  ensureRuntime();
+  compileIfDirty();
 
   runtimeErrorStage_.clear();
   runtimeErrorDetail_.clear();
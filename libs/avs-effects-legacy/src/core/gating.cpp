@@ -1,5 +1,7 @@
 #include <avs/effects/core/gating.h>
 
+#include <cstdint>
+
 namespace avs::effects {
 
 void BeatGate::configure(const GateOptions& options) {
@@ -13,6 +15,22 @@ void BeatGate::reset() {
   stickyActive_ = false;
 }
 
+void BeatGate::saveState(avs::core::StateWriter& writer) const {
+  writer.writeVarInt(holdCounter_);
+  writer.writeBool(stickyActive_);
+}
+
+bool BeatGate::restoreState(avs::core::StateReader& reader) {
+  const std::int64_t holdCounter = reader.readVarInt();
+  const bool stickyActive = reader.readBool();
+  if (!reader.ok() || holdCounter < 0 || holdCounter > INT32_MAX) {
+    return false;
+  }
+  holdCounter_ = static_cast<int>(holdCounter);
+  stickyActive_ = stickyActive;
+  return true;
+}
+
 GateResult BeatGate::step(bool beatEvent) {
   GateResult result{};
   if (!options_.enableOnBeat) {
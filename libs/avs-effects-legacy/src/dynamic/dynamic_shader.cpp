@@ -1,5 +1,6 @@
 #include <avs/effects/dynamic/dynamic_shader.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -10,7 +11,23 @@ namespace avs::effects {
 namespace {
 constexpr int kInstructionBudget = 4000000;
 constexpr double kPi = 3.1415926535897932384626433832795;
+// Pixel spacing of the script evaluation grid per reduced quality level.
+constexpr int kGridStepByLevel[avs::core::kMaxQualityLevel] = {8, 4, 2};
+
+/** Grid node index at or before @p pixel, and the interpolation weight towards the next node. */
+struct GridSpan {
+  int node;
+  float t;
+};
+
+GridSpan gridSpan(int pixel, int step, int extent) {
+  const int node = pixel / step;
+  const int begin = node * step;
+  const int end = std::min(begin + step, extent - 1);
+  const float t = end > begin ? static_cast<float>(pixel - begin) / static_cast<float>(end - begin) : 0.0f;
+  return {node, t};
 }
+}  // namespace
 
 DynamicShaderEffect::DynamicShaderEffect() { budget_.maxInstructionBytes = kInstructionBudget; }
 
@@ -30,23 +47,44 @@ void DynamicShaderEffect::setParams(const avs::core::ParamBlock& params) {
   }
 }
 
-bool DynamicShaderEffect::render(avs::core::RenderContext& context) {
-  if (!prepareHistory(context)) {
-    return true;
+void DynamicShaderEffect::setQualityLevel(int level) { qualityLevel_ = avs::core::clampQualityLevel(level); }
+
+void DynamicShaderEffect::saveState(avs::core::StateWriter& writer) const {
+  FrameWarpEffect::saveState(writer);
+  writer.writeF64(timeSeconds_);
+  writer.writeBool(initExecuted_);
+  writer.writeBool(runtime_ != nullptr);
+  if (runtime_) {
+    runtime_->saveState(writer);
+  }
+}
+
+bool DynamicShaderEffect::restoreState(avs::core::StateReader& reader) {
+  if (!FrameWarpEffect::restoreState(reader)) {
+    return false;
   }
+  timeSeconds_ = reader.readF64();
+  initExecuted_ = reader.readBool();
+  if (reader.readBool()) {
+    ensureRuntime();
+    return runtime_->restoreState(reader);
+  }
+  return reader.ok();
+}
 
+FrameWarpEffect::WarpStart DynamicShaderEffect::beginWarp(avs::core::RenderContext& context) {
   ensureRuntime();
   if (!runtime_) {
-    return true;
+    return WarpStart::Skip;
   }
 
   if (dirty_ && !compileScripts()) {
-    return false;
+    return WarpStart::Abort;
   }
 
   if (!initExecuted_) {
     if (!executeStage(avs::runtime::script::EelRuntime::Stage::kInit)) {
-      return false;
+      return WarpStart::Abort;
     }
     initExecuted_ = true;
   }
@@ -54,34 +92,96 @@ bool DynamicShaderEffect::render(avs::core::RenderContext& context) {
   bindFrame(context);
 
   if (!executeStage(avs::runtime::script::EelRuntime::Stage::kFrame)) {
-    return false;
+    return WarpStart::Abort;
   }
 
   const int width = historyWidth();
   const int height = historyHeight();
   if (width <= 0 || height <= 0) {
-    return true;
+    return WarpStart::Skip;
   }
 
+  sampleCoords_.resize(static_cast<std::size_t>(width) * static_cast<std::size_t>(height));
+  if (qualityLevel_ < avs::core::kMaxQualityLevel) {
+    return evaluateGrid(width, height, kGridStepByLevel[qualityLevel_], context) ? WarpStart::Render
+                                                                                 : WarpStart::Abort;
+  }
+  std::size_t index = 0;
   for (int py = 0; py < height; ++py) {
     for (int px = 0; px < width; ++px) {
-      bindPixel(px, py, context);
-      if (!executeStage(avs::runtime::script::EelRuntime::Stage::kPixel)) {
+      if (!evaluatePixel(px, py, context, sampleCoords_[index++])) {
+        return WarpStart::Abort;
+      }
+    }
+  }
+  return WarpStart::Render;
+}
+
+bool DynamicShaderEffect::evaluatePixel(int px, int py, const avs::core::RenderContext& context,
+                                        SampleCoord& out) {
+  bindPixel(px, py, context);
+  if (!executeStage(avs::runtime::script::EelRuntime::Stage::kPixel)) {
+    return false;
+  }
+  out = resolveSample();
+  return true;
+}
+
+bool DynamicShaderEffect::evaluateGrid(int width, int height, int step,
+                                       const avs::core::RenderContext& context) {
+  // Nodes sit every `step` pixels plus one on the last row and column, so every
+  // pixel lies between two evaluated nodes on each axis.
+  const int columns = (width - 1 + step - 1) / step + 1;
+  const int rows = (height - 1 + step - 1) / step + 1;
+  gridCoords_.resize(static_cast<std::size_t>(columns) * static_cast<std::size_t>(rows));
+  std::size_t node = 0;
+  for (int gy = 0; gy < rows; ++gy) {
+    const int py = std::min(gy * step, height - 1);
+    for (int gx = 0; gx < columns; ++gx) {
+      if (!evaluatePixel(std::min(gx * step, width - 1), py, context, gridCoords_[node++])) {
         return false;
       }
-      const SampleCoord coord = resolveSample();
+    }
+  }
+
+  const auto at = [&](int gx, int gy) -> const SampleCoord& {
+    return gridCoords_[static_cast<std::size_t>(std::min(gy, rows - 1)) * static_cast<std::size_t>(columns) +
+                       static_cast<std::size_t>(std::min(gx, columns - 1))];
+  };
+  std::size_t index = 0;
+  for (int py = 0; py < height; ++py) {
+    const GridSpan sy = gridSpan(py, step, height);
+    for (int px = 0; px < width; ++px) {
+      const GridSpan sx = gridSpan(px, step, width);
+      const SampleCoord& c00 = at(sx.node, sy.node);
+      const SampleCoord& c10 = at(sx.node + 1, sy.node);
+      const SampleCoord& c01 = at(sx.node, sy.node + 1);
+      const SampleCoord& c11 = at(sx.node + 1, sy.node + 1);
+      const float topX = c00.x + (c10.x - c00.x) * sx.t;
+      const float topY = c00.y + (c10.y - c00.y) * sx.t;
+      const float bottomX = c01.x + (c11.x - c01.x) * sx.t;
+      const float bottomY = c01.y + (c11.y - c01.y) * sx.t;
+      sampleCoords_[index++] = {topX + (bottomX - topX) * sy.t, topY + (bottomY - topY) * sy.t};
+    }
+  }
+  return true;
+}
+
+void DynamicShaderEffect::warpRows(avs::core::RenderContext& context, int rowBegin, int rowEnd) {
+  const int width = historyWidth();
+  for (int py = rowBegin; py < rowEnd; ++py) {
+    for (int px = 0; px < width; ++px) {
+      const std::size_t pixel = static_cast<std::size_t>(py) * static_cast<std::size_t>(width) +
+                                static_cast<std::size_t>(px);
+      const SampleCoord& coord = sampleCoords_[pixel];
       const auto color = sampleHistory(coord.x, coord.y, wrap_);
-      const std::size_t index = (static_cast<std::size_t>(py) * static_cast<std::size_t>(width) +
-                                 static_cast<std::size_t>(px)) * 4u;
+      const std::size_t index = pixel * 4u;
       context.framebuffer.data[index + 0] = color[0];
       context.framebuffer.data[index + 1] = color[1];
       context.framebuffer.data[index + 2] = color[2];
       context.framebuffer.data[index + 3] = color[3];
     }
   }
-
-  storeHistory(context);
-  return true;
 }
 
 void DynamicShaderEffect::ensureRuntime() {
@@ -2,9 +2,79 @@
 
 #include <algorithm>
 #include <cmath>
+#include <utility>
+
+#include <avs/core/RowBand.hpp>
 
 namespace avs::effects {
 
+bool FrameWarpEffect::render(avs::core::RenderContext& context) {
+  if (smp_begin(context, 1) > 0) {
+    smp_render(context, 0, 1);
+  }
+  return smp_finish(context);
+}
+
+int FrameWarpEffect::smp_begin(avs::core::RenderContext& context, int maxThreads) {
+  frameActive_ = false;
+  frameFailed_ = false;
+  if (!prepareHistory(context)) {
+    return 0;
+  }
+  switch (beginWarp(context)) {
+    case WarpStart::Render:
+      break;
+    case WarpStart::Skip:
+      return 0;
+    case WarpStart::Abort:
+      frameFailed_ = true;
+      return 0;
+  }
+  frameActive_ = true;
+  return maxThreads;
+}
+
+bool FrameWarpEffect::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
+  if (!frameActive_) {
+    return true;
+  }
+  const avs::core::RowBand band = avs::core::rowBand(height_, threadId, maxThreads);
+  if (!band.empty()) {
+    warpRows(context, band.begin, band.end);
+  }
+  return true;
+}
+
+bool FrameWarpEffect::smp_finish(avs::core::RenderContext& context) {
+  if (frameActive_) {
+    storeHistory(context);
+    frameActive_ = false;
+  }
+  return !frameFailed_;
+}
+
+void FrameWarpEffect::saveState(avs::core::StateWriter& writer) const {
+  writer.writeVarInt(width_);
+  writer.writeVarInt(height_);
+  writer.writeBytes(history_.data(), history_.size());
+}
+
+bool FrameWarpEffect::restoreState(avs::core::StateReader& reader) {
+  const std::int64_t width = reader.readVarInt();
+  const std::int64_t height = reader.readVarInt();
+  std::vector<std::uint8_t> history;
+  if (!reader.readBytes(history) || width < 0 || height < 0 || width > INT32_MAX ||
+      height > INT32_MAX || static_cast<std::uint64_t>(width * height) * 4u != history.size()) {
+    return false;
+  }
+  width_ = static_cast<int>(width);
+  height_ = static_cast<int>(height);
+  history_ = std::move(history);
+  frameActive_ = false;
+  frameFailed_ = false;
+  return true;
+}
+
 bool FrameWarpEffect::prepareHistory(const avs::core::RenderContext& context) {
   if (context.width <= 0 || context.height <= 0 || !context.framebuffer.data) {
     return false;
@@ -36,6 +106,10 @@ FrameWarpEffect::Rgba FrameWarpEffect::sampleHistory(float normX, float normY, b
   if (history_.empty() || width_ <= 0 || height_ <= 0) {
     return {0, 0, 0, 255};
   }
+  return sampleHistoryAt(historyPoint(normX, normY, wrap), wrap);
+}
+
+std::array<float, 2> FrameWarpEffect::historyPoint(float normX, float normY, bool wrap) const {
   // Transform normalized coordinates (-1..1) into pixel space.
   float u = (normX + 1.0f) * 0.5f;
   float v = (1.0f - (normY + 1.0f) * 0.5f);
@@ -49,8 +123,7 @@ FrameWarpEffect::Rgba FrameWarpEffect::sampleHistory(float normX, float normY, b
     fx = std::clamp(fx, 0.0f, static_cast<float>(width_ - 1));
     fy = std::clamp(fy, 0.0f, static_cast<float>(height_ - 1));
   }
-
-  return bilinearSample(fx, fy, wrap);
+  return {fx, fy};
 }
 
 FrameWarpEffect::Rgba FrameWarpEffect::bilinearSample(float fx, float fy, bool wrap) const {
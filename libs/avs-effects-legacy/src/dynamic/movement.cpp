@@ -25,23 +25,25 @@ void MovementEffect::setParams(const avs::core::ParamBlock& params) {
   if (params.contains("wrap")) {
     wrap_ = params.getBool("wrap", wrap_);
   }
+  pointsDirty_ = true;
 }
 
-bool MovementEffect::render(avs::core::RenderContext& context) {
-  if (!prepareHistory(context)) {
-    return true;
+FrameWarpEffect::WarpStart MovementEffect::beginWarp(avs::core::RenderContext& /* context */) {
+  if (pointsDirty_ || pointsWidth_ != historyWidth() || pointsHeight_ != historyHeight()) {
+    rebuildPoints();
   }
+  return WarpStart::Render;
+}
+
+void MovementEffect::rebuildPoints() {
   const int width = historyWidth();
   const int height = historyHeight();
-  if (width <= 0 || height <= 0) {
-    return true;
-  }
-
   const double radians = rotationDeg_ * kDegToRad;
   const float cosR = static_cast<float>(std::cos(radians));
   const float sinR = static_cast<float>(std::sin(radians));
   const float invScale = 1.0f / std::max(scale_, 0.0001f);
 
+  points_.resize(static_cast<std::size_t>(width) * static_cast<std::size_t>(height));
   for (int py = 0; py < height; ++py) {
     for (int px = 0; px < width; ++px) {
       const float normX = (static_cast<float>(px) + 0.5f) / static_cast<float>(width);
@@ -56,20 +58,26 @@ bool MovementEffect::render(avs::core::RenderContext& context) {
 
       const float rx = x * cosR - y * sinR;
       const float ry = x * sinR + y * cosR;
-
-      const auto color = sampleHistory(rx, ry, wrap_);
-      const std::size_t index = (static_cast<std::size_t>(py) * static_cast<std::size_t>(width) +
-                                 static_cast<std::size_t>(px)) * 4u;
-      context.framebuffer.data[index + 0] = color[0];
-      context.framebuffer.data[index + 1] = color[1];
-      context.framebuffer.data[index + 2] = color[2];
-      context.framebuffer.data[index + 3] = color[3];
+      points_[static_cast<std::size_t>(py) * static_cast<std::size_t>(width) +
+              static_cast<std::size_t>(px)] = historyPoint(rx, ry, wrap_);
     }
   }
+  pointsWidth_ = width;
+  pointsHeight_ = height;
+  pointsDirty_ = false;
+}
 
-  storeHistory(context);
-  return true;
+void MovementEffect::warpRows(avs::core::RenderContext& context, int rowBegin, int rowEnd) {
+  const std::size_t width = static_cast<std::size_t>(historyWidth());
+  for (std::size_t pixel = static_cast<std::size_t>(rowBegin) * width;
+       pixel < static_cast<std::size_t>(rowEnd) * width; ++pixel) {
+    const auto color = sampleHistoryAt(points_[pixel], wrap_);
+    std::uint8_t* out = context.framebuffer.data + pixel * 4u;
+    out[0] = color[0];
+    out[1] = color[1];
+    out[2] = color[2];
+    out[3] = color[3];
+  }
 }
 
 }  // namespace avs::effects
-
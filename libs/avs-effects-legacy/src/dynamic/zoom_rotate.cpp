@@ -27,25 +27,25 @@ void ZoomRotateEffect::setParams(const avs::core::ParamBlock& params) {
   }
 }
 
-bool ZoomRotateEffect::render(avs::core::RenderContext& context) {
-  if (!prepareHistory(context)) {
-    return true;
-  }
+FrameWarpEffect::WarpStart ZoomRotateEffect::beginWarp(avs::core::RenderContext& /* context */) {
+  const double radians = rotationDeg_ * kDegToRad;
+  cosR_ = static_cast<float>(std::cos(radians));
+  sinR_ = static_cast<float>(std::sin(radians));
+  invZoom_ = 1.0f / std::max(zoom_, 0.0001f);
+  return WarpStart::Render;
+}
+
+void ZoomRotateEffect::warpRows(avs::core::RenderContext& context, int rowBegin, int rowEnd) {
   const int width = historyWidth();
   const int height = historyHeight();
-  if (width <= 0 || height <= 0) {
-    return true;
-  }
-
-  const double radians = rotationDeg_ * kDegToRad;
-  const float cosR = static_cast<float>(std::cos(radians));
-  const float sinR = static_cast<float>(std::sin(radians));
-  const float invZoom = 1.0f / std::max(zoom_, 0.0001f);
+  const float cosR = cosR_;
+  const float sinR = sinR_;
+  const float invZoom = invZoom_;
 
   const float anchorNormX = anchorX_ * 2.0f - 1.0f;
   const float anchorNormY = 1.0f - anchorY_ * 2.0f;
 
-  for (int py = 0; py < height; ++py) {
+  for (int py = rowBegin; py < rowEnd; ++py) {
     for (int px = 0; px < width; ++px) {
       const float normX = (static_cast<float>(px) + 0.5f) / static_cast<float>(width);
       const float normY = (static_cast<float>(py) + 0.5f) / static_cast<float>(height);
@@ -72,9 +72,6 @@ bool ZoomRotateEffect::render(avs::core::RenderContext& context) {
       context.framebuffer.data[index + 3] = color[3];
     }
   }
-
-  storeHistory(context);
-  return true;
 }
 
 }  // namespace avs::effects
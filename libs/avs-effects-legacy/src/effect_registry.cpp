@@ -71,10 +71,14 @@ class AddBordersCompatEffect : public avs::Effect {
     (void)h;
   }
 
+  bool processesInPlace() const override { return true; }
+
   void process(const avs::Framebuffer& in, avs::Framebuffer& out) override {
-    out.w = in.w;
-    out.h = in.h;
-    out.rgba = in.rgba;
+    if (&in != &out) {
+      out.w = in.w;
+      out.h = in.h;
+      out.rgba = in.rgba;
+    }
 
     avs::core::RenderContext context{};
     context.width = out.w;
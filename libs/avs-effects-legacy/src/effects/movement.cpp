@@ -10,8 +10,9 @@ namespace avs {
 
 namespace {
 constexpr double kPI = 3.14159265358979323846;
-}
 
+// Internal linkage: avs::MovementEffect already names the compat IEffect in
+// effects_trans.hpp, and two classes sharing that name would share a vtable.
 class MovementEffect : public Effect {
  public:
   MovementEffect(int effect_type, bool blend, bool sourcemapped, bool rectangular,
@@ -85,35 +86,50 @@ class MovementEffect : public Effect {
         }
       }
     } else {
-      // Normal mode: map from output position to input position
-      for (size_t i = 0; i < pixel_count; ++i) {
-        int src_offset = transform_table_[i];
-        if (src_offset >= 0 && src_offset < static_cast<int>(pixel_count)) {
-          size_t src_idx = static_cast<size_t>(src_offset) * 4;
-          size_t dst_idx = i * 4;
-
-          outp[dst_idx + 0] = inp[src_idx + 0];
-          outp[dst_idx + 1] = inp[src_idx + 1];
-          outp[dst_idx + 2] = inp[src_idx + 2];
-          outp[dst_idx + 3] = inp[src_idx + 3];
-        } else {
-          // Out of bounds - set to black
-          size_t dst_idx = i * 4;
-          outp[dst_idx + 0] = 0;
-          outp[dst_idx + 1] = 0;
-          outp[dst_idx + 2] = 0;
-          outp[dst_idx + 3] = 255;
-        }
-      }
+      processBand(in, out, 0, h);
+    }
+  }
 
+  // Normal mode gathers every output pixel from `in`, so disjoint row bands
+  // are independent. Source mapping scatters into arbitrary rows and stays serial.
+  bool bandSafe() const override { return !sourcemapped_; }
+
+  void processBand(const Framebuffer& in, Framebuffer& out, int rowBegin, int rowEnd) override {
+    const std::uint8_t* inp = in.rgba.data();
+    std::uint8_t* outp = out.rgba.data();
+    if (effect_type_ == 0 || transform_table_.empty()) {
+      const size_t rowBytes = static_cast<size_t>(in.w) * 4;
+      std::copy(inp + rowBegin * rowBytes, inp + rowEnd * rowBytes, outp + rowBegin * rowBytes);
+      return;
+    }
+
+    // Normal mode: map from output position to input position
+    const int w = width_;
+    const int pixel_count = static_cast<int>(transform_table_.size());
+    const size_t begin = static_cast<size_t>(rowBegin) * w;
+    const size_t end = std::min(static_cast<size_t>(rowEnd) * w, transform_table_.size());
+    for (size_t i = begin; i < end; ++i) {
+      const int src_offset = transform_table_[i];
+      const size_t dst_idx = i * 4;
+      if (src_offset >= 0 && src_offset < pixel_count) {
+        const size_t src_idx = static_cast<size_t>(src_offset) * 4;
+        outp[dst_idx + 0] = inp[src_idx + 0];
+        outp[dst_idx + 1] = inp[src_idx + 1];
+        outp[dst_idx + 2] = inp[src_idx + 2];
+        outp[dst_idx + 3] = inp[src_idx + 3];
+      } else {
+        // Out of bounds - set to black
+        outp[dst_idx + 0] = 0;
+        outp[dst_idx + 1] = 0;
+        outp[dst_idx + 2] = 0;
+        outp[dst_idx + 3] = 255;
+      }
       if (blend_) {
         // Average blend with input
-        for (size_t i = 0; i < pixel_count * 4; i += 4) {
-          outp[i + 0] = (outp[i + 0] + inp[i + 0]) >> 1;
-          outp[i + 1] = (outp[i + 1] + inp[i + 1]) >> 1;
-          outp[i + 2] = (outp[i + 2] + inp[i + 2]) >> 1;
-          outp[i + 3] = (outp[i + 3] + inp[i + 3]) >> 1;
-        }
+        outp[dst_idx + 0] = (outp[dst_idx + 0] + inp[dst_idx + 0]) >> 1;
+        outp[dst_idx + 1] = (outp[dst_idx + 1] + inp[dst_idx + 1]) >> 1;
+        outp[dst_idx + 2] = (outp[dst_idx + 2] + inp[dst_idx + 2]) >> 1;
+        outp[dst_idx + 3] = (outp[dst_idx + 3] + inp[dst_idx + 3]) >> 1;
       }
     }
   }
@@ -307,6 +323,8 @@ class MovementEffect : public Effect {
   std::vector<int> transform_table_;
 };
 
+}  // namespace
+
 // Factory function for use by the effect registry
 std::unique_ptr<Effect> createMovementEffect(int effect, bool blend, bool sourcemapped,
                                               bool rectangular, bool subpixel, bool wrap,
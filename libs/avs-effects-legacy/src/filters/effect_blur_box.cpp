@@ -9,42 +9,41 @@ namespace avs::effects::filters {
 
 namespace {
 constexpr int kMaxRadius = 32;
+// Radius ceiling per reduced quality level; full quality is uncapped.
+constexpr int kRadiusCapByLevel[avs::core::kMaxQualityLevel] = {2, 4, 8};
+
+int cappedRadius(int radius, int level) {
+  return level >= avs::core::kMaxQualityLevel ? radius : std::min(radius, kRadiusCapByLevel[level]);
 }
+}  // namespace
 
 void BlurBox::setParams(const avs::core::ParamBlock& params) {
-  radius_ = std::clamp(params.getInt("radius", radius_), 0, kMaxRadius);
+  requestedRadius_ = std::clamp(params.getInt("radius", requestedRadius_), 0, kMaxRadius);
+  radius_ = cappedRadius(requestedRadius_, qualityLevel_);
   preserveAlpha_ = params.getBool("preserve_alpha", true);
 }
 
-void BlurBox::ensureBuffers(int width, int height) {
-  const std::size_t required = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u;
-  ensureScratch(scratch_, required);
-  if (static_cast<int>(prefixRow_.size()) < (width + 1) * 4) {
-    prefixRow_.assign(static_cast<std::size_t>(width + 1) * 4u, 0);
-  }
-  if (static_cast<int>(prefixColumn_.size()) < (height + 1) * 4) {
-    prefixColumn_.assign(static_cast<std::size_t>(height + 1) * 4u, 0);
-  }
+void BlurBox::setQualityLevel(int level) {
+  qualityLevel_ = avs::core::clampQualityLevel(level);
+  radius_ = cappedRadius(requestedRadius_, qualityLevel_);
 }
 
-void BlurBox::horizontalPass(const std::uint8_t* src, std::uint8_t* dst, int width, int height) const {
-  if (radius_ <= 0) {
-    std::memcpy(dst, src, static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u);
-    return;
-  }
+void BlurBox::horizontalPass(const std::uint8_t* src, std::uint8_t* dst, int width, int rows,
+                             std::vector<int>& prefixRow) const {
   const int window = radius_ * 2 + 1;
   const int stride = width * 4;
-  for (int y = 0; y < height; ++y) {
-    std::fill(prefixRow_.begin(), prefixRow_.begin() + static_cast<std::ptrdiff_t>((width + 1) * 4), 0);
+  prefixRow.resize(static_cast<std::size_t>(width + 1) * 4u);
+  for (int y = 0; y < rows; ++y) {
+    std::fill(prefixRow.begin(), prefixRow.end(), 0);
     const std::uint8_t* row = src + static_cast<std::size_t>(y) * stride;
     std::uint8_t* dstRow = dst + static_cast<std::size_t>(y) * stride;
     for (int x = 0; x < width; ++x) {
       const std::size_t srcIndex = static_cast<std::size_t>(x) * 4u;
       const std::size_t prefixIndex = static_cast<std::size_t>(x + 1) * 4u;
-      prefixRow_[prefixIndex + 0] = prefixRow_[prefixIndex - 4] + row[srcIndex + 0];
-      prefixRow_[prefixIndex + 1] = prefixRow_[prefixIndex - 3] + row[srcIndex + 1];
-      prefixRow_[prefixIndex + 2] = prefixRow_[prefixIndex - 2] + row[srcIndex + 2];
-      prefixRow_[prefixIndex + 3] = prefixRow_[prefixIndex - 1] + row[srcIndex + 3];
+      prefixRow[prefixIndex + 0] = prefixRow[prefixIndex - 4] + row[srcIndex + 0];
+      prefixRow[prefixIndex + 1] = prefixRow[prefixIndex - 3] + row[srcIndex + 1];
+      prefixRow[prefixIndex + 2] = prefixRow[prefixIndex - 2] + row[srcIndex + 2];
+      prefixRow[prefixIndex + 3] = prefixRow[prefixIndex - 1] + row[srcIndex + 3];
     }
     for (int x = 0; x < width; ++x) {
       const int left = x - radius_;
@@ -59,7 +58,7 @@ void BlurBox::horizontalPass(const std::uint8_t* src, std::uint8_t* dst, int wid
       const std::uint8_t* firstPx = row;
       const std::uint8_t* lastPx = row + static_cast<std::size_t>(width - 1) * 4u;
       for (int channel = 0; channel < 4; ++channel) {
-        int sum = prefixRow_[prefixRight + channel] - prefixRow_[prefixLeft + channel];
+        int sum = prefixRow[prefixRight + channel] - prefixRow[prefixLeft + channel];
         if (leftPadding > 0) {
           sum += leftPadding * static_cast<int>(firstPx[channel]);
         }
@@ -76,36 +75,39 @@ void BlurBox::horizontalPass(const std::uint8_t* src, std::uint8_t* dst, int wid
   }
 }
 
-void BlurBox::verticalPass(const std::uint8_t* src, std::uint8_t* dst, int width, int height) const {
-  if (radius_ <= 0) {
-    std::memcpy(dst, src, static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u);
-    return;
-  }
+void BlurBox::verticalPass(const std::uint8_t* src, avs::core::RowBand srcRows, std::uint8_t* dst,
+                           int width, int height, avs::core::RowBand dstRows,
+                           std::vector<int>& prefixColumn) const {
+  // src holds frame rows [srcRows.begin, srcRows.end): the destination band plus radius_ halo.
   const int window = radius_ * 2 + 1;
+  const int rowCount = srcRows.end - srcRows.begin;
+  prefixColumn.resize(static_cast<std::size_t>(rowCount + 1) * 4u);
   for (int x = 0; x < width; ++x) {
-    std::fill(prefixColumn_.begin(), prefixColumn_.begin() + static_cast<std::ptrdiff_t>((height + 1) * 4), 0);
-    for (int y = 0; y < height; ++y) {
+    std::fill(prefixColumn.begin(), prefixColumn.end(), 0);
+    for (int y = 0; y < rowCount; ++y) {
       const std::size_t srcIndex = (static_cast<std::size_t>(y) * width + static_cast<std::size_t>(x)) * 4u;
       const std::size_t prefixIndex = static_cast<std::size_t>(y + 1) * 4u;
-      prefixColumn_[prefixIndex + 0] = prefixColumn_[prefixIndex - 4] + src[srcIndex + 0];
-      prefixColumn_[prefixIndex + 1] = prefixColumn_[prefixIndex - 3] + src[srcIndex + 1];
-      prefixColumn_[prefixIndex + 2] = prefixColumn_[prefixIndex - 2] + src[srcIndex + 2];
-      prefixColumn_[prefixIndex + 3] = prefixColumn_[prefixIndex - 1] + src[srcIndex + 3];
+      prefixColumn[prefixIndex + 0] = prefixColumn[prefixIndex - 4] + src[srcIndex + 0];
+      prefixColumn[prefixIndex + 1] = prefixColumn[prefixIndex - 3] + src[srcIndex + 1];
+      prefixColumn[prefixIndex + 2] = prefixColumn[prefixIndex - 2] + src[srcIndex + 2];
+      prefixColumn[prefixIndex + 3] = prefixColumn[prefixIndex - 1] + src[srcIndex + 3];
     }
-    const std::uint8_t* firstPx = src + static_cast<std::size_t>(x) * 4u;
-    const std::uint8_t* lastPx = src + (static_cast<std::size_t>(height - 1) * width + static_cast<std::size_t>(x)) * 4u;
-    for (int y = 0; y < height; ++y) {
+    for (int y = dstRows.begin; y < dstRows.end; ++y) {
       const int top = y - radius_;
       const int bottom = y + radius_;
-      const int clampedTop = clampIndex(top, 0, height - 1);
-      const int clampedBottom = clampIndex(bottom, 0, height - 1);
-      const int topPadding = clampedTop - top;
-      const int bottomPadding = bottom - clampedBottom;
+      const int clampedTop = clampIndex(top, 0, height - 1) - srcRows.begin;
+      const int clampedBottom = clampIndex(bottom, 0, height - 1) - srcRows.begin;
+      const int topPadding = clampedTop + srcRows.begin - top;
+      const int bottomPadding = bottom - (clampedBottom + srcRows.begin);
       const std::size_t prefixTop = static_cast<std::size_t>(clampedTop) * 4u;
       const std::size_t prefixBottom = static_cast<std::size_t>(clampedBottom + 1) * 4u;
+      // Padding only happens at the frame edges, where the clamped row is the edge row.
+      const std::uint8_t* firstPx = src + (static_cast<std::size_t>(clampedTop) * width + static_cast<std::size_t>(x)) * 4u;
+      const std::uint8_t* lastPx = src + (static_cast<std::size_t>(clampedBottom) * width + static_cast<std::size_t>(x)) * 4u;
+      const std::uint8_t* srcPx = src + (static_cast<std::size_t>(y - srcRows.begin) * width + static_cast<std::size_t>(x)) * 4u;
       std::uint8_t* dstPx = dst + (static_cast<std::size_t>(y) * width + static_cast<std::size_t>(x)) * 4u;
       for (int channel = 0; channel < 4; ++channel) {
-        int sum = prefixColumn_[prefixBottom + channel] - prefixColumn_[prefixTop + channel];
+        int sum = prefixColumn[prefixBottom + channel] - prefixColumn[prefixTop + channel];
         if (topPadding > 0) {
           sum += topPadding * static_cast<int>(firstPx[channel]);
         }
@@ -113,7 +115,7 @@ void BlurBox::verticalPass(const std::uint8_t* src, std::uint8_t* dst, int width
           sum += bottomPadding * static_cast<int>(lastPx[channel]);
         }
         if (preserveAlpha_ && channel == 3) {
-          dstPx[channel] = src[(static_cast<std::size_t>(y) * width + static_cast<std::size_t>(x)) * 4u + channel];
+          dstPx[channel] = srcPx[channel];
         } else {
           dstPx[channel] = clampByte((sum + window / 2) / window);
         }
@@ -123,28 +125,55 @@ void BlurBox::verticalPass(const std::uint8_t* src, std::uint8_t* dst, int width
 }
 
 bool BlurBox::render(avs::core::RenderContext& context) {
-  if (!hasFramebuffer(context)) {
+  if (smp_begin(context, 1) <= 0) {
+    return true;
+  }
+  return smp_render(context, 0, 1);
+}
+
+int BlurBox::smp_begin(avs::core::RenderContext& context, int maxThreads) {
+  if (!hasFramebuffer(context) || radius_ <= 0) {
+    return 0;
+  }
+  if (static_cast<int>(bands_.size()) < maxThreads) {
+    bands_.resize(static_cast<std::size_t>(maxThreads));
+  }
+
+  // A single band copies every source row into its own scratch before writing, so
+  // only concurrent bands need the snapshot to read their halo rows from.
+  snapshotSource_ = maxThreads > 1;
+  if (snapshotSource_) {
+    const std::size_t bytes =
+        static_cast<std::size_t>(context.width) * static_cast<std::size_t>(context.height) * 4u;
+    ensureScratch(source_, bytes);
+    std::memcpy(source_.data(), context.framebuffer.data, bytes);
+  }
+  return maxThreads;
+}
+
+bool BlurBox::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
+  if (!hasFramebuffer(context) || radius_ <= 0) {
     return true;
   }
-  const int width = std::max(0, context.width);
-  const int height = std::max(0, context.height);
-  if (radius_ <= 0) {
+  const int width = context.width;
+  const int height = context.height;
+  const avs::core::HaloBand band = avs::core::haloBand(height, threadId, maxThreads, radius_);
+  if (band.rows.empty()) {
     return true;
   }
-  ensureBuffers(width, height);
 
   std::uint8_t* framebuffer = context.framebuffer.data;
-  horizontalPass(framebuffer, scratch_.data(), width, height);
-  verticalPass(scratch_.data(), framebuffer, width, height);
+  const std::uint8_t* source = snapshotSource_ ? source_.data() : framebuffer;
+  const std::size_t stride = static_cast<std::size_t>(width) * 4u;
+  const int sourceRows = band.source.end - band.source.begin;
+  BandScratch& scratch = bands_[static_cast<std::size_t>(threadId)];
+  ensureScratch(scratch.rows, static_cast<std::size_t>(sourceRows) * stride);
 
-  if (preserveAlpha_) {
-    const std::size_t pixels = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
-    for (std::size_t i = 0; i < pixels; ++i) {
-      framebuffer[i * 4u + 3] = scratch_[i * 4u + 3];
-    }
-  }
+  horizontalPass(source + static_cast<std::size_t>(band.source.begin) * stride, scratch.rows.data(), width,
+                 sourceRows, scratch.prefixRow);
+  verticalPass(scratch.rows.data(), band.source, framebuffer, width, height, band.rows,
+               scratch.prefixColumn);
   return true;
 }
 
 }  // namespace avs::effects::filters
-
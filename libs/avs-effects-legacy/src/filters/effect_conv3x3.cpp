@@ -7,6 +7,7 @@
 #include <string>
 #include <string_view>
 
+#include <avs/core/RowBand.hpp>
 #include <avs/effects/filters/filter_common.h>
 
 namespace avs::effects::filters {
@@ -53,20 +54,38 @@ void Convolution3x3::setParams(const avs::core::ParamBlock& params) {
 }
 
 bool Convolution3x3::render(avs::core::RenderContext& context) {
-  if (!hasFramebuffer(context)) {
+  if (smp_begin(context, 1) <= 0) {
     return true;
   }
+  return smp_render(context, 0, 1);
+}
 
-  const int width = context.width;
-  const int height = context.height;
+int Convolution3x3::smp_begin(avs::core::RenderContext& context, int maxThreads) {
+  if (!hasFramebuffer(context)) {
+    return 0;
+  }
+
+  // Bands read their one-row halo from this snapshot, never from the framebuffer.
   std::uint8_t* pixels = context.framebuffer.data;
-  const std::size_t totalBytes = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u;
+  const std::size_t totalBytes =
+      static_cast<std::size_t>(context.width) * static_cast<std::size_t>(context.height) * 4u;
   ensureScratch(scratch_, totalBytes);
   std::copy(pixels, pixels + totalBytes, scratch_.begin());
+  return maxThreads;
+}
 
+bool Convolution3x3::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
+  if (!hasFramebuffer(context)) {
+    return true;
+  }
+
+  const int width = context.width;
+  const int height = context.height;
+  std::uint8_t* pixels = context.framebuffer.data;
   const float divisor = std::abs(divisor_) < 1e-6f ? 1.0f : divisor_;
+  const avs::core::RowBand band = avs::core::rowBand(height, threadId, maxThreads);
 
-  for (int y = 0; y < height; ++y) {
+  for (int y = band.begin; y < band.end; ++y) {
     for (int x = 0; x < width; ++x) {
       float accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
       for (int ky = -1; ky <= 1; ++ky) {
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cmath>
 
+#include <avs/core/RowBand.hpp>
 #include <avs/effects/filters/filter_common.h>
 
 namespace avs::effects::filters {
@@ -25,30 +26,67 @@ void FastBrightness::setParams(const avs::core::ParamBlock& params) {
 }
 
 bool FastBrightness::render(avs::core::RenderContext& context) {
-  if (!hasFramebuffer(context)) {
+  if (smp_begin(context, 1) <= 0) {
     return true;
   }
+  return smp_render(context, 0, 1);
+}
 
-  if (std::abs(amount_ - 1.0f) < 1e-6f && std::abs(bias_) < 1e-3f) {
-    return true;
+int FastBrightness::smp_begin(avs::core::RenderContext& context, int maxThreads) {
+  if (!hasFramebuffer(context) || isIdentity()) {
+    return 0;
   }
+  return maxThreads;
+}
 
-  std::uint8_t* pixels = context.framebuffer.data;
+bool FastBrightness::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
+  if (!hasFramebuffer(context) || isIdentity()) {
+    return true;
+  }
   const std::size_t totalPixels = static_cast<std::size_t>(context.width) * static_cast<std::size_t>(context.height);
-  for (std::size_t i = 0; i < totalPixels; ++i) {
+  const auto span =
+      avs::core::rowBandPixels(totalPixels, context.width, context.height, threadId, maxThreads);
+  applyPixels(context.framebuffer.data, span.begin, span.end);
+  return true;
+}
+
+bool FastBrightness::hasChannelLut(const avs::core::RenderContext& /* context */) const {
+  return true;
+}
+
+void FastBrightness::buildChannelLut(avs::core::RenderContext& /* context */,
+                                     avs::core::ChannelLut& lut) {
+  if (isIdentity()) {
+    lut.setIdentity();
+    return;
+  }
+  // Every channel shares the same transfer curve.
+  lut.fill([this](int /* channel */, std::uint8_t value) { return mapChannel(value); });
+}
+
+bool FastBrightness::preservesBlack(const avs::core::RenderContext& /* context */) const {
+  // A positive bias lifts black.
+  return isIdentity() || mapChannel(0) == 0;
+}
+
+bool FastBrightness::isIdentity() const {
+  return std::abs(amount_ - 1.0f) < 1e-6f && std::abs(bias_) < 1e-3f;
+}
+
+std::uint8_t FastBrightness::mapChannel(std::uint8_t value) const {
+  const float scaled = static_cast<float>(value) * amount_ + bias_;
+  const float processed = clampOutput_ ? std::clamp(scaled, 0.0f, 255.0f) : scaled;
+  const int rounded = static_cast<int>(std::nearbyint(processed));
+  return clampOutput_ ? clampByte(rounded) : static_cast<std::uint8_t>(rounded);
+}
+
+void FastBrightness::applyPixels(std::uint8_t* pixels, std::size_t begin, std::size_t end) const {
+  for (std::size_t i = begin; i < end; ++i) {
     std::uint8_t* px = pixels + i * 4u;
     for (int channel = 0; channel < 3; ++channel) {
-      const float scaled = static_cast<float>(px[channel]) * amount_ + bias_;
-      const float processed =
-          clampOutput_ ? std::clamp(scaled, 0.0f, 255.0f) : scaled;
-      const int rounded = static_cast<int>(std::nearbyint(processed));
-      const std::uint8_t quantized =
-          clampOutput_ ? clampByte(rounded) : static_cast<std::uint8_t>(rounded);
-      px[channel] = quantized;
+      px[channel] = mapChannel(px[channel]);
     }
   }
-  return true;
 }
 
 }  // namespace avs::effects::filters
-
@@ -2,10 +2,10 @@
 
 #include <algorithm>
 #include <cmath>
-#include <random>
 #include <string>
 #include <string_view>
 
+#include <avs/core/RowBand.hpp>
 #include <avs/effects/filters/filter_common.h>
 
 namespace avs::effects::filters {
@@ -50,6 +50,27 @@ void Interferences::setParams(const avs::core::ParamBlock& params) {
 }
 
 bool Interferences::render(avs::core::RenderContext& context) {
+  if (smp_begin(context, 1) <= 0) {
+    return true;
+  }
+  return smp_render(context, 0, 1);
+}
+
+int Interferences::smp_begin(avs::core::RenderContext& context, int maxThreads) {
+  if (!hasFramebuffer(context) || amplitude_ <= 0) {
+    return 0;
+  }
+
+  framePhaseShift_ = phase_ + speed_ * static_cast<int>(context.frameIndex);
+  if (noise_ <= 0) {
+    return maxThreads;
+  }
+
+  noiseStream_ = context.rng.stream();
+  return maxThreads;
+}
+
+bool Interferences::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
   if (!hasFramebuffer(context) || amplitude_ <= 0) {
     return true;
   }
@@ -58,19 +79,10 @@ bool Interferences::render(avs::core::RenderContext& context) {
   const int height = context.height;
   std::uint8_t* pixels = context.framebuffer.data;
   const float invPeriod = kTwoPi / static_cast<float>(period_);
-  const int phaseShift = phase_ + speed_ * static_cast<int>(context.frameIndex);
-
-  std::mt19937 rng;
-  std::uniform_int_distribution<int> noiseDist(-noise_, noise_);
-  if (noise_ > 0) {
-    std::uint32_t base = context.rng.nextUint32() ^ static_cast<std::uint32_t>(phaseShift * 1315423911);
-    if (base == 0) {
-      base = 0x6C8E9CF5u;
-    }
-    rng.seed(base);
-  }
+  const int phaseShift = framePhaseShift_;
+  const avs::core::RowBand band = avs::core::rowBand(height, threadId, maxThreads);
 
-  for (int y = 0; y < height; ++y) {
+  for (int y = band.begin; y < band.end; ++y) {
     for (int x = 0; x < width; ++x) {
       const int coordPrimary = vertical_ ? x : y;
       const int coordSecondary = vertical_ ? y : x;
@@ -80,7 +92,9 @@ bool Interferences::render(avs::core::RenderContext& context) {
       float wave = std::sin(anglePrimary) * 0.75f + std::sin(angleSecondary) * 0.25f;
       int base = static_cast<int>(std::lround(wave * static_cast<float>(amplitude_)));
       if (noise_ > 0) {
-        base += noiseDist(rng);
+        const std::uint64_t pixel = static_cast<std::uint64_t>(y) * static_cast<std::uint64_t>(width) +
+                                    static_cast<std::uint64_t>(x);
+        base += noiseStream_.rangeAt(pixel, -noise_, noise_);
       }
       base = std::clamp(base, -255, 255);
 
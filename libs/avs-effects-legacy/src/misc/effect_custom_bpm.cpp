@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 
 #include <avs/core/ParamBlock.hpp>
 #include <avs/runtime/GlobalState.hpp>
@@ -49,6 +50,27 @@ void CustomBpmEffect::resetState() {
   gate_.reset();
 }
 
+void CustomBpmEffect::saveState(avs::core::StateWriter& writer) const {
+  writer.writeVarInt(beatsSeen_);
+  writer.writeVarInt(skipCounter_);
+  writer.writeF64(accumulatorSeconds_);
+  gate_.saveState(writer);
+}
+
+bool CustomBpmEffect::restoreState(avs::core::StateReader& reader) {
+  const std::int64_t beatsSeen = reader.readVarInt();
+  const std::int64_t skipCounter = reader.readVarInt();
+  const double accumulatorSeconds = reader.readF64();
+  if (!reader.ok() || beatsSeen < 0 || beatsSeen > INT32_MAX || skipCounter < 0 ||
+      skipCounter > INT32_MAX) {
+    return false;
+  }
+  beatsSeen_ = static_cast<int>(beatsSeen);
+  skipCounter_ = static_cast<int>(skipCounter);
+  accumulatorSeconds_ = accumulatorSeconds;
+  return gate_.restoreState(reader);
+}
+
 void CustomBpmEffect::configureGate() {
   gate_.configure(gateOptions_);
   gate_.reset();
@@ -6,6 +6,9 @@
 namespace avs::effects {
 
 bool Clear::render(avs::core::RenderContext& context) {
+  if (value_ == 0) {
+    context.dirtyOut = avs::core::DirtyRect::none();
+  }
   // Modern path: use framebuffer backend if available
   if (context.framebufferBackend) {
     // Clear all channels (RGBA) to the same value to match legacy behavior
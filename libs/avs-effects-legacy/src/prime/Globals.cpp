@@ -35,6 +35,44 @@ bool Globals::compileScripts() {
   return true;
 }
 
+void Globals::compileIfDirty() {
+  if (!dirty_) {
+    return;
+  }
+  compiled_ = compileScripts();
+  initExecuted_ = false;
+  dirty_ = false;
+}
+
+void Globals::saveState(avs::core::StateWriter& writer) const {
+  writer.writeF64(timeSeconds_);
+  writer.writeBool(initExecuted_);
+  writer.writeBool(runtime_ != nullptr);
+  if (runtime_) {
+    runtime_->saveState(writer);
+  }
+}
+
+bool Globals::restoreState(avs::core::StateReader& reader) {
+  const double timeSeconds = reader.readF64();
+  const bool initExecuted = reader.readBool();
+  const bool hasRuntime = reader.readBool();
+  if (!reader.ok()) {
+    return false;
+  }
+  if (hasRuntime) {
+    // A compile still pending would rearm init on the next render.
+    ensureRuntime();
+    compileIfDirty();
+    if (!runtime_->restoreState(reader)) {
+      return false;
+    }
+  }
+  timeSeconds_ = timeSeconds;
+  initExecuted_ = initExecuted;
+  return true;
+}
+
 void Globals::syncFromState(const avs::runtime::GlobalState& state) {
   for (std::size_t i = 0; i < registerPointers_.size(); ++i) {
     if (registerPointers_[i]) {
@@ -56,12 +94,7 @@ bool Globals::render(avs::core::RenderContext& context) {
     return true;
   }
   ensureRuntime();
-
-  if (dirty_) {
-    compiled_ = compileScripts();
-    initExecuted_ = false;
-    dirty_ = false;
-  }
+  compileIfDirty();
   if (!compiled_) {
     return false;
   }
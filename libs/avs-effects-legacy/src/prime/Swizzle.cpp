@@ -43,28 +43,32 @@ std::array<std::uint8_t, 3> orderForMode(avs::effects::SwizzleMode mode) {
 namespace avs::effects {
 
 bool Swizzle::render(avs::core::RenderContext& context) {
-  // Modern path: use framebuffer backend if available
-  std::uint8_t* data = nullptr;
-  std::size_t size = 0;
-
+  // Modern path: use framebuffer backend if available. Its rows may be padded.
+  avs::core::PixelBufferView view;
   if (context.framebufferBackend) {
-    data = context.framebufferBackend->data();
-    size = context.framebufferBackend->sizeBytes();
+    view = context.framebufferBackend->view();
+  } else if (context.framebuffer.stride != 0) {
+    view = context.framebuffer;
   } else {
-    // Legacy path: direct pixel buffer access
-    if (!context.framebuffer.data || context.framebuffer.size == 0) {
-      return true;
-    }
-    data = context.framebuffer.data;
-    size = context.framebuffer.size;
+    // Legacy path: packed pixels, walked as one long row
+    view.data = context.framebuffer.data;
+    view.width = static_cast<int>(context.framebuffer.size / 4u);
+    view.height = 1;
+  }
+  if (!view.data) {
+    return true;
   }
 
   // Swizzle RGB channels
-  for (std::size_t offset = 0; offset + 3 < size; offset += 4) {
-    const std::uint8_t original[3] = {data[offset + 0], data[offset + 1], data[offset + 2]};
-    data[offset + 0] = original[order_[0]];
-    data[offset + 1] = original[order_[1]];
-    data[offset + 2] = original[order_[2]];
+  for (int y = 0; y < view.height; ++y) {
+    std::uint8_t* row = view.row(y);
+    for (int x = 0; x < view.width; ++x) {
+      std::uint8_t* pixel = row + static_cast<std::size_t>(x) * 4u;
+      const std::uint8_t original[3] = {pixel[0], pixel[1], pixel[2]};
+      pixel[0] = original[order_[0]];
+      pixel[1] = original[order_[1]];
+      pixel[2] = original[order_[2]];
+    }
   }
   return true;
 }
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 
 #include <avs/core/ParamBlock.hpp>
 #include <avs/effects/core/gating.h>
@@ -120,6 +121,48 @@ void TransformAffine::setParams(const avs::core::ParamBlock& params) {
   randomScaleFactor_ = 1.0f;
 }
 
+void TransformAffine::saveState(avs::core::StateWriter& writer) const {
+  gateConfig_.gate.saveState(writer);
+  writer.writeF32(jitter_[0]);
+  writer.writeF32(jitter_[1]);
+  writer.writeF32(randomAngleOffset_);
+  writer.writeF32(randomScaleFactor_);
+  // historyLimit_ is recomputed from the parameters and frame size on render.
+  writer.writeVarUint(history_.size());
+  for (const GateState& state : history_) {
+    writer.writeU8(static_cast<std::uint8_t>(state.flag));
+  }
+}
+
+bool TransformAffine::restoreState(avs::core::StateReader& reader) {
+  BeatGate gate = gateConfig_.gate;
+  if (!gate.restoreState(reader)) {
+    return false;
+  }
+  const float jitterX = reader.readF32();
+  const float jitterY = reader.readF32();
+  const float randomAngleOffset = reader.readF32();
+  const float randomScaleFactor = reader.readF32();
+  // One byte per entry, so a count past what is left is corrupt.
+  std::deque<GateState> history(reader.readSize(reader.remaining()));
+  for (GateState& state : history) {
+    const std::uint8_t flag = reader.readU8();
+    if (flag > static_cast<std::uint8_t>(GateFlag::Sticky)) {
+      reader.fail();
+    }
+    state.flag = static_cast<GateFlag>(flag);
+  }
+  if (!reader.ok()) {
+    return false;
+  }
+  gateConfig_.gate = gate;
+  jitter_ = {jitterX, jitterY};
+  randomAngleOffset_ = randomAngleOffset;
+  randomScaleFactor_ = randomScaleFactor;
+  history_ = std::move(history);
+  return true;
+}
+
 void TransformAffine::updateRandom(avs::core::RenderContext& context, bool beatTriggered) {
   if (!beatTriggered) {
     return;
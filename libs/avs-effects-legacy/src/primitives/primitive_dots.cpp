@@ -29,6 +29,7 @@ void PrimitiveDots::setParams(const avs::core::ParamBlock& params) {
 }
 
 bool PrimitiveDots::render(avs::core::RenderContext& context) {
+  context.dirtyOut = context.dirtyIn;
   if (!context.framebuffer.data || context.width <= 0 || context.height <= 0) {
     return true;
   }
@@ -38,6 +39,7 @@ bool PrimitiveDots::render(avs::core::RenderContext& context) {
   }
   for (const auto& pt : points_) {
     detail::drawFilledCircle(context, pt.first, pt.second, radius_, color);
+    detail::markDrawn(context, pt.first, pt.second, pt.first, pt.second, radius_);
   }
   return true;
 }
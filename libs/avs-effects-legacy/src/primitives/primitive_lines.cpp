@@ -38,6 +38,7 @@ void PrimitiveLines::setParams(const avs::core::ParamBlock& params) {
 }
 
 bool PrimitiveLines::render(avs::core::RenderContext& context) {
+  context.dirtyOut = context.dirtyIn;
   if (!context.framebuffer.data || context.width <= 0 || context.height <= 0) {
     return true;
   }
@@ -55,11 +56,13 @@ bool PrimitiveLines::render(avs::core::RenderContext& context) {
     const auto& a = points_[i - 1];
     const auto& b = points_[i];
     detail::drawThickLine(context, a.first, a.second, b.first, b.second, effectiveWidth, color);
+    detail::markDrawn(context, a.first, a.second, b.first, b.second, effectiveWidth / 2);
   }
   if (closed_ && points_.size() > 2) {
     const auto& first = points_.front();
     const auto& last = points_.back();
     detail::drawThickLine(context, last.first, last.second, first.first, first.second, effectiveWidth, color);
+    detail::markDrawn(context, last.first, last.second, first.first, first.second, effectiveWidth / 2);
   }
   return true;
 }
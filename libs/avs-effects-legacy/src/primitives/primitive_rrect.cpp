@@ -59,6 +59,7 @@ static bool containsPoint(int px,
 }
 
 bool PrimitiveRoundedRect::render(avs::core::RenderContext& context) {
+  context.dirtyOut = context.dirtyIn;
   if (!context.framebuffer.data || context.width <= 0 || context.height <= 0) {
     return true;
   }
@@ -72,6 +73,7 @@ bool PrimitiveRoundedRect::render(avs::core::RenderContext& context) {
   const int radius = std::min({radius_, (x1 - x0) / 2, (y1 - y0) / 2});
   const detail::RGBA fillColor = detail::colorFromInt(color_, detail::clampByte(alpha_));
   const detail::RGBA outlineColor = detail::colorFromInt(outlineColor_, detail::clampByte(outlineAlpha_));
+  detail::markDrawn(context, x0, y0, x1, y1);
   for (int y = std::max(0, y0); y <= std::min(context.height - 1, y1); ++y) {
     for (int x = std::max(0, x0); x <= std::min(context.width - 1, x1); ++x) {
       const bool inside = containsPoint(x, y, x0, y0, x1, y1, radius, 0);
@@ -16,6 +16,7 @@ void PrimitiveSolid::setParams(const avs::core::ParamBlock& params) {
 }
 
 bool PrimitiveSolid::render(avs::core::RenderContext& context) {
+  context.dirtyOut = context.dirtyIn;
   if (!context.framebuffer.data || context.width <= 0 || context.height <= 0) {
     return true;
   }
@@ -28,6 +29,7 @@ bool PrimitiveSolid::render(avs::core::RenderContext& context) {
   maxX = std::min(context.width - 1, maxX);
   maxY = std::min(context.height - 1, maxY);
   detail::RGBA color = detail::colorFromInt(color_, detail::clampByte(alpha_));
+  detail::markDrawn(context, minX, minY, maxX, maxY);
   for (int y = minY; y <= maxY; ++y) {
     for (int x = minX; x <= maxX; ++x) {
       detail::blendPixel(context, x, y, color);
@@ -34,6 +34,7 @@ void PrimitiveTriangles::setParams(const avs::core::ParamBlock& params) {
 }
 
 bool PrimitiveTriangles::render(avs::core::RenderContext& context) {
+  context.dirtyOut = context.dirtyIn;
   if (!context.framebuffer.data || context.width <= 0 || context.height <= 0) {
     return true;
   }
@@ -43,6 +44,10 @@ bool PrimitiveTriangles::render(avs::core::RenderContext& context) {
     const detail::Point p0{tri[0], tri[1]};
     const detail::Point p1{tri[2], tri[3]};
     const detail::Point p2{tri[4], tri[5]};
+    // Outlines are circles of radius width / 2 stamped along each edge.
+    const int outlinePad = (!filled_ || outlineWidth_ > 0) ? std::max(1, outlineWidth_) / 2 : 0;
+    detail::markDrawn(context, std::min({p0.x, p1.x, p2.x}), std::min({p0.y, p1.y, p2.y}),
+                      std::max({p0.x, p1.x, p2.x}), std::max({p0.y, p1.y, p2.y}), outlinePad);
     if (filled_) {
       int minX = std::min({p0.x, p1.x, p2.x});
       int maxX = std::max({p0.x, p1.x, p2.x});
@@ -16,6 +16,15 @@ void ClearScreenEffect::setParams(const avs::core::ParamBlock& params) {
   }
 }
 
+avs::core::OutputDependence ClearScreenEffect::outputDependence() const {
+  if (blendMode_ != 1) {
+    return avs::core::OutputDependence::Params;
+  }
+  // Additive: black adds nothing, any other color depends on the input.
+  return (color_ & 0xFFFFFFu) == 0 ? avs::core::OutputDependence::Nothing
+                                   : avs::core::OutputDependence::Frame;
+}
+
 bool ClearScreenEffect::render(avs::core::RenderContext& context) {
   const std::size_t pixelCount = context.width * context.height;
   std::uint8_t* data = context.framebuffer.data;
@@ -24,6 +33,14 @@ bool ClearScreenEffect::render(avs::core::RenderContext& context) {
   const std::uint8_t g = (color_ >> 8) & 0xFF;
   const std::uint8_t b = color_ & 0xFF;
 
+  const bool black = (r | g | b) == 0;
+  if (blendMode_ == 1) {
+    // Adding black changes nothing; any other color lights the whole frame.
+    context.dirtyOut = black ? context.dirtyIn : avs::core::DirtyRect::all();
+  } else if (black) {
+    context.dirtyOut = avs::core::DirtyRect::none();
+  }
+
   if (blendMode_ == 0) {
     // Replace mode - simple fill
     for (std::size_t i = 0; i < pixelCount; ++i) {
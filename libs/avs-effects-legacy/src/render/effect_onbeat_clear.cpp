@@ -17,6 +17,7 @@ void OnBeatClearEffect::setParams(const avs::core::ParamBlock& params) {
 
 bool OnBeatClearEffect::render(avs::core::RenderContext& context) {
   if (!enabled_ || !context.audioBeat) {
+    context.dirtyOut = context.dirtyIn;
     return true;
   }
 
@@ -27,6 +28,9 @@ bool OnBeatClearEffect::render(avs::core::RenderContext& context) {
   const std::uint8_t r = (color_ >> 16) & 0xFF;
   const std::uint8_t g = (color_ >> 8) & 0xFF;
   const std::uint8_t b = color_ & 0xFF;
+  if ((r | g | b) == 0) {
+    context.dirtyOut = avs::core::DirtyRect::none();
+  }
 
   for (std::size_t i = 0; i < pixelCount; ++i) {
     const std::size_t offset = i * 4;
@@ -120,6 +120,7 @@ void OscilloscopeStar::putPixel(avs::core::RenderContext& context, int x, int y,
   if (index + 3u >= context.framebuffer.size) {
     return;
   }
+  context.dirtyOut.include(x, y);
   context.framebuffer.data[index + 0u] = color[0];
   context.framebuffer.data[index + 1u] = color[1];
   context.framebuffer.data[index + 2u] = color[2];
@@ -391,6 +392,8 @@ double OscilloscopeStar::anchorX(const avs::core::RenderContext& context) const
 }
 
 bool OscilloscopeStar::render(avs::core::RenderContext& context) {
+  // Everything drawn goes through putPixel(), which grows the region.
+  context.dirtyOut = context.dirtyIn;
   if (context.width <= 0 || context.height <= 0) {
     rotation_ += rotationSpeed_;
     return true;
@@ -119,6 +119,7 @@ void Ring::drawLine(avs::core::RenderContext& context, int x0, int y0, int x1, i
            static_cast<std::size_t>(x0)) *
           4u;
       if (index + 3 < context.framebuffer.size) {
+        context.dirtyOut.include(x0, y0);
         std::uint8_t* pixel = context.framebuffer.data + index;
         pixel[0] = color.r;
         pixel[1] = color.g;
@@ -408,6 +409,8 @@ void Ring::setParams(const avs::core::ParamBlock& params) {
 }
 
 bool Ring::render(avs::core::RenderContext& context) {
+  // Everything drawn goes through drawLine(), which grows the region.
+  context.dirtyOut = context.dirtyIn;
   if (!context.framebuffer.data || context.width <= 0 || context.height <= 0) {
     return true;
   }
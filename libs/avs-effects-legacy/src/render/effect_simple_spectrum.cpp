@@ -67,6 +67,8 @@ void SimpleSpectrum::setParams(const avs::core::ParamBlock& params) {
 }
 
 bool SimpleSpectrum::render(avs::core::RenderContext& context) {
+  // Everything drawn goes through blendPixel(), which grows the region.
+  context.dirtyOut = context.dirtyIn;
   if (!context.framebuffer.data || context.width <= 0 || context.height <= 0) {
     return true;
   }
@@ -176,6 +178,7 @@ void SimpleSpectrum::blendPixel(avs::core::RenderContext& context, int x, int y,
   if (!context.framebuffer.data || !inBounds(context, x, y)) {
     return;
   }
+  context.dirtyOut.include(x, y);
   auto* pixel = context.framebuffer.data + (static_cast<std::size_t>(y) * context.width + x) * 4u;
   const avs::runtime::LegacyRenderState* legacy =
       (context.globals && context.globals->legacyRender.lineBlendModeActive)
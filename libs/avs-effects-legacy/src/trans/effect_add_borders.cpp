@@ -17,6 +17,11 @@ std::uint32_t AddBorders::makeRGBA(std::uint32_t rgb) {
   return (0xFF << 24) | (b << 16) | (g << 8) | r;
 }
 
+avs::core::OutputDependence AddBorders::outputDependence() const {
+  return enabled_ && size_ > 0 ? avs::core::OutputDependence::Params
+                               : avs::core::OutputDependence::Nothing;
+}
+
 bool AddBorders::render(avs::core::RenderContext& context) {
   if (!enabled_ || !context.framebuffer.data) {
     return true;
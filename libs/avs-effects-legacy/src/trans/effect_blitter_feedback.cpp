@@ -199,23 +199,12 @@ std::uint8_t BlitterFeedback::applyFeedback(std::uint8_t value) const {
   return static_cast<std::uint8_t>(std::lround(clamped));
 }
 
-bool BlitterFeedback::render(avs::core::RenderContext& context) {
-  if (!prepareHistory(context)) {
-    return true;
-  }
-
+void BlitterFeedback::warpRows(avs::core::RenderContext& context, int rowBegin, int rowEnd) {
+  // prepareHistory() has already validated the framebuffer against the history size.
   const int width = historyWidth();
   const int height = historyHeight();
-  if (width <= 0 || height <= 0) {
-    return true;
-  }
 
-  const std::size_t expectedSize = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u;
-  if (!context.framebuffer.data || context.framebuffer.size < expectedSize) {
-    return true;
-  }
-
-  for (int py = 0; py < height; ++py) {
+  for (int py = rowBegin; py < rowEnd; ++py) {
     for (int px = 0; px < width; ++px) {
       const float normX = (static_cast<float>(px) + 0.5f) / static_cast<float>(width);
       const float normY = (static_cast<float>(py) + 0.5f) / static_cast<float>(height);
@@ -261,9 +250,6 @@ bool BlitterFeedback::render(avs::core::RenderContext& context) {
       context.framebuffer.data[index + 3] = color[3];
     }
   }
-
-  storeHistory(context);
-  return true;
 }
 
 }  // namespace avs::effects::trans
@@ -3,8 +3,17 @@
 #include <algorithm>
 #include <cstring>
 
+#include <avs/core/FrameArena.hpp>
+#include <avs/core/RowBand.hpp>
+
 namespace {
 constexpr int kMaxRadius = 32;
+// Radius ceiling per reduced quality level; full quality is uncapped.
+constexpr int kRadiusCapByLevel[avs::core::kMaxQualityLevel] = {2, 4, 8};
+
+int cappedRadius(int radius, int level) {
+  return level >= avs::core::kMaxQualityLevel ? radius : std::min(radius, kRadiusCapByLevel[level]);
+}
 
 bool hasFramebuffer(const avs::core::RenderContext& context) {
   return context.framebuffer.data != nullptr && context.framebuffer.size >= 4u && context.width > 0 &&
@@ -45,7 +54,7 @@ void R_Blur::setParams(const avs::core::ParamBlock& params) {
   }
 
   if (hasRadius) {
-    radius_ = std::clamp(params.getInt("radius", radius_), 0, kMaxRadius);
+    requestedRadius_ = std::clamp(params.getInt("radius", requestedRadius_), 0, kMaxRadius);
   }
   if (hasStrength) {
     const float strengthValue = params.getFloat("strength", static_cast<float>(strength_));
@@ -58,13 +67,13 @@ void R_Blur::setParams(const avs::core::ParamBlock& params) {
         strength_ = 0;
         break;
       case 1:
-        radius_ = std::max(1, radius_);
+        requestedRadius_ = std::max(1, requestedRadius_);
         if (!hasStrength) {
           strength_ = 256;
         }
         break;
       case 2:
-        radius_ = std::max(1, radius_);
+        requestedRadius_ = std::max(1, requestedRadius_);
         if (!hasStrength) {
           strength_ = 192;
         } else {
@@ -72,7 +81,7 @@ void R_Blur::setParams(const avs::core::ParamBlock& params) {
         }
         break;
       case 3:
-        radius_ = std::max(2, radius_);
+        requestedRadius_ = std::max(2, requestedRadius_);
         if (!hasStrength) {
           strength_ = 256;
         }
@@ -84,19 +93,21 @@ void R_Blur::setParams(const avs::core::ParamBlock& params) {
 
   horizontal_ = params.getBool("horizontal", horizontal_);
   vertical_ = params.getBool("vertical", vertical_);
+  radius_ = cappedRadius(requestedRadius_, qualityLevel_);
 }
 
-void R_Blur::ensureBuffers(int width, int height) {
+void R_Blur::setQualityLevel(int level) {
+  qualityLevel_ = avs::core::clampQualityLevel(level);
+  radius_ = cappedRadius(requestedRadius_, qualityLevel_);
+}
+
+void R_Blur::ensureBuffers(avs::core::RenderContext& context, bool needTemp) {
+  const int width = context.width;
+  const int height = context.height;
   const std::size_t total = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u;
-  if (original_.size() < total) {
-    original_.resize(total);
-  }
-  if (temp_.size() < total) {
-    temp_.resize(total);
-  }
-  if (blurred_.size() < total) {
-    blurred_.resize(total);
-  }
+  original_ = avs::core::frameScratch(context.arena, originalFallback_, total);
+  blurred_ = avs::core::frameScratch(context.arena, blurredFallback_, total);
+  temp_ = needTemp ? avs::core::frameScratch(context.arena, tempFallback_, total) : nullptr;
   if (static_cast<int>(prefixRow_.size()) < (width + 1) * 4) {
     prefixRow_.assign(static_cast<std::size_t>(width + 1) * 4u, 0);
   }
@@ -119,24 +130,24 @@ bool R_Blur::renderBox(avs::core::RenderContext& context) {
     return true;
   }
 
-  ensureBuffers(width, height);
+  ensureBuffers(context, vertical_);
   std::uint8_t* framebuffer = context.framebuffer.data;
   const std::size_t total = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u;
-  std::memcpy(original_.data(), framebuffer, total);
+  std::memcpy(original_, framebuffer, total);
 
-  std::uint8_t* firstPassDst = vertical_ ? temp_.data() : blurred_.data();
+  std::uint8_t* firstPassDst = vertical_ ? temp_ : blurred_;
   if (horizontal_) {
-    horizontalPass(original_.data(), firstPassDst, width, height);
+    horizontalPass(original_, firstPassDst, width, height);
   } else {
-    std::memcpy(firstPassDst, original_.data(), total);
+    std::memcpy(firstPassDst, original_, total);
   }
 
   if (vertical_) {
-    const std::uint8_t* verticalSrc = horizontal_ ? temp_.data() : original_.data();
-    verticalPass(verticalSrc, blurred_.data(), width, height);
+    const std::uint8_t* verticalSrc = horizontal_ ? temp_ : original_;
+    verticalPass(verticalSrc, blurred_, width, height);
   }
 
-  blend(framebuffer, original_.data(), blurred_.data(), width, height);
+  blend(framebuffer, original_, blurred_, width, height);
   return true;
 }
 
@@ -289,6 +300,26 @@ std::uint8_t R_Blur::clampByte(int value) {
 // Multi-threaded rendering implementation
 // ============================================================================
 
+int R_Blur::smp_begin(avs::core::RenderContext& context, int maxThreads) {
+  if (!hasFramebuffer(context)) {
+    return 0;
+  }
+  if (radius_ <= 0 || strength_ <= 0 || (!horizontal_ && !vertical_)) {
+    return 0;
+  }
+
+  // Snapshot the source once; bands only read original_ from here on.
+  const int width = context.width;
+  const int height = context.height;
+  ensureBuffers(context, false);
+  const std::size_t total = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u;
+  std::memcpy(original_, context.framebuffer.data, total);
+  if (static_cast<int>(bandScratch_.size()) < maxThreads) {
+    bandScratch_.resize(static_cast<std::size_t>(maxThreads));
+  }
+  return maxThreads;
+}
+
 bool R_Blur::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
   if (!hasFramebuffer(context)) {
     return true;
@@ -297,52 +328,41 @@ bool R_Blur::smp_render(avs::core::RenderContext& context, int threadId, int max
 }
 
 bool R_Blur::renderBoxThreaded(avs::core::RenderContext& context, int threadId, int maxThreads) {
-  if (radius_ <= 0 || strength_ <= 0) {
-    return true;
-  }
-  if (!horizontal_ && !vertical_) {
-    return true;
-  }
-
   const int width = std::max(0, context.width);
   const int height = std::max(0, context.height);
   if (width == 0 || height == 0) {
     return true;
   }
 
-  // Thread 0 prepares buffers
-  if (threadId == 0) {
-    ensureBuffers(width, height);
-    std::uint8_t* framebuffer = context.framebuffer.data;
-    const std::size_t total = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u;
-    std::memcpy(original_.data(), framebuffer, total);
-  }
-
-  // Wait for all threads (implicit barrier in ThreadPool)
-
-  // Divide work by rows
-  const int rowsPerThread = height / maxThreads;
-  const int startRow = threadId * rowsPerThread;
-  const int endRow = (threadId == maxThreads - 1) ? height : startRow + rowsPerThread;
-
-  std::uint8_t* firstPassDst = vertical_ ? temp_.data() : blurred_.data();
-
-  // Horizontal pass (row-parallel)
-  if (horizontal_) {
-    horizontalPassThreaded(original_.data(), firstPassDst, width, height, startRow, endRow);
-  } else if (threadId == 0) {
-    const std::size_t total = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u;
-    std::memcpy(firstPassDst, original_.data(), total);
+  // The vertical pass samples radius_ rows around the band. Those rows come from
+  // the immutable original_ snapshot, never from another band's output.
+  const avs::core::HaloBand band =
+      avs::core::haloBand(height, threadId, maxThreads, vertical_ ? radius_ : 0);
+  if (band.rows.empty()) {
+    return true;
   }
-
-  // Vertical pass (also row-parallel, processing different rows)
-  if (vertical_) {
-    const std::uint8_t* verticalSrc = horizontal_ ? temp_.data() : original_.data();
-    verticalPassThreaded(verticalSrc, blurred_.data(), width, height, startRow, endRow);
+  const int startRow = band.rows.begin;
+  const int endRow = band.rows.end;
+  const std::size_t stride = static_cast<std::size_t>(width) * 4u;
+  const std::uint8_t* sourceRows = original_ + static_cast<std::size_t>(band.source.begin) * stride;
+  BandScratch& scratch = bandScratch_[static_cast<std::size_t>(threadId)];
+
+  if (!vertical_) {
+    horizontalPassThreaded(original_, blurred_, width, height, startRow, endRow);
+  } else if (horizontal_) {
+    // Blur the halo rows horizontally into band-local storage, then vertically into our rows.
+    const int sourceRowCount = band.source.end - band.source.begin;
+    scratch.rows.resize(static_cast<std::size_t>(sourceRowCount) * stride);
+    horizontalPassThreaded(sourceRows, scratch.rows.data(), width, sourceRowCount, 0, sourceRowCount);
+    verticalPassThreaded(scratch.rows.data(), band.source.begin, band.source.end, blurred_, width,
+                         height, startRow, endRow, scratch.prefixColumn);
+  } else {
+    verticalPassThreaded(sourceRows, band.source.begin, band.source.end, blurred_, width, height,
+                         startRow, endRow, scratch.prefixColumn);
   }
 
   // Blend (row-parallel)
-  blendThreaded(context.framebuffer.data, original_.data(), blurred_.data(), width, height, startRow, endRow);
+  blendThreaded(context.framebuffer.data, original_, blurred_, width, height, startRow, endRow);
 
   return true;
 }
@@ -406,27 +426,31 @@ void R_Blur::horizontalPassThreaded(const std::uint8_t* src, std::uint8_t* dst,
   }
 }
 
-void R_Blur::verticalPassThreaded(const std::uint8_t* src, std::uint8_t* dst,
-                                  int width, int height,
-                                  int startRow, int endRow) const {
+void R_Blur::verticalPassThreaded(const std::uint8_t* src, int srcBeginRow, int srcEndRow,
+                                  std::uint8_t* dst, int width, int height,
+                                  int startRow, int endRow,
+                                  std::vector<int>& prefixColumn) const {
+  // src holds rows [srcBeginRow, srcEndRow) of the frame, which must cover the band plus radius_.
+  const std::size_t stride = static_cast<std::size_t>(width) * 4u;
   if (!vertical_ || radius_ <= 0) {
-    const std::size_t stride = static_cast<std::size_t>(width) * 4u;
     for (int y = startRow; y < endRow; ++y) {
-      const std::size_t offset = static_cast<std::size_t>(y) * stride;
-      std::memcpy(dst + offset, src + offset, stride);
+      std::memcpy(dst + static_cast<std::size_t>(y) * stride,
+                  src + static_cast<std::size_t>(y - srcBeginRow) * stride, stride);
     }
     return;
   }
 
   const int window = radius_ * 2 + 1;
-  std::vector<int> localPrefixColumn((height + 1) * 4);
+  const int srcRows = srcEndRow - srcBeginRow;
+  std::vector<int>& localPrefixColumn = prefixColumn;
+  localPrefixColumn.resize(static_cast<std::size_t>(srcRows + 1) * 4u);
 
   // Process columns within the assigned row range
   for (int x = 0; x < width; ++x) {
     std::fill(localPrefixColumn.begin(), localPrefixColumn.end(), 0);
 
-    // Build prefix sum for this column (full height needed)
-    for (int y = 0; y < height; ++y) {
+    // Build prefix sum for this column over the band and its halo
+    for (int y = 0; y < srcRows; ++y) {
       const std::size_t srcIndex =
           (static_cast<std::size_t>(y) * static_cast<std::size_t>(width) + static_cast<std::size_t>(x)) * 4u;
       const std::size_t prefixIndex = static_cast<std::size_t>(y + 1) * 4u;
@@ -436,10 +460,6 @@ void R_Blur::verticalPassThreaded(const std::uint8_t* src, std::uint8_t* dst,
       localPrefixColumn[prefixIndex + 3] = localPrefixColumn[prefixIndex - 1] + src[srcIndex + 3];
     }
 
-    const std::uint8_t* firstPx = src + static_cast<std::size_t>(x) * 4u;
-    const std::uint8_t* lastPx =
-        src + (static_cast<std::size_t>(height - 1) * static_cast<std::size_t>(width) + static_cast<std::size_t>(x)) * 4u;
-
     // Only process rows assigned to this thread
     for (int y = startRow; y < endRow; ++y) {
       const int top = y - radius_;
@@ -448,8 +468,17 @@ void R_Blur::verticalPassThreaded(const std::uint8_t* src, std::uint8_t* dst,
       const int clampedBottom = clampIndex(bottom, 0, height - 1);
       const int topPadding = clampedTop - top;
       const int bottomPadding = bottom - clampedBottom;
-      const std::size_t prefixTop = static_cast<std::size_t>(clampedTop) * 4u;
-      const std::size_t prefixBottom = static_cast<std::size_t>(clampedBottom + 1) * 4u;
+      const std::size_t prefixTop = static_cast<std::size_t>(clampedTop - srcBeginRow) * 4u;
+      const std::size_t prefixBottom = static_cast<std::size_t>(clampedBottom + 1 - srcBeginRow) * 4u;
+      // Padding only occurs at the frame edges, where the clamped row is the edge row.
+      const std::uint8_t* firstPx =
+          src + (static_cast<std::size_t>(clampedTop - srcBeginRow) * static_cast<std::size_t>(width) +
+                 static_cast<std::size_t>(x)) *
+                    4u;
+      const std::uint8_t* lastPx =
+          src + (static_cast<std::size_t>(clampedBottom - srcBeginRow) * static_cast<std::size_t>(width) +
+                 static_cast<std::size_t>(x)) *
+                    4u;
       std::uint8_t* dstPx = dst +
                              (static_cast<std::size_t>(y) * static_cast<std::size_t>(width) +
                               static_cast<std::size_t>(x)) *
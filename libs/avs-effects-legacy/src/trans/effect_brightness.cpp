@@ -6,6 +6,8 @@
 #include <cstdlib>
 #include <string>
 
+#include <avs/core/RowBand.hpp>
+
 namespace {
 
 inline bool hasFramebuffer(const avs::core::RenderContext& context) {
@@ -18,22 +20,69 @@ inline bool hasFramebuffer(const avs::core::RenderContext& context) {
 namespace avs::effects::trans {
 
 bool Brightness::render(avs::core::RenderContext& context) {
-  if (!enabled_) {
+  if (smp_begin(context, 1) <= 0) {
     return true;
   }
+  return smp_render(context, 0, 1);
+}
+
+int Brightness::smp_begin(avs::core::RenderContext& context, int maxThreads) {
+  if (!enabled_) {
+    return 0;
+  }
   if (!hasFramebuffer(context)) {
+    return 0;
+  }
+
+  updateLookupTables();
+  return maxThreads;
+}
+
+bool Brightness::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
+  if (!enabled_ || !hasFramebuffer(context)) {
     return true;
   }
+  const std::size_t totalPixels =
+      static_cast<std::size_t>(context.width) * static_cast<std::size_t>(context.height);
+  const auto span =
+      avs::core::rowBandPixels(totalPixels, context.width, context.height, threadId, maxThreads);
+  applyPixels(context.framebuffer.data, span.begin, span.end);
+  return true;
+}
 
+bool Brightness::hasChannelLut(const avs::core::RenderContext& /* context */) const {
+  // The exclusion test compares whole pixels against the reference color.
+  return !enabled_ || !exclude_;
+}
+
+void Brightness::buildChannelLut(avs::core::RenderContext& /* context */, avs::core::ChannelLut& lut) {
+  if (!enabled_) {
+    lut.setIdentity();
+    return;
+  }
   updateLookupTables();
 
+  const std::array<const std::array<std::uint8_t, 256>*, 3> tables = {&redTable_, &greenTable_,
+                                                                       &blueTable_};
   const bool useAdditiveBlend = blendAdditive_;
   const bool useAverageBlend = !useAdditiveBlend && blendAverage_;
+  lut.fill([&](int channel, std::uint8_t value) {
+    const std::uint8_t adjusted = (*tables[static_cast<std::size_t>(channel)])[value];
+    if (useAdditiveBlend) {
+      return saturatingAdd(value, adjusted);
+    }
+    if (useAverageBlend) {
+      return static_cast<std::uint8_t>((static_cast<int>(value) + static_cast<int>(adjusted)) >> 1);
+    }
+    return adjusted;
+  });
+}
 
-  std::uint8_t* pixels = context.framebuffer.data;
-  const std::size_t totalPixels =
-      static_cast<std::size_t>(context.width) * static_cast<std::size_t>(context.height);
-  for (std::size_t i = 0; i < totalPixels; ++i) {
+void Brightness::applyPixels(std::uint8_t* pixels, std::size_t begin, std::size_t end) const {
+  const bool useAdditiveBlend = blendAdditive_;
+  const bool useAverageBlend = !useAdditiveBlend && blendAverage_;
+
+  for (std::size_t i = begin; i < end; ++i) {
     std::uint8_t* px = pixels + i * 4u;
     if (exclude_ && shouldSkipPixel(px)) {
       continue;
@@ -58,8 +107,6 @@ bool Brightness::render(avs::core::RenderContext& context) {
       px[2] = newBlue;
     }
   }
-
-  return true;
 }
 
 void Brightness::setParams(const avs::core::ParamBlock& params) {
@@ -8,6 +8,7 @@
 #include <string>
 
 #include <avs/core/RenderContext.hpp>
+#include <avs/core/RowBand.hpp>
 
 namespace {
 constexpr int kIdRgb = 1183;
@@ -59,9 +60,16 @@ void ChannelShift::setParams(const avs::core::ParamBlock& params) {
 }
 
 bool ChannelShift::render(avs::core::RenderContext& context) {
-  if (!context.framebuffer.data || context.framebuffer.size < 4) {
+  if (smp_begin(context, 1) <= 0) {
     return true;
   }
+  return smp_render(context, 0, 1);
+}
+
+int ChannelShift::smp_begin(avs::core::RenderContext& context, int maxThreads) {
+  if (!context.framebuffer.data || context.framebuffer.size < 4) {
+    return 0;
+  }
 
   if (context.audioBeat && randomizeOnBeat_) {
     const std::uint32_t randomValue = context.rng.nextUint32();
@@ -72,12 +80,26 @@ bool ChannelShift::render(avs::core::RenderContext& context) {
   }
 
   if (currentMode_ == Mode::RGB) {
+    return 0;
+  }
+
+  // Without frame geometry the buffer cannot be split into rows.
+  if (context.width <= 0 || context.height <= 0) {
+    return 1;
+  }
+  return maxThreads;
+}
+
+bool ChannelShift::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
+  if (!context.framebuffer.data || context.framebuffer.size < 4 || currentMode_ == Mode::RGB) {
     return true;
   }
 
   std::uint8_t* data = context.framebuffer.data;
-  const std::size_t size = context.framebuffer.size;
-  for (std::size_t offset = 0; offset + 3 < size; offset += 4) {
+  const std::size_t pixelCount = context.framebuffer.size / 4u;
+  const auto span =
+      avs::core::rowBandPixels(pixelCount, context.width, context.height, threadId, maxThreads);
+  for (std::size_t offset = span.begin * 4u; offset < span.end * 4u; offset += 4) {
     const std::array<std::uint8_t, 3> original = {data[offset + 0], data[offset + 1], data[offset + 2]};
     data[offset + 0] = original[channelOrder_[0]];
     data[offset + 1] = original[channelOrder_[1]];
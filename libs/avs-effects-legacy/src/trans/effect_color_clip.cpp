@@ -3,6 +3,8 @@
 #include <array>
 #include <cstddef>
 
+#include <avs/core/RowBand.hpp>
+
 namespace avs::effects::trans {
 namespace {
 bool hasFramebuffer(const avs::core::RenderContext& context) {
@@ -56,7 +58,9 @@ void ColorClip::setParams(const avs::core::ParamBlock& params) {
   clipColor_[2] = extractComponent(colorValue, 16);
 }
 
-bool ColorClip::render(avs::core::RenderContext& context) {
+bool ColorClip::render(avs::core::RenderContext& context) { return smp_render(context, 0, 1); }
+
+bool ColorClip::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
   if (!enabled_) {
     return true;
   }
@@ -66,7 +70,9 @@ bool ColorClip::render(avs::core::RenderContext& context) {
 
   std::uint8_t* pixels = context.framebuffer.data;
   const std::size_t totalPixels = static_cast<std::size_t>(context.width) * static_cast<std::size_t>(context.height);
-  for (std::size_t i = 0; i < totalPixels; ++i) {
+  const auto span =
+      avs::core::rowBandPixels(totalPixels, context.width, context.height, threadId, maxThreads);
+  for (std::size_t i = span.begin; i < span.end; ++i) {
     std::uint8_t* px = pixels + i * 4u;
     if (px[0] <= clipColor_[0] && px[1] <= clipColor_[1] && px[2] <= clipColor_[2]) {
       px[0] = clipColor_[0];
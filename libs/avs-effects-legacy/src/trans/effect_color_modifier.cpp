@@ -10,6 +10,8 @@
 #include <string>
 #include <string_view>
 
+#include <avs/core/RowBand.hpp>
+
 namespace {
 
 bool hasFramebuffer(const avs::core::RenderContext& context) {
@@ -70,40 +72,29 @@ Mode parseModeInt(int value, Mode fallback) {
 }
 
 Mode readModeParam(const avs::core::ParamBlock& params, Mode fallback) {
-  constexpr std::array<std::string_view, 4> kKeys{"mode", "modifier_mode", "color_modifier_mode",
-                                                  "color_mode"};
-  for (const auto& keyView : kKeys) {
-    const std::string key(keyView);
-    if (!params.contains(key)) {
-      continue;
-    }
-
-    const std::string sentinel(1, '\x01');
-    const std::string asString = params.getString(key, sentinel);
-    if (asString != sentinel) {
-      return parseModeString(asString, fallback);
-    }
-
-    const int asInt = params.getInt(key, static_cast<int>(fallback));
-    return parseModeInt(asInt, fallback);
+  static const avs::core::ParamAliases kKeys{"mode", "modifier_mode", "color_modifier_mode",
+                                             "color_mode"};
+  const auto key = params.firstPresent(kKeys);
+  if (!key) {
+    return fallback;
   }
-  return fallback;
+  if (const std::string* asString = params.findString(*key)) {
+    return parseModeString(*asString, fallback);
+  }
+  return parseModeInt(params.getInt(*key, static_cast<int>(fallback)), fallback);
 }
 
-bool readBoolParam(const avs::core::ParamBlock& params, const std::array<std::string_view, 3>& keys,
+bool readBoolParam(const avs::core::ParamBlock& params, const avs::core::ParamAliases& keys,
                    bool fallback) {
-  for (const auto& keyView : keys) {
-    const std::string key(keyView);
-    if (!params.contains(key)) {
-      continue;
-    }
-    bool value = params.getBool(key, fallback);
-    if (!value) {
-      value = params.getInt(key, value ? 1 : 0) != 0;
-    }
-    return value;
+  const auto key = params.firstPresent(keys);
+  if (!key) {
+    return fallback;
   }
-  return fallback;
+  bool value = params.getBool(*key, fallback);
+  if (!value) {
+    value = params.getInt(*key, 0) != 0;
+  }
+  return value;
 }
 
 std::array<float, 3> evaluateNormalized(float normalized, Mode mode) {
@@ -134,7 +125,8 @@ std::array<float, 3> evaluateNormalized(float normalized, Mode mode) {
 namespace avs::effects::trans {
 
 void ColorModifier::setParams(const avs::core::ParamBlock& params) {
-  const bool newEnabled = readBoolParam(params, {"enabled", "active", "on"}, enabled_);
+  static const avs::core::ParamAliases kEnabledKeys{"enabled", "active", "on"};
+  const bool newEnabled = readBoolParam(params, kEnabledKeys, enabled_);
   const Mode newMode = readModeParam(params, mode_);
 
   if (newMode != mode_) {
@@ -146,26 +138,53 @@ void ColorModifier::setParams(const avs::core::ParamBlock& params) {
 }
 
 bool ColorModifier::render(avs::core::RenderContext& context) {
-  if (!enabled_) {
-    return true;
-  }
-  if (!hasFramebuffer(context)) {
+  if (smp_begin(context, 1) <= 0) {
     return true;
   }
+  return smp_render(context, 0, 1);
+}
 
+int ColorModifier::smp_begin(avs::core::RenderContext& context, int maxThreads) {
+  if (!enabled_ || !hasFramebuffer(context)) {
+    return 0;
+  }
   recomputeLookupTables();
+  return maxThreads;
+}
 
-  std::uint8_t* pixels = context.framebuffer.data;
+bool ColorModifier::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
+  if (!enabled_ || !hasFramebuffer(context)) {
+    return true;
+  }
   const std::size_t totalPixels =
       static_cast<std::size_t>(context.width) * static_cast<std::size_t>(context.height);
-  for (std::size_t i = 0; i < totalPixels; ++i) {
+  const auto span =
+      avs::core::rowBandPixels(totalPixels, context.width, context.height, threadId, maxThreads);
+  applyPixels(context.framebuffer.data, span.begin, span.end);
+  return true;
+}
+
+bool ColorModifier::hasChannelLut(const avs::core::RenderContext& /* context */) const {
+  return true;
+}
+
+void ColorModifier::buildChannelLut(avs::core::RenderContext& /* context */,
+                                    avs::core::ChannelLut& lut) {
+  if (!enabled_) {
+    lut.setIdentity();
+    return;
+  }
+  recomputeLookupTables();
+  lut.channels = {redTable_, greenTable_, blueTable_};
+}
+
+void ColorModifier::applyPixels(std::uint8_t* pixels, std::size_t begin, std::size_t end) const {
+  for (std::size_t i = begin; i < end; ++i) {
     std::uint8_t* px = pixels + i * 4u;
     px[0] = redTable_[px[0]];
     px[1] = greenTable_[px[1]];
     px[2] = blueTable_[px[2]];
   }
-
-  return true;
 }
 
 void ColorModifier::recomputeLookupTables() {
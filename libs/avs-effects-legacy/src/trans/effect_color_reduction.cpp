@@ -4,6 +4,8 @@
 #include <cstddef>
 #include <cstdint>
 
+#include <avs/core/RowBand.hpp>
+
 namespace avs::effects::trans {
 
 namespace {
@@ -31,6 +33,10 @@ void ColorReduction::setParams(const avs::core::ParamBlock& params) {
 }
 
 bool ColorReduction::render(avs::core::RenderContext& context) {
+  return smp_render(context, 0, 1);
+}
+
+bool ColorReduction::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
   if (context.width <= 0 || context.height <= 0 || context.framebuffer.data == nullptr ||
       context.framebuffer.size < 4u) {
     return true;
@@ -45,8 +51,10 @@ bool ColorReduction::render(avs::core::RenderContext& context) {
   const std::size_t availablePixels = context.framebuffer.size / 4u;
   const std::size_t pixelCount = std::min(totalPixels, availablePixels);
 
+  const auto span =
+      avs::core::rowBandPixels(pixelCount, context.width, context.height, threadId, maxThreads);
   std::uint8_t* data = context.framebuffer.data;
-  for (std::size_t i = 0; i < pixelCount; ++i) {
+  for (std::size_t i = span.begin; i < span.end; ++i) {
     std::uint8_t* px = data + i * 4u;
     px[0] &= channelMask_;
     px[1] &= channelMask_;
@@ -56,6 +64,16 @@ bool ColorReduction::render(avs::core::RenderContext& context) {
   return true;
 }
 
+bool ColorReduction::hasChannelLut(const avs::core::RenderContext& /* context */) const {
+  return true;
+}
+
+void ColorReduction::buildChannelLut(avs::core::RenderContext& /* context */,
+                                     avs::core::ChannelLut& lut) {
+  const std::uint8_t mask = channelMask_;
+  lut.fill([mask](int /* channel */, std::uint8_t value) { return static_cast<std::uint8_t>(value & mask); });
+}
+
 void ColorReduction::updateMask() {
   const int clampedLevels = std::clamp(levels_, kMinLevels, kMaxLevels);
   levels_ = clampedLevels;
@@ -5,6 +5,8 @@
 #include <cstdint>
 #include <cstddef>
 
+#include <avs/core/RowBand.hpp>
+
 namespace avs::effects::trans {
 
 namespace {
@@ -118,14 +120,25 @@ void Colorfade::updateOffsets(avs::core::RenderContext& context) {
 }
 
 bool Colorfade::render(avs::core::RenderContext& context) {
-  if (!enabled_ || context.framebuffer.data == nullptr || context.width <= 0 || context.height <= 0) {
+  if (smp_begin(context, 1) <= 0) {
     return true;
   }
+  return smp_render(context, 0, 1);
+}
+
+int Colorfade::smp_begin(avs::core::RenderContext& context, int maxThreads) {
+  if (!enabled_ || context.framebuffer.data == nullptr || context.width <= 0 || context.height <= 0) {
+    return 0;
+  }
 
   updateOffsets(context);
 
   const bool hasEffect = (currentOffsets_[0] != 0 || currentOffsets_[1] != 0 || currentOffsets_[2] != 0);
-  if (!hasEffect) {
+  return hasEffect ? maxThreads : 0;
+}
+
+bool Colorfade::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
+  if (!enabled_ || context.framebuffer.data == nullptr || context.width <= 0 || context.height <= 0) {
     return true;
   }
 
@@ -138,8 +151,10 @@ bool Colorfade::render(avs::core::RenderContext& context) {
 
   std::uint8_t* pixels = context.framebuffer.data;
   const std::size_t totalPixels = static_cast<std::size_t>(context.width) * static_cast<std::size_t>(context.height);
+  const auto span =
+      avs::core::rowBandPixels(totalPixels, context.width, context.height, threadId, maxThreads);
 
-  for (std::size_t i = 0; i < totalPixels; ++i) {
+  for (std::size_t i = span.begin; i < span.end; ++i) {
     std::uint8_t* px = pixels + i * 4u;
     int tableIndex = 3;
     if (px[1] > px[2] && px[1] > px[0]) {
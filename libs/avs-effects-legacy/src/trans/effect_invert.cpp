@@ -1,6 +1,7 @@
 #include "avs/effects/trans/effect_invert.h"
 
 #include <avs/core/IFramebuffer.hpp>
+#include <avs/core/RowBand.hpp>
 
 namespace avs::effects::trans {
 
@@ -10,36 +11,50 @@ void InvertEffect::setParams(const avs::core::ParamBlock& params) {
   }
 }
 
-bool InvertEffect::render(avs::core::RenderContext& context) {
+bool InvertEffect::render(avs::core::RenderContext& context) { return smp_render(context, 0, 1); }
+
+bool InvertEffect::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
   if (!enabled_) {
     return true;
   }
 
-  // Modern path: use framebuffer backend if available
-  std::uint8_t* data = nullptr;
-  std::size_t pixelCount = 0;
-
+  // Modern path: use framebuffer backend if available. Its rows may be padded.
+  avs::core::PixelBufferView view;
   if (context.framebufferBackend) {
-    data = context.framebufferBackend->data();
-    pixelCount = static_cast<std::size_t>(context.framebufferBackend->width()) *
-                 context.framebufferBackend->height();
+    view = context.framebufferBackend->view();
   } else {
     // Legacy path: direct pixel buffer access
-    data = context.framebuffer.data;
-    pixelCount = static_cast<std::size_t>(context.width) * context.height;
+    view = context.framebuffer;
+    view.width = context.width;
+    view.height = context.height;
+  }
+  if (!view.data) {
+    return true;
   }
 
-  // Invert RGB channels
-  for (std::size_t i = 0; i < pixelCount; ++i) {
-    const std::size_t offset = i * 4;
+  const avs::core::RowBand band = avs::core::rowBand(view.height, threadId, maxThreads);
+  for (int y = band.begin; y < band.end; ++y) {
+    std::uint8_t* row = view.row(y);
     // Invert RGB, leave alpha unchanged
-    data[offset + 0] = 255 - data[offset + 0];  // R
-    data[offset + 1] = 255 - data[offset + 1];  // G
-    data[offset + 2] = 255 - data[offset + 2];  // B
-    // data[offset + 3] unchanged (A)
+    for (int x = 0; x < view.width; ++x) {
+      std::uint8_t* pixel = row + static_cast<std::size_t>(x) * 4u;
+      pixel[0] = 255 - pixel[0];  // R
+      pixel[1] = 255 - pixel[1];  // G
+      pixel[2] = 255 - pixel[2];  // B
+    }
   }
 
   return true;
 }
 
+bool InvertEffect::hasChannelLut(const avs::core::RenderContext& /* context */) const {
+  return true;
+}
+
+void InvertEffect::buildChannelLut(avs::core::RenderContext& /* context */, avs::core::ChannelLut& lut) {
+  lut.fill([this](int /* channel */, std::uint8_t value) {
+    return enabled_ ? static_cast<std::uint8_t>(255 - value) : value;
+  });
+}
+
 }  // namespace avs::effects::trans
@@ -6,6 +6,10 @@
 #include <cstdlib>
 #include <cstring>
 
+#include <avs/core/FrameArena.hpp>
+
+#include <avs/core/RowBand.hpp>
+
 namespace avs::effects::trans {
 
 namespace {
@@ -22,12 +26,6 @@ std::uint8_t saturatingAdd(std::uint8_t a, std::uint8_t b) {
 
 }  // namespace
 
-void Mosaic::ensureScratch(std::size_t bytes) {
-  if (scratch_.size() < bytes) {
-    scratch_.resize(bytes);
-  }
-}
-
 std::uint32_t Mosaic::blendAdditive(std::uint32_t dst, std::uint32_t src) {
   const std::uint32_t r =
       saturatingAdd(static_cast<std::uint8_t>(dst & 0xFFu), static_cast<std::uint8_t>(src & 0xFFu));
@@ -82,14 +80,21 @@ void Mosaic::setParams(const avs::core::ParamBlock& params) {
 }
 
 bool Mosaic::render(avs::core::RenderContext& context) {
-  if (!enabled_ || !hasFramebuffer(context)) {
+  if (smp_begin(context, 1) <= 0) {
     return true;
   }
+  return smp_render(context, 0, 1);
+}
+
+int Mosaic::smp_begin(avs::core::RenderContext& context, int maxThreads) {
+  if (!enabled_ || !hasFramebuffer(context)) {
+    return 0;
+  }
 
   const int width = context.width;
   const int height = context.height;
   if (width <= 0 || height <= 0) {
-    return true;
+    return 0;
   }
 
   if (triggerOnBeat_ && context.audioBeat) {
@@ -100,103 +105,119 @@ bool Mosaic::render(avs::core::RenderContext& context) {
   }
 
   currentQuality_ = clampQuality(currentQuality_);
-  const int effectiveQuality = currentQuality_;
-  if (effectiveQuality < kQualityMin) {
-    return true;
+  frameQuality_ = currentQuality_;
+  advanceBeatDecay();
+  if (frameQuality_ < kQualityMin || frameQuality_ >= kQualityMax) {
+    return 0;
   }
 
-  if (effectiveQuality < kQualityMax) {
-    const std::size_t pixelCount =
-        static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
-    const std::size_t bytes = pixelCount * 4u;
-    ensureScratch(bytes);
-    std::uint8_t* framebuffer = context.framebuffer.data;
-    std::memcpy(scratch_.data(), framebuffer, bytes);
-
-    const auto* source = reinterpret_cast<const std::uint32_t*>(scratch_.data());
-    auto* dst = reinterpret_cast<std::uint32_t*>(framebuffer);
-
-    const int sXInc = (width * 65536) / effectiveQuality;
-    const int sYInc = (height * 65536) / effectiveQuality;
-    const bool subPixelX = sXInc < kOne;
-    const bool subPixelY = sYInc < kOne;
-    int ypos = sYInc >> 17;
-    int dypos = 0;
-
-    for (int y = 0; y < height; ++y) {
-      if (ypos >= height) {
-        break;
-      }
-      const int sampleRow = ypos * width;
-      int dpos = 0;
-      int xpos = sXInc >> 17;
-      if (xpos >= width) {
-        xpos = width - 1;
+  // Blocks sample arbitrary source rows, so bands read a whole-frame snapshot.
+  const std::size_t bytes = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u;
+  source_ = avs::core::frameScratch(context.arena, scratch_, bytes);
+  std::memcpy(source_, context.framebuffer.data, bytes);
+
+  // The sampled row only depends on the destination row; resolve it up front so
+  // bands can start anywhere. Rows past the last block keep their source pixels.
+  const int sYInc = (height * 65536) / frameQuality_;
+  const bool subPixelY = sYInc < kOne;
+  int ypos = sYInc >> 17;
+  int dypos = 0;
+  sampleRows_.assign(static_cast<std::size_t>(height), -1);
+  for (int y = 0; y < height; ++y) {
+    if (ypos >= height) {
+      break;
+    }
+    sampleRows_[static_cast<std::size_t>(y)] = ypos;
+    if (subPixelY) {
+      dypos += sYInc;
+      if (dypos >= kOne) {
+        const int advance = dypos >> 16;
+        ypos += advance;
+        dypos -= advance * kOne;
       }
-      std::uint32_t srcPixel = source[sampleRow + xpos];
-      for (int x = 0; x < width; ++x) {
-        const std::size_t index = static_cast<std::size_t>(y) * static_cast<std::size_t>(width) +
-                                  static_cast<std::size_t>(x);
-        const std::uint32_t basePixel = source[index];
-        std::uint32_t result;
-        if (blendAdditive_) {
-          result = blendAdditive(basePixel, srcPixel);
-        } else if (blendAverage_) {
-          result = blendAverage(basePixel, srcPixel);
-        } else {
-          result = srcPixel;
-        }
-        dst[index] = result;
-
-        if (subPixelX) {
-          dpos += sXInc;
-          if (dpos >= kOne) {
-            const int advance = dpos >> 16;
-            xpos += advance;
-            if (xpos >= width) {
-              break;
-            }
-            srcPixel = source[sampleRow + xpos];
-            dpos -= advance * kOne;
-          }
-        } else {
-          dpos += kOne;
-          if (dpos >= sXInc) {
-            const int advance = dpos >> 16;
-            xpos += advance;
-            if (xpos >= width) {
-              break;
-            }
-            srcPixel = source[sampleRow + xpos];
-            dpos -= sXInc;
-          }
-        }
+    } else {
+      dypos += kOne;
+      if (dypos >= sYInc) {
+        const int advance = dypos >> 16;
+        ypos += advance;
+        dypos -= sYInc;
       }
+    }
+  }
+  return maxThreads;
+}
 
-      if (subPixelY) {
-        dypos += sYInc;
-        if (dypos >= kOne) {
-          const int advance = dypos >> 16;
-          ypos += advance;
-          if (ypos >= height) {
+bool Mosaic::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
+  if (!enabled_ || !hasFramebuffer(context)) {
+    return true;
+  }
+
+  const int width = context.width;
+  const int height = context.height;
+  const int effectiveQuality = frameQuality_;
+  const auto* source = reinterpret_cast<const std::uint32_t*>(source_);
+  auto* dst = reinterpret_cast<std::uint32_t*>(context.framebuffer.data);
+
+  const int sXInc = (width * 65536) / effectiveQuality;
+  const bool subPixelX = sXInc < kOne;
+  const avs::core::RowBand band = avs::core::rowBand(height, threadId, maxThreads);
+
+  for (int y = band.begin; y < band.end; ++y) {
+    const int ypos = sampleRows_[static_cast<std::size_t>(y)];
+    if (ypos < 0) {
+      break;
+    }
+    const int sampleRow = ypos * width;
+    int dpos = 0;
+    int xpos = sXInc >> 17;
+    if (xpos >= width) {
+      xpos = width - 1;
+    }
+    std::uint32_t srcPixel = source[sampleRow + xpos];
+    for (int x = 0; x < width; ++x) {
+      const std::size_t index = static_cast<std::size_t>(y) * static_cast<std::size_t>(width) +
+                                static_cast<std::size_t>(x);
+      const std::uint32_t basePixel = source[index];
+      std::uint32_t result;
+      if (blendAdditive_) {
+        result = blendAdditive(basePixel, srcPixel);
+      } else if (blendAverage_) {
+        result = blendAverage(basePixel, srcPixel);
+      } else {
+        result = srcPixel;
+      }
+      dst[index] = result;
+
+      if (subPixelX) {
+        dpos += sXInc;
+        if (dpos >= kOne) {
+          const int advance = dpos >> 16;
+          xpos += advance;
+          if (xpos >= width) {
             break;
           }
-          dypos -= advance * kOne;
+          srcPixel = source[sampleRow + xpos];
+          dpos -= advance * kOne;
         }
       } else {
-        dypos += kOne;
-        if (dypos >= sYInc) {
-          const int advance = dypos >> 16;
-          ypos += advance;
-          if (ypos >= height) {
+        dpos += kOne;
+        if (dpos >= sXInc) {
+          const int advance = dpos >> 16;
+          xpos += advance;
+          if (xpos >= width) {
             break;
           }
-          dypos -= sYInc;
+          srcPixel = source[sampleRow + xpos];
+          dpos -= sXInc;
         }
       }
     }
   }
 
+  return true;
+}
+
+void Mosaic::advanceBeatDecay() {
   if (remainingBeatFrames_ > 0) {
     --remainingBeatFrames_;
     if (remainingBeatFrames_ > 0 && durationFrames_ > 0) {
@@ -210,8 +231,6 @@ bool Mosaic::render(avs::core::RenderContext& context) {
       }
     }
   }
-
-  return true;
 }
 
 }  // namespace avs::effects::trans
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include <charconv>
+#include <cstdint>
 #include <system_error>
 
 namespace avs::effects::trans {
@@ -74,15 +75,38 @@ std::vector<std::string> makeDelayKeys(std::size_t index) {
   };
 }
 
-std::optional<bool> parseBoolLike(const avs::core::ParamBlock& params, const std::string& key) {
+// Alias tables are interned once; setParams() then only compares key ids.
+const avs::core::ParamAliases& beatAliases(std::size_t index) {
+  static const std::vector<avs::core::ParamAliases> aliases = [] {
+    std::vector<avs::core::ParamAliases> table;
+    table.reserve(kBufferCount);
+    for (std::size_t i = 0; i < kBufferCount; ++i) {
+      table.emplace_back(makeBeatKeys(i));
+    }
+    return table;
+  }();
+  return aliases[index];
+}
+
+const avs::core::ParamAliases& delayAliases(std::size_t index) {
+  static const std::vector<avs::core::ParamAliases> aliases = [] {
+    std::vector<avs::core::ParamAliases> table;
+    table.reserve(kBufferCount);
+    for (std::size_t i = 0; i < kBufferCount; ++i) {
+      table.emplace_back(makeDelayKeys(i));
+    }
+    return table;
+  }();
+  return aliases[index];
+}
+
+std::optional<bool> parseBoolLike(const avs::core::ParamBlock& params, avs::core::ParamKey key) {
   if (!params.contains(key)) {
     return std::nullopt;
   }
 
-  const std::string sentinel = "__avs_multi_delay_sentinel__";
-  const std::string rawValue = params.getString(key, sentinel);
-  if (rawValue != sentinel) {
-    std::string trimmed = trimCopy(rawValue);
+  if (const std::string* rawValue = params.findString(key)) {
+    std::string trimmed = trimCopy(*rawValue);
     if (!trimmed.empty()) {
       std::string lowered = trimmed;
       std::transform(lowered.begin(), lowered.end(), lowered.begin(), [](unsigned char ch) {
@@ -121,15 +145,13 @@ std::optional<bool> parseBoolLike(const avs::core::ParamBlock& params, const std
   return params.getBool(key, false);
 }
 
-std::optional<int> parseIntLike(const avs::core::ParamBlock& params, const std::string& key) {
+std::optional<int> parseIntLike(const avs::core::ParamBlock& params, avs::core::ParamKey key) {
   if (!params.contains(key)) {
     return std::nullopt;
   }
 
-  const std::string sentinel = "__avs_multi_delay_sentinel__";
-  const std::string rawValue = params.getString(key, sentinel);
-  if (rawValue != sentinel) {
-    std::string trimmed = trimCopy(rawValue);
+  if (const std::string* rawValue = params.findString(key)) {
+    std::string trimmed = trimCopy(*rawValue);
     if (!trimmed.empty()) {
       int base = 10;
       const char* begin = trimmed.c_str();
@@ -189,29 +211,111 @@ class SharedState {
     return state;
   }
 
-  void addInstance() { ++instanceCount_; }
+  void addInstance(const MultiDelay* instance) { instances_.push_back(instance); }
 
-  void removeInstance() {
-    if (instanceCount_ == 0) {
+  void removeInstance(const MultiDelay* instance) {
+    const auto found = std::find(instances_.begin(), instances_.end(), instance);
+    if (found == instances_.end()) {
       return;
     }
-    --instanceCount_;
-    if (instanceCount_ == 0) {
+    instances_.erase(found);
+    if (instances_.empty()) {
       reset();
     }
   }
 
+  // The instance that checkpoints the shared buffers.
+  bool owns(const MultiDelay* instance) const {
+    return !instances_.empty() && instances_.front() == instance;
+  }
+
+  void save(avs::core::StateWriter& writer) const {
+    for (const BufferConfig& cfg : configs_) {
+      writer.writeBool(cfg.useBeat);
+      writer.writeVarInt(cfg.delayFrames);
+    }
+    for (const BufferRuntime& buffer : buffers_) {
+      writer.writeVarUint(buffer.frameStride);
+      writer.writeVarUint(buffer.frameCount);
+      writer.writeVarUint(buffer.readIndex);
+      writer.writeVarUint(buffer.writeIndex);
+      writer.writeBytes(buffer.storage.data(), buffer.storage.size());
+    }
+    writer.writeBool(haveFrame_);
+    writer.writeBool(configDirty_);
+    writer.writeVarUint(lastFrameIndex_);
+    writer.writeVarUint(lastFrameStride_);
+    writer.writeVarInt(lastWidth_);
+    writer.writeVarInt(lastHeight_);
+    writer.writeVarUint(framesSinceBeat_);
+    writer.writeVarUint(framesPerBeat_);
+  }
+
+  bool restore(avs::core::StateReader& reader) {
+    std::array<BufferConfig, kBufferCount> configs{};
+    for (BufferConfig& cfg : configs) {
+      cfg.useBeat = reader.readBool();
+      const std::int64_t delay = reader.readVarInt();
+      if (delay < 0 || delay > static_cast<std::int64_t>(kMaxHistoryFrames)) {
+        reader.fail();
+      }
+      cfg.delayFrames = static_cast<int>(delay);
+    }
+    std::array<BufferRuntime, kBufferCount> buffers{};
+    for (BufferRuntime& buffer : buffers) {
+      buffer.frameStride = reader.readSize(SIZE_MAX);
+      buffer.frameCount = reader.readSize(kMaxHistoryFrames + 1u);
+      buffer.readIndex = reader.readSize(SIZE_MAX);
+      buffer.writeIndex = reader.readSize(SIZE_MAX);
+      reader.readBytes(buffer.storage);
+      // Storage is either empty or holds every frame, and the indices stay inside it.
+      const bool sized = buffer.storage.empty() ||
+                         (buffer.frameStride > 0 && buffer.frameStride <= buffer.storage.size() &&
+                          buffer.storage.size() == buffer.frameStride * buffer.frameCount &&
+                          buffer.readIndex < buffer.frameCount &&
+                          buffer.writeIndex < buffer.frameCount);
+      if (!sized) {
+        reader.fail();
+      }
+    }
+    const bool haveFrame = reader.readBool();
+    const bool configDirty = reader.readBool();
+    const std::uint64_t lastFrameIndex = reader.readVarUint();
+    const std::size_t lastFrameStride = reader.readSize(SIZE_MAX);
+    const std::int64_t lastWidth = reader.readVarInt();
+    const std::int64_t lastHeight = reader.readVarInt();
+    const std::size_t framesSinceBeat = reader.readSize(kMaxHistoryFrames);
+    const std::size_t framesPerBeat = reader.readSize(kMaxHistoryFrames);
+    if (!reader.ok() || lastWidth < INT32_MIN || lastWidth > INT32_MAX || lastHeight < INT32_MIN ||
+        lastHeight > INT32_MAX) {
+      return false;
+    }
+    configs_ = configs;
+    buffers_ = std::move(buffers);
+    haveFrame_ = haveFrame;
+    configDirty_ = configDirty;
+    lastFrameIndex_ = lastFrameIndex;
+    lastFrameStride_ = lastFrameStride;
+    lastWidth_ = static_cast<int>(lastWidth);
+    lastHeight_ = static_cast<int>(lastHeight);
+    framesSinceBeat_ = framesSinceBeat;
+    framesPerBeat_ = framesPerBeat;
+    return true;
+  }
+
   void applyParams(const avs::core::ParamBlock& params) {
     bool dirty = false;
 
-    const auto globalBeat =
-        extractBool(params, {"usebeat", "usebeats", "use_beats", "beats", "UseBeat", "UseBeats"});
-    const auto globalDelay =
-        extractInt(params, {"delay", "delay_frames", "frames", "Delay", "DelayFrames"});
+    static const avs::core::ParamAliases kGlobalBeat{"usebeat", "usebeats", "use_beats",
+                                                    "beats",   "UseBeat",  "UseBeats"};
+    static const avs::core::ParamAliases kGlobalDelay{"delay", "delay_frames", "frames", "Delay",
+                                                      "DelayFrames"};
+    const auto globalBeat = extractBool(params, kGlobalBeat);
+    const auto globalDelay = extractInt(params, kGlobalDelay);
 
     for (std::size_t i = 0; i < kBufferCount; ++i) {
-      const auto beatValue = extractIndexedBool(params, i);
-      const auto delayValue = extractIndexedInt(params, i);
+      const auto beatValue = extractBool(params, beatAliases(i));
+      const auto delayValue = extractInt(params, delayAliases(i));
 
       bool targetBeat = configs_[i].useBeat;
       int targetDelay = configs_[i].delayFrames;
@@ -333,41 +437,17 @@ class SharedState {
   }
 
   static std::optional<bool> extractBool(const avs::core::ParamBlock& params,
-                                         const std::initializer_list<const char*>& keys) {
-    for (const char* key : keys) {
-      if (auto value = parseBoolLike(params, key)) {
-        return value;
-      }
+                                         const avs::core::ParamAliases& aliases) {
+    if (auto key = params.firstPresent(aliases)) {
+      return parseBoolLike(params, *key);
     }
     return std::nullopt;
   }
 
   static std::optional<int> extractInt(const avs::core::ParamBlock& params,
-                                       const std::initializer_list<const char*>& keys) {
-    for (const char* key : keys) {
-      if (auto value = parseIntLike(params, key)) {
-        return value;
-      }
-    }
-    return std::nullopt;
-  }
-
-  static std::optional<bool> extractIndexedBool(const avs::core::ParamBlock& params, std::size_t index) {
-    const auto candidates = makeBeatKeys(index);
-    for (const auto& key : candidates) {
-      if (auto value = parseBoolLike(params, key)) {
-        return value;
-      }
-    }
-    return std::nullopt;
-  }
-
-  static std::optional<int> extractIndexedInt(const avs::core::ParamBlock& params, std::size_t index) {
-    const auto candidates = makeDelayKeys(index);
-    for (const auto& key : candidates) {
-      if (auto value = parseIntLike(params, key)) {
-        return value;
-      }
+                                       const avs::core::ParamAliases& aliases) {
+    if (auto key = params.firstPresent(aliases)) {
+      return parseIntLike(params, *key);
     }
     return std::nullopt;
   }
@@ -489,7 +569,7 @@ class SharedState {
 
   std::array<BufferConfig, kBufferCount> configs_{};
   std::array<BufferRuntime, kBufferCount> buffers_{};
-  std::size_t instanceCount_ = 0;
+  std::vector<const MultiDelay*> instances_;  // In construction order.
   bool haveFrame_ = false;
   bool configDirty_ = false;
   std::uint64_t lastFrameIndex_ = std::numeric_limits<std::uint64_t>::max();
@@ -502,9 +582,9 @@ class SharedState {
 
 }  // namespace
 
-MultiDelay::MultiDelay() { SharedState::instance().addInstance(); }
+MultiDelay::MultiDelay() { SharedState::instance().addInstance(this); }
 
-MultiDelay::~MultiDelay() { SharedState::instance().removeInstance(); }
+MultiDelay::~MultiDelay() { SharedState::instance().removeInstance(this); }
 
 bool MultiDelay::render(avs::core::RenderContext& context) {
   SharedState& state = SharedState::instance();
@@ -529,38 +609,39 @@ bool MultiDelay::render(avs::core::RenderContext& context) {
   return true;
 }
 
+void MultiDelay::saveState(avs::core::StateWriter& writer) const {
+  const SharedState& state = SharedState::instance();
+  writer.writeBool(state.owns(this));
+  if (state.owns(this)) {
+    state.save(writer);
+  }
+}
+
+bool MultiDelay::restoreState(avs::core::StateReader& reader) {
+  if (!reader.readBool()) {
+    return reader.ok();
+  }
+  return SharedState::instance().restore(reader);
+}
+
 void MultiDelay::setParams(const avs::core::ParamBlock& params) {
   SharedState::instance().applyParams(params);
 
-  const std::array<std::string, 4> modeKeys = {"mode", "operation", "op", "action"};
-  for (const auto& key : modeKeys) {
-    if (!params.contains(key)) {
-      continue;
-    }
-    const std::string modeValue = params.getString(key, {});
-    if (!modeValue.empty()) {
-      if (setModeFromString(modeValue)) {
-        goto modeHandled;
-      }
+  static const avs::core::ParamAliases kModeKeys{"mode", "operation", "op", "action"};
+  if (auto key = params.firstPresent(kModeKeys)) {
+    const std::string* modeValue = params.findString(*key);
+    if (!modeValue || modeValue->empty() || !setModeFromString(*modeValue)) {
+      setMode(params.getInt(*key, static_cast<int>(mode_)));
     }
-    setMode(params.getInt(key, static_cast<int>(mode_)));
-    goto modeHandled;
   }
-modeHandled:
 
-  const std::array<std::string, 5> bufferKeys = {"buffer", "buffer_index", "slot", "activebuffer", "channel"};
-  for (const auto& key : bufferKeys) {
-    if (!params.contains(key)) {
-      continue;
-    }
-    const std::string bufferValue = params.getString(key, {});
-    if (!bufferValue.empty()) {
-      if (setActiveBufferFromString(bufferValue)) {
-        return;
-      }
+  static const avs::core::ParamAliases kBufferKeys{"buffer", "buffer_index", "slot", "activebuffer",
+                                                   "channel"};
+  if (auto key = params.firstPresent(kBufferKeys)) {
+    const std::string* bufferValue = params.findString(*key);
+    if (!bufferValue || bufferValue->empty() || !setActiveBufferFromString(*bufferValue)) {
+      setActiveBuffer(params.getInt(*key, activeBuffer_));
     }
-    setActiveBuffer(params.getInt(key, activeBuffer_));
-    return;
   }
 }
 
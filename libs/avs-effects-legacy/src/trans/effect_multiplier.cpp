@@ -5,6 +5,8 @@
 #include <cmath>
 #include <cstddef>
 
+#include <avs/core/RowBand.hpp>
+
 namespace avs::effects::trans {
 
 namespace {
@@ -83,31 +85,75 @@ void Multiplier::setParams(const avs::core::ParamBlock& params) {
   }
 }
 
-bool Multiplier::render(avs::core::RenderContext& context) {
+bool Multiplier::render(avs::core::RenderContext& context) { return smp_render(context, 0, 1); }
+
+bool Multiplier::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
   if (!hasFramebuffer(context)) {
     return true;
   }
 
-  std::uint8_t* const pixels = context.framebuffer.data;
   const std::size_t totalPixels =
       static_cast<std::size_t>(context.width) * static_cast<std::size_t>(context.height);
+  const auto span =
+      avs::core::rowBandPixels(totalPixels, context.width, context.height, threadId, maxThreads);
+  applyPixels(context.framebuffer.data, span.begin, span.end);
+  return true;
+}
 
+bool Multiplier::hasChannelLut(const avs::core::RenderContext& /* context */) const {
+  // Infinity and zero decide from all three channels at once.
+  return useCustomFactors_ || (mode_ != Mode::kInfinity && mode_ != Mode::kZero);
+}
+
+void Multiplier::buildChannelLut(avs::core::RenderContext& /* context */, avs::core::ChannelLut& lut) {
+  if (useCustomFactors_) {
+    lut.fill([this](int channel, std::uint8_t value) {
+      return scaleChannel(value, customFactors_[static_cast<std::size_t>(channel)]);
+    });
+    return;
+  }
+
+  switch (mode_) {
+    case Mode::kX8:
+    case Mode::kX4:
+    case Mode::kX2: {
+      const int factor = mode_ == Mode::kX8 ? 8 : (mode_ == Mode::kX4 ? 4 : 2);
+      lut.fill([factor](int /* channel */, std::uint8_t value) { return multiplyChannel(value, factor); });
+      break;
+    }
+    case Mode::kHalf:
+    case Mode::kQuarter:
+    case Mode::kEighth: {
+      const int shift = mode_ == Mode::kHalf ? 1 : (mode_ == Mode::kQuarter ? 2 : 3);
+      lut.fill([shift](int /* channel */, std::uint8_t value) {
+        return static_cast<std::uint8_t>(value >> shift);
+      });
+      break;
+    }
+    case Mode::kInfinity:
+    case Mode::kZero:
+      lut.setIdentity();
+      break;
+  }
+}
+
+void Multiplier::applyPixels(std::uint8_t* const pixels, std::size_t begin, std::size_t end) const {
   if (useCustomFactors_) {
     const float factorR = customFactors_[0];
     const float factorG = customFactors_[1];
     const float factorB = customFactors_[2];
-    for (std::size_t index = 0; index < totalPixels; ++index) {
+    for (std::size_t index = begin; index < end; ++index) {
       std::uint8_t* const px = pixels + index * kBytesPerPixel;
       px[0] = scaleChannel(px[0], factorR);
       px[1] = scaleChannel(px[1], factorG);
       px[2] = scaleChannel(px[2], factorB);
     }
-    return true;
+    return;
   }
 
   switch (mode_) {
     case Mode::kInfinity: {
-      for (std::size_t index = 0; index < totalPixels; ++index) {
+      for (std::size_t index = begin; index < end; ++index) {
         std::uint8_t* const px = pixels + index * kBytesPerPixel;
         const bool any = (px[0] | px[1] | px[2]) != 0;
         const std::uint8_t value =
@@ -119,7 +165,7 @@ bool Multiplier::render(avs::core::RenderContext& context) {
       break;
     }
     case Mode::kZero: {
-      for (std::size_t index = 0; index < totalPixels; ++index) {
+      for (std::size_t index = begin; index < end; ++index) {
         std::uint8_t* const px = pixels + index * kBytesPerPixel;
         if (px[0] == 255u && px[1] == 255u && px[2] == 255u) {
           continue;
@@ -134,7 +180,7 @@ bool Multiplier::render(avs::core::RenderContext& context) {
     case Mode::kX4:
     case Mode::kX2: {
       const int factor = mode_ == Mode::kX8 ? 8 : (mode_ == Mode::kX4 ? 4 : 2);
-      for (std::size_t index = 0; index < totalPixels; ++index) {
+      for (std::size_t index = begin; index < end; ++index) {
         std::uint8_t* const px = pixels + index * kBytesPerPixel;
         px[0] = multiplyChannel(px[0], factor);
         px[1] = multiplyChannel(px[1], factor);
@@ -146,7 +192,7 @@ bool Multiplier::render(avs::core::RenderContext& context) {
     case Mode::kQuarter:
     case Mode::kEighth: {
       const int shift = mode_ == Mode::kHalf ? 1 : (mode_ == Mode::kQuarter ? 2 : 3);
-      for (std::size_t index = 0; index < totalPixels; ++index) {
+      for (std::size_t index = begin; index < end; ++index) {
         std::uint8_t* const px = pixels + index * kBytesPerPixel;
         px[0] = static_cast<std::uint8_t>(px[0] >> shift);
         px[1] = static_cast<std::uint8_t>(px[1] >> shift);
@@ -155,8 +201,6 @@ bool Multiplier::render(avs::core::RenderContext& context) {
       break;
     }
   }
-
-  return true;
 }
 
 }  // namespace avs::effects::trans
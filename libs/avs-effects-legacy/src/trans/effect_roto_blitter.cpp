@@ -4,6 +4,7 @@
 #include <cmath>
 
 #include <avs/core/ParamBlock.hpp>
+#include <avs/core/RowBand.hpp>
 
 namespace {
 constexpr float kPi = 3.14159265358979323846f;
@@ -73,9 +74,6 @@ bool RotoBlitter::ensureHistory(const avs::core::RenderContext& context) {
     historyWidth_ = context.width;
     historyHeight_ = context.height;
   }
-  if (scratch_.size() != expected) {
-    scratch_.resize(expected);
-  }
   return true;
 }
 
@@ -237,8 +235,16 @@ void RotoBlitter::setParams(const avs::core::ParamBlock& params) {
 }
 
 bool RotoBlitter::render(avs::core::RenderContext& context) {
+  if (smp_begin(context, 1) > 0) {
+    smp_render(context, 0, 1);
+  }
+  return smp_finish(context);
+}
+
+int RotoBlitter::smp_begin(avs::core::RenderContext& context, int maxThreads) {
+  frameActive_ = false;
   if (!ensureHistory(context)) {
-    return true;
+    return 0;
   }
 
   if (context.audioBeat && beatReverse_) {
@@ -280,14 +286,28 @@ bool RotoBlitter::render(avs::core::RenderContext& context) {
 
   const float angleDegrees = (static_cast<float>(rotationRaw_) - 32.0f) * reversePos_;
   const float angleRadians = angleDegrees * (kPi / 180.0f);
-  const float cosTheta = std::cos(angleRadians) * zoom;
-  const float sinTheta = std::sin(angleRadians) * zoom;
+  frameCos_ = std::cos(angleRadians) * zoom;
+  frameSin_ = std::sin(angleRadians) * zoom;
+
+  frameAnchorX_ = anchorNorm_[0] * static_cast<float>(std::max(context.width - 1, 0));
+  frameAnchorY_ = anchorNorm_[1] * static_cast<float>(std::max(context.height - 1, 0));
+  frameActive_ = true;
+  return maxThreads;
+}
 
-  const float anchorX = anchorNorm_[0] * static_cast<float>(std::max(context.width - 1, 0));
-  const float anchorY = anchorNorm_[1] * static_cast<float>(std::max(context.height - 1, 0));
+bool RotoBlitter::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
+  if (!frameActive_) {
+    return true;
+  }
+  const float cosTheta = frameCos_;
+  const float sinTheta = frameSin_;
+  const float anchorX = frameAnchorX_;
+  const float anchorY = frameAnchorY_;
 
+  // Samples come from history_, so each band can blend its rows in place.
+  const avs::core::RowBand band = avs::core::rowBand(context.height, threadId, maxThreads);
   const std::size_t expected = static_cast<std::size_t>(context.width) * static_cast<std::size_t>(context.height) * 4u;
-  for (int y = 0; y < context.height; ++y) {
+  for (int y = band.begin; y < band.end; ++y) {
     for (int x = 0; x < context.width; ++x) {
       const float dx = static_cast<float>(x) - anchorX;
       const float dy = static_cast<float>(y) - anchorY;
@@ -300,9 +320,9 @@ bool RotoBlitter::render(avs::core::RenderContext& context) {
       if (offset + 3 >= expected) {
         continue;
       }
-      const std::uint8_t* input = context.framebuffer.data + offset;
-      std::uint8_t* out = scratch_.data() + offset;
+      std::uint8_t* out = context.framebuffer.data + offset;
       if (blend_) {
+        const std::uint8_t* input = out;
         out[0] = static_cast<std::uint8_t>((static_cast<int>(input[0]) + static_cast<int>(color[0])) / 2);
         out[1] = static_cast<std::uint8_t>((static_cast<int>(input[1]) + static_cast<int>(color[1])) / 2);
         out[2] = static_cast<std::uint8_t>((static_cast<int>(input[2]) + static_cast<int>(color[2])) / 2);
@@ -316,8 +336,14 @@ bool RotoBlitter::render(avs::core::RenderContext& context) {
     }
   }
 
-  std::copy(scratch_.begin(), scratch_.begin() + expected, context.framebuffer.data);
-  storeHistory(context);
+  return true;
+}
+
+bool RotoBlitter::smp_finish(avs::core::RenderContext& context) {
+  if (frameActive_) {
+    storeHistory(context);
+    frameActive_ = false;
+  }
   return true;
 }
 
@@ -5,6 +5,9 @@
 #include <cstdint>
 #include <cstring>
 
+#include <avs/core/FrameArena.hpp>
+#include <avs/core/RowBand.hpp>
+
 namespace avs::effects::trans {
 
 namespace {
@@ -12,6 +15,9 @@ constexpr int kFalloffRadius = 4;
 constexpr int kKernelSize = 8;
 constexpr int kOffsetTableSize = 512;
 constexpr int kOffsetMask = kOffsetTableSize - 1;
+// Offsets reach 3 rows and 3 columns; a column offset past the row edge wraps
+// into the next row, so bands need 4 rows of halo.
+constexpr int kHaloRows = kKernelSize / 2;
 }  // namespace
 
 bool Scatter::hasFramebuffer(const avs::core::RenderContext& context) {
@@ -44,12 +50,6 @@ std::uint32_t Scatter::lerpColor(std::uint32_t original,
   return blendChannel(0) | blendChannel(8) | blendChannel(16) | blendChannel(24);
 }
 
-void Scatter::ensureScratch(std::size_t bytes) {
-  if (scratch_.size() < bytes) {
-    scratch_.resize(bytes);
-  }
-}
-
 void Scatter::ensureOffsetTable(int width) {
   if (width <= 0) {
     offsets_.clear();
@@ -80,31 +80,49 @@ void Scatter::setParams(const avs::core::ParamBlock& params) {
   enabled_ = params.getBool("enabled", enabled_);
 }
 
+avs::core::AccessPattern Scatter::accessPattern() const {
+  return {avs::core::AccessPattern::Kind::Neighborhood, kHaloRows};
+}
+
 bool Scatter::render(avs::core::RenderContext& context) {
-  if (!enabled_ || !hasFramebuffer(context)) {
+  if (smp_begin(context, 1) <= 0) {
     return true;
   }
+  return smp_render(context, 0, 1);
+}
 
-  const int width = context.width;
-  const int height = context.height;
-  const int totalPixels = width * height;
-  if (totalPixels <= 0) {
-    return true;
+int Scatter::smp_begin(avs::core::RenderContext& context, int maxThreads) {
+  snapshot_ = nullptr;
+  if (!enabled_ || !hasFramebuffer(context)) {
+    return 0;
+  }
+  ensureOffsetTable(context.width);
+  if (offsets_.empty()) {
+    return 0;
   }
 
-  const std::size_t bytes = static_cast<std::size_t>(totalPixels) * 4u;
-  ensureScratch(bytes);
-  std::uint8_t* framebuffer = context.framebuffer.data;
-  std::memcpy(scratch_.data(), framebuffer, bytes);
-  const auto* source = reinterpret_cast<const std::uint32_t*>(scratch_.data());
-  auto* destination = reinterpret_cast<std::uint32_t*>(framebuffer);
+  const std::size_t bytes = static_cast<std::size_t>(context.width) *
+                            static_cast<std::size_t>(context.height) * 4u;
+  std::uint8_t* snapshot = avs::core::frameScratch(context.arena, scratch_, bytes);
+  std::memcpy(snapshot, context.framebuffer.data, bytes);
+  snapshot_ = snapshot;
+  stream_ = context.rng.stream();
+  return maxThreads;
+}
 
-  ensureOffsetTable(width);
-  if (offsets_.empty()) {
+bool Scatter::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
+  if (!snapshot_ || !hasFramebuffer(context)) {
     return true;
   }
 
-  for (int y = 0; y < height; ++y) {
+  const int width = context.width;
+  const int height = context.height;
+  const int totalPixels = width * height;
+  const auto* source = reinterpret_cast<const std::uint32_t*>(snapshot_);
+  auto* destination = reinterpret_cast<std::uint32_t*>(context.framebuffer.data);
+  const avs::core::RowBand band = avs::core::rowBand(height, threadId, maxThreads);
+
+  for (int y = band.begin; y < band.end; ++y) {
     const int distanceY = std::min(y, height - 1 - y);
     for (int x = 0; x < width; ++x) {
       const int index = y * width + x;
@@ -117,7 +135,7 @@ bool Scatter::render(avs::core::RenderContext& context) {
         continue;
       }
 
-      const std::uint32_t randomValue = context.rng.nextUint32();
+      const std::uint32_t randomValue = stream_.at(static_cast<std::uint64_t>(index));
       const int tableIndex = static_cast<int>(randomValue & kOffsetMask);
       const ScatterOffset& offset = offsets_[tableIndex];
       const int flatOffset = offset.dy * width + offset.dx;
@@ -6,6 +6,8 @@
 #include <cstdint>
 #include <initializer_list>
 
+#include <avs/core/RowBand.hpp>
+
 namespace {
 
 bool hasFramebuffer(const avs::core::RenderContext& context) {
@@ -75,22 +77,33 @@ void UniqueTone::setParams(const avs::core::ParamBlock& params) {
 }
 
 bool UniqueTone::render(avs::core::RenderContext& context) {
-  if (!enabled_ || !hasFramebuffer(context)) {
+  if (smp_begin(context, 1) <= 0) {
     return true;
   }
+  return smp_render(context, 0, 1);
+}
 
-  rebuildLookupTables();
+int UniqueTone::smp_begin(avs::core::RenderContext& context, int maxThreads) {
+  if (!enabled_ || !hasFramebuffer(context)) {
+    return 0;
+  }
 
-  std::uint8_t* pixels = context.framebuffer.data;
-  const std::size_t totalPixels = static_cast<std::size_t>(context.width) * static_cast<std::size_t>(context.height);
-  const std::size_t availablePixels = context.framebuffer.size / 4u;
-  const std::size_t pixelCount = std::min(totalPixels, availablePixels);
+  rebuildLookupTables();
+  return pixelCount(context) == 0 ? 0 : maxThreads;
+}
 
-  if (pixelCount == 0) {
+bool UniqueTone::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
+  if (!enabled_ || !hasFramebuffer(context)) {
     return true;
   }
+  const auto span = avs::core::rowBandPixels(pixelCount(context), context.width, context.height,
+                                             threadId, maxThreads);
+  applyPixels(context.framebuffer.data, span.begin, span.end);
+  return true;
+}
 
-  for (std::size_t i = 0; i < pixelCount; ++i) {
+void UniqueTone::applyPixels(std::uint8_t* pixels, std::size_t begin, std::size_t end) const {
+  for (std::size_t i = begin; i < end; ++i) {
     std::uint8_t* px = pixels + i * 4u;
     int depth = px[0];
     if (px[1] > depth) {
@@ -129,8 +142,6 @@ bool UniqueTone::render(avs::core::RenderContext& context) {
         break;
     }
   }
-
-  return true;
 }
 
 void UniqueTone::rebuildLookupTables() {
@@ -155,6 +166,13 @@ bool UniqueTone::hasFramebuffer(const avs::core::RenderContext& context) {
   return ::hasFramebuffer(context);
 }
 
+std::size_t UniqueTone::pixelCount(const avs::core::RenderContext& context) {
+  const std::size_t totalPixels =
+      static_cast<std::size_t>(context.width) * static_cast<std::size_t>(context.height);
+  const std::size_t availablePixels = context.framebuffer.size / 4u;
+  return std::min(totalPixels, availablePixels);
+}
+
 std::uint8_t UniqueTone::saturatingAdd(std::uint8_t base, std::uint8_t addend) {
   const int sum = static_cast<int>(base) + static_cast<int>(addend);
   return static_cast<std::uint8_t>(sum > 255 ? 255 : sum);
@@ -1,7 +1,11 @@
 #include <avs/effects/trans/effect_video_delay.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
+#include <utility>
+
+#include <avs/core/FrameArena.hpp>
 
 namespace avs::effects::trans {
 
@@ -60,6 +64,43 @@ void VideoDelay::setParams(const avs::core::ParamBlock& params) {
   }
 }
 
+void VideoDelay::saveState(avs::core::StateWriter& writer) const {
+  writer.writeVarInt(currentDelayFrames_);
+  writer.writeVarInt(framesSinceBeat_);
+  writer.writeVarUint(frameSize_);
+  writer.writeVarUint(bufferFrameCount_);
+  writer.writeVarUint(headIndex_);
+  writer.writeVarUint(filledFrameCount_);
+  writer.writeBytes(buffer_.data(), buffer_.size());
+}
+
+bool VideoDelay::restoreState(avs::core::StateReader& reader) {
+  const std::int64_t currentDelay = reader.readVarInt();
+  const std::int64_t sinceBeat = reader.readVarInt();
+  const std::uint64_t frameSize = reader.readVarUint();
+  const std::size_t frameCount = reader.readSize(kMaxHistoryFrames);
+  const std::uint64_t head = reader.readVarUint();
+  const std::uint64_t filled = reader.readVarUint();
+  std::vector<std::uint8_t> buffer;
+  reader.readBytes(buffer);
+  const bool sized = frameCount == 0 ? buffer.empty() && head == 0
+                                     : frameSize <= buffer.size() &&
+                                           buffer.size() == frameCount * frameSize &&
+                                           head < frameCount;
+  if (!reader.ok() || !sized || filled > frameCount || currentDelay < 0 ||
+      currentDelay > kMaxHistoryFrames || sinceBeat < 0 || sinceBeat > kMaxHistoryFrames) {
+    return false;
+  }
+  currentDelayFrames_ = static_cast<int>(currentDelay);
+  framesSinceBeat_ = static_cast<int>(sinceBeat);
+  frameSize_ = static_cast<std::size_t>(frameSize);
+  bufferFrameCount_ = frameCount;
+  headIndex_ = static_cast<std::size_t>(head);
+  filledFrameCount_ = static_cast<std::size_t>(filled);
+  buffer_ = std::move(buffer);
+  return true;
+}
+
 bool VideoDelay::render(avs::core::RenderContext& context) {
   const int requiredDelay = computeDelayFrames(context.audioBeat);
 
@@ -86,11 +127,11 @@ bool VideoDelay::render(avs::core::RenderContext& context) {
   }
 
   if (requiredDelay > 0) {
-    ensureScratch(frameSize);
+    std::uint8_t* scratch = avs::core::frameScratch(context.arena, scratch_, frameSize);
     std::uint8_t* slot = buffer_.data() + headIndex_ * frameSize;
-    std::memcpy(scratch_.data(), context.framebuffer.data, frameSize);
+    std::memcpy(scratch, context.framebuffer.data, frameSize);
     std::memcpy(context.framebuffer.data, slot, frameSize);
-    std::memcpy(slot, scratch_.data(), frameSize);
+    std::memcpy(slot, scratch, frameSize);
     if (filledFrameCount_ < bufferFrameCount_) {
       ++filledFrameCount_;
     }
@@ -149,12 +190,6 @@ void VideoDelay::ensureBuffer(std::size_t frameSize, int requiredFrames) {
   filledFrameCount_ = framesToCopy;
 }
 
-void VideoDelay::ensureScratch(std::size_t frameSize) {
-  if (scratch_.size() < frameSize) {
-    scratch_.resize(frameSize);
-  }
-}
-
 int VideoDelay::computeDelayFrames(bool beatDetected) {
   if (useBeats_) {
     if (beatDetected) {
@@ -2,6 +2,8 @@
 
 #include <cstring>
 
+#include <avs/core/FrameArena.hpp>
+
 namespace avs::effects::trans {
 
 namespace {
@@ -49,13 +51,10 @@ bool Water::render(avs::core::RenderContext& context) {
   if (lastFrame_.size() != requiredBytes) {
     lastFrame_.assign(requiredBytes, 0u);
   }
-  if (scratch_.size() < requiredBytes) {
-    scratch_.resize(requiredBytes);
-  }
 
   const std::uint8_t* src = context.framebuffer.data;
   const std::uint8_t* prev = lastFrame_.data();
-  std::uint8_t* dst = scratch_.data();
+  std::uint8_t* dst = avs::core::frameScratch(context.arena, scratch_, requiredBytes);
 
   const int widthInt = context.width;
   const int heightInt = context.height;
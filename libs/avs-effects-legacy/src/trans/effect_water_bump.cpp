@@ -9,6 +9,7 @@
 
 #include <avs/core/DeterministicRng.hpp>
 #include <avs/core/RenderContext.hpp>
+#include <avs/core/RowBand.hpp>
 
 namespace {
 
@@ -294,30 +295,26 @@ void WaterBump::applyHeightBlob(int x, int y, int radius, int heightDelta,
   }
 }
 
-void WaterBump::simulateWater() {
-  if (bufferWidth_ <= 0 || bufferHeight_ <= 0) {
+void WaterBump::simulateRows(int rowBegin, int rowEnd) {
+  const int width = bufferWidth_;
+  const int height = bufferHeight_;
+  if (width < 3 || height < 3) {
     return;
   }
 
   const int nextPage = 1 - currentPage_;
-  auto& current = heightBuffers_[currentPage_];
+  const auto& current = heightBuffers_[currentPage_];
   auto& next = heightBuffers_[nextPage];
   if (current.empty() || next.empty()) {
     return;
   }
 
-  const int width = bufferWidth_;
-  const int height = bufferHeight_;
-
-  if (width < 3 || height < 3) {
-    std::fill(next.begin(), next.end(), 0);
-    currentPage_ = nextPage;
-    return;
-  }
-
+  // Each interior row only reads the current page and updates its own row of
+  // the next page, so disjoint row ranges can run concurrently.
   const int dampingShift = clampInt(density_, 0, 10);
-
-  for (int y = 1; y < height - 1; ++y) {
+  const int firstRow = std::max(rowBegin, 1);
+  const int lastRow = std::min(rowEnd, height - 1);
+  for (int y = firstRow; y < lastRow; ++y) {
     const int rowOffset = y * width;
     for (int x = 1; x < width - 1; ++x) {
       const std::size_t index = static_cast<std::size_t>(rowOffset + x);
@@ -329,6 +326,27 @@ void WaterBump::simulateWater() {
       next[index] = newHeight - (newHeight >> dampingShift);
     }
   }
+}
+
+void WaterBump::finishSimulation() {
+  if (bufferWidth_ <= 0 || bufferHeight_ <= 0) {
+    return;
+  }
+
+  const int nextPage = 1 - currentPage_;
+  auto& next = heightBuffers_[nextPage];
+  if (heightBuffers_[currentPage_].empty() || next.empty()) {
+    return;
+  }
+
+  const int width = bufferWidth_;
+  const int height = bufferHeight_;
+
+  if (width < 3 || height < 3) {
+    std::fill(next.begin(), next.end(), 0);
+    currentPage_ = nextPage;
+    return;
+  }
 
   for (int x = 0; x < width; ++x) {
     next[static_cast<std::size_t>(x)] = 0;
@@ -344,37 +362,56 @@ void WaterBump::simulateWater() {
 }
 
 bool WaterBump::render(avs::core::RenderContext& context) {
+  if (smp_begin(context, 1) > 0) {
+    smp_render(context, 0, 1);
+  }
+  return smp_finish(context);
+}
+
+int WaterBump::smp_begin(avs::core::RenderContext& context, int maxThreads) {
+  frameActive_ = false;
   if (!enabled_) {
-    return true;
+    return 0;
   }
   if (context.width <= 0 || context.height <= 0) {
-    return true;
+    return 0;
   }
 
   const std::size_t width = static_cast<std::size_t>(context.width);
   const std::size_t height = static_cast<std::size_t>(context.height);
   const std::size_t requiredBytes = width * height * kChannels;
   if (!hasFramebuffer(context, requiredBytes)) {
-    return true;
+    return 0;
   }
 
   if (!ensureResources(context.width, context.height, requiredBytes)) {
-    return true;
+    return 0;
   }
 
   applyDrop(context);
 
-  const auto& heightMap = heightBuffers_[currentPage_];
-  if (heightMap.empty()) {
+  if (heightBuffers_[currentPage_].empty()) {
+    return 0;
+  }
+  frameActive_ = true;
+  return maxThreads;
+}
+
+bool WaterBump::smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) {
+  if (!frameActive_) {
     return true;
   }
 
+  // Bands displace into scratch_ while the framebuffer stays untouched until smp_finish().
+  const auto& heightMap = heightBuffers_[currentPage_];
+  const std::size_t width = static_cast<std::size_t>(context.width);
   std::uint8_t* dst = scratch_.data();
   const std::uint8_t* src = context.framebuffer.data;
   const int widthInt = context.width;
   const int heightInt = context.height;
+  const avs::core::RowBand band = avs::core::rowBand(heightInt, threadId, maxThreads);
 
-  for (int y = 0; y < heightInt; ++y) {
+  for (int y = band.begin; y < band.end; ++y) {
     for (int x = 0; x < widthInt; ++x) {
       const std::size_t index = static_cast<std::size_t>(y) * width + static_cast<std::size_t>(x);
       const std::size_t pixelOffset = index * kChannels;
@@ -402,10 +439,19 @@ bool WaterBump::render(avs::core::RenderContext& context) {
     }
   }
 
-  std::memcpy(context.framebuffer.data, dst, requiredBytes);
-
-  simulateWater();
+  simulateRows(band.begin, band.end);
+  return true;
+}
 
+bool WaterBump::smp_finish(avs::core::RenderContext& context) {
+  if (!frameActive_) {
+    return true;
+  }
+  frameActive_ = false;
+  const std::size_t requiredBytes =
+      static_cast<std::size_t>(context.width) * static_cast<std::size_t>(context.height) * kChannels;
+  std::memcpy(context.framebuffer.data, scratch_.data(), requiredBytes);
+  finishSimulation();
   return true;
 }
 
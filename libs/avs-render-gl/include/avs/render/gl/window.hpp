@@ -13,6 +13,8 @@ class Window {
 
   bool poll();
   std::pair<int, int> size() const;
+  // Draw an RGBA image stretched over the whole window with linear filtering;
+  // it may be smaller than the window, e.g. when rendering at reduced scale.
   void blit(const std::uint8_t* rgba, int width, int height);
   bool keyPressed(int key);
 
@@ -27,6 +27,9 @@ class OffscreenRenderer {
 
   void setAudioBuffer(std::vector<float> samples, unsigned sampleRate, unsigned channels);
 
+  // Row-band threads for the engine; output must not depend on this.
+  void setThreadCount(int threads);
+
   FrameView render();
 
   [[nodiscard]] std::uint64_t frameIndex() const { return frameIndex_; }
@@ -42,6 +45,7 @@ class OffscreenRenderer {
   int width_ = 0;
   int height_ = 0;
   double deltaSeconds_ = 1.0 / 60.0;
+  int threads_ = 1;
   std::unique_ptr<avs::Engine> engine_;
   std::unique_ptr<AudioTrack> audio_;
   std::filesystem::path presetPath_;
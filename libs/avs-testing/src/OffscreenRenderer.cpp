@@ -201,6 +201,7 @@ void OffscreenRenderer::loadPreset(const std::filesystem::path& presetPath) {
 
   presetPath_ = presetPath;
   engine_ = std::make_unique<avs::Engine>(width_, height_);
+  engine_->setThreadCount(threads_);
   engine_->setChain(std::move(parsed.chain));
   presetLoaded_ = true;
   frameIndex_ = 0;
@@ -220,6 +221,13 @@ void OffscreenRenderer::setAudioBuffer(std::vector<float> samples, unsigned samp
   }
 }
 
+void OffscreenRenderer::setThreadCount(int threads) {
+  threads_ = threads;
+  if (engine_) {
+    engine_->setThreadCount(threads_);
+  }
+}
+
 FrameView OffscreenRenderer::render() {
   if (!engine_) {
     engine_ = std::make_unique<avs::Engine>(width_, height_);
@@ -26,9 +26,15 @@
 #include <avs/effects.hpp>
 #include <avs/effects_render.hpp>
 #include <avs/engine.hpp>
+#include <avs/frame_interpolator.hpp>
 #include <avs/fs.hpp>
+#include <avs/idle_monitor.hpp>
+#include <avs/offscreen/Md5.hpp>
+#include <avs/offscreen/OffscreenRenderer.hpp>
 #include <avs/preset.hpp>
+#include <avs/preset_loader.hpp>
 #include <avs/registry.hpp>
+#include <avs/scale.hpp>
 
 #if __has_include(<portaudio.h>)
 #include <avs/audio_portaudio_internal.hpp>
@@ -303,6 +309,613 @@ TEST(AdditiveBlendEffect, AddsConstant) {
   EXPECT_EQ(checksum(out), 440u);
 }
 
+TEST(BilinearScaler, EqualSizeCopiesInput) {
+  Framebuffer in;
+  in.w = 5;
+  in.h = 3;
+  in.rgba.resize(5 * 3 * 4);
+  for (size_t i = 0; i < in.rgba.size(); ++i) {
+    in.rgba[i] = static_cast<std::uint8_t>(i * 37);
+  }
+  Framebuffer out;
+  BilinearScaler scaler;
+  scaler.scale(in, out, in.w, in.h);
+  EXPECT_EQ(out.w, in.w);
+  EXPECT_EQ(out.h, in.h);
+  EXPECT_EQ(out.rgba, in.rgba);
+}
+
+TEST(BilinearScaler, UpscaleInterpolatesBetweenCenters) {
+  Framebuffer in;
+  in.w = 2;
+  in.h = 1;
+  in.rgba = {0, 0, 0, 255, 200, 100, 40, 255};
+  Framebuffer out;
+  BilinearScaler scaler;
+  scaler.scale(in, out, 4, 2);
+  ASSERT_EQ(out.rgba.size(), 4u * 2u * 4u);
+  // Destination centers map to source x = 0 (clamped), 0.25, 0.75 and 1 (clamped).
+  const std::array<std::uint8_t, 4> expectedRed{0, 50, 150, 200};
+  for (int y = 0; y < 2; ++y) {
+    for (int x = 0; x < 4; ++x) {
+      const size_t index = static_cast<size_t>(y * 4 + x) * 4u;
+      EXPECT_EQ(out.rgba[index + 0], expectedRed[static_cast<size_t>(x)]);
+      EXPECT_EQ(out.rgba[index + 3], 255);
+    }
+  }
+  EXPECT_EQ(out.rgba[1 * 4 + 1], 25);
+  EXPECT_EQ(out.rgba[2 * 4 + 2], 30);
+}
+
+TEST(Engine, RenderScaleRunsChainAtReducedSize) {
+  Engine engine(64, 48);
+  engine.setRenderScale(0.5f);
+  std::vector<std::unique_ptr<Effect>> chain;
+  chain.push_back(std::make_unique<AdditiveBlendEffect>());
+  engine.setChain(std::move(chain));
+  engine.step(1.0f / 60.0f);
+  EXPECT_EQ(engine.frame().w, 32);
+  EXPECT_EQ(engine.frame().h, 24);
+  const Framebuffer& output = engine.outputFrame();
+  EXPECT_EQ(output.w, 64);
+  EXPECT_EQ(output.h, 48);
+  EXPECT_EQ(output.rgba.size(), 64u * 48u * 4u);
+
+  engine.setRenderScale(1.0f);
+  engine.step(1.0f / 60.0f);
+  EXPECT_EQ(engine.frame().w, 64);
+  EXPECT_EQ(&engine.outputFrame(), &engine.frame());
+
+  // Mid-crossfade the output is the scaled blend, not the incoming chain alone.
+  engine.setRenderScale(0.5f);
+  std::vector<std::unique_ptr<Effect>> outgoing;
+  outgoing.push_back(std::make_unique<avs::TunnelEffect>());
+  engine.setChain(std::move(outgoing));
+  engine.step(1.0f / 60.0f);
+  std::vector<std::unique_ptr<Effect>> incoming;
+  incoming.push_back(std::make_unique<AdditiveBlendEffect>());
+  incoming.back()->init(32, 24);
+  engine.beginTransition(std::move(incoming), 32, 24, avs::core::TransitionMode::kCrossDissolve,
+                         1.0f);
+  engine.step(0.25f);
+  ASSERT_TRUE(engine.inTransition());
+  Framebuffer expected;
+  BilinearScaler().scale(engine.frame(), expected, 64, 48);
+  EXPECT_EQ(engine.outputFrame().rgba, expected.rgba);
+}
+
+namespace {
+
+// Records the buffers it is handed and writes the frame number into red.
+class ProbeEffect : public Effect {
+ public:
+  ProbeEffect(bool inPlace, bool drawsOver) : inPlace_(inPlace), drawsOver_(drawsOver) {}
+
+  void update(float, int frame, const AudioState&, const MouseState&) override { frame_ = frame; }
+  bool processesInPlace() const override { return inPlace_; }
+  bool drawsOverInput() const override { return drawsOver_; }
+  void process(const Framebuffer& in, Framebuffer& out) override {
+    sameBuffer = &in == &out;
+    seeded = out.rgba == in.rgba;
+    out.w = in.w;
+    out.h = in.h;
+    out.rgba.resize(in.rgba.size());
+    out.rgba[0] = static_cast<std::uint8_t>(frame_);
+  }
+
+  bool sameBuffer = false;
+  bool seeded = false;
+
+ private:
+  bool inPlace_;
+  bool drawsOver_;
+  int frame_ = 0;
+};
+
+}  // namespace
+
+TEST(Engine, StepsInPlaceEffectsWithoutSwitchingBuffers) {
+  Engine engine(8, 4);
+  std::vector<std::unique_ptr<Effect>> chain;
+  chain.push_back(std::make_unique<ProbeEffect>(true, false));
+  chain.push_back(std::make_unique<ProbeEffect>(false, true));
+  chain.push_back(std::make_unique<ProbeEffect>(false, false));
+  auto* inPlace = static_cast<ProbeEffect*>(chain[0].get());
+  auto* drawsOver = static_cast<ProbeEffect*>(chain[1].get());
+  auto* overwrites = static_cast<ProbeEffect*>(chain[2].get());
+  engine.setChain(std::move(chain));
+
+  engine.step(1.0f / 60.0f);
+  EXPECT_TRUE(inPlace->sameBuffer);
+  EXPECT_FALSE(drawsOver->sameBuffer);
+  EXPECT_TRUE(drawsOver->seeded);
+  EXPECT_FALSE(overwrites->sameBuffer);
+  // The update hook reached every effect before it ran.
+  EXPECT_EQ(engine.frame().rgba[0], 1);
+  engine.step(1.0f / 60.0f);
+  EXPECT_EQ(engine.frame().rgba[0], 2);
+}
+
+TEST(Engine, RowBandsMatchSerialRendering) {
+  // A binary preset with the Movement variants real presets use: a blended
+  // radial warp, a plain gather and a source-mapped scatter, which stays serial.
+  const auto movementPreset = std::filesystem::temp_directory_path() / "row_bands_movement.avs";
+  {
+    std::string data = "Nullsoft AVS Preset 0.2\x1a";
+    data.push_back('\0');
+    auto putU32 = [&data](std::uint32_t value) {
+      for (int i = 0; i < 4; ++i) data.push_back(static_cast<char>((value >> (8 * i)) & 0xFFu));
+    };
+    auto putMovement = [&putU32](std::uint32_t effect, bool blend, bool sourcemapped) {
+      putU32(15);
+      putU32(6 * 4);
+      putU32(effect);
+      putU32(blend ? 1u : 0u);
+      putU32(sourcemapped ? 1u : 0u);
+      putU32(0);  // rectangular
+      putU32(1);  // subpixel
+      putU32(0);  // wrap
+    };
+    putMovement(3, true, false);
+    putMovement(2, false, false);
+    putMovement(5, false, true);
+    std::ofstream(movementPreset, std::ios::binary) << data;
+  }
+  auto makeChain = [&movementPreset] {
+    std::vector<std::unique_ptr<Effect>> chain;
+    chain.push_back(std::make_unique<avs::TunnelEffect>());
+    chain.push_back(std::make_unique<avs::GlowEffect>());
+    chain.push_back(std::make_unique<avs::MirrorEffect>());
+    chain.push_back(std::make_unique<avs::ColorMapEffect>());
+    chain.push_back(std::make_unique<avs::AdditiveBlendEffect>());
+    chain.push_back(std::make_unique<avs::ColorTransformEffect>());
+    chain.push_back(std::make_unique<avs::ZoomRotateEffect>());
+    chain.push_back(std::make_unique<avs::ConvolutionEffect>());
+    chain.push_back(std::make_unique<avs::RadialBlurEffect>());
+    auto parsed =
+        avs::parsePreset(std::filesystem::path(SOURCE_DIR) / "tests/data/color_mod_classic.avs");
+    for (auto& effect : parsed.chain) chain.push_back(std::move(effect));
+    auto movement = avs::parsePreset(movementPreset);
+    EXPECT_TRUE(movement.warnings.empty());
+    if (movement.chain.size() == 3u) {
+      EXPECT_TRUE(movement.chain[0]->bandSafe());
+      EXPECT_TRUE(movement.chain[1]->bandSafe());
+      EXPECT_FALSE(movement.chain[2]->bandSafe());
+    } else {
+      ADD_FAILURE() << "movement preset parsed to " << movement.chain.size() << " effects";
+    }
+    for (auto& effect : movement.chain) chain.push_back(std::move(effect));
+    return chain;
+  };
+  // An odd size leaves bands of uneven height.
+  Engine serial(37, 23);
+  Engine banded(37, 23);
+  banded.setThreadCount(4);
+  EXPECT_EQ(serial.threadCount(), 1);
+  EXPECT_EQ(banded.threadCount(), 4);
+  serial.setChain(makeChain());
+  banded.setChain(makeChain());
+  for (int i = 0; i < 3; ++i) {
+    serial.step(1.0f / 60.0f);
+    banded.step(1.0f / 60.0f);
+    ASSERT_EQ(banded.frame().rgba, serial.frame().rgba) << "frame " << i;
+  }
+  std::filesystem::remove(movementPreset);
+}
+
+TEST(Engine, RegressionPresetsHashIdenticallyAtAnyThreadCount) {
+  namespace fs = std::filesystem;
+  std::vector<fs::path> presets;
+  for (const char* dir : {"tests/data/phase1", "tests/regression/data"}) {
+    for (const auto& entry : fs::directory_iterator(fs::path(SOURCE_DIR) / dir)) {
+      if (entry.path().extension() == ".avs") presets.push_back(entry.path());
+    }
+  }
+  std::sort(presets.begin(), presets.end());
+  ASSERT_FALSE(presets.empty());
+
+  auto renderHashes = [](const fs::path& preset, int threads) {
+    avs::offscreen::OffscreenRenderer renderer(96, 64);
+    renderer.setThreadCount(threads);
+    renderer.loadPreset(preset);
+    std::vector<std::string> hashes;
+    for (int frame = 0; frame < 10; ++frame) {
+      const auto view = renderer.render();
+      hashes.push_back(avs::offscreen::computeMd5Hex(view.data, view.size));
+    }
+    return hashes;
+  };
+  for (const auto& preset : presets) {
+    SCOPED_TRACE(preset.filename().string());
+    const auto serial = renderHashes(preset, 1);
+    for (int threads : {2, 4, 8}) {
+      EXPECT_EQ(renderHashes(preset, threads), serial) << threads << " threads";
+    }
+  }
+}
+
+TEST(Engine, TransitionsRenderBothChainsAndComposite) {
+  auto outgoing = [] {
+    std::vector<std::unique_ptr<Effect>> chain;
+    chain.push_back(std::make_unique<avs::TunnelEffect>());
+    return chain;
+  };
+  auto incoming = [] {
+    std::vector<std::unique_ptr<Effect>> chain;
+    chain.push_back(std::make_unique<avs::TunnelEffect>());
+    chain.push_back(std::make_unique<avs::ColorTransformEffect>());
+    for (auto& e : chain) e->init(24, 16);
+    return chain;
+  };
+  Engine reference(24, 16);
+  reference.setChain(incoming());
+  reference.step(0.25f);
+
+  std::vector<std::vector<std::uint8_t>> serialFrames;
+  for (int threads : {1, 4}) {
+    Engine engine(24, 16);
+    engine.setThreadCount(threads);
+    engine.setChain(outgoing());
+    engine.step(0.25f);
+    const auto before = engine.frame().rgba;
+    engine.beginTransition(incoming(), 24, 16, avs::core::TransitionMode::kCrossDissolve, 1.0f);
+    EXPECT_TRUE(engine.inTransition());
+
+    std::vector<std::vector<std::uint8_t>> frames;
+    for (int i = 0; i < 4; ++i) {
+      engine.step(0.25f);
+      frames.emplace_back(engine.frame().rgba.begin(), engine.frame().rgba.end());
+    }
+    // Mid-way the frame is neither chain on its own.
+    EXPECT_NE(frames[1], std::vector<std::uint8_t>(before.begin(), before.end()));
+    EXPECT_NE(frames[1],
+              std::vector<std::uint8_t>(reference.frame().rgba.begin(),
+                                        reference.frame().rgba.end()));
+    EXPECT_FALSE(engine.inTransition());
+    EXPECT_EQ(engine.frame().rgba, reference.frame().rgba);
+    EXPECT_EQ(engine.takeRetiredChain().size(), 1u);
+    EXPECT_TRUE(engine.takeRetiredChain().empty());
+
+    if (threads == 1) {
+      serialFrames = frames;
+    } else {
+      EXPECT_EQ(frames, serialFrames);
+    }
+  }
+}
+
+// reg00 is shared by every script in the process, so chains that script
+// against it must render one after the other, in the same order as serially.
+TEST(Engine, TransitionsBetweenScriptedChainsMatchSerialRendering) {
+  auto outgoing = [] {
+    std::vector<std::unique_ptr<Effect>> chain;
+    chain.push_back(std::make_unique<avs::ScriptedEffect>(
+        "reg00 = 0;", "loop(20000, reg00 = reg00 + 0.0001);", "",
+        "red = red * 0.5 + reg00 * 0.1; green = reg00 * 0.2 - floor(reg00 * 0.2); blue = blue;",
+        avs::ScriptedEffect::Mode::kColorModifier, true));
+    return chain;
+  };
+  auto incoming = [] {
+    std::vector<std::unique_ptr<Effect>> chain;
+    chain.push_back(std::make_unique<avs::ScriptedEffect>(
+        "", "loop(20000, reg00 = reg00 * 0.9999 + 0.00002);", "",
+        "red = reg00 - floor(reg00); green = green * 0.5 + red * 0.5; blue = red * 0.5;",
+        avs::ScriptedEffect::Mode::kColorModifier, true));
+    for (auto& e : chain) e->init(20, 12);
+    return chain;
+  };
+
+  std::vector<std::vector<std::uint8_t>> serialFrames;
+  for (int threads : {1, 4}) {
+    Engine engine(20, 12);
+    engine.setThreadCount(threads);
+    engine.setChain(outgoing());
+    engine.step(0.1f);
+    engine.beginTransition(incoming(), 20, 12, avs::core::TransitionMode::kCrossDissolve, 1.0f);
+
+    std::vector<std::vector<std::uint8_t>> frames;
+    for (int i = 0; i < 6; ++i) {
+      engine.step(0.1f);
+      frames.emplace_back(engine.frame().rgba.begin(), engine.frame().rgba.end());
+    }
+    EXPECT_TRUE(engine.inTransition());
+    if (threads == 1) {
+      serialFrames = frames;
+    } else {
+      EXPECT_EQ(frames, serialFrames);
+    }
+  }
+}
+
+TEST(PresetLoader, BuildsChainsInTheBackground) {
+  const auto presetPath = std::filesystem::path(SOURCE_DIR) / "tests/data/color_mod_classic.avs";
+  avs::PresetLoader loader;
+  auto waitForChain = [&loader] {
+    std::optional<avs::LoadedChain> loaded;
+    for (int i = 0; i < 500 && !loaded; ++i) {
+      loaded = loader.takeReady();
+      if (!loaded) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return loaded;
+  };
+
+  loader.request(presetPath, 16, 12);
+  auto loaded = waitForChain();
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_FALSE(loader.busy());
+  EXPECT_TRUE(loaded->ok());
+  EXPECT_EQ(loaded->path, presetPath);
+  EXPECT_EQ(loaded->w, 16);
+  EXPECT_EQ(loaded->h, 12);
+
+  // A chain swapped in renders exactly like one installed with setChain().
+  Engine swapped(16, 12);
+  Engine direct(16, 12);
+  loader.retire(swapped.swapChain(std::move(loaded->effects), loaded->w, loaded->h));
+  direct.setChain(avs::parsePreset(presetPath).chain);
+  swapped.step(1.0f / 60.0f);
+  direct.step(1.0f / 60.0f);
+  EXPECT_EQ(swapped.frame().rgba, direct.frame().rgba);
+  EXPECT_FALSE(loader.takeReady().has_value());
+
+  loader.request("does-not-exist.avs", 16, 12);
+  auto missing = waitForChain();
+  ASSERT_TRUE(missing.has_value());
+  EXPECT_FALSE(missing->ok());
+}
+
+TEST(PresetLoader, WarmCacheFollowsFileContent) {
+  const auto tmp = std::filesystem::temp_directory_path() / "preset_loader_cache.avs";
+  {
+    std::ofstream(tmp) << "blur radius=2\n";
+  }
+  constexpr size_t kFrameBytes = 8 * 6 * 4;
+  avs::PresetLoader loader;
+  auto waitIdle = [&loader] {
+    for (int i = 0; i < 500 && loader.busy(); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  };
+
+  loader.prefetch(tmp, 8, 6);
+  waitIdle();
+  EXPECT_EQ(loader.cachedCount(), 1u);
+  EXPECT_EQ(loader.cachedBytes(), kFrameBytes);
+
+  loader.request(tmp, 8, 6);
+  waitIdle();
+  auto hit = loader.takeReady();
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit->effects.size(), 1u);
+  // The warm copy that was handed out is rebuilt behind it.
+  EXPECT_EQ(loader.cachedCount(), 1u);
+
+  // Editing the file invalidates the warm copy.
+  {
+    std::ofstream(tmp) << "blur radius=2\ncolormap\n";
+  }
+  loader.request(tmp, 8, 6);
+  waitIdle();
+  auto edited = loader.takeReady();
+  ASSERT_TRUE(edited.has_value());
+  EXPECT_EQ(edited->effects.size(), 2u);
+  EXPECT_EQ(loader.cachedCount(), 0u);
+
+  loader.prefetch(tmp, 8, 6);
+  waitIdle();
+  EXPECT_EQ(loader.cachedBytes(), 2 * kFrameBytes);
+  loader.setCacheBudget(kFrameBytes);
+  EXPECT_EQ(loader.cachedCount(), 0u);
+  EXPECT_EQ(loader.cachedBytes(), 0u);
+  std::filesystem::remove(tmp);
+}
+
+TEST(PresetLoader, PresetWithoutEffectsStillLoads) {
+  const auto tmp = std::filesystem::temp_directory_path() / "preset_loader_empty.avs";
+  {
+    std::ofstream(tmp) << "# nothing but a comment\n";
+  }
+  auto direct = avs::PresetLoader::build(tmp, 8, 6);
+  EXPECT_TRUE(direct.ok());
+  EXPECT_TRUE(direct.effects.empty());
+
+  avs::PresetLoader loader;
+  loader.prefetch(tmp, 8, 6);
+  for (int i = 0; i < 500 && loader.busy(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(loader.cachedCount(), 1u);
+  std::filesystem::remove(tmp);
+}
+
+namespace {
+
+std::uint8_t latticeValue(int x, int y, int channel) {
+  std::uint32_t v = static_cast<std::uint32_t>(x * 73856093) ^ static_cast<std::uint32_t>(y * 19349663) ^
+                    static_cast<std::uint32_t>(channel * 83492791);
+  v ^= v >> 13;
+  v *= 0x5bd1e995u;
+  v ^= v >> 15;
+  return static_cast<std::uint8_t>(v);
+}
+
+// Smooth value noise over the whole plane (8 px cells), sampled with the
+// frame moved by (dx, dy), so shifted frames have no edges to lock onto.
+Framebuffer shiftedNoise(int w, int h, int dx, int dy) {
+  constexpr int kCell = 8;
+  Framebuffer frame;
+  frame.w = w;
+  frame.h = h;
+  frame.rgba.resize(static_cast<size_t>(w) * h * 4);
+  for (int y = 0; y < h; ++y) {
+    for (int x = 0; x < w; ++x) {
+      const int sx = x - dx + 1000;
+      const int sy = y - dy + 1000;
+      const int cx = sx / kCell, cy = sy / kCell;
+      const int fx = sx % kCell, fy = sy % kCell;
+      std::uint8_t* px = frame.rgba.data() + (static_cast<size_t>(y) * w + x) * 4;
+      for (int c = 0; c < 3; ++c) {
+        const int top = latticeValue(cx, cy, c) * (kCell - fx) + latticeValue(cx + 1, cy, c) * fx;
+        const int bottom =
+            latticeValue(cx, cy + 1, c) * (kCell - fx) + latticeValue(cx + 1, cy + 1, c) * fx;
+        px[c] = static_cast<std::uint8_t>((top * (kCell - fy) + bottom * fy) / (kCell * kCell));
+      }
+      px[3] = 255;
+    }
+  }
+  return frame;
+}
+
+}  // namespace
+
+TEST(FrameInterpolator, FindsTranslationAndSynthesizesTheMidpoint) {
+  const Framebuffer older = shiftedNoise(96, 64, 0, 0);
+  const Framebuffer newer = shiftedNoise(96, 64, 6, -4);
+  FrameInterpolator::Config config;
+  const MotionField field = FrameInterpolator::estimateMotion(older, newer, config);
+  ASSERT_EQ(field.cols, 6);
+  ASSERT_EQ(field.rows, 4);
+  for (int row = 1; row < field.rows - 1; ++row) {
+    for (int col = 1; col < field.cols - 1; ++col) {
+      EXPECT_EQ(field.at(col, row).dx, 6) << col << "," << row;
+      EXPECT_EQ(field.at(col, row).dy, -4) << col << "," << row;
+      EXPECT_TRUE(field.at(col, row).reliable);
+    }
+  }
+
+  Framebuffer mid;
+  FrameInterpolator::synthesize(older, newer, field, 0.5f, mid);
+  const Framebuffer expected = shiftedNoise(96, 64, 3, -2);
+  for (int y = 16; y < 48; ++y) {
+    for (int x = 16; x < 80; ++x) {
+      const size_t i = (static_cast<size_t>(y) * 96 + x) * 4;
+      ASSERT_EQ(mid.rgba[i], expected.rgba[i]) << x << "," << y;
+    }
+  }
+
+  // Unrelated frames fall back to a cross-fade.
+  const Framebuffer other = shiftedNoise(96, 64, 1000, 1000);
+  const MotionField cut = FrameInterpolator::estimateMotion(older, other, config);
+  EXPECT_FALSE(cut.at(2, 2).reliable);
+  FrameInterpolator::synthesize(older, other, cut, 0.5f, mid);
+  const size_t i = (static_cast<size_t>(40) * 96 + 40) * 4;
+  EXPECT_EQ(mid.rgba[i], (older.rgba[i] * 128 + other.rgba[i] * 128 + 128) >> 8);
+}
+
+TEST(FrameInterpolator, PresentsOneRenderIntervalBehind) {
+  FrameInterpolator interpolator;
+  Framebuffer out;
+  const Framebuffer first = shiftedNoise(32, 32, 0, 0);
+  const Framebuffer second = shiftedNoise(32, 32, 2, 0);
+  interpolator.submit(first, 1.0);
+  interpolator.flush();
+  EXPECT_FALSE(interpolator.present(1.0, out));
+
+  interpolator.submit(second, 1.5);
+  interpolator.flush();
+  ASSERT_TRUE(interpolator.present(1.5, out));
+  EXPECT_EQ(out.rgba, first.rgba);
+  ASSERT_TRUE(interpolator.present(2.0, out));
+  EXPECT_EQ(out.rgba, second.rgba);
+  ASSERT_TRUE(interpolator.present(1.75, out));
+  EXPECT_NE(out.rgba, first.rgba);
+  EXPECT_NE(out.rgba, second.rgba);
+
+  // A new size starts over instead of blending across the resize.
+  interpolator.submit(shiftedNoise(16, 16, 0, 0), 2.0);
+  interpolator.flush();
+  EXPECT_FALSE(interpolator.present(2.0, out));
+
+  interpolator.submit(shiftedNoise(16, 16, 1, 0), 2.5);
+  interpolator.flush();
+  EXPECT_TRUE(interpolator.present(2.5, out));
+  interpolator.reset();
+  EXPECT_FALSE(interpolator.present(2.5, out));
+}
+
+TEST(IdleMonitor, IdlesOnSteadySilentFramesAndWakesOnActivity) {
+  IdleMonitor::Config config;
+  config.settleFrames = 3;
+  config.idleIntervalSeconds = 0.5;
+  IdleMonitor monitor(config);
+  Framebuffer frame;
+  frame.w = 3;
+  frame.h = 2;
+  frame.rgba.assign(3 * 2 * 4, 40);
+
+  auto observe = [&](float rms) {
+    monitor.observeAudio(rms);
+    monitor.observeFrame(frame);
+  };
+  for (int i = 0; i < 3; ++i) {
+    observe(0.0f);
+    EXPECT_FALSE(monitor.idle());
+  }
+  observe(0.0f);
+  EXPECT_TRUE(monitor.idle());
+  EXPECT_FALSE(monitor.shouldRender(0.1));
+  EXPECT_TRUE(monitor.shouldRender(0.5));
+
+  // Audio resumes full rate before the next frame is rendered.
+  monitor.observeAudio(0.2f);
+  EXPECT_FALSE(monitor.idle());
+  EXPECT_TRUE(monitor.shouldRender(0.0));
+  for (int i = 0; i < 4; ++i) observe(0.0f);
+  EXPECT_TRUE(monitor.idle());
+
+  // So does a frame that changed, however small the change.
+  frame.rgba[5] ^= 1;
+  observe(0.0f);
+  EXPECT_FALSE(monitor.idle());
+  for (int i = 0; i < 3; ++i) observe(0.0f);
+  EXPECT_TRUE(monitor.idle());
+
+  monitor.wake();
+  EXPECT_FALSE(monitor.idle());
+  for (int i = 0; i < 3; ++i) observe(0.0f);
+  EXPECT_FALSE(monitor.idle());
+  observe(0.0f);
+  EXPECT_TRUE(monitor.idle());
+}
+
+TEST(IdleMonitor, LoudSteadyFramesNeverIdle) {
+  IdleMonitor::Config config;
+  config.settleFrames = 2;
+  IdleMonitor monitor(config);
+  Framebuffer frame;
+  frame.w = 2;
+  frame.h = 2;
+  frame.rgba.assign(16, 0);
+  for (int i = 0; i < 10; ++i) {
+    monitor.observeAudio(0.5f);
+    monitor.observeFrame(frame);
+  }
+  EXPECT_FALSE(monitor.idle());
+
+  config.settleFrames = 0;
+  IdleMonitor disabled(config);
+  for (int i = 0; i < 10; ++i) {
+    disabled.observeAudio(0.0f);
+    disabled.observeFrame(frame);
+  }
+  EXPECT_FALSE(disabled.idle());
+}
+
+TEST(IdleMonitor, HashCoversSizeAndTail) {
+  Framebuffer a;
+  a.w = 3;
+  a.h = 1;
+  a.rgba.assign(12, 7);
+  Framebuffer b = a;
+  EXPECT_EQ(IdleMonitor::hashFrame(a), IdleMonitor::hashFrame(b));
+  b.rgba[11] = 8;
+  EXPECT_NE(IdleMonitor::hashFrame(a), IdleMonitor::hashFrame(b));
+  b = a;
+  b.w = 1;
+  b.h = 3;
+  EXPECT_NE(IdleMonitor::hashFrame(a), IdleMonitor::hashFrame(b));
+}
+
 TEST(PresetParser, ParsesChainAndReportsUnsupported) {
   auto tmp = std::filesystem::temp_directory_path() / "test.avs";
   {
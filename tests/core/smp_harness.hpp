@@ -0,0 +1,98 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <avs/core/EffectRegistry.hpp>
+#include <avs/core/ParamBlock.hpp>
+#include <avs/core/Pipeline.hpp>
+#include <avs/core/RenderContext.hpp>
+
+namespace smp_test {
+
+// One effect configuration rendered alone through a Pipeline.
+struct Case {
+  std::string name;
+  avs::core::EffectRegistry::Factory factory;
+  avs::core::ParamBlock params;
+};
+
+// The configurations one test file checks, in the order they are rendered.
+class CaseList {
+ public:
+  void add(std::string name, avs::core::EffectRegistry::Factory factory,
+           avs::core::ParamBlock params = {}) {
+    cases_.push_back(Case{std::move(name), std::move(factory), std::move(params)});
+  }
+  const std::vector<Case>& cases() const { return cases_; }
+
+ private:
+  std::vector<Case> cases_;
+};
+
+// Frame size, input and beat pattern the cases of one test file are rendered with.
+struct Scene {
+  int width = 0;
+  int height = 0;
+  int frames = 0;
+  std::uint64_t seed = 0;
+  // Writes the input pixels for a frame: before the first frame only, or before
+  // every frame when refillEachFrame is set.
+  std::function<void(std::vector<std::uint8_t>&, int)> fill;
+  bool refillEachFrame = false;
+  std::function<bool(int)> beat;
+  double deltaSeconds = 0.0;
+};
+
+inline std::vector<std::vector<std::uint8_t>> renderFrames(const Case& testCase, const Scene& scene,
+                                                           int threads) {
+  avs::core::EffectRegistry registry;
+  registry.registerFactory(testCase.name, testCase.factory);
+  avs::core::Pipeline pipeline(registry, threads);
+  pipeline.setAutoThreading(false);
+  pipeline.add(testCase.name, testCase.params);
+
+  std::vector<std::uint8_t> pixels(static_cast<std::size_t>(scene.width) * scene.height * 4u);
+  avs::core::RenderContext context{};
+  context.width = scene.width;
+  context.height = scene.height;
+  context.deltaSeconds = scene.deltaSeconds;
+  context.framebuffer = {pixels.data(), pixels.size()};
+  context.rng = avs::core::DeterministicRng(scene.seed);
+
+  std::vector<std::vector<std::uint8_t>> frames;
+  for (int frame = 0; frame < scene.frames; ++frame) {
+    if (frame == 0 || scene.refillEachFrame) {
+      scene.fill(pixels, frame);
+    }
+    context.frameIndex = static_cast<std::uint64_t>(frame);
+    context.audioBeat = scene.beat(frame);
+    EXPECT_TRUE(pipeline.render(context));
+    frames.push_back(pixels);
+  }
+  return frames;
+}
+
+// Every case must render the same frames on 2, 3 and 8 threads as on one.
+inline void expectThreadedMatchesSingleThreaded(const CaseList& cases, const Scene& scene) {
+  for (const auto& testCase : cases.cases()) {
+    SCOPED_TRACE(testCase.name);
+    const auto reference = renderFrames(testCase, scene, 1);
+    for (int threads : {2, 3, 8}) {
+      SCOPED_TRACE(threads);
+      const auto threaded = renderFrames(testCase, scene, threads);
+      ASSERT_EQ(reference.size(), threaded.size());
+      for (std::size_t frame = 0; frame < reference.size(); ++frame) {
+        EXPECT_EQ(reference[frame], threaded[frame]) << "frame " << frame;
+      }
+    }
+  }
+}
+
+}  // namespace smp_test
@@ -0,0 +1,339 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <avs/core/EffectRegistry.hpp>
+#include <avs/core/IEffect.hpp>
+#include <avs/core/Mt19937.hpp>
+#include <avs/core/ParamBlock.hpp>
+#include <avs/core/Pipeline.hpp>
+#include <avs/core/RenderContext.hpp>
+#include <avs/core/StateStream.hpp>
+#include <avs/effects/prime/RegisterEffects.hpp>
+#include <avs/runtime/GlobalState.hpp>
+
+namespace {
+
+using avs::core::ParamBlock;
+
+constexpr int kWidth = 40;
+constexpr int kHeight = 24;
+constexpr int kFrames = 12;
+constexpr int kCheckpointFrame = 5;
+
+std::vector<std::pair<std::string, ParamBlock>> makeChain() {
+  std::vector<std::pair<std::string, ParamBlock>> chain;
+
+  ParamBlock store;
+  store.setString("mode", "store");
+  store.setInt("buffer", 0);
+  store.setInt("delay0", 2);
+  chain.emplace_back("holden05: multi delay", store);
+
+  ParamBlock videoDelay;
+  videoDelay.setInt("delay", 3);
+  chain.emplace_back("holden04: video delay", videoDelay);
+
+  // Variables, megabuf in two RAM blocks, and an init stage that must not rerun.
+  ParamBlock scripted;
+  scripted.setString("init", "acc = 0; far = 100000; far[0] = 3;");
+  scripted.setString("frame",
+                     "acc = acc + 1; (frame % 7)[0] = acc; far[0] = far[0] * 1.01 + 3[0];");
+  scripted.setString("pixel", "red = red * 0.5 + (acc % 7) / 14; green = far[0] % 1;");
+  chain.emplace_back("scripted", scripted);
+
+  ParamBlock fetch;
+  fetch.setString("mode", "fetch");
+  fetch.setInt("buffer", 0);
+  chain.emplace_back("holden05: multi delay", fetch);
+
+  ParamBlock movement;
+  movement.setFloat("scale", 1.1f);
+  movement.setFloat("rotate", 9.0f);
+  chain.emplace_back("movement", movement);
+
+  ParamBlock globals;
+  globals.setString("init", "g2 = 5;");
+  globals.setString("frame", "g1 = g1 + g2; g2 = g2 * 0.5 + 1;");
+  chain.emplace_back("globals", globals);
+
+  ParamBlock affine;
+  affine.setBool("onbeat", true);
+  affine.setInt("hold", 3);
+  affine.setFloat("random_angle", 30.0f);
+  chain.emplace_back("transform_affine", affine);
+
+  chain.emplace_back("misc / custom bpm", ParamBlock{});
+  return chain;
+}
+
+void fillInput(std::vector<std::uint8_t>& pixels, int frame) {
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      const std::size_t index = (static_cast<std::size_t>(y) * kWidth + static_cast<std::size_t>(x)) * 4u;
+      pixels[index + 0] = static_cast<std::uint8_t>((x * 11 + frame * 29) & 0xFF);
+      pixels[index + 1] = static_cast<std::uint8_t>((y * 7 + x * frame) & 0xFF);
+      pixels[index + 2] = static_cast<std::uint8_t>(((x ^ y) * 5 + frame * 3) & 0xFF);
+      pixels[index + 3] = 255u;
+    }
+  }
+}
+
+// A render job that can stop at any frame and report where it got to.
+class Show {
+ public:
+  Show() : pipeline_(registry_) {
+    avs::effects::registerCoreEffects(registry_);
+    for (auto& [key, params] : makeChain()) {
+      pipeline_.add(key, params);
+    }
+    pixels_.resize(static_cast<std::size_t>(kWidth) * kHeight * 4u);
+  }
+
+  std::vector<std::uint8_t> render(int frame) {
+    fillInput(pixels_, frame);
+    avs::core::RenderContext context{};
+    context.width = kWidth;
+    context.height = kHeight;
+    context.frameIndex = static_cast<std::uint64_t>(frame);
+    context.deltaSeconds = 1.0 / 60.0;
+    context.audioBeat = frame % 3 == 0;
+    context.framebuffer = {pixels_.data(), pixels_.size()};
+    context.globals = &globals_;
+    pipeline_.render(context);
+    return pixels_;
+  }
+
+  std::vector<std::uint8_t> checkpoint() const {
+    avs::core::StateWriter writer;
+    globals_.save(writer);
+    const std::vector<std::uint8_t> effects = pipeline_.saveState();
+    writer.writeBytes(effects.data(), effects.size());
+    return writer.take();
+  }
+
+  bool restore(const std::vector<std::uint8_t>& checkpoint) {
+    avs::core::StateReader reader(checkpoint);
+    std::vector<std::uint8_t> effects;
+    return globals_.restore(reader) && reader.readBytes(effects) && reader.atEnd() &&
+           pipeline_.restoreState(effects);
+  }
+
+  avs::core::Pipeline& pipeline() { return pipeline_; }
+
+ private:
+  avs::core::EffectRegistry registry_;
+  avs::core::Pipeline pipeline_;
+  avs::runtime::GlobalState globals_;
+  std::vector<std::uint8_t> pixels_;
+};
+
+class CountingEffect : public avs::core::IEffect {
+ public:
+  bool render(avs::core::RenderContext&) override {
+    ++frames_;
+    return true;
+  }
+  void setParams(const ParamBlock&) override {}
+  void saveState(avs::core::StateWriter& writer) const override { writer.writeVarUint(frames_); }
+  bool restoreState(avs::core::StateReader& reader) override {
+    frames_ = reader.readVarUint();
+    return true;
+  }
+
+ private:
+  std::uint64_t frames_ = 0;
+};
+
+class RejectingEffect : public avs::core::IEffect {
+ public:
+  bool render(avs::core::RenderContext&) override { return true; }
+  void setParams(const ParamBlock&) override {}
+  bool restoreState(avs::core::StateReader&) override { return false; }
+};
+
+}  // namespace
+
+TEST(StateStreamTest, RoundTripsValuesAndFailsOnTruncation) {
+  avs::core::StateWriter writer;
+  writer.writeVarUint(0);
+  writer.writeVarUint(300);
+  writer.writeVarUint(UINT64_MAX);
+  writer.writeVarInt(-1);
+  writer.writeVarInt(INT64_MIN);
+  writer.writeF32(-2.5f);
+  writer.writeF64(1.0 / 3.0);
+  writer.writeBool(true);
+  writer.writeString("movement");
+  writer.writeBytes(nullptr, 0);
+  // Small values stay small.
+  EXPECT_EQ(writer.data().size(), 1u + 2u + 10u + 1u + 10u + 4u + 8u + 1u + 9u + 1u);
+
+  avs::core::StateReader reader(writer.data());
+  EXPECT_EQ(reader.readVarUint(), 0u);
+  EXPECT_EQ(reader.readVarUint(), 300u);
+  EXPECT_EQ(reader.readVarUint(), UINT64_MAX);
+  EXPECT_EQ(reader.readVarInt(), -1);
+  EXPECT_EQ(reader.readVarInt(), INT64_MIN);
+  EXPECT_EQ(reader.readF32(), -2.5f);
+  EXPECT_EQ(reader.readF64(), 1.0 / 3.0);
+  EXPECT_TRUE(reader.readBool());
+  EXPECT_EQ(reader.readString(), "movement");
+  std::vector<std::uint8_t> empty{1, 2};
+  EXPECT_TRUE(reader.readBytes(empty));
+  EXPECT_TRUE(empty.empty());
+  EXPECT_TRUE(reader.ok());
+  EXPECT_TRUE(reader.atEnd());
+
+  // Cut inside the third value: the reader fails there and stays failed.
+  std::vector<std::uint8_t> truncated(writer.data().begin(), writer.data().begin() + 5);
+  avs::core::StateReader shortReader(truncated);
+  EXPECT_EQ(shortReader.readVarUint(), 0u);
+  EXPECT_EQ(shortReader.readSize(1000), 300u);
+  EXPECT_TRUE(shortReader.ok());
+  EXPECT_EQ(shortReader.readVarUint(), 0u);
+  EXPECT_FALSE(shortReader.ok());
+  EXPECT_EQ(shortReader.readF64(), 0.0);
+}
+
+TEST(Mt19937Test, MatchesTheStandardEngineAndRoundTrips) {
+  for (std::uint32_t seed : {0u, 1u, 5489u, 0xDEADBEEFu}) {
+    SCOPED_TRACE(seed);
+    std::mt19937 reference(seed);
+    avs::core::Mt19937 rng(seed);
+    // Past the first twist, so the checkpoint lands mid-block.
+    for (int i = 0; i < 1000; ++i) {
+      ASSERT_EQ(rng(), reference());
+    }
+
+    avs::core::StateWriter writer;
+    rng.saveState(writer);
+    avs::core::Mt19937 restored;
+    avs::core::StateReader reader(writer.data());
+    ASSERT_TRUE(restored.restoreState(reader));
+    EXPECT_TRUE(reader.atEnd());
+    for (int i = 0; i < 1000; ++i) {
+      ASSERT_EQ(restored(), reference());
+    }
+  }
+
+  // A word past 32 bits is rejected and leaves the generator as it was.
+  avs::core::StateWriter corrupt;
+  corrupt.writeVarUint(UINT64_MAX);
+  avs::core::Mt19937 rng;
+  avs::core::StateReader reader(corrupt.data());
+  EXPECT_FALSE(rng.restoreState(reader));
+  EXPECT_EQ(rng(), std::mt19937()());
+}
+
+TEST(CheckpointTest, ResumedShowMatchesUninterruptedOne) {
+  std::vector<std::uint8_t> checkpoint;
+  std::vector<std::vector<std::uint8_t>> expected;
+  std::vector<std::uint8_t> expectedFinal;
+  {
+    Show original;
+    for (int frame = 0; frame < kFrames; ++frame) {
+      if (frame == kCheckpointFrame) {
+        checkpoint = original.checkpoint();
+      }
+      const std::vector<std::uint8_t> output = original.render(frame);
+      if (frame >= kCheckpointFrame) {
+        expected.push_back(output);
+      }
+    }
+    expectedFinal = original.checkpoint();
+  }
+
+  // The original is gone, as after a crash; Multi Delay's shared buffers with it.
+  Show resumed;
+  ASSERT_TRUE(resumed.restore(checkpoint));
+  for (int frame = kCheckpointFrame; frame < kFrames; ++frame) {
+    EXPECT_EQ(resumed.render(frame), expected[static_cast<std::size_t>(frame - kCheckpointFrame)])
+        << "frame " << frame;
+  }
+  EXPECT_EQ(resumed.checkpoint(), expectedFinal);
+}
+
+TEST(CheckpointTest, RestoringTheSameCheckpointTwiceSeeksBack) {
+  Show show;
+  for (int frame = 0; frame < kCheckpointFrame; ++frame) {
+    show.render(frame);
+  }
+  const std::vector<std::uint8_t> checkpoint = show.checkpoint();
+  const std::vector<std::uint8_t> first = show.render(kCheckpointFrame);
+  show.render(kCheckpointFrame + 1);
+
+  ASSERT_TRUE(show.restore(checkpoint));
+  EXPECT_EQ(show.render(kCheckpointFrame), first);
+}
+
+TEST(CheckpointTest, RejectedCheckpointLeavesEffectsUntouched) {
+  Show show;
+  for (int frame = 0; frame < 3; ++frame) {
+    show.render(frame);
+  }
+  const std::vector<std::uint8_t> before = show.pipeline().saveState();
+
+  avs::core::EffectRegistry registry;
+  avs::effects::registerCoreEffects(registry);
+  avs::core::Pipeline other(registry);
+  other.add("movement", ParamBlock{});
+  EXPECT_FALSE(show.pipeline().restoreState(other.saveState()));
+
+  std::vector<std::uint8_t> truncated = before;
+  truncated.pop_back();
+  EXPECT_FALSE(show.pipeline().restoreState(truncated));
+  EXPECT_EQ(show.pipeline().saveState(), before);
+}
+
+TEST(CheckpointTest, EffectRejectingItsStateRollsBackTheOthers) {
+  avs::core::EffectRegistry registry;
+  registry.registerFactory("counter", [] { return std::make_unique<CountingEffect>(); });
+  registry.registerFactory("reject", [] { return std::make_unique<RejectingEffect>(); });
+  avs::core::Pipeline pipeline(registry);
+  pipeline.add("counter", ParamBlock{});
+  pipeline.add("reject", ParamBlock{});
+
+  std::vector<std::uint8_t> pixels(4u);
+  avs::core::RenderContext context{};
+  context.width = 1;
+  context.height = 1;
+  context.framebuffer = {pixels.data(), pixels.size()};
+  pipeline.render(context);
+  const std::vector<std::uint8_t> checkpoint = pipeline.saveState();
+  pipeline.render(context);
+  pipeline.render(context);
+  const std::vector<std::uint8_t> before = pipeline.saveState();
+
+  EXPECT_FALSE(pipeline.restoreState(checkpoint));
+  EXPECT_EQ(pipeline.saveState(), before);
+}
+
+TEST(CheckpointTest, CorruptHistoryCountIsRejected) {
+  avs::core::EffectRegistry registry;
+  avs::effects::registerCoreEffects(registry);
+  std::unique_ptr<avs::core::IEffect> affine = registry.make("transform_affine");
+  ASSERT_TRUE(affine);
+  avs::core::StateWriter before;
+  affine->saveState(before);
+
+  // Gate, jitter and random offsets, then a history count no checkpoint could hold.
+  avs::core::StateWriter corrupt;
+  corrupt.writeVarInt(1);
+  corrupt.writeBool(false);
+  for (int i = 0; i < 4; ++i) {
+    corrupt.writeF32(0.5f);
+  }
+  corrupt.writeVarUint(UINT64_MAX);
+  avs::core::StateReader reader(corrupt.data());
+  EXPECT_FALSE(affine->restoreState(reader));
+
+  avs::core::StateWriter after;
+  affine->saveState(after);
+  EXPECT_EQ(after.data(), before.data());
+}
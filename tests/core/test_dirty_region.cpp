@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include <avs/core/DirtyRect.hpp>
+#include <avs/core/EffectRegistry.hpp>
+#include <avs/core/IEffect.hpp>
+#include <avs/core/ParamBlock.hpp>
+#include <avs/core/Pipeline.hpp>
+#include <avs/core/RenderContext.hpp>
+#include <avs/core/RowBand.hpp>
+#include <avs/effects/prime/Clear.hpp>
+#include <avs/effects/primitives/Primitives.hpp>
+#include <avs/effects/trans/effect_brightness.h>
+#include <avs/effects/trans/effect_color_reduction.h>
+#include <avs/effects/trans/effect_invert.h>
+
+namespace {
+
+using avs::core::DirtyRect;
+
+constexpr int kWidth = 160;
+constexpr int kHeight = 120;
+
+/** Pointwise effect that keeps black and counts the rows it was handed. */
+class RowCounter : public avs::core::IEffect {
+ public:
+  explicit RowCounter(std::atomic<int>& rows) : rows_(rows) {}
+
+  bool render(avs::core::RenderContext& context) override {
+    return smp_render(context, 0, 1);
+  }
+  bool smp_render(avs::core::RenderContext& context, int threadId, int maxThreads) override {
+    const avs::core::RowBand band = avs::core::rowBand(context.height, threadId, maxThreads);
+    rows_ += band.end - band.begin;
+    return true;
+  }
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override {
+    return {avs::core::AccessPattern::Kind::Pointwise, 0};
+  }
+  bool preservesBlack(const avs::core::RenderContext&) const override { return true; }
+  void setParams(const avs::core::ParamBlock&) override {}
+
+ private:
+  std::atomic<int>& rows_;
+};
+
+void registerEffects(avs::core::EffectRegistry& registry) {
+  registry.registerFactory("clear", [] { return std::make_unique<avs::effects::Clear>(); });
+  registry.registerFactory("solid", [] { return std::make_unique<avs::effects::PrimitiveSolid>(); });
+  registry.registerFactory("brightness",
+                           [] { return std::make_unique<avs::effects::trans::Brightness>(); });
+  registry.registerFactory("color_reduction",
+                           [] { return std::make_unique<avs::effects::trans::ColorReduction>(); });
+  registry.registerFactory("invert",
+                           [] { return std::make_unique<avs::effects::trans::InvertEffect>(); });
+}
+
+avs::core::ParamBlock solidParams() {
+  avs::core::ParamBlock params;
+  params.setInt("x1", 40);
+  params.setInt("y1", 50);
+  params.setInt("x2", 59);
+  params.setInt("y2", 61);
+  params.setInt("color", 0x80A0C0);
+  return params;
+}
+
+avs::core::ParamBlock brightnessParams() {
+  avs::core::ParamBlock params;
+  params.setInt("redp", 1024);
+  params.setInt("bluep", -512);
+  return params;
+}
+
+avs::core::ParamBlock colorReductionParams() {
+  avs::core::ParamBlock params;
+  params.setInt("levels", 5);
+  return params;
+}
+
+avs::core::RenderContext makeContext(std::vector<std::uint8_t>& pixels) {
+  avs::core::RenderContext context;
+  context.width = kWidth;
+  context.height = kHeight;
+  context.framebuffer = {pixels.data(), pixels.size()};
+  return context;
+}
+
+// Runs the effects one by one on a bare context, so nothing is tracked.
+std::vector<std::uint8_t> renderUntracked(const std::vector<std::uint8_t>& source) {
+  std::vector<std::uint8_t> pixels = source;
+  avs::core::RenderContext context = makeContext(pixels);
+  avs::effects::Clear clear;
+  avs::effects::PrimitiveSolid solid;
+  avs::effects::trans::Brightness brightness;
+  avs::effects::trans::ColorReduction reduction;
+  solid.setParams(solidParams());
+  brightness.setParams(brightnessParams());
+  reduction.setParams(colorReductionParams());
+  for (avs::core::IEffect* effect :
+       std::initializer_list<avs::core::IEffect*>{&clear, &solid, &brightness, &reduction}) {
+    effect->render(context);
+  }
+  return pixels;
+}
+
+std::vector<std::uint8_t> noise() {
+  std::vector<std::uint8_t> pixels(static_cast<std::size_t>(kWidth) * kHeight * 4u);
+  for (std::size_t i = 0; i < pixels.size(); ++i) {
+    pixels[i] = static_cast<std::uint8_t>((i * 2654435761u) >> 13);
+  }
+  return pixels;
+}
+
+}  // namespace
+
+TEST(DirtyRectTest, IncludeGrowsAndClipClamps) {
+  DirtyRect rect = DirtyRect::none();
+  EXPECT_TRUE(rect.empty());
+  rect.include(5, 7);
+  EXPECT_EQ(rect, (DirtyRect{5, 7, 6, 8}));
+  rect.include(DirtyRect{-3, 10, 2, 12});
+  EXPECT_EQ(rect, (DirtyRect{-3, 7, 6, 12}));
+  rect.include(DirtyRect::none());
+  EXPECT_EQ(rect, (DirtyRect{-3, 7, 6, 12}));
+
+  EXPECT_EQ(rect.clipped(4, 100), (DirtyRect{0, 7, 4, 12}));
+  EXPECT_TRUE(rect.clipped(4, 5).empty());
+  EXPECT_TRUE(DirtyRect::all().coversFrame(kWidth, kHeight));
+  EXPECT_EQ(DirtyRect::all().clipped(kWidth, kHeight), (DirtyRect{0, 0, kWidth, kHeight}));
+  EXPECT_TRUE(rect.intersectsRows(11, 20));
+  EXPECT_FALSE(rect.intersectsRows(12, 20));
+}
+
+TEST(DirtyRegionTest, SparseChainMatchesUntrackedRender) {
+  const std::vector<std::uint8_t> source = noise();
+  const std::vector<std::uint8_t> expected = renderUntracked(source);
+
+  for (int threads : {1, 4}) {
+    avs::core::EffectRegistry registry;
+    registerEffects(registry);
+    avs::core::Pipeline pipeline(registry, threads);
+    pipeline.setAutoThreading(false);
+    pipeline.add("clear", {});
+    pipeline.add("solid", solidParams());
+    pipeline.add("brightness", brightnessParams());
+    pipeline.add("color_reduction", colorReductionParams());
+
+    std::vector<std::uint8_t> pixels = source;
+    avs::core::RenderContext context = makeContext(pixels);
+    ASSERT_TRUE(pipeline.render(context));
+    EXPECT_EQ(pixels, expected) << threads << " threads";
+    EXPECT_EQ(context.dirtyOut, (DirtyRect{40, 50, 60, 62}));
+    EXPECT_EQ(context.dirtyIn, DirtyRect::all());
+  }
+}
+
+TEST(DirtyRegionTest, BlackPreservingEffectsSkipBlackRows) {
+  std::atomic<int> rows{0};
+  avs::core::EffectRegistry registry;
+  registerEffects(registry);
+  registry.registerFactory("counter", [&rows] { return std::make_unique<RowCounter>(rows); });
+  // Two threads split the frame into several tiles; a single-threaded run of a
+  // frame this small is one tile and has nothing to skip.
+  avs::core::Pipeline pipeline(registry, 2);
+  pipeline.setAutoThreading(false);
+  pipeline.add("clear", {});
+  pipeline.add("solid", solidParams());
+  pipeline.add("counter", {});
+
+  std::vector<std::uint8_t> pixels = noise();
+  avs::core::RenderContext context = makeContext(pixels);
+  ASSERT_TRUE(pipeline.render(context));
+  EXPECT_GE(rows.load(), 12);
+  EXPECT_LT(rows.load(), kHeight);
+  EXPECT_EQ(context.dirtyOut, (DirtyRect{40, 50, 60, 62}));
+
+  // Without a cleared frame nothing is known, so every row is visited.
+  rows = 0;
+  avs::core::Pipeline untracked(registry, 2);
+  untracked.setAutoThreading(false);
+  untracked.add("counter", {});
+  ASSERT_TRUE(untracked.render(context));
+  EXPECT_EQ(rows.load(), kHeight);
+  EXPECT_EQ(context.dirtyOut, (DirtyRect{0, 0, kWidth, kHeight}));
+}
+
+TEST(DirtyRegionTest, EffectsThatLiftBlackWidenTheRegion) {
+  avs::core::EffectRegistry registry;
+  registerEffects(registry);
+  avs::core::Pipeline pipeline(registry);
+  pipeline.add("clear", {});
+  pipeline.add("solid", solidParams());
+  pipeline.add("invert", {});
+
+  std::vector<std::uint8_t> pixels = noise();
+  avs::core::RenderContext context = makeContext(pixels);
+  ASSERT_TRUE(pipeline.render(context));
+  EXPECT_EQ(context.dirtyOut, (DirtyRect{0, 0, kWidth, kHeight}));
+  // Rows far from the rectangle were inverted from black.
+  EXPECT_EQ(pixels[0], 255u);
+  EXPECT_EQ(pixels[pixels.size() - 2], 255u);
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <avs/core/EffectRegistry.hpp>
+#include <avs/core/FrameArena.hpp>
+#include <avs/core/IEffect.hpp>
+#include <avs/core/ParamBlock.hpp>
+#include <avs/core/Pipeline.hpp>
+#include <avs/core/RenderContext.hpp>
+#include <avs/effects/trans/effect_blur.h>
+
+namespace {
+
+bool isAligned(const void* pointer) {
+  return reinterpret_cast<std::uintptr_t>(pointer) % avs::core::FrameArena::kAlignment == 0;
+}
+
+/** Takes a frame-sized buffer from the arena and records what it saw. */
+class ArenaProbe : public avs::core::IEffect {
+ public:
+  explicit ArenaProbe(std::vector<avs::core::FrameArena*>& seen) : seen_(seen) {}
+
+  bool render(avs::core::RenderContext& context) override {
+    seen_.push_back(context.arena);
+    if (context.arena) {
+      const std::size_t bytes = static_cast<std::size_t>(context.width) * context.height * 4u;
+      auto* scratch = context.arena->allocateArray<std::uint8_t>(bytes);
+      std::memset(scratch, 0xAB, bytes);
+    }
+    return true;
+  }
+  void setParams(const avs::core::ParamBlock&) override {}
+
+ private:
+  std::vector<avs::core::FrameArena*>& seen_;
+};
+
+}  // namespace
+
+TEST(FrameArenaTest, AllocationsAreAlignedAndDisjoint) {
+  avs::core::FrameArena arena;
+  auto* a = static_cast<std::uint8_t*>(arena.allocate(3));
+  auto* b = static_cast<std::uint8_t*>(arena.allocate(100));
+  auto* c = arena.allocateArray<int>(7);
+  EXPECT_TRUE(isAligned(a));
+  EXPECT_TRUE(isAligned(b));
+  EXPECT_TRUE(isAligned(c));
+  EXPECT_GE(b - a, 3);
+  EXPECT_GE(reinterpret_cast<std::uint8_t*>(c) - b, 100);
+  EXPECT_EQ(arena.bytesUsed(), 4 * avs::core::FrameArena::kAlignment);  // 64 + 128 + 64
+  EXPECT_EQ(arena.allocate(0), nullptr);
+}
+
+TEST(FrameArenaTest, ResetReusesMemory) {
+  avs::core::FrameArena arena;
+  void* first = arena.allocate(4096);
+  arena.reset();
+  EXPECT_EQ(arena.bytesUsed(), 0u);
+  EXPECT_EQ(arena.allocate(4096), first);
+}
+
+TEST(FrameArenaTest, OverflowChainsBlocksThenFoldsThemOnReset) {
+  avs::core::FrameArena arena;
+  const std::size_t frameBytes = 320 * 240 * 4;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_NE(arena.allocate(frameBytes), nullptr);
+  }
+  EXPECT_EQ(arena.bytesUsed(), 4 * frameBytes);
+  const std::size_t capacity = arena.capacity();
+  EXPECT_GE(capacity, 4 * frameBytes);
+
+  // The same workload fits the folded block without growing it again.
+  arena.reset();
+  EXPECT_EQ(arena.capacity(), capacity);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_NE(arena.allocate(frameBytes), nullptr);
+  }
+  EXPECT_EQ(arena.capacity(), capacity);
+}
+
+TEST(FrameArenaTest, FrameScratchFallsBackToOwnedVector) {
+  std::vector<std::uint8_t> fallback;
+  std::uint8_t* scratch = avs::core::frameScratch(nullptr, fallback, 64);
+  EXPECT_EQ(scratch, fallback.data());
+  EXPECT_EQ(fallback.size(), 64u);
+
+  avs::core::FrameArena arena;
+  std::vector<std::uint8_t> unused;
+  EXPECT_TRUE(isAligned(avs::core::frameScratch(&arena, unused, 64)));
+  EXPECT_TRUE(unused.empty());
+}
+
+TEST(FrameArenaTest, PipelineLendsArenaForTheFrameOnly) {
+  std::vector<avs::core::FrameArena*> seen;
+  avs::core::EffectRegistry registry;
+  registry.registerFactory("probe", [&seen] { return std::make_unique<ArenaProbe>(seen); });
+  avs::core::Pipeline pipeline(registry);
+  pipeline.add("probe", {});
+  pipeline.add("probe", {});
+
+  std::vector<std::uint8_t> pixels(16 * 8 * 4, 0);
+  avs::core::RenderContext context;
+  context.width = 16;
+  context.height = 8;
+  context.framebuffer = {pixels.data(), pixels.size()};
+  ASSERT_TRUE(pipeline.render(context));
+  ASSERT_EQ(seen.size(), 2u);
+  EXPECT_NE(seen[0], nullptr);
+  EXPECT_EQ(seen[0], seen[1]);
+  EXPECT_EQ(seen[0]->bytesUsed(), 0u);
+  EXPECT_EQ(context.arena, nullptr);
+
+  // A caller-owned arena is used as is and left for the caller to reset.
+  avs::core::FrameArena callerArena;
+  context.arena = &callerArena;
+  ASSERT_TRUE(pipeline.render(context));
+  EXPECT_EQ(seen[2], &callerArena);
+  EXPECT_EQ(callerArena.bytesUsed(), 2 * pixels.size());
+}
+
+TEST(FrameArenaTest, BlurMatchesWithAndWithoutArena) {
+  avs::core::ParamBlock params;
+  params.setInt("radius", 3);
+  avs::effects::trans::R_Blur withArena;
+  avs::effects::trans::R_Blur withoutArena;
+  withArena.setParams(params);
+  withoutArena.setParams(params);
+
+  const int width = 37;
+  const int height = 23;
+  std::vector<std::uint8_t> source(static_cast<std::size_t>(width) * height * 4);
+  for (std::size_t i = 0; i < source.size(); ++i) {
+    source[i] = static_cast<std::uint8_t>((i * 131u) ^ (i >> 3));
+  }
+  std::vector<std::uint8_t> a = source;
+  std::vector<std::uint8_t> b = source;
+
+  avs::core::FrameArena arena;
+  avs::core::RenderContext context;
+  context.width = width;
+  context.height = height;
+  context.framebuffer = {a.data(), a.size()};
+  context.arena = &arena;
+  ASSERT_TRUE(withArena.render(context));
+  EXPECT_GT(arena.bytesUsed(), 0u);
+
+  context.framebuffer = {b.data(), b.size()};
+  context.arena = nullptr;
+  ASSERT_TRUE(withoutArena.render(context));
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, source);
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <avs/core/EffectRegistry.hpp>
+#include <avs/core/FrameGovernor.hpp>
+#include <avs/core/IEffect.hpp>
+#include <avs/core/ParamBlock.hpp>
+#include <avs/core/Pipeline.hpp>
+#include <avs/core/RenderContext.hpp>
+#include <avs/effects/filters/effect_blur_box.h>
+
+namespace {
+
+using avs::core::FrameGovernor;
+using avs::core::kMaxQualityLevel;
+
+constexpr int kWidth = 37;
+constexpr int kHeight = 29;
+
+FrameGovernor::Config testConfig() {
+  FrameGovernor::Config config;
+  config.targetMs = 10.0;
+  config.window = 4;
+  config.downshiftRatio = 1.0;
+  config.upshiftRatio = 0.5;
+  config.upshiftWindows = 2;
+  return config;
+}
+
+void observeWindow(FrameGovernor& governor, double frameMs) {
+  for (std::size_t i = 0; i < governor.config().window; ++i) {
+    governor.observe(frameMs);
+  }
+}
+
+class QualityRecorder : public avs::core::IEffect {
+ public:
+  explicit QualityRecorder(std::vector<int>* levels) : levels_(levels) {}
+  bool render(avs::core::RenderContext&) override { return true; }
+  void setParams(const avs::core::ParamBlock&) override {}
+  void setQualityLevel(int level) override { levels_->push_back(level); }
+
+ private:
+  std::vector<int>* levels_;
+};
+
+std::vector<std::uint8_t> renderBlur(int radius, int lockedLevel, double budgetMs = 0.0) {
+  avs::core::EffectRegistry registry;
+  registry.registerFactory("blur", [] { return std::make_unique<avs::effects::filters::BlurBox>(); });
+  avs::core::Pipeline pipeline(registry);
+  if (lockedLevel >= 0) {
+    pipeline.lockQualityLevel(lockedLevel);
+  }
+  pipeline.setFrameBudget(budgetMs);
+  avs::core::ParamBlock params;
+  params.setInt("radius", radius);
+  pipeline.add("blur", params);
+
+  std::vector<std::uint8_t> pixels(static_cast<std::size_t>(kWidth) * kHeight * 4u);
+  for (std::size_t i = 0; i < pixels.size(); ++i) {
+    pixels[i] = static_cast<std::uint8_t>((i * 37u + (i / 97u) * 11u) & 0xFFu);
+  }
+  avs::core::RenderContext context{};
+  context.width = kWidth;
+  context.height = kHeight;
+  context.framebuffer = {pixels.data(), pixels.size()};
+  for (int frame = 0; frame < 3; ++frame) {
+    context.frameIndex = static_cast<std::uint64_t>(frame);
+    EXPECT_TRUE(pipeline.render(context));
+  }
+  return pixels;
+}
+
+}  // namespace
+
+TEST(FrameGovernorTest, StepsDownOncePerSlowWindow) {
+  FrameGovernor governor(testConfig());
+  for (std::size_t i = 0; i + 1 < governor.config().window; ++i) {
+    EXPECT_EQ(governor.observe(50.0), kMaxQualityLevel);
+  }
+  EXPECT_EQ(governor.observe(50.0), kMaxQualityLevel - 1);
+  observeWindow(governor, 50.0);
+  EXPECT_EQ(governor.level(), kMaxQualityLevel - 2);
+  for (int i = 0; i < 10; ++i) {
+    observeWindow(governor, 50.0);
+  }
+  EXPECT_EQ(governor.level(), avs::core::kMinQualityLevel);
+}
+
+TEST(FrameGovernorTest, HoldsLevelInsideHysteresisBand) {
+  FrameGovernor governor(testConfig());
+  observeWindow(governor, 50.0);
+  ASSERT_EQ(governor.level(), kMaxQualityLevel - 1);
+  // Between upshiftRatio and downshiftRatio of the target: neither direction.
+  for (int i = 0; i < 10; ++i) {
+    observeWindow(governor, 7.0);
+  }
+  EXPECT_EQ(governor.level(), kMaxQualityLevel - 1);
+}
+
+TEST(FrameGovernorTest, StepsUpOnlyAfterConsecutiveHeadroomWindows) {
+  FrameGovernor governor(testConfig());
+  observeWindow(governor, 50.0);
+  ASSERT_EQ(governor.level(), kMaxQualityLevel - 1);
+
+  observeWindow(governor, 1.0);
+  EXPECT_EQ(governor.level(), kMaxQualityLevel - 1);
+  // A window in the band resets the headroom streak.
+  observeWindow(governor, 7.0);
+  observeWindow(governor, 1.0);
+  EXPECT_EQ(governor.level(), kMaxQualityLevel - 1);
+  observeWindow(governor, 1.0);
+  EXPECT_EQ(governor.level(), kMaxQualityLevel);
+}
+
+TEST(FrameGovernorTest, SingleSlowFrameDoesNotStepDown) {
+  FrameGovernor::Config config = testConfig();
+  config.window = 20;
+  FrameGovernor governor(config);
+  governor.observe(100.0);
+  for (std::size_t i = 1; i < governor.config().window; ++i) {
+    governor.observe(2.0);
+  }
+  EXPECT_EQ(governor.level(), kMaxQualityLevel);
+}
+
+TEST(FrameGovernorTest, LockPinsLevelUntilUnlocked) {
+  FrameGovernor governor(testConfig());
+  governor.lock(1);
+  EXPECT_FALSE(governor.adaptive());
+  observeWindow(governor, 50.0);
+  observeWindow(governor, 1.0);
+  observeWindow(governor, 1.0);
+  EXPECT_EQ(governor.level(), 1);
+
+  governor.unlock();
+  observeWindow(governor, 1.0);
+  observeWindow(governor, 1.0);
+  EXPECT_EQ(governor.level(), 2);
+}
+
+TEST(FrameGovernorTest, DisablingBudgetRestoresFullQuality) {
+  FrameGovernor governor(testConfig());
+  observeWindow(governor, 50.0);
+  ASSERT_LT(governor.level(), kMaxQualityLevel);
+  governor.setTargetMs(0.0);
+  EXPECT_FALSE(governor.adaptive());
+  EXPECT_EQ(governor.level(), kMaxQualityLevel);
+  observeWindow(governor, 50.0);
+  EXPECT_EQ(governor.level(), kMaxQualityLevel);
+}
+
+TEST(FrameGovernorTest, PipelinePushesLevelChangesToEffects) {
+  std::vector<int> levels;
+  avs::core::EffectRegistry registry;
+  registry.registerFactory("recorder", [&levels] { return std::make_unique<QualityRecorder>(&levels); });
+  avs::core::Pipeline pipeline(registry);
+  pipeline.add("recorder", {});
+  // No frame can finish inside a zero-width budget, so every window steps down.
+  pipeline.setFrameBudget(1e-9);
+
+  avs::core::RenderContext context{};
+  const std::size_t window = FrameGovernor::Config{}.window;
+  for (std::size_t frame = 0; frame < window * 2; ++frame) {
+    EXPECT_TRUE(pipeline.render(context));
+  }
+  EXPECT_EQ(pipeline.qualityLevel(), kMaxQualityLevel - 2);
+  EXPECT_EQ(levels, (std::vector<int>{kMaxQualityLevel - 1, kMaxQualityLevel - 2}));
+
+  pipeline.lockQualityLevel(kMaxQualityLevel);
+  EXPECT_EQ(levels.back(), kMaxQualityLevel);
+
+  // Effects added after a change start at the current level.
+  pipeline.lockQualityLevel(0);
+  std::vector<int> lateLevels;
+  registry.registerFactory("late", [&lateLevels] { return std::make_unique<QualityRecorder>(&lateLevels); });
+  pipeline.add("late", {});
+  EXPECT_EQ(lateLevels, (std::vector<int>{0}));
+}
+
+TEST(FrameGovernorTest, FullQualityOutputIsUnchangedByBudget) {
+  EXPECT_EQ(renderBlur(12, -1), renderBlur(12, -1, 1e6));
+  EXPECT_EQ(renderBlur(12, -1), renderBlur(12, kMaxQualityLevel));
+}
+
+TEST(FrameGovernorTest, LockedLevelCapsBlurRadius) {
+  const auto reduced = renderBlur(12, 0);
+  EXPECT_NE(reduced, renderBlur(12, -1));
+  EXPECT_EQ(reduced, renderBlur(2, -1));
+}
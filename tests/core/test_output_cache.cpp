@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <avs/core/EffectRegistry.hpp>
+#include <avs/core/IEffect.hpp>
+#include <avs/core/ParamBlock.hpp>
+#include <avs/core/Pipeline.hpp>
+#include <avs/core/RenderContext.hpp>
+#include <avs/effects/dynamic/movement.h>
+#include <avs/effects/misc/effect_comment.h>
+#include <avs/effects/render/effect_clear_screen.h>
+#include <avs/effects/trans/effect_add_borders.h>
+
+namespace {
+
+constexpr int kWidth = 97;
+constexpr int kHeight = 61;
+
+std::vector<std::uint8_t> makePattern(int seed) {
+  std::vector<std::uint8_t> pixels(static_cast<std::size_t>(kWidth) * kHeight * 4u);
+  for (std::size_t i = 0; i < pixels.size(); ++i) {
+    pixels[i] = static_cast<std::uint8_t>((i * 37u + static_cast<std::size_t>(seed) * 11u) & 0xFF);
+  }
+  return pixels;
+}
+
+// Declares its output fixed by its parameters but actually inverts the input.
+class MislabeledInvert : public avs::core::IEffect {
+ public:
+  bool render(avs::core::RenderContext& context) override {
+    for (std::size_t i = 0; i < context.framebuffer.size; ++i) {
+      context.framebuffer.data[i] = static_cast<std::uint8_t>(~context.framebuffer.data[i]);
+    }
+    return true;
+  }
+  void setParams(const avs::core::ParamBlock&) override {}
+  avs::core::OutputDependence outputDependence() const override {
+    return avs::core::OutputDependence::Params;
+  }
+};
+
+avs::core::EffectRegistry makeRegistry() {
+  avs::core::EffectRegistry registry;
+  registry.registerFactory("comment", [] { return std::make_unique<avs::effects::misc::Comment>(); });
+  registry.registerFactory("clear",
+                           [] { return std::make_unique<avs::effects::render::ClearScreenEffect>(); });
+  registry.registerFactory("borders", [] { return std::make_unique<avs::effects::trans::AddBorders>(); });
+  registry.registerFactory("invert", [] { return std::make_unique<MislabeledInvert>(); });
+  return registry;
+}
+
+// Renders the pipeline over a fresh input frame each time and returns every output.
+std::vector<std::vector<std::uint8_t>> renderFrames(avs::core::Pipeline& pipeline, int frames) {
+  std::vector<std::vector<std::uint8_t>> outputs;
+  for (int frame = 0; frame < frames; ++frame) {
+    std::vector<std::uint8_t> pixels = makePattern(frame);
+    avs::core::RenderContext context{};
+    context.width = kWidth;
+    context.height = kHeight;
+    context.frameIndex = static_cast<std::uint64_t>(frame);
+    context.framebuffer = {pixels.data(), pixels.size()};
+    EXPECT_TRUE(pipeline.render(context));
+    outputs.push_back(std::move(pixels));
+  }
+  return outputs;
+}
+
+// The same chain rendered by calling each effect directly.
+std::vector<std::uint8_t> renderDirect(const std::vector<std::unique_ptr<avs::core::IEffect>>& effects,
+                                       int frame) {
+  std::vector<std::uint8_t> pixels = makePattern(frame);
+  avs::core::RenderContext context{};
+  context.width = kWidth;
+  context.height = kHeight;
+  context.frameIndex = static_cast<std::uint64_t>(frame);
+  context.framebuffer = {pixels.data(), pixels.size()};
+  for (const auto& effect : effects) {
+    EXPECT_TRUE(effect->render(context));
+  }
+  return pixels;
+}
+
+}  // namespace
+
+TEST(OutputCacheTest, EffectsWithoutOutputAreNeverScheduled) {
+  avs::core::EffectRegistry registry = makeRegistry();
+  avs::core::Pipeline pipeline(registry, 1);
+  pipeline.setProfilingEnabled(true);
+  pipeline.add("comment", avs::core::ParamBlock{});
+  avs::core::ParamBlock disabled;
+  disabled.setBool("enabled", false);
+  pipeline.add("borders", disabled);
+
+  const auto outputs = renderFrames(pipeline, 2);
+  EXPECT_EQ(outputs.back(), makePattern(1));
+  const avs::core::PipelineProfile& profile = pipeline.profile();
+  ASSERT_EQ(profile.nodes.size(), 2u);
+  EXPECT_EQ(profile.nodes[0].frames, 0u);
+  EXPECT_EQ(profile.nodes[1].frames, 0u);
+}
+
+TEST(OutputCacheTest, CachedLayersMatchDirectRendering) {
+  avs::core::EffectRegistry registry = makeRegistry();
+  avs::core::Pipeline pipeline(registry, 1);
+  pipeline.setProfilingEnabled(true);
+
+  avs::core::ParamBlock clear;
+  clear.setInt("color", 0x204060);
+  avs::core::ParamBlock borders;
+  borders.setBool("enabled", true);
+  borders.setInt("size", 10);
+  borders.setInt("color", 0xC08010);
+  pipeline.add("clear", clear);
+  pipeline.add("borders", borders);
+  // Borders alone over a changing frame exercises the blend rows.
+  avs::core::Pipeline bordersOnly(registry, 1);
+  bordersOnly.setProfilingEnabled(true);
+  bordersOnly.add("borders", borders);
+
+  std::vector<std::unique_ptr<avs::core::IEffect>> direct;
+  direct.push_back(std::make_unique<avs::effects::render::ClearScreenEffect>());
+  direct.back()->setParams(clear);
+  direct.push_back(std::make_unique<avs::effects::trans::AddBorders>());
+  direct.back()->setParams(borders);
+  std::vector<std::unique_ptr<avs::core::IEffect>> directBorders;
+  directBorders.push_back(std::make_unique<avs::effects::trans::AddBorders>());
+  directBorders.back()->setParams(borders);
+
+  const auto chained = renderFrames(pipeline, 3);
+  const auto bordered = renderFrames(bordersOnly, 3);
+  for (int frame = 0; frame < 3; ++frame) {
+    SCOPED_TRACE(frame);
+    EXPECT_EQ(chained[static_cast<std::size_t>(frame)], renderDirect(direct, frame));
+    EXPECT_EQ(bordered[static_cast<std::size_t>(frame)], renderDirect(directBorders, frame));
+  }
+  EXPECT_TRUE(pipeline.profile().nodes.at(0).lastCached);
+  EXPECT_TRUE(pipeline.profile().nodes.at(1).lastCached);
+  EXPECT_TRUE(bordersOnly.profile().nodes.at(0).lastCached);
+}
+
+TEST(OutputCacheTest, EffectsThatReadTheirInputAreDemoted) {
+  avs::core::EffectRegistry registry = makeRegistry();
+  avs::core::Pipeline pipeline(registry, 1);
+  pipeline.setProfilingEnabled(true);
+  pipeline.add("invert", avs::core::ParamBlock{});
+
+  std::vector<std::unique_ptr<avs::core::IEffect>> direct;
+  direct.push_back(std::make_unique<MislabeledInvert>());
+  const auto outputs = renderFrames(pipeline, 3);
+  for (int frame = 0; frame < 3; ++frame) {
+    EXPECT_EQ(outputs[static_cast<std::size_t>(frame)], renderDirect(direct, frame)) << frame;
+  }
+  EXPECT_FALSE(pipeline.profile().nodes.at(0).lastCached);
+  EXPECT_EQ(pipeline.profile().nodes.at(0).frames, 3u);
+}
+
+TEST(OutputCacheTest, MovementRebuildsItsTableWhenParamsChange) {
+  avs::core::ParamBlock first;
+  first.setFloat("scale", 1.1f);
+  first.setFloat("rotate", 12.0f);
+  avs::core::ParamBlock second;
+  second.setFloat("scale", 0.8f);
+  second.setFloat("rotate", -30.0f);
+  second.setFloat("offset_x", 0.1f);
+  second.setBool("wrap", true);
+
+  avs::effects::MovementEffect warped;
+  warped.setParams(first);
+  std::vector<std::uint8_t> pixels = makePattern(0);
+  avs::core::RenderContext context{};
+  context.width = kWidth;
+  context.height = kHeight;
+  context.framebuffer = {pixels.data(), pixels.size()};
+  ASSERT_TRUE(warped.render(context));
+  const std::vector<std::uint8_t> history = pixels;
+
+  // A fresh effect starts from its first input, so both warp the same history.
+  warped.setParams(second);
+  ASSERT_TRUE(warped.render(context));
+
+  avs::effects::MovementEffect fresh;
+  fresh.setParams(second);
+  std::vector<std::uint8_t> expected = history;
+  context.framebuffer = {expected.data(), expected.size()};
+  ASSERT_TRUE(fresh.render(context));
+  EXPECT_EQ(pixels, expected);
+}
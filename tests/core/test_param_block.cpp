@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <avs/core/ParamBlock.hpp>
+#include <avs/core/ParamKey.hpp>
+
+using avs::core::ParamAliases;
+using avs::core::ParamBlock;
+using avs::core::ParamKey;
+
+TEST(ParamKeyTest, InterningIsStableAndNameRoundTrips) {
+  const ParamKey first("param_key_test_radius");
+  const ParamKey second(std::string("param_key_test_") + "radius");
+  EXPECT_EQ(first, second);
+  EXPECT_NE(first, ParamKey("param_key_test_strength"));
+  EXPECT_EQ(first.name(), "param_key_test_radius");
+  EXPECT_FALSE(ParamKey().valid());
+  EXPECT_TRUE(ParamKey().name().empty());
+}
+
+TEST(ParamKeyTest, LookupDoesNotIntern) {
+  EXPECT_FALSE(ParamKey::lookup("param_key_test_never_set").has_value());
+  ParamBlock block;
+  EXPECT_FALSE(block.contains("param_key_test_never_set"));
+  EXPECT_EQ(block.getInt("param_key_test_never_set", 7), 7);
+  EXPECT_FALSE(ParamKey::lookup("param_key_test_never_set").has_value());
+}
+
+TEST(ParamBlockTest, StringAndKeyOverloadsShareStorage) {
+  static const ParamKey kDelay("delay");
+  ParamBlock block;
+  block.setInt("delay", 4);
+  EXPECT_EQ(block.getInt(kDelay), 4);
+  block.setFloat(kDelay, 2.5f);
+  EXPECT_FLOAT_EQ(block.getFloat("delay"), 2.5f);
+  EXPECT_EQ(block.getInt("delay"), 2);
+  block.setString(kDelay, "six");
+  EXPECT_EQ(block.getInt(kDelay, -1), -1);
+  ASSERT_NE(block.findString(kDelay), nullptr);
+  EXPECT_EQ(*block.findString(kDelay), "six");
+  EXPECT_EQ(block.getString("delay"), "six");
+}
+
+TEST(ParamBlockTest, KeepsTypeCoercionRules) {
+  ParamBlock block;
+  block.setInt("count", 3);
+  block.setBool("enabled", true);
+  EXPECT_FLOAT_EQ(block.getFloat("count"), 3.0f);
+  EXPECT_FALSE(block.getBool("count", false));
+  EXPECT_EQ(block.getInt("enabled", 9), 9);
+  EXPECT_EQ(block.getString("count", "fallback"), "fallback");
+  EXPECT_EQ(block.findString(ParamKey("count")), nullptr);
+}
+
+TEST(ParamBlockTest, FirstPresentFollowsAliasOrder) {
+  static const ParamAliases kAliases{"mode", "operation", "op"};
+  ParamBlock block;
+  EXPECT_FALSE(block.firstPresent(kAliases).has_value());
+  block.setInt("op", 1);
+  block.setInt("operation", 2);
+  const auto key = block.firstPresent(kAliases);
+  ASSERT_TRUE(key.has_value());
+  EXPECT_EQ(key->name(), "operation");
+  EXPECT_EQ(block.getInt(*key), 2);
+}
+
+TEST(ParamBlockTest, InsertionOrderDoesNotAffectLookup) {
+  ParamBlock forward;
+  ParamBlock backward;
+  const char* names[] = {"zeta", "alpha", "mid", "beta", "omega"};
+  for (int i = 0; i < 5; ++i) {
+    forward.setInt(names[i], i);
+    backward.setInt(names[4 - i], 4 - i);
+  }
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(forward.getInt(names[i], -1), i);
+    EXPECT_EQ(backward.getInt(names[i], -1), i);
+  }
+  ParamBlock copy = forward;
+  copy.setInt("mid", 40);
+  EXPECT_EQ(copy.getInt("mid"), 40);
+  EXPECT_EQ(forward.getInt("mid"), 2);
+}
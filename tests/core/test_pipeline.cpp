@@ -16,6 +16,7 @@
 #include <avs/core/IEffect.hpp>
 #include <avs/core/ParamBlock.hpp>
 #include <avs/core/Pipeline.hpp>
+#include <avs/core/Profiling.hpp>
 #include <avs/core/RenderContext.hpp>
 
 namespace {
@@ -227,3 +228,66 @@ TEST(PipelineTest, StopsProcessingWhenEffectFails) {
   EXPECT_FALSE(succeedingExecuted);
 }
 
+
+TEST(PipelineTest, ProfilingIsEmptyWhenDisabled) {
+  avs::core::EffectRegistry registry;
+  registry.registerFactory("noop", []() { return std::make_unique<NoOpEffect>(); });
+  avs::core::Pipeline pipeline(registry);
+  pipeline.add("noop", ParamBlock{});
+
+  std::vector<std::uint8_t> pixels(16u, 0u);
+  auto ctx = makeContext(pixels);
+  ASSERT_TRUE(pipeline.render(ctx));
+
+  EXPECT_FALSE(pipeline.profilingEnabled());
+  const auto profile = pipeline.profile();
+  EXPECT_EQ(profile.frames, 0u);
+  EXPECT_TRUE(profile.nodes.empty());
+}
+
+TEST(PipelineTest, ProfilingRecordsEveryNodeAndFrame) {
+  avs::core::EffectRegistry registry;
+  registry.registerFactory("noop", []() { return std::make_unique<NoOpEffect>(); });
+  registry.registerFactory("increment", []() { return std::make_unique<IncrementEffect>(); });
+  avs::core::Pipeline pipeline(registry);
+  pipeline.add("noop", ParamBlock{});
+  pipeline.add("increment", ParamBlock{});
+  pipeline.setProfilingEnabled(true);
+
+  std::vector<std::uint8_t> pixels(16u, 0u);
+  auto ctx = makeContext(pixels);
+  for (int frame = 0; frame < 5; ++frame) {
+    ASSERT_TRUE(pipeline.render(ctx));
+  }
+
+  const auto profile = pipeline.profile();
+  EXPECT_EQ(profile.frames, 5u);
+  EXPECT_LE(profile.frameP50Ms, profile.frameP99Ms);
+  ASSERT_EQ(profile.nodes.size(), 2u);
+  EXPECT_EQ(profile.nodes[0].key, "noop");
+  EXPECT_EQ(profile.nodes[1].key, "increment");
+  for (const auto& node : profile.nodes) {
+    EXPECT_EQ(node.frames, 5u);
+    EXPECT_FALSE(node.lastSmp);
+    EXPECT_EQ(node.lastThreads, 1);
+    EXPECT_EQ(node.lastPixels, 4u);
+    EXPECT_LE(node.p50Ms, node.p95Ms);
+    EXPECT_LE(node.p95Ms, node.p99Ms);
+  }
+
+  const std::string json = avs::core::toJson(profile);
+  EXPECT_NE(json.find("\"effect\": \"increment\""), std::string::npos);
+  EXPECT_NE(json.find("\"p99\""), std::string::npos);
+}
+
+TEST(PipelineTest, RollingHistogramKeepsMostRecentWindow) {
+  avs::core::RollingHistogram histogram(4);
+  EXPECT_EQ(histogram.percentile(50.0), 0.0);
+  for (double value : {100.0, 100.0, 1.0, 2.0, 3.0, 4.0}) {
+    histogram.add(value);
+  }
+  EXPECT_EQ(histogram.size(), 4u);
+  EXPECT_EQ(histogram.percentile(50.0), 2.0);
+  EXPECT_EQ(histogram.percentile(99.0), 4.0);
+  EXPECT_EQ(histogram.percentile(0.0), 1.0);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <avs/core/ParamBlock.hpp>
+#include <avs/core/RowBand.hpp>
+#include <avs/effects/filters/effect_blur_box.h>
+#include <avs/effects/filters/effect_conv3x3.h>
+#include <avs/effects/filters/effect_grain.h>
+#include <avs/effects/filters/effect_interferences.h>
+#include <avs/effects/trans/effect_blur.h>
+#include <avs/effects/trans/effect_mosaic.h>
+#include "smp_harness.hpp"
+
+namespace {
+
+constexpr int kWidth = 41;
+constexpr int kHeight = 31;
+constexpr int kFrames = 4;
+
+void fillPattern(std::vector<std::uint8_t>& pixels, int /* frame */) {
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      const std::size_t index = (static_cast<std::size_t>(y) * kWidth + static_cast<std::size_t>(x)) * 4u;
+      pixels[index + 0] = static_cast<std::uint8_t>((x * 29 + y * 11) & 0xFF);
+      pixels[index + 1] = static_cast<std::uint8_t>((x * x + y * 53 + 40) & 0xFF);
+      pixels[index + 2] = static_cast<std::uint8_t>((x * 7 + y * y + 150) & 0xFF);
+      pixels[index + 3] = static_cast<std::uint8_t>((x * 3 + y * 5) & 0xFF);
+    }
+  }
+}
+
+smp_test::CaseList makeCases() {
+  smp_test::CaseList cases;
+
+  avs::core::ParamBlock sharpen;
+  sharpen.setString("kernel", "0 -1 0 -1 5 -1 0 -1 0");
+  sharpen.setBool("preserve_alpha", false);
+  cases.add("conv3x3",
+            [] { return std::make_unique<avs::effects::filters::Convolution3x3>(); }, sharpen);
+
+  avs::core::ParamBlock blurBox;
+  blurBox.setInt("radius", 5);
+  cases.add("blur_box", [] { return std::make_unique<avs::effects::filters::BlurBox>(); }, blurBox);
+
+  avs::core::ParamBlock interferences;
+  interferences.setInt("amplitude", 80);
+  interferences.setInt("noise", 20);
+  interferences.setInt("speed", 2);
+  interferences.setBool("vertical", true);
+  cases.add("interferences",
+            [] { return std::make_unique<avs::effects::filters::Interferences>(); }, interferences);
+
+  avs::core::ParamBlock grain;
+  grain.setInt("amount", 40);
+  cases.add("grain", [] { return std::make_unique<avs::effects::filters::Grain>(); }, grain);
+
+  avs::core::ParamBlock staticGrain;
+  staticGrain.setInt("amount", 25);
+  staticGrain.setBool("static", true);
+  staticGrain.setBool("monochrome", true);
+  cases.add("grain_static",
+            [] { return std::make_unique<avs::effects::filters::Grain>(); }, staticGrain);
+
+  avs::core::ParamBlock mosaic;
+  mosaic.setInt("quality", 9);
+  mosaic.setInt("quality_onbeat", 60);
+  mosaic.setInt("beat_duration", 3);
+  mosaic.setBool("onbeat", true);
+  mosaic.setBool("blendavg", true);
+  cases.add("mosaic", [] { return std::make_unique<avs::effects::trans::Mosaic>(); }, mosaic);
+
+  avs::core::ParamBlock blur;
+  blur.setInt("radius", 4);
+  blur.setInt("strength", 200);
+  cases.add("blur", [] { return std::make_unique<avs::effects::trans::R_Blur>(); }, blur);
+
+  avs::core::ParamBlock verticalBlur;
+  verticalBlur.setInt("radius", 6);
+  verticalBlur.setBool("horizontal", false);
+  cases.add("blur_vertical",
+            [] { return std::make_unique<avs::effects::trans::R_Blur>(); }, verticalBlur);
+
+  return cases;
+}
+
+smp_test::Scene makeScene() {
+  smp_test::Scene scene;
+  scene.width = kWidth;
+  scene.height = kHeight;
+  scene.frames = kFrames;
+  scene.seed = 1234;
+  scene.fill = fillPattern;
+  scene.beat = [](int frame) { return frame == 1; };
+  return scene;
+}
+
+}  // namespace
+
+TEST(HaloBandTest, SourceCoversRowsPlusClampedHalo) {
+  for (int threads = 1; threads <= 6; ++threads) {
+    for (int id = 0; id < threads; ++id) {
+      const auto band = avs::core::haloBand(kHeight, id, threads, 2);
+      EXPECT_EQ(band.source.begin, std::max(0, band.rows.begin - 2));
+      EXPECT_EQ(band.source.end, std::min(kHeight, band.rows.end + 2));
+    }
+  }
+  const auto whole = avs::core::haloBand(kHeight, 1, 3, avs::core::kWholeFrameHalo);
+  EXPECT_EQ(whole.source.begin, 0);
+  EXPECT_EQ(whole.source.end, kHeight);
+  EXPECT_TRUE(avs::core::haloBand(2, 3, 4, 1).rows.empty());
+}
+
+TEST(SmpNeighborhoodEffects, ThreadedOutputMatchesSingleThreaded) {
+  smp_test::expectThreadedMatchesSingleThreaded(makeCases(), makeScene());
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <avs/core/ParamBlock.hpp>
+#include <avs/core/RowBand.hpp>
+#include <avs/effects/filters/effect_fast_brightness.h>
+#include <avs/effects/trans/effect_brightness.h>
+#include <avs/effects/trans/effect_channel_shift.h>
+#include <avs/effects/trans/effect_color_clip.h>
+#include <avs/effects/trans/effect_color_modifier.h>
+#include <avs/effects/trans/effect_color_reduction.h>
+#include <avs/effects/trans/effect_colorfade.h>
+#include <avs/effects/trans/effect_invert.h>
+#include <avs/effects/trans/effect_multiplier.h>
+#include <avs/effects/trans/effect_unique_tone.h>
+#include "smp_harness.hpp"
+
+namespace {
+
+constexpr int kWidth = 37;
+constexpr int kHeight = 29;
+constexpr int kFrames = 4;
+
+void fillPattern(std::vector<std::uint8_t>& pixels, int /* frame */) {
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      const std::size_t index = (static_cast<std::size_t>(y) * kWidth + static_cast<std::size_t>(x)) * 4u;
+      pixels[index + 0] = static_cast<std::uint8_t>((x * 31 + y * 7) & 0xFF);
+      pixels[index + 1] = static_cast<std::uint8_t>((x * 13 + y * 47 + 90) & 0xFF);
+      pixels[index + 2] = static_cast<std::uint8_t>((x * 5 + y * 19 + 200) & 0xFF);
+      pixels[index + 3] = static_cast<std::uint8_t>((x + y) & 0xFF);
+    }
+  }
+}
+
+smp_test::CaseList makeCases() {
+  smp_test::CaseList cases;
+
+  avs::core::ParamBlock colorModifier;
+  colorModifier.setInt("mode", 3);
+  cases.add("color_modifier",
+            [] { return std::make_unique<avs::effects::trans::ColorModifier>(); }, colorModifier);
+
+  avs::core::ParamBlock uniqueTone;
+  uniqueTone.setInt("color", 0x3080F0);
+  uniqueTone.setBool("blendavg", true);
+  cases.add("unique_tone",
+            [] { return std::make_unique<avs::effects::trans::UniqueTone>(); }, uniqueTone);
+
+  avs::core::ParamBlock brightness;
+  brightness.setInt("redp", 1024);
+  brightness.setInt("greenp", -2048);
+  brightness.setInt("bluep", 512);
+  brightness.setBool("exclude", true);
+  brightness.setInt("color", 0x404040);
+  brightness.setInt("distance", 40);
+  cases.add("brightness",
+            [] { return std::make_unique<avs::effects::trans::Brightness>(); }, brightness);
+
+  avs::core::ParamBlock fastBrightness;
+  fastBrightness.setFloat("amount", 1.7f);
+  fastBrightness.setFloat("bias", -12.0f);
+  cases.add("fast_brightness",
+            [] { return std::make_unique<avs::effects::filters::FastBrightness>(); },
+            fastBrightness);
+
+  avs::core::ParamBlock multiplier;
+  multiplier.setFloat("factor_r", 1.5f);
+  multiplier.setFloat("factor_b", 0.25f);
+  cases.add("multiplier",
+            [] { return std::make_unique<avs::effects::trans::Multiplier>(); }, multiplier);
+
+  cases.add("invert", [] { return std::make_unique<avs::effects::trans::InvertEffect>(); });
+
+  avs::core::ParamBlock colorClip;
+  colorClip.setInt("color", 0x607080);
+  cases.add("color_clip",
+            [] { return std::make_unique<avs::effects::trans::ColorClip>(); }, colorClip);
+
+  avs::core::ParamBlock colorReduction;
+  colorReduction.setInt("levels", 3);
+  cases.add("color_reduction",
+            [] { return std::make_unique<avs::effects::trans::ColorReduction>(); }, colorReduction);
+
+  avs::core::ParamBlock colorfade;
+  colorfade.setInt("flags", 1 | 2 | 4);
+  cases.add("colorfade",
+            [] { return std::make_unique<avs::effects::trans::Colorfade>(); }, colorfade);
+
+  avs::core::ParamBlock channelShift;
+  channelShift.setString("mode", "gbr");
+  channelShift.setBool("onbeat", true);
+  cases.add("channel_shift",
+            [] { return std::make_unique<avs::effects::trans::ChannelShift>(); }, channelShift);
+
+  return cases;
+}
+
+smp_test::Scene makeScene() {
+  smp_test::Scene scene;
+  scene.width = kWidth;
+  scene.height = kHeight;
+  scene.frames = kFrames;
+  scene.seed = 99;
+  scene.fill = fillPattern;
+  scene.beat = [](int frame) { return (frame % 2) == 1; };
+  return scene;
+}
+
+}  // namespace
+
+TEST(RowBandTest, BandsCoverRowsExactlyOnce) {
+  for (int threads = 1; threads <= 9; ++threads) {
+    int expectedBegin = 0;
+    for (int id = 0; id < threads; ++id) {
+      const auto band = avs::core::rowBand(kHeight, id, threads);
+      EXPECT_EQ(band.begin, expectedBegin);
+      EXPECT_LE(band.end - band.begin, kHeight / threads + 1);
+      expectedBegin = band.end;
+    }
+    EXPECT_EQ(expectedBegin, kHeight);
+  }
+}
+
+TEST(RowBandTest, LastBandAbsorbsTrailingPixels) {
+  const std::size_t pixelCount = static_cast<std::size_t>(kWidth) * kHeight + 3u;
+  const auto last = avs::core::rowBandPixels(pixelCount, kWidth, kHeight, 3, 4);
+  EXPECT_EQ(last.end, pixelCount);
+  const auto single = avs::core::rowBandPixels(pixelCount, 0, 0, 0, 1);
+  EXPECT_EQ(single.begin, 0u);
+  EXPECT_EQ(single.end, pixelCount);
+}
+
+TEST(SmpPointwiseEffects, ThreadedOutputMatchesSingleThreaded) {
+  smp_test::expectThreadedMatchesSingleThreaded(makeCases(), makeScene());
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <avs/core/EffectRegistry.hpp>
+#include <avs/core/ParamBlock.hpp>
+#include <avs/core/Pipeline.hpp>
+#include <avs/core/RenderContext.hpp>
+#include <avs/effects/dynamic/dyn_movement.h>
+#include <avs/effects/dynamic/movement.h>
+#include <avs/effects/dynamic/zoom_rotate.h>
+#include <avs/effects/trans/effect_blitter_feedback.h>
+#include <avs/effects/trans/effect_roto_blitter.h>
+#include <avs/effects/trans/effect_water_bump.h>
+#include "smp_harness.hpp"
+
+namespace {
+
+constexpr int kWidth = 45;
+constexpr int kHeight = 33;
+constexpr int kFrames = 5;
+
+void fillPattern(std::vector<std::uint8_t>& pixels, int frame) {
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      const std::size_t index = (static_cast<std::size_t>(y) * kWidth + static_cast<std::size_t>(x)) * 4u;
+      pixels[index + 0] = static_cast<std::uint8_t>((x * 17 + y * 3 + frame * 40) & 0xFF);
+      pixels[index + 1] = static_cast<std::uint8_t>((x * 5 + y * 23 + 60) & 0xFF);
+      pixels[index + 2] = static_cast<std::uint8_t>(((x ^ y) * 9 + frame) & 0xFF);
+      pixels[index + 3] = 255u;
+    }
+  }
+}
+
+smp_test::CaseList makeCases() {
+  smp_test::CaseList cases;
+
+  avs::core::ParamBlock movement;
+  movement.setFloat("scale", 1.3f);
+  movement.setFloat("rotate", 17.0f);
+  movement.setFloat("offset_x", 0.1f);
+  movement.setBool("wrap", true);
+  cases.add("movement", [] { return std::make_unique<avs::effects::MovementEffect>(); }, movement);
+
+  avs::core::ParamBlock zoomRotate;
+  zoomRotate.setFloat("zoom", 0.8f);
+  zoomRotate.setFloat("rotate", -33.0f);
+  zoomRotate.setFloat("anchor_x", 0.3f);
+  cases.add("zoom_rotate",
+            [] { return std::make_unique<avs::effects::ZoomRotateEffect>(); }, zoomRotate);
+
+  avs::core::ParamBlock dynMovement;
+  dynMovement.setString("frame", "t = t + 0.1;");
+  dynMovement.setString("pixel", "x = x * 0.9 + sin(y * 3 + t) * 0.05; y = y * 0.95;");
+  cases.add("dyn_movement",
+            [] { return std::make_unique<avs::effects::DynamicMovementEffect>(); }, dynMovement);
+
+  avs::core::ParamBlock blitterFeedback;
+  blitterFeedback.setBool("mirror_x", true);
+  blitterFeedback.setInt("rotate", 1);
+  cases.add("blitter_feedback",
+            [] { return std::make_unique<avs::effects::trans::BlitterFeedback>(); },
+            blitterFeedback);
+
+  avs::core::ParamBlock rotoBlitter;
+  rotoBlitter.setInt("zoom", 40);
+  rotoBlitter.setInt("zoom_beat", 20);
+  rotoBlitter.setBool("beat_zoom", true);
+  rotoBlitter.setBool("beat_reverse", true);
+  rotoBlitter.setInt("rotation", 40);
+  rotoBlitter.setBool("blend", true);
+  cases.add("roto_blitter",
+            [] { return std::make_unique<avs::effects::trans::RotoBlitter>(); }, rotoBlitter);
+
+  avs::core::ParamBlock waterBump;
+  waterBump.setInt("drop_radius", 12);
+  waterBump.setInt("depth", 900);
+  waterBump.setBool("random_drop", true);
+  cases.add("water_bump",
+            [] { return std::make_unique<avs::effects::trans::WaterBump>(); }, waterBump);
+
+  return cases;
+}
+
+smp_test::Scene makeScene() {
+  smp_test::Scene scene;
+  scene.width = kWidth;
+  scene.height = kHeight;
+  scene.frames = kFrames;
+  scene.seed = 7;
+  scene.fill = fillPattern;
+  // Fresh input each frame so the output depends on the stored history.
+  scene.refillEachFrame = true;
+  scene.beat = [](int frame) { return (frame % 2) == 0; };
+  scene.deltaSeconds = 1.0 / 60.0;
+  return scene;
+}
+
+}  // namespace
+
+TEST(SmpWarpEffects, ThreadedOutputMatchesSingleThreaded) {
+  smp_test::expectThreadedMatchesSingleThreaded(makeCases(), makeScene());
+}
+
+TEST(SmpWarpEffects, FailedScriptHaltsPipeline) {
+  avs::core::EffectRegistry registry;
+  registry.registerFactory("dyn_movement",
+                           [] { return std::make_unique<avs::effects::DynamicMovementEffect>(); });
+  avs::core::Pipeline pipeline(registry, 4);
+  pipeline.setAutoThreading(false);
+  avs::core::ParamBlock params;
+  params.setString("pixel", "x = (;");
+  pipeline.add("dyn_movement", params);
+
+  std::vector<std::uint8_t> pixels(static_cast<std::size_t>(kWidth) * kHeight * 4u);
+  fillPattern(pixels, 0);
+  const auto before = pixels;
+  avs::core::RenderContext context{};
+  context.width = kWidth;
+  context.height = kHeight;
+  context.framebuffer = {pixels.data(), pixels.size()};
+  EXPECT_FALSE(pipeline.render(context));
+  EXPECT_EQ(before, pixels);
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <avs/core/EffectRegistry.hpp>
+#include <avs/core/IEffect.hpp>
+#include <avs/core/ParamBlock.hpp>
+#include <avs/core/Pipeline.hpp>
+#include <avs/core/RenderContext.hpp>
+#include <avs/core/TaskCostModel.hpp>
+
+namespace {
+
+using avs::core::TaskCostModel;
+
+// Spends a fixed amount of time per frame, split evenly across its bands.
+class SleepingEffect : public avs::core::IEffect {
+ public:
+  explicit SleepingEffect(std::chrono::microseconds frameCost) : frameCost_(frameCost) {}
+
+  bool render(avs::core::RenderContext&) override {
+    std::this_thread::sleep_for(frameCost_);
+    return true;
+  }
+  bool smp_render(avs::core::RenderContext&, int, int maxThreads) override {
+    std::this_thread::sleep_for(frameCost_ / maxThreads);
+    return true;
+  }
+  bool supportsMultiThreaded() const override { return true; }
+  void setParams(const avs::core::ParamBlock&) override {}
+
+ private:
+  std::chrono::microseconds frameCost_;
+};
+
+avs::core::NodeProfile renderSleeping(std::chrono::microseconds frameCost, int width, int height,
+                                      int frames) {
+  avs::core::EffectRegistry registry;
+  registry.registerFactory("sleep", [frameCost] { return std::make_unique<SleepingEffect>(frameCost); });
+  avs::core::Pipeline pipeline(registry, 4);
+  pipeline.add("sleep", avs::core::ParamBlock{});
+  pipeline.setProfilingEnabled(true);
+
+  std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * height * 4u);
+  avs::core::RenderContext context{};
+  context.width = width;
+  context.height = height;
+  context.framebuffer = {pixels.data(), pixels.size()};
+  for (int frame = 0; frame < frames; ++frame) {
+    context.frameIndex = static_cast<std::uint64_t>(frame);
+    EXPECT_TRUE(pipeline.render(context));
+  }
+  return pipeline.profile().nodes.at(0);
+}
+
+}  // namespace
+
+TEST(TaskCostModelTest, UncalibratedNodesRenderSerially) {
+  const TaskCostModel model;
+  const TaskCostModel::Decision decision = model.decide(0, 1920u * 1080u, 8);
+  EXPECT_EQ(decision.threads, 1);
+  EXPECT_EQ(decision.tasks, 1);
+  EXPECT_EQ(decision.nsPerPixel, 0.0);
+}
+
+TEST(TaskCostModelTest, ThreadsOnlyWhenWorkOutweighsDispatch) {
+  TaskCostModel::Config config;
+  config.initialDispatchUs = 30.0;
+  config.minTaskUs = 20.0;
+  config.minPixelsPerTask = 4096;
+  config.tasksPerThread = 4;
+  TaskCostModel model(config);
+
+  // 2 ns per pixel: 64x64 is 8 us of work, 1080p about 4 ms.
+  model.observeWork(0, 64u * 64u, 8.192);
+  EXPECT_EQ(model.decide(0, 64u * 64u, 8).threads, 1);
+
+  model.observeWork(1, 1920u * 1080u, 4147.2);
+  const TaskCostModel::Decision large = model.decide(1, 1920u * 1080u, 8);
+  EXPECT_EQ(large.threads, 8);
+  EXPECT_EQ(large.tasks, 32);
+  EXPECT_NEAR(large.nsPerPixel, 2.0, 1e-9);
+
+  // 320x240 at 2 ns is 154 us: enough for a few threads, each task still
+  // covering at least minPixelsPerTask.
+  const TaskCostModel::Decision medium = model.decide(1, 320u * 240u, 8);
+  EXPECT_EQ(medium.threads, 5);
+  EXPECT_EQ(medium.tasks, 7);
+  EXPECT_GE(320u * 240u / static_cast<unsigned>(medium.tasks), config.minPixelsPerTask);
+}
+
+TEST(TaskCostModelTest, SlowDispatchRaisesTheThreshold) {
+  TaskCostModel model;
+  model.observeWork(0, 640u * 480u, 600.0);
+  const int before = model.decide(0, 640u * 480u, 8).threads;
+  for (int i = 0; i < 40; ++i) {
+    model.observeDispatch(250.0);
+  }
+  EXPECT_NEAR(model.dispatchUs(), 250.0, 1.0);
+  EXPECT_LT(model.decide(0, 640u * 480u, 8).threads, before);
+}
+
+TEST(TaskCostModelTest, KeepsEstimatesPerFrameSize) {
+  TaskCostModel model;
+  model.observeWork(0, 1000u, 1.0);    // 1 ns per pixel
+  model.observeWork(0, 100000u, 300.0);  // 3 ns per pixel
+  EXPECT_NEAR(model.nsPerPixel(0, 1000u), 1.0, 1e-9);
+  EXPECT_NEAR(model.nsPerPixel(0, 100000u), 3.0, 1e-9);
+  // An unseen size borrows the latest estimate until it is measured itself.
+  EXPECT_NEAR(model.nsPerPixel(0, 5000u), 3.0, 1e-9);
+  EXPECT_EQ(model.nsPerPixel(1, 1000u), 0.0);
+
+  model.clear();
+  EXPECT_EQ(model.nsPerPixel(0, 1000u), 0.0);
+}
+
+TEST(TaskCostModelTest, NewSizeEvictsTheLeastRecentlyObserved) {
+  TaskCostModel model;
+  // Four sizes fill the table; the first keeps being refreshed.
+  for (std::size_t pixels : {1000u, 2000u, 3000u, 4000u}) {
+    model.observeWork(0, pixels, static_cast<double>(pixels) / 1000.0);
+  }
+  for (int frame = 0; frame < 3; ++frame) {
+    model.observeWork(0, 1000u, 1.0);
+    model.observeWork(0, 5000u + static_cast<std::size_t>(frame) * 1000u, 30.0);
+  }
+  // 5000, 6000 and 7000 replaced 2000, 3000 and 4000; the refreshed size and the newer ones stay.
+  EXPECT_NEAR(model.nsPerPixel(0, 1000u), 1.0, 1e-9);
+  for (std::size_t pixels : {5000u, 6000u, 7000u}) {
+    EXPECT_NEAR(model.nsPerPixel(0, pixels), 30000.0 / static_cast<double>(pixels), 1e-9);
+  }
+  // Evicted sizes fall back to the latest estimate.
+  EXPECT_NEAR(model.nsPerPixel(0, 2000u), 30000.0 / 7000.0, 1e-9);
+}
+
+TEST(TaskCostModelTest, PipelineThreadsExpensiveNodesAndReportsTheDecision) {
+  const avs::core::NodeProfile node = renderSleeping(std::chrono::microseconds(4000), 256, 256, 3);
+  EXPECT_TRUE(node.lastSmp);
+  EXPECT_EQ(node.lastThreads, 4);
+  EXPECT_EQ(node.lastTasks, 16);
+  EXPECT_GT(node.costNsPerPixel, 10.0);
+}
+
+TEST(TaskCostModelTest, PipelineKeepsSmallFramesOnTheCallingThread) {
+  const avs::core::NodeProfile node = renderSleeping(std::chrono::microseconds(200), 64, 64, 3);
+  EXPECT_FALSE(node.lastSmp);
+  EXPECT_EQ(node.lastThreads, 1);
+  EXPECT_EQ(node.lastTasks, 1);
+  EXPECT_GT(node.costNsPerPixel, 0.0);
+}
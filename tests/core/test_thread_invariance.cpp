@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <avs/core/DeterministicRng.hpp>
+#include <avs/core/EffectRegistry.hpp>
+#include <avs/core/ParamBlock.hpp>
+#include <avs/core/Pipeline.hpp>
+#include <avs/core/RenderContext.hpp>
+#include <avs/effects/filters/effect_grain.h>
+#include <avs/effects/filters/effect_interferences.h>
+#include <avs/effects/trans/effect_channel_shift.h>
+#include <avs/effects/trans/effect_colorfade.h>
+#include <avs/effects/trans/effect_scatter.h>
+#include <avs/effects/trans/effect_water_bump.h>
+
+namespace {
+
+constexpr int kWidth = 211;
+constexpr int kHeight = 173;
+constexpr int kFrames = 4;
+
+std::vector<std::uint8_t> makePattern() {
+  std::vector<std::uint8_t> pixels(static_cast<std::size_t>(kWidth) * kHeight * 4u);
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      const std::size_t index = (static_cast<std::size_t>(y) * kWidth + static_cast<std::size_t>(x)) * 4u;
+      pixels[index + 0] = static_cast<std::uint8_t>((x * 29 + y * 3) & 0xFF);
+      pixels[index + 1] = static_cast<std::uint8_t>((x * 7 + y * 37 + 40) & 0xFF);
+      pixels[index + 2] = static_cast<std::uint8_t>((x ^ y) & 0xFF);
+      pixels[index + 3] = 0xFF;
+    }
+  }
+  return pixels;
+}
+
+// Every effect that draws random numbers, in a chain long enough that later
+// effects would see a different sequence if earlier ones consumed more draws.
+std::vector<std::vector<std::uint8_t>> renderChain(int threads) {
+  avs::core::EffectRegistry registry;
+  registry.registerFactory("scatter", [] { return std::make_unique<avs::effects::trans::Scatter>(); });
+  registry.registerFactory("grain", [] { return std::make_unique<avs::effects::filters::Grain>(); });
+  registry.registerFactory("interferences",
+                           [] { return std::make_unique<avs::effects::filters::Interferences>(); });
+  registry.registerFactory("channel_shift",
+                           [] { return std::make_unique<avs::effects::trans::ChannelShift>(); });
+  registry.registerFactory("colorfade", [] { return std::make_unique<avs::effects::trans::Colorfade>(); });
+  registry.registerFactory("water_bump", [] { return std::make_unique<avs::effects::trans::WaterBump>(); });
+
+  avs::core::Pipeline pipeline(registry, threads);
+  pipeline.setAutoThreading(false);
+  pipeline.add("scatter", avs::core::ParamBlock{});
+
+  avs::core::ParamBlock grain;
+  grain.setInt("amount", 40);
+  pipeline.add("grain", grain);
+
+  avs::core::ParamBlock staticGrain;
+  staticGrain.setInt("amount", 12);
+  staticGrain.setBool("monochrome", true);
+  staticGrain.setBool("static", true);
+  staticGrain.setInt("seed", 5);
+  pipeline.add("grain", staticGrain);
+
+  avs::core::ParamBlock interferences;
+  interferences.setInt("noise", 24);
+  pipeline.add("interferences", interferences);
+
+  avs::core::ParamBlock channelShift;
+  channelShift.setBool("onbeat", true);
+  pipeline.add("channel_shift", channelShift);
+
+  avs::core::ParamBlock colorfade;
+  colorfade.setInt("flags", 1 | 2 | 4);
+  pipeline.add("colorfade", colorfade);
+
+  pipeline.add("water_bump", avs::core::ParamBlock{});
+
+  std::vector<std::uint8_t> pixels = makePattern();
+  avs::core::RenderContext context{};
+  context.width = kWidth;
+  context.height = kHeight;
+  context.framebuffer = {pixels.data(), pixels.size()};
+  context.rng = avs::core::DeterministicRng(11);
+
+  std::vector<std::vector<std::uint8_t>> frames;
+  for (int frame = 0; frame < kFrames; ++frame) {
+    context.frameIndex = static_cast<std::uint64_t>(frame);
+    context.audioBeat = (frame % 2) == 0;
+    EXPECT_TRUE(pipeline.render(context));
+    frames.push_back(pixels);
+  }
+  return frames;
+}
+
+}  // namespace
+
+TEST(DeterministicRngTest, StreamIgnoresSequentialDraws) {
+  avs::core::DeterministicRng fresh(42);
+  fresh.reseed(3, 2);
+  avs::core::DeterministicRng drained(42);
+  drained.reseed(3, 2);
+  for (int i = 0; i < 17; ++i) {
+    (void)drained.nextUint32();
+  }
+  const auto expected = fresh.stream();
+  const auto actual = drained.stream();
+  for (std::uint64_t index = 0; index < 64; ++index) {
+    EXPECT_EQ(actual.at(index), expected.at(index));
+  }
+  EXPECT_NE(fresh.stream(1).at(0), expected.at(0));
+}
+
+TEST(DeterministicRngTest, EffectIndexSeparatesSequences) {
+  avs::core::DeterministicRng first(42);
+  first.reseed(5);
+  avs::core::DeterministicRng explicitZero(42);
+  explicitZero.reseed(5, 0);
+  avs::core::DeterministicRng second(42);
+  second.reseed(5, 1);
+
+  const std::uint32_t value = first.nextUint32();
+  EXPECT_EQ(explicitZero.nextUint32(), value);
+  EXPECT_NE(second.nextUint32(), value);
+  EXPECT_NE(first.stream().at(0), second.stream().at(0));
+}
+
+TEST(DeterministicRngTest, RangeAtStaysInBounds) {
+  const avs::core::RandomStream stream(0x1234);
+  for (std::uint64_t index = 0; index < 4096; ++index) {
+    const int value = stream.rangeAt(index, -7, 7);
+    EXPECT_GE(value, -7);
+    EXPECT_LE(value, 7);
+  }
+}
+
+TEST(ThreadInvariance, RandomEffectsRenderIdenticallyAtAnyThreadCount) {
+  const auto reference = renderChain(1);
+  for (int threads : {2, 4, 8}) {
+    SCOPED_TRACE(threads);
+    const auto frames = renderChain(threads);
+    ASSERT_EQ(frames.size(), reference.size());
+    for (std::size_t frame = 0; frame < reference.size(); ++frame) {
+      EXPECT_EQ(frames[frame], reference[frame]) << "frame " << frame;
+    }
+  }
+}
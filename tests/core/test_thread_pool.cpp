@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <latch>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <signal.h>
+#endif
+
+#include <avs/core/ThreadPool.hpp>
+#include <avs/thread_placement.hpp>
+
+TEST(ThreadPoolTest, EveryTaskRunsExactlyOnce) {
+  for (int threads : {1, 2, 3, 8}) {
+    SCOPED_TRACE(threads);
+    avs::core::ThreadPool pool(threads);
+    for (int taskCount : {0, 1, 2, 7, 64, 1000}) {
+      SCOPED_TRACE(taskCount);
+      std::vector<std::atomic<int>> hits(static_cast<std::size_t>(taskCount));
+      std::atomic<bool> workerInRange{true};
+      pool.parallelFor(taskCount, [&](int task, int worker) {
+        hits[static_cast<std::size_t>(task)].fetch_add(1);
+        if (worker < 0 || worker >= pool.getThreadCount()) {
+          workerInRange = false;
+        }
+      });
+      EXPECT_TRUE(workerInRange);
+      for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+      }
+    }
+  }
+}
+
+TEST(ThreadPoolTest, RepeatedDispatchesComplete) {
+  avs::core::ThreadPool pool(4);
+  std::atomic<long> total{0};
+  for (int dispatch = 0; dispatch < 2000; ++dispatch) {
+    pool.parallelFor(16, [&](int task, int) { total.fetch_add(task); });
+  }
+  EXPECT_EQ(total.load(), 2000L * (15 * 16 / 2));
+}
+
+TEST(ThreadPoolTest, IdleWorkersStealFromSlowRange) {
+  avs::core::ThreadPool pool(4);
+  std::vector<std::atomic<int>> workerForTask(32);
+  // Worker 0's initial slice is tasks 0-7; make them slow so others steal.
+  pool.parallelFor(32, [&](int task, int worker) {
+    if (task < 8) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    workerForTask[static_cast<std::size_t>(task)] = worker;
+  });
+  bool stolen = false;
+  for (int task = 0; task < 8; ++task) {
+    stolen = stolen || workerForTask[static_cast<std::size_t>(task)].load() != 0;
+  }
+  EXPECT_TRUE(stolen);
+}
+
+TEST(ThreadPoolTest, ExecuteShimPassesEveryThreadId) {
+  avs::core::ThreadPool pool(3);
+  std::vector<std::atomic<int>> hits(3);
+  std::atomic<bool> countMatches{true};
+  pool.execute([&](int threadId, int maxThreads) {
+    hits[static_cast<std::size_t>(threadId)].fetch_add(1);
+    if (maxThreads != 3) {
+      countMatches = false;
+    }
+  });
+  EXPECT_TRUE(countMatches);
+  for (const auto& hit : hits) {
+    EXPECT_EQ(hit.load(), 1);
+  }
+}
+
+TEST(ThreadPoolTest, PinsEachWorkerToOneCpuOfThePlacement) {
+  const std::vector<int> cpus = avs::availableCpus();
+  avs::ThreadPlacement placement;
+  placement.cpus = cpus;
+  avs::core::ThreadPool pool(3, placement);
+  const auto& placed = pool.workerPlacements();
+  ASSERT_EQ(placed.size(), 2u);
+  for (std::size_t i = 0; i < placed.size(); ++i) {
+    EXPECT_TRUE(placed[i].refused.empty());
+    EXPECT_EQ(placed[i].cpus, std::vector<int>{cpus[(i + 1) % cpus.size()]});
+  }
+  std::atomic<int> total{0};
+  pool.parallelFor(8, [&](int task, int) { total.fetch_add(task); });
+  EXPECT_EQ(total.load(), 28);
+}
+
+TEST(ThreadPlacementTest, ParsesAndFormatsCpuLists) {
+  EXPECT_EQ(avs::parseCpuList("0-3,6"), (std::vector<int>{0, 1, 2, 3, 6}));
+  EXPECT_EQ(avs::parseCpuList("5,2,2"), (std::vector<int>{2, 5}));
+  for (const char* bad : {"", "a", "3-1", "1,", "-2", "1--2"}) {
+    EXPECT_FALSE(avs::parseCpuList(bad).has_value()) << bad;
+  }
+  EXPECT_EQ(avs::formatCpuList({0, 1, 2, 3, 6, 8, 9}), "0-3,6,8-9");
+}
+
+TEST(ThreadPoolTest, WorkerLimitKeepsTasksOnTheFirstWorkers) {
+  avs::core::ThreadPool pool(4);
+  for (int limit : {0, 1, 2, 3, 4, 9}) {
+    SCOPED_TRACE(limit);
+    std::vector<std::atomic<int>> hits(40);
+    std::atomic<int> highestWorker{0};
+    pool.parallelFor(40, limit, [&](int task, int worker) {
+      hits[static_cast<std::size_t>(task)].fetch_add(1);
+      int seen = highestWorker.load();
+      while (worker > seen && !highestWorker.compare_exchange_weak(seen, worker)) {
+      }
+    });
+    for (const auto& hit : hits) {
+      EXPECT_EQ(hit.load(), 1);
+    }
+    EXPECT_LT(highestWorker.load(), std::max(1, std::min(limit, 4)));
+  }
+}
+
+#ifdef __linux__
+namespace {
+
+std::atomic<bool> workerStalled{false};
+std::atomic<bool> releaseWorker{false};
+
+// Holds whichever thread receives the signal until the test lets it go.
+void stallWorker(int) {
+  workerStalled = true;
+  while (!releaseWorker.load()) {
+  }
+}
+
+}  // namespace
+
+TEST(ThreadPoolTest, LimitedDispatchDoesNotWaitOnIdleWorkers) {
+  constexpr int kThreads = 4;
+  avs::core::ThreadPool pool(kThreads);
+
+  // One task per worker, each held until all have started, so none can steal
+  // and every worker reports its own thread.
+  std::vector<pthread_t> threads(kThreads);
+  std::latch started(kThreads);
+  pool.parallelFor(kThreads, [&](int, int worker) {
+    threads[static_cast<std::size_t>(worker)] = pthread_self();
+    started.arrive_and_wait();
+  });
+
+  struct sigaction action {};
+  struct sigaction previous {};
+  action.sa_handler = stallWorker;
+  sigemptyset(&action.sa_mask);
+  ASSERT_EQ(sigaction(SIGUSR1, &action, &previous), 0);
+  workerStalled = false;
+  releaseWorker = false;
+  ASSERT_EQ(pthread_kill(threads[kThreads - 1], SIGUSR1), 0);
+  while (!workerStalled.load()) {
+    std::this_thread::yield();
+  }
+
+  // The last worker is stuck; a two-worker job must not need it.
+  auto limited = std::async(std::launch::async, [&pool] {
+    std::atomic<int> total{0};
+    pool.parallelFor(64, 2, [&](int task, int) { total.fetch_add(task); });
+    return total.load();
+  });
+  const bool finished = limited.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+  releaseWorker = true;
+  EXPECT_TRUE(finished);
+  EXPECT_EQ(limited.get(), 63 * 64 / 2);
+  sigaction(SIGUSR1, &previous, nullptr);
+}
+#endif
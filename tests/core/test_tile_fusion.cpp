@@ -0,0 +1,337 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <avs/core/ChannelLut.hpp>
+#include <avs/core/EffectRegistry.hpp>
+#include <avs/core/ParamBlock.hpp>
+#include <avs/core/Pipeline.hpp>
+#include <avs/core/RenderContext.hpp>
+#include <avs/core/RowBand.hpp>
+#include <avs/effects/filters/effect_blur_box.h>
+#include <avs/effects/filters/effect_conv3x3.h>
+#include <avs/effects/filters/effect_fast_brightness.h>
+#include <avs/effects/filters/effect_grain.h>
+#include <avs/effects/trans/effect_blur.h>
+#include <avs/effects/trans/effect_brightness.h>
+#include <avs/effects/trans/effect_channel_shift.h>
+#include <avs/effects/trans/effect_color_modifier.h>
+#include <avs/effects/trans/effect_color_reduction.h>
+#include <avs/effects/trans/effect_colorfade.h>
+#include <avs/effects/trans/effect_invert.h>
+#include <avs/effects/trans/effect_mosaic.h>
+#include <avs/effects/trans/effect_multiplier.h>
+#include <avs/effects/trans/effect_unique_tone.h>
+
+namespace {
+
+// Large enough that a single-threaded run spans several cache-sized tiles.
+constexpr int kWidth = 211;
+constexpr int kHeight = 173;
+constexpr int kFrames = 4;
+
+struct Stage {
+  std::string name;
+  avs::core::EffectRegistry::Factory factory;
+  avs::core::ParamBlock params;
+};
+
+std::vector<Stage> makeChain() {
+  std::vector<Stage> chain;
+  auto add = [&chain](std::string name, avs::core::EffectRegistry::Factory factory,
+                      avs::core::ParamBlock params) {
+    chain.push_back(Stage{std::move(name), std::move(factory), std::move(params)});
+  };
+
+  avs::core::ParamBlock sharpen;
+  sharpen.setString("kernel", "0 -1 0 -1 5 -1 0 -1 0");
+  add("conv3x3", [] { return std::make_unique<avs::effects::filters::Convolution3x3>(); }, sharpen);
+
+  avs::core::ParamBlock brightness;
+  brightness.setInt("redp", 1024);
+  brightness.setInt("bluep", -512);
+  add("brightness", [] { return std::make_unique<avs::effects::trans::Brightness>(); }, brightness);
+
+  avs::core::ParamBlock grain;
+  grain.setInt("amount", 30);
+  add("grain", [] { return std::make_unique<avs::effects::filters::Grain>(); }, grain);
+
+  avs::core::ParamBlock blurBox;
+  blurBox.setInt("radius", 3);
+  add("blur_box", [] { return std::make_unique<avs::effects::filters::BlurBox>(); }, blurBox);
+
+  avs::core::ParamBlock channelShift;
+  channelShift.setBool("onbeat", true);
+  add("channel_shift", [] { return std::make_unique<avs::effects::trans::ChannelShift>(); },
+      channelShift);
+
+  add("invert", [] { return std::make_unique<avs::effects::trans::InvertEffect>(); },
+      avs::core::ParamBlock{});
+
+  avs::core::ParamBlock mosaic;
+  mosaic.setInt("quality", 20);
+  add("mosaic", [] { return std::make_unique<avs::effects::trans::Mosaic>(); }, mosaic);
+
+  avs::core::ParamBlock colorfade;
+  colorfade.setInt("flags", 1 | 2 | 4);
+  add("colorfade", [] { return std::make_unique<avs::effects::trans::Colorfade>(); }, colorfade);
+
+  avs::core::ParamBlock blur;
+  blur.setInt("radius", 5);
+  blur.setInt("strength", 180);
+  add("blur", [] { return std::make_unique<avs::effects::trans::R_Blur>(); }, blur);
+
+  avs::core::ParamBlock uniqueTone;
+  uniqueTone.setInt("color", 0x3080F0);
+  add("unique_tone", [] { return std::make_unique<avs::effects::trans::UniqueTone>(); },
+      uniqueTone);
+  return chain;
+}
+
+// Per-channel color effects that collapse into lookup tables, broken once by a
+// multiplier mode that mixes channels.
+std::vector<Stage> makeLutChain() {
+  std::vector<Stage> chain;
+  auto add = [&chain](std::string name, avs::core::EffectRegistry::Factory factory,
+                      avs::core::ParamBlock params) {
+    chain.push_back(Stage{std::move(name), std::move(factory), std::move(params)});
+  };
+
+  avs::core::ParamBlock colorModifier;
+  colorModifier.setInt("mode", 3);
+  add("color_modifier", [] { return std::make_unique<avs::effects::trans::ColorModifier>(); },
+      colorModifier);
+
+  avs::core::ParamBlock brightness;
+  brightness.setInt("redp", 2048);
+  brightness.setInt("greenp", -1024);
+  brightness.setBool("blend", true);
+  add("brightness", [] { return std::make_unique<avs::effects::trans::Brightness>(); }, brightness);
+
+  add("invert", [] { return std::make_unique<avs::effects::trans::InvertEffect>(); },
+      avs::core::ParamBlock{});
+
+  avs::core::ParamBlock infinity;
+  infinity.setInt("mode", 0);
+  add("multiplier_infinity", [] { return std::make_unique<avs::effects::trans::Multiplier>(); },
+      infinity);
+
+  avs::core::ParamBlock reduction;
+  reduction.setInt("levels", 4);
+  add("color_reduction", [] { return std::make_unique<avs::effects::trans::ColorReduction>(); },
+      reduction);
+
+  avs::core::ParamBlock scale;
+  scale.setFloat("factor_r", 1.25f);
+  scale.setFloat("factor_g", 0.5f);
+  add("multiplier_scale", [] { return std::make_unique<avs::effects::trans::Multiplier>(); }, scale);
+
+  avs::core::ParamBlock fastBrightness;
+  fastBrightness.setFloat("amount", 1.4f);
+  fastBrightness.setFloat("bias", -9.0f);
+  add("fast_brightness", [] { return std::make_unique<avs::effects::filters::FastBrightness>(); },
+      fastBrightness);
+  return chain;
+}
+
+std::vector<std::uint8_t> makePattern() {
+  std::vector<std::uint8_t> pixels(static_cast<std::size_t>(kWidth) * kHeight * 4u);
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      const std::size_t index = (static_cast<std::size_t>(y) * kWidth + static_cast<std::size_t>(x)) * 4u;
+      pixels[index + 0] = static_cast<std::uint8_t>((x * 23 + y * 5) & 0xFF);
+      pixels[index + 1] = static_cast<std::uint8_t>((x * 3 + y * 41 + 70) & 0xFF);
+      pixels[index + 2] = static_cast<std::uint8_t>((x * y + 120) & 0xFF);
+      pixels[index + 3] = 0xFF;
+    }
+  }
+  return pixels;
+}
+
+avs::core::RenderContext makeContext(std::vector<std::uint8_t>& pixels) {
+  avs::core::RenderContext context{};
+  context.width = kWidth;
+  context.height = kHeight;
+  context.framebuffer = {pixels.data(), pixels.size()};
+  context.rng = avs::core::DeterministicRng(7);
+  return context;
+}
+
+// Unfused reference: every effect sweeps the whole frame before the next one.
+std::vector<std::vector<std::uint8_t>> renderSequential(const std::vector<Stage>& chain) {
+  std::vector<std::unique_ptr<avs::core::IEffect>> effects;
+  for (const auto& stage : chain) {
+    effects.push_back(stage.factory());
+    effects.back()->setParams(stage.params);
+  }
+
+  std::vector<std::uint8_t> pixels = makePattern();
+  auto context = makeContext(pixels);
+  std::vector<std::vector<std::uint8_t>> frames;
+  for (int frame = 0; frame < kFrames; ++frame) {
+    context.frameIndex = static_cast<std::uint64_t>(frame);
+    context.audioBeat = (frame % 2) == 1;
+    // Each effect draws from its own stream, as the pipeline sets them up.
+    for (std::size_t index = 0; index < effects.size(); ++index) {
+      context.rng.reseed(context.frameIndex, index);
+      EXPECT_TRUE(effects[index]->render(context));
+    }
+    frames.push_back(pixels);
+  }
+  return frames;
+}
+
+std::vector<std::vector<std::uint8_t>> renderPipeline(const std::vector<Stage>& chain, int threads) {
+  avs::core::EffectRegistry registry;
+  avs::core::Pipeline pipeline(registry, threads);
+  pipeline.setAutoThreading(false);
+  for (const auto& stage : chain) {
+    registry.registerFactory(stage.name, stage.factory);
+    pipeline.add(stage.name, stage.params);
+  }
+
+  std::vector<std::uint8_t> pixels = makePattern();
+  auto context = makeContext(pixels);
+  std::vector<std::vector<std::uint8_t>> frames;
+  for (int frame = 0; frame < kFrames; ++frame) {
+    context.frameIndex = static_cast<std::uint64_t>(frame);
+    context.audioBeat = (frame % 2) == 1;
+    EXPECT_TRUE(pipeline.render(context));
+    frames.push_back(pixels);
+  }
+  return frames;
+}
+
+class RecordingEffect : public avs::core::IEffect {
+ public:
+  RecordingEffect(avs::core::AccessPattern::Kind kind, std::vector<std::string>& log, std::string name)
+      : kind_(kind), log_(log), name_(std::move(name)) {}
+
+  bool render(avs::core::RenderContext&) override {
+    log_.push_back(name_ + ":render");
+    return true;
+  }
+  int smp_begin(avs::core::RenderContext&, int maxThreads) override {
+    log_.push_back(name_ + ":begin");
+    return maxThreads;
+  }
+  bool smp_render(avs::core::RenderContext&, int threadId, int) override {
+    if (threadId == 0) {
+      log_.push_back(name_ + ":tile0");
+    }
+    return true;
+  }
+  bool smp_finish(avs::core::RenderContext&) override {
+    log_.push_back(name_ + ":finish");
+    return true;
+  }
+  bool supportsMultiThreaded() const override { return true; }
+  avs::core::AccessPattern accessPattern() const override { return {kind_, 0}; }
+  void setParams(const avs::core::ParamBlock&) override {}
+
+ private:
+  avs::core::AccessPattern::Kind kind_;
+  std::vector<std::string>& log_;
+  std::string name_;
+};
+
+}  // namespace
+
+TEST(TileFusion, FusedChainMatchesSequentialRender) {
+  const auto chain = makeChain();
+  const auto reference = renderSequential(chain);
+  for (int threads : {1, 2, 8}) {
+    SCOPED_TRACE(threads);
+    const auto fused = renderPipeline(chain, threads);
+    ASSERT_EQ(reference.size(), fused.size());
+    for (std::size_t frame = 0; frame < reference.size(); ++frame) {
+      EXPECT_EQ(reference[frame], fused[frame]) << "frame " << frame;
+    }
+  }
+}
+
+TEST(TileFusion, LutChainMatchesSequentialRender) {
+  const auto chain = makeLutChain();
+  const auto reference = renderSequential(chain);
+  for (int threads : {1, 4}) {
+    SCOPED_TRACE(threads);
+    const auto fused = renderPipeline(chain, threads);
+    ASSERT_EQ(reference.size(), fused.size());
+    for (std::size_t frame = 0; frame < reference.size(); ++frame) {
+      EXPECT_EQ(reference[frame], fused[frame]) << "frame " << frame;
+    }
+  }
+}
+
+TEST(ChannelLutTest, ComposesInApplicationOrder) {
+  avs::core::ChannelLut first;
+  first.fill([](int channel, std::uint8_t value) { return static_cast<std::uint8_t>(value + channel); });
+  avs::core::ChannelLut second;
+  second.fill([](int, std::uint8_t value) { return static_cast<std::uint8_t>(value * 2); });
+  first.then(second);
+
+  std::uint8_t pixel[4] = {10, 20, 30, 40};
+  first.apply(pixel, 0, 1);
+  EXPECT_EQ(pixel[0], 20);
+  EXPECT_EQ(pixel[1], 42);
+  EXPECT_EQ(pixel[2], 64);
+  EXPECT_EQ(pixel[3], 40);
+}
+
+TEST(TileFusion, RunsBreakAtGlobalAndNeighborhoodEffects) {
+  using Kind = avs::core::AccessPattern::Kind;
+  std::vector<std::string> log;
+  avs::core::EffectRegistry registry;
+  registry.registerFactory("a", [&log] { return std::make_unique<RecordingEffect>(Kind::Pointwise, log, "a"); });
+  registry.registerFactory("b", [&log] { return std::make_unique<RecordingEffect>(Kind::Pointwise, log, "b"); });
+  registry.registerFactory("g", [&log] { return std::make_unique<RecordingEffect>(Kind::Global, log, "g"); });
+  registry.registerFactory("n",
+                           [&log] { return std::make_unique<RecordingEffect>(Kind::Neighborhood, log, "n"); });
+
+  avs::core::Pipeline pipeline(registry);
+  for (const char* key : {"a", "b", "g", "n", "a"}) {
+    pipeline.add(key, avs::core::ParamBlock{});
+  }
+
+  std::vector<std::uint8_t> pixels(static_cast<std::size_t>(kWidth) * kHeight * 4u);
+  auto context = makeContext(pixels);
+  ASSERT_TRUE(pipeline.render(context));
+
+  const std::vector<std::string> expected = {
+      "a:begin",  "b:begin",  "a:tile0", "b:tile0",  "a:finish", "b:finish",
+      "g:render", "n:begin",  "a:begin", "n:tile0",  "a:tile0",  "n:finish", "a:finish"};
+  EXPECT_EQ(log, expected);
+}
+
+TEST(TileFusion, ProfilingAttributesFusedRunToEveryMember) {
+  const auto chain = makeLutChain();
+  avs::core::EffectRegistry registry;
+  avs::core::Pipeline pipeline(registry, 4);
+  pipeline.setAutoThreading(false);
+  for (const auto& stage : chain) {
+    registry.registerFactory(stage.name, stage.factory);
+    pipeline.add(stage.name, stage.params);
+  }
+  pipeline.setProfilingEnabled(true);
+
+  std::vector<std::uint8_t> pixels = makePattern();
+  auto context = makeContext(pixels);
+  ASSERT_TRUE(pipeline.render(context));
+
+  const auto profile = pipeline.profile();
+  ASSERT_EQ(profile.nodes.size(), chain.size());
+  double nodeMs = 0.0;
+  for (const auto& node : profile.nodes) {
+    SCOPED_TRACE(node.key);
+    EXPECT_EQ(node.frames, 1u);
+    EXPECT_TRUE(node.lastFused);
+    EXPECT_TRUE(node.lastSmp);
+    EXPECT_EQ(node.lastPixels, static_cast<std::uint64_t>(kWidth) * kHeight);
+    nodeMs += node.lastMs;
+  }
+  EXPECT_LE(nodeMs, profile.frameP50Ms * 1.001 + 1e-6);
+}
@@ -81,6 +81,7 @@ std::vector<std::uint8_t> runReferenceScatter(const std::vector<std::uint8_t>& b
   auto offsets = buildOffsets(width);
   avs::core::DeterministicRng rng(seed);
   rng.reseed(frameIndex);
+  const avs::core::RandomStream stream = rng.stream();
 
   const auto* source = reinterpret_cast<const std::uint32_t*>(base.data());
   auto* dst = reinterpret_cast<std::uint32_t*>(result.data());
@@ -99,7 +100,7 @@ std::vector<std::uint8_t> runReferenceScatter(const std::vector<std::uint8_t>& b
         continue;
       }
 
-      const std::uint32_t randomValue = rng.nextUint32();
+      const std::uint32_t randomValue = stream.at(static_cast<std::uint64_t>(index));
       const int tableIndex = static_cast<int>(randomValue & kOffsetMask);
       int sampleIndex = index + offsets[tableIndex];
       sampleIndex = std::clamp(sampleIndex, 0, totalPixels - 1);
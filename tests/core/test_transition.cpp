@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <avs/core/DeterministicRng.hpp>
+#include <avs/core/Transition.hpp>
+
+namespace {
+
+using avs::core::TransitionMode;
+
+constexpr int kWidth = 36;
+constexpr int kHeight = 24;
+
+std::vector<std::uint8_t> solid(std::uint8_t value) {
+  return std::vector<std::uint8_t>(static_cast<std::size_t>(kWidth) * kHeight * 4u, value);
+}
+
+std::vector<std::uint8_t> composite(TransitionMode mode, const std::vector<std::uint8_t>& from,
+                                    const std::vector<std::uint8_t>& to, float progress,
+                                    std::uint32_t& blockMask, avs::core::DeterministicRng& rng) {
+  std::vector<std::uint8_t> out(from.size(), 7);
+  avs::core::compositeTransition(mode, {from.data(), to.data(), out.data(), kWidth, kHeight},
+                                 progress, blockMask, rng);
+  return out;
+}
+
+}  // namespace
+
+TEST(TransitionTest, EveryModeRunsFromOutgoingToIncoming) {
+  const std::vector<std::uint8_t> from = solid(10);
+  const std::vector<std::uint8_t> to = solid(200);
+  for (int m = 0; m < avs::core::kTransitionModeCount; ++m) {
+    const auto mode = static_cast<TransitionMode>(m);
+    std::uint32_t blockMask = 0;
+    avs::core::DeterministicRng rng(42);
+    std::vector<std::uint8_t> out;
+    for (int step = 0; step <= 36; ++step) {
+      out = composite(mode, from, to, static_cast<float>(step) / 36.0f, blockMask, rng);
+      if (step == 0 && mode != TransitionMode::kNineRandomBlocks) {
+        EXPECT_EQ(out, from) << "mode " << m;
+      }
+      if (step == 18) {
+        EXPECT_NE(out, from) << "mode " << m;
+        EXPECT_NE(out, to) << "mode " << m;
+      }
+    }
+    EXPECT_EQ(out, to) << "mode " << m;
+  }
+}
+
+TEST(TransitionTest, NineRandomBlocksIsDeterministic) {
+  const std::vector<std::uint8_t> from = solid(0);
+  const std::vector<std::uint8_t> to = solid(255);
+  std::uint32_t maskA = 0;
+  std::uint32_t maskB = 0;
+  avs::core::DeterministicRng rngA(7);
+  avs::core::DeterministicRng rngB(7);
+  for (int step = 0; step <= 9; ++step) {
+    const float progress = static_cast<float>(step) / 9.0f;
+    EXPECT_EQ(composite(TransitionMode::kNineRandomBlocks, from, to, progress, maskA, rngA),
+              composite(TransitionMode::kNineRandomBlocks, from, to, progress, maskB, rngB));
+  }
+  EXPECT_EQ(maskA & 0x1FFu, 0x1FFu);
+}
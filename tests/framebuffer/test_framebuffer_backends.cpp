@@ -1,3 +1,4 @@
+#include <avs/core/AlignedBuffer.hpp>
 #include <avs/core/IFramebuffer.hpp>
 #include <gtest/gtest.h>
 
@@ -68,7 +69,14 @@ TEST(CPUFramebuffer, ResizeChangesDimensions) {
 
   EXPECT_EQ(fb->width(), 200);
   EXPECT_EQ(fb->height(), 150);
-  EXPECT_EQ(fb->sizeBytes(), 200 * 150 * 4);
+  EXPECT_EQ(fb->stride(), 200u * 4u);
+  EXPECT_EQ(fb->sizeBytes(), 200u * 150u * 4u);
+
+  // Padded framebuffers keep padding their rows across resizes.
+  auto padded = createCPUFramebuffer(100, 100, /*padRows=*/true);
+  padded->resize(200, 150);
+  EXPECT_EQ(padded->stride(), alignedRowStride(200));
+  EXPECT_EQ(padded->sizeBytes(), padded->stride() * 150);
 }
 
 TEST(CPUFramebuffer, DirectDataAccessWorks) {
@@ -77,12 +85,15 @@ TEST(CPUFramebuffer, DirectDataAccessWorks) {
   uint8_t* data = fb->data();
   ASSERT_NE(data, nullptr);
 
-  // Write directly to buffer
-  for (int i = 0; i < 10 * 10 * 4; i += 4) {
-    data[i + 0] = 100;
-    data[i + 1] = 200;
-    data[i + 2] = 50;
-    data[i + 3] = 255;
+  // Write directly to buffer, one padded row at a time
+  for (int y = 0; y < 10; ++y) {
+    uint8_t* row = data + y * fb->stride();
+    for (int i = 0; i < 10 * 4; i += 4) {
+      row[i + 0] = 100;
+      row[i + 1] = 200;
+      row[i + 2] = 50;
+      row[i + 3] = 255;
+    }
   }
 
   // Verify via download
@@ -97,6 +108,54 @@ TEST(CPUFramebuffer, DirectDataAccessWorks) {
   }
 }
 
+TEST(CPUFramebuffer, RowsArePackedByDefault) {
+  auto fb = createCPUFramebuffer(37, 5);
+  EXPECT_EQ(fb->stride(), 37u * 4u);
+  EXPECT_EQ(fb->sizeBytes(), 37u * 5u * 4u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(fb->data()) % kCacheLineBytes, 0u);
+}
+
+TEST(CPUFramebuffer, RowsArePaddedToCacheLines) {
+  auto fb = createCPUFramebuffer(37, 5, /*padRows=*/true);
+  EXPECT_EQ(fb->stride() % kCacheLineBytes, 0u);
+  EXPECT_GE(fb->stride(), 37u * 4u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(fb->data()) % kCacheLineBytes, 0u);
+
+  // Packed uploads land row by row and come back packed.
+  std::vector<uint8_t> packed(37 * 5 * 4);
+  for (size_t i = 0; i < packed.size(); ++i) {
+    packed[i] = static_cast<uint8_t>(i * 7);
+  }
+  fb->upload(packed.data(), packed.size());
+  EXPECT_EQ(fb->data()[fb->stride()], packed[37 * 4]);
+
+  std::vector<uint8_t> downloaded(packed.size());
+  fb->download(downloaded.data(), downloaded.size());
+  EXPECT_EQ(downloaded, packed);
+}
+
+TEST(PixelBufferView, SubViewSharesParentRows) {
+  auto fb = createCPUFramebuffer(16, 8);
+  fb->clear(0, 0, 0, 0);
+  PixelBufferView parent = fb->view();
+  ASSERT_EQ(parent.rowStride(), fb->stride());
+
+  PixelBufferView tile = parent.subView(4, 2, 6, 3);
+  EXPECT_EQ(tile.width, 6);
+  EXPECT_EQ(tile.height, 3);
+  EXPECT_EQ(tile.rowStride(), parent.rowStride());
+  EXPECT_FALSE(tile.packed());
+  EXPECT_EQ(tile.data, parent.row(2) + 4 * 4);
+  tile.row(1)[0] = 42;
+  EXPECT_EQ(fb->data()[3 * fb->stride() + 4 * 4], 42);
+
+  // Rectangles are clipped to the parent.
+  PixelBufferView clipped = parent.subView(12, 6, 10, 10);
+  EXPECT_EQ(clipped.width, 4);
+  EXPECT_EQ(clipped.height, 2);
+  EXPECT_EQ(parent.subView(20, 0, 4, 4).data, nullptr);
+}
+
 // Test File Framebuffer PNG export
 TEST(FileFramebuffer, CreatesWithCorrectDimensions) {
   const char* tmpPath = "/tmp/test_frame.png";
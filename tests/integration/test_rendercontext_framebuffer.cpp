@@ -1,8 +1,16 @@
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <avs/core/EffectRegistry.hpp>
 #include <avs/core/IFramebuffer.hpp>
+#include <avs/core/Pipeline.hpp>
 #include <avs/core/RenderContext.hpp>
 #include <avs/effects/prime/Clear.hpp>
+#include <avs/effects/prime/Swizzle.hpp>
+#include <avs/effects/trans/effect_invert.h>
 
 namespace {
 
@@ -28,9 +36,8 @@ TEST(RenderContextFramebuffer, ClearEffectUsesFramebufferBackend) {
   context.deltaSeconds = 1.0 / 60.0;
   context.framebufferBackend = framebuffer.get();
 
-  // Also set legacy view for backward compatibility
-  context.framebuffer.data = framebuffer->data();
-  context.framebuffer.size = framebuffer->sizeBytes();
+  // Also set legacy view for backward compatibility; rows may be padded
+  context.framebuffer = framebuffer->view();
 
   // Verify initial state (red)
   const uint8_t* pixels = framebuffer->data();
@@ -106,4 +113,108 @@ TEST(RenderContextFramebuffer, BackendMetadataAccessible) {
   EXPECT_EQ(context.framebufferBackend->height(), 240);
 }
 
+// Padded rows at odd widths; effects on the backend must leave pixels where they were.
+TEST(RenderContextFramebuffer, OddWidthBackendKeepsPixelPositions) {
+  constexpr int kWidth = 321;
+  constexpr int kHeight = 7;
+  auto framebuffer = avs::core::createCPUFramebuffer(kWidth, kHeight, /*padRows=*/true);
+  ASSERT_GT(framebuffer->stride(), static_cast<size_t>(kWidth) * 4u);
+
+  auto pixelAt = [](int x, int y) {
+    return std::vector<std::uint8_t>{static_cast<std::uint8_t>(x & 0xFF),
+                                     static_cast<std::uint8_t>(y * 30),
+                                     static_cast<std::uint8_t>((x >> 8) + y * 2), 255};
+  };
+  std::vector<std::uint8_t> packed;
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      const auto pixel = pixelAt(x, y);
+      packed.insert(packed.end(), pixel.begin(), pixel.end());
+    }
+  }
+  framebuffer->upload(packed.data(), packed.size());
+
+  avs::core::RenderContext context{};
+  context.width = kWidth;
+  context.height = kHeight;
+  context.framebufferBackend = framebuffer.get();
+  context.framebuffer = framebuffer->view();
+
+  avs::effects::Swizzle swizzle;
+  avs::core::ParamBlock params;
+  params.setString("mode", "bgr");
+  swizzle.setParams(params);
+  ASSERT_TRUE(swizzle.render(context));
+  avs::effects::trans::InvertEffect invert;
+  ASSERT_TRUE(invert.render(context));
+
+  std::vector<std::uint8_t> result(packed.size());
+  framebuffer->download(result.data(), result.size());
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      const auto source = pixelAt(x, y);
+      const std::uint8_t* pixel = result.data() + (static_cast<size_t>(y) * kWidth + x) * 4u;
+      ASSERT_EQ(pixel[0], 255 - source[2]) << x << "," << y;
+      ASSERT_EQ(pixel[1], 255 - source[1]) << x << "," << y;
+      ASSERT_EQ(pixel[2], 255 - source[0]) << x << "," << y;
+      ASSERT_EQ(pixel[3], 255) << x << "," << y;
+    }
+  }
+}
+
+// The default CPU backend is packed, so the pipeline renders it at any width.
+TEST(RenderContextFramebuffer, PipelineRendersCpuBackendAtOddWidth) {
+  constexpr int kWidth = 321;
+  constexpr int kHeight = 7;
+  auto framebuffer = avs::core::createCPUFramebuffer(kWidth, kHeight);
+  ASSERT_EQ(framebuffer->stride(), static_cast<size_t>(kWidth) * 4u);
+  framebuffer->clear(10, 20, 30, 255);
+
+  avs::core::EffectRegistry registry;
+  registry.registerFactory("invert",
+                           [] { return std::make_unique<avs::effects::trans::InvertEffect>(); });
+  avs::core::Pipeline pipeline(registry);
+  pipeline.add("invert", avs::core::ParamBlock{});
+
+  avs::core::RenderContext context{};
+  context.width = kWidth;
+  context.height = kHeight;
+  context.framebufferBackend = framebuffer.get();
+  context.framebuffer.data = framebuffer->data();
+  context.framebuffer.size = framebuffer->sizeBytes();
+  ASSERT_TRUE(pipeline.render(context));
+
+  std::vector<std::uint8_t> result(static_cast<size_t>(kWidth) * kHeight * 4u);
+  framebuffer->download(result.data(), result.size());
+  for (size_t i = 0; i < result.size(); i += 4) {
+    ASSERT_EQ(result[i + 0], 245) << i / 4;
+    ASSERT_EQ(result[i + 1], 235) << i / 4;
+    ASSERT_EQ(result[i + 2], 225) << i / 4;
+    ASSERT_EQ(result[i + 3], 255) << i / 4;
+  }
+}
+
+// The pipeline indexes packed rows, so it refuses an opted-in padded frame rather than misrender it.
+TEST(RenderContextFramebuffer, PipelineRejectsPaddedFrame) {
+  auto framebuffer = avs::core::createCPUFramebuffer(321, 7, /*padRows=*/true);
+  framebuffer->clear(10, 20, 30, 255);
+
+  avs::core::EffectRegistry registry;
+  registry.registerFactory("invert",
+                           [] { return std::make_unique<avs::effects::trans::InvertEffect>(); });
+  avs::core::Pipeline pipeline(registry);
+  pipeline.add("invert", avs::core::ParamBlock{});
+
+  avs::core::RenderContext context{};
+  context.width = 321;
+  context.height = 7;
+  context.framebufferBackend = framebuffer.get();
+  context.framebuffer = framebuffer->view();
+  EXPECT_FALSE(pipeline.render(context));
+
+  const std::uint8_t* pixels = framebuffer->data();
+  EXPECT_EQ(pixels[0], 10);
+  EXPECT_EQ(pixels[framebuffer->stride() * 6 + 320 * 4 + 2], 30);
+}
+
 }  // namespace
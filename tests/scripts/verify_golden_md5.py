@@ -15,13 +15,14 @@ def parse_args() -> argparse.Namespace:
   parser.add_argument("--width", type=int, default=320)
   parser.add_argument("--height", type=int, default=240)
   parser.add_argument("--seed", type=int, default=1234)
+  parser.add_argument("--threads", type=int, default=1, help="Render threads; hashes must not change")
   parser.add_argument("--preset", help="Optional preset path")
   return parser.parse_args()
 
 
 def run_tool(binary: Path, args: argparse.Namespace) -> dict:
   cmd = [str(binary), "--frames", str(args.frames), "--width", str(args.width), "--height", str(args.height),
-         "--seed", str(args.seed)]
+         "--seed", str(args.seed), "--threads", str(args.threads)]
   if args.preset:
     cmd.extend(["--preset", args.preset])
   result = subprocess.run(cmd, check=True, capture_output=True, text=True)
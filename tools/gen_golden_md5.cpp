@@ -16,11 +16,13 @@ struct Options {
   int width = 320;
   int height = 240;
   int seed = 1234;
+  int threads = 1;
   std::filesystem::path preset;
 };
 
 void printUsage() {
-  std::cout << "Usage: gen_golden_md5 [--frames N] [--width W] [--height H] [--seed S] [--preset FILE]\n";
+  std::cout << "Usage: gen_golden_md5 [--frames N] [--width W] [--height H] [--seed S] [--threads N]\n"
+               "                      [--preset FILE]\n";
 }
 
 std::string requireValue(int& index, int argc, char** argv) {
@@ -48,6 +50,8 @@ Options parseOptions(int argc, char** argv) {
       opts.height = std::stoi(requireValue(i, argc, argv));
     } else if (arg == "--seed") {
       opts.seed = std::stoi(requireValue(i, argc, argv));
+    } else if (arg == "--threads") {
+      opts.threads = std::stoi(requireValue(i, argc, argv));
     } else if (arg == "--preset") {
       opts.preset = requireValue(i, argc, argv);
     } else {
@@ -61,6 +65,9 @@ Options parseOptions(int argc, char** argv) {
   if (opts.width <= 0 || opts.height <= 0) {
     throw std::runtime_error("--width and --height must be positive");
   }
+  if (opts.threads <= 0) {
+    throw std::runtime_error("--threads must be positive");
+  }
   if (opts.preset.empty()) {
     throw std::runtime_error("--preset must not be empty");
   }
@@ -101,6 +108,7 @@ int main(int argc, char** argv) {
     applySeed(opts.seed);
 
     avs::offscreen::OffscreenRenderer renderer(opts.width, opts.height);
+    renderer.setThreadCount(opts.threads);
     renderer.loadPreset(opts.preset);
 
     auto audio = generateAudioBuffer(48000, 2, 0.05, 0.5, 1000.0);